@@ -0,0 +1,480 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_socket_server.c
+* @{
+*
+* This file contains a stand-in server for the socket io backend. It stores
+* the values written to the device in a sparse memory and answers reads and
+* polls from it, so applications and the driver can be exercised with the
+* socket backend without the simulator.
+*
+* The server listens on localhost, on the port given as argument or on a free
+* port, and writes the port number to ./mesim_output/mesimulator_aximm_port
+* where the socket backend looks for it. It serves one connection at a time.
+*
+* Both protocols of the backend are implemented:
+*	- Text: "W <addr> <value>\n", "R <addr>\n" replied with "0x%08X\n", and
+*	  "P <version>\n" which switches the connection to the binary protocol.
+*	- Binary: a 16 byte header {u8 opcode, u8 rsvd[3], u32 size, u64 addr}
+*	  followed by the payload words, all little endian. Reads, syncs and
+*	  mask polls are replied with one word, block reads with size words.
+*
+* The memory only changes on writes from the client, so a mask poll which is
+* not satisfied when received waits for its timeout and fails.
+*
+******************************************************************************/
+
+/***************************** Include Files *********************************/
+#define _POSIX_C_SOURCE 200112L
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/************************** Constant Definitions *****************************/
+#define SERVER_PORT_DIR		"./mesim_output"
+#define SERVER_PORT_FILE	SERVER_PORT_DIR "/mesimulator_aximm_port"
+#define SERVER_PROTO_VERSION	1U
+#define SERVER_LINE_SIZE	64U
+#define SERVER_INIT_ENTRIES	4096U
+
+/* Opcodes of the binary protocol frames */
+#define SERVER_OP_WRITE		0x1U
+#define SERVER_OP_BLOCKWRITE	0x2U
+#define SERVER_OP_BLOCKSET	0x3U
+#define SERVER_OP_READ		0x4U
+#define SERVER_OP_SYNC		0x5U
+#define SERVER_OP_MASKPOLL	0x6U
+#define SERVER_OP_BLOCKREAD	0x7U
+
+/**************************** Type Definitions *******************************/
+typedef struct {
+	uint8_t Opcode;
+	uint8_t Rsvd[3];
+	uint32_t Size;
+	uint64_t Addr;
+} FrameHdr;
+
+typedef struct {
+	uint64_t Addr;
+	uint32_t Value;
+	uint8_t Used;
+} MemEntry;
+
+typedef struct {
+	MemEntry *Entries;
+	uint64_t NumEntries;
+	uint64_t MaxEntries;
+} SparseMem;
+
+/************************** Function Definitions *****************************/
+static MemEntry *MemLookup(SparseMem *Mem, uint64_t Addr)
+{
+	uint64_t Mask = Mem->MaxEntries - 1U;
+	uint64_t Index = ((Addr >> 2U) * 0x9E3779B97F4A7C15ULL) >> 32;
+
+	Index &= Mask;
+	while(Mem->Entries[Index].Used && Mem->Entries[Index].Addr != Addr) {
+		Index = (Index + 1U) & Mask;
+	}
+
+	return &Mem->Entries[Index];
+}
+
+static int MemInit(SparseMem *Mem)
+{
+	Mem->Entries = calloc(SERVER_INIT_ENTRIES, sizeof(*Mem->Entries));
+	Mem->NumEntries = 0U;
+	Mem->MaxEntries = SERVER_INIT_ENTRIES;
+
+	return (Mem->Entries == NULL) ? -1 : 0;
+}
+
+static uint32_t MemRead(SparseMem *Mem, uint64_t Addr)
+{
+	MemEntry *Entry = MemLookup(Mem, Addr);
+
+	return Entry->Used ? Entry->Value : 0U;
+}
+
+static int MemWrite(SparseMem *Mem, uint64_t Addr, uint32_t Value)
+{
+	MemEntry *Entry = MemLookup(Mem, Addr);
+
+	if(!Entry->Used) {
+		if((Mem->NumEntries + 1U) * 2U > Mem->MaxEntries) {
+			SparseMem New;
+
+			New.MaxEntries = Mem->MaxEntries * 2U;
+			New.NumEntries = Mem->NumEntries;
+			New.Entries = calloc(New.MaxEntries,
+					sizeof(*New.Entries));
+			if(New.Entries == NULL) {
+				return -1;
+			}
+
+			for(uint64_t i = 0U; i < Mem->MaxEntries; i++) {
+				if(Mem->Entries[i].Used) {
+					*MemLookup(&New, Mem->Entries[i].Addr) =
+						Mem->Entries[i];
+				}
+			}
+			free(Mem->Entries);
+			*Mem = New;
+			Entry = MemLookup(Mem, Addr);
+		}
+
+		Entry->Used = 1U;
+		Entry->Addr = Addr;
+		Mem->NumEntries++;
+	}
+
+	Entry->Value = Value;
+
+	return 0;
+}
+
+/* Converts between the host byte order and little endian, both ways */
+static uint32_t Le32(uint32_t Val)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return __builtin_bswap32(Val);
+#else
+	return Val;
+#endif
+}
+
+static uint64_t Le64(uint64_t Val)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return __builtin_bswap64(Val);
+#else
+	return Val;
+#endif
+}
+
+static int RecvAll(int Fd, void *Buf, size_t Len)
+{
+	uint8_t *Ptr = Buf;
+
+	while(Len > 0U) {
+		ssize_t Ret = read(Fd, Ptr, Len);
+
+		if(Ret < 0 && errno == EINTR) {
+			continue;
+		}
+		if(Ret <= 0) {
+			return -1;
+		}
+		Ptr += Ret;
+		Len -= (size_t)Ret;
+	}
+
+	return 0;
+}
+
+static int SendAll(int Fd, const void *Buf, size_t Len)
+{
+	const uint8_t *Ptr = Buf;
+
+	while(Len > 0U) {
+		ssize_t Ret = write(Fd, Ptr, Len);
+
+		if(Ret < 0 && errno == EINTR) {
+			continue;
+		}
+		if(Ret <= 0) {
+			return -1;
+		}
+		Ptr += Ret;
+		Len -= (size_t)Ret;
+	}
+
+	return 0;
+}
+
+static int SendWord(int Fd, uint32_t Value)
+{
+	Value = Le32(Value);
+
+	return SendAll(Fd, &Value, sizeof(Value));
+}
+
+static int RecvWords(int Fd, uint32_t *Words, uint32_t NumWords)
+{
+	if(RecvAll(Fd, Words, NumWords * sizeof(*Words)) != 0) {
+		return -1;
+	}
+
+	for(uint32_t i = 0U; i < NumWords; i++) {
+		Words[i] = Le32(Words[i]);
+	}
+
+	return 0;
+}
+
+static int BlockRead(int Fd, SparseMem *Mem, uint64_t Addr, uint32_t Size)
+{
+	uint32_t *Buf;
+	int Ret;
+
+	Buf = malloc((size_t)Size * sizeof(*Buf) + 1U);
+	if(Buf == NULL) {
+		return -1;
+	}
+
+	for(uint32_t i = 0U; i < Size; i++) {
+		Buf[i] = Le32(MemRead(Mem, Addr + 4U * i));
+	}
+
+	Ret = SendAll(Fd, Buf, (size_t)Size * sizeof(*Buf));
+	free(Buf);
+
+	return Ret;
+}
+
+static uint32_t MaskPoll(SparseMem *Mem, uint64_t Addr, uint32_t Mask,
+		uint32_t Value, uint32_t TimeOutUs)
+{
+	struct timespec Ts;
+
+	if((MemRead(Mem, Addr) & Mask) == Value) {
+		return 0U;
+	}
+
+	Ts.tv_sec = TimeOutUs / 1000000U;
+	Ts.tv_nsec = (long)(TimeOutUs % 1000000U) * 1000L;
+	nanosleep(&Ts, NULL);
+
+	return ((MemRead(Mem, Addr) & Mask) == Value) ? 0U : 1U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function serves binary frames until the connection is closed.
+*
+* @param	Fd: Connection socket.
+* @param	Mem: Sparse memory of the device.
+*
+* @return	0 when the client closed the connection, -1 on error.
+*
+******************************************************************************/
+static int ServeBinary(int Fd, SparseMem *Mem)
+{
+	uint32_t Words[3];
+	FrameHdr Hdr;
+
+	while(RecvAll(Fd, &Hdr, sizeof(Hdr)) == 0) {
+		Hdr.Size = Le32(Hdr.Size);
+		Hdr.Addr = Le64(Hdr.Addr);
+
+		switch(Hdr.Opcode) {
+		case SERVER_OP_WRITE:
+			if(RecvWords(Fd, Words, 1U) != 0 ||
+					MemWrite(Mem, Hdr.Addr, Words[0]) != 0) {
+				return -1;
+			}
+			break;
+		case SERVER_OP_BLOCKWRITE:
+			for(uint32_t i = 0U; i < Hdr.Size; i++) {
+				if(RecvWords(Fd, Words, 1U) != 0 ||
+						MemWrite(Mem, Hdr.Addr + 4U * i,
+							Words[0]) != 0) {
+					return -1;
+				}
+			}
+			break;
+		case SERVER_OP_BLOCKSET:
+			if(RecvWords(Fd, Words, 1U) != 0) {
+				return -1;
+			}
+			for(uint32_t i = 0U; i < Hdr.Size; i++) {
+				if(MemWrite(Mem, Hdr.Addr + 4U * i,
+							Words[0]) != 0) {
+					return -1;
+				}
+			}
+			break;
+		case SERVER_OP_READ:
+			if(SendWord(Fd, MemRead(Mem, Hdr.Addr)) != 0) {
+				return -1;
+			}
+			break;
+		case SERVER_OP_BLOCKREAD:
+			if(BlockRead(Fd, Mem, Hdr.Addr, Hdr.Size) != 0) {
+				return -1;
+			}
+			break;
+		case SERVER_OP_SYNC:
+			/* Frames are applied as they are received */
+			if(SendWord(Fd, 0U) != 0) {
+				return -1;
+			}
+			break;
+		case SERVER_OP_MASKPOLL:
+			if(RecvWords(Fd, Words, 3U) != 0 ||
+					SendWord(Fd, MaskPoll(Mem, Hdr.Addr,
+						Words[0], Words[1],
+						Words[2])) != 0) {
+				return -1;
+			}
+			break;
+		default:
+			fprintf(stderr, "Unknown frame opcode %u\n",
+					Hdr.Opcode);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function serves a connection, starting with the text protocol.
+*
+* @param	Fd: Connection socket.
+* @param	Mem: Sparse memory of the device.
+*
+* @return	0 when the client closed the connection, -1 on error.
+*
+******************************************************************************/
+static int ServeConnection(int Fd, SparseMem *Mem)
+{
+	char Line[SERVER_LINE_SIZE];
+	char Reply[SERVER_LINE_SIZE];
+	unsigned long long Addr, Value;
+	size_t Len = 0U;
+
+	while(RecvAll(Fd, &Line[Len], 1U) == 0) {
+		if(Line[Len] != '\n') {
+			if(++Len == SERVER_LINE_SIZE) {
+				fprintf(stderr, "Command line too long\n");
+				return -1;
+			}
+			continue;
+		}
+
+		Line[Len] = '\0';
+		Len = 0U;
+
+		if(sscanf(Line, "W %llx %llx", &Addr, &Value) == 2) {
+			if(MemWrite(Mem, Addr, (uint32_t)Value) != 0) {
+				return -1;
+			}
+		} else if(sscanf(Line, "R %llx", &Addr) == 1) {
+			sprintf(Reply, "0x%08X\n", MemRead(Mem, Addr));
+			if(SendAll(Fd, Reply, strlen(Reply)) != 0) {
+				return -1;
+			}
+		} else if(sscanf(Line, "P %llx", &Value) == 1) {
+			if(Value != SERVER_PROTO_VERSION) {
+				sprintf(Reply, "0x%08X\n", 0U);
+				if(SendAll(Fd, Reply, strlen(Reply)) != 0) {
+					return -1;
+				}
+				continue;
+			}
+
+			sprintf(Reply, "0x%08X\n", SERVER_PROTO_VERSION);
+			if(SendAll(Fd, Reply, strlen(Reply)) != 0) {
+				return -1;
+			}
+
+			return ServeBinary(Fd, Mem);
+		} else {
+			fprintf(stderr, "Unknown command %s\n", Line);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	struct sockaddr_in Addr;
+	socklen_t AddrLen = sizeof(Addr);
+	SparseMem Mem;
+	int Fd, Opt = 1;
+	FILE *PortFile;
+
+	memset(&Addr, 0, sizeof(Addr));
+	Addr.sin_family = AF_INET;
+	Addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	Addr.sin_port = htons((argc > 1) ? (uint16_t)atoi(argv[1]) : 0U);
+
+	Fd = socket(AF_INET, SOCK_STREAM, 0);
+	if(Fd < 0) {
+		perror("socket");
+		return -1;
+	}
+
+	setsockopt(Fd, SOL_SOCKET, SO_REUSEADDR, &Opt, sizeof(Opt));
+	if(bind(Fd, (struct sockaddr *)&Addr, sizeof(Addr)) != 0 ||
+			listen(Fd, 1) != 0 ||
+			getsockname(Fd, (struct sockaddr *)&Addr,
+				&AddrLen) != 0) {
+		perror("bind");
+		close(Fd);
+		return -1;
+	}
+
+	mkdir(SERVER_PORT_DIR, 0755);
+	PortFile = fopen(SERVER_PORT_FILE, "w");
+	if(PortFile == NULL) {
+		perror("fopen");
+		close(Fd);
+		return -1;
+	}
+	fprintf(PortFile, "%u", ntohs(Addr.sin_port));
+	fclose(PortFile);
+	printf("Listening on localhost:%u\n", ntohs(Addr.sin_port));
+	fflush(stdout);
+
+	if(MemInit(&Mem) != 0) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		close(Fd);
+		return -1;
+	}
+
+	while(1) {
+		int ConnFd = accept(Fd, NULL, NULL);
+
+		if(ConnFd < 0) {
+			if(errno == EINTR) {
+				continue;
+			}
+			perror("accept");
+			break;
+		}
+
+		if(ServeConnection(ConnFd, &Mem) != 0) {
+			fprintf(stderr, "Connection closed on error\n");
+		}
+		close(ConnFd);
+	}
+
+	free(Mem.Entries);
+	close(Fd);
+
+	return 0;
+}
+
+/** @} */
@@ -39,10 +39,22 @@
 
 /************************** Constant Definitions *****************************/
 #define XAIE_DEFAULT_NUM_CMDS 1024U
+#define XAIE_TXN_MAX_NUM_CMDS	0x80000000U
+#define XAIE_TXN_CHUNK_SIZE	0x4000U
+#define XAIE_TXN_MAX_CHUNK_SIZE	0x400000U
 
-#define XAIE_TXN_INSTANCE_EXPORTED	0b10U
-#define XAIE_TXN_INST_EXPORTED_MASK XAIE_TXN_INSTANCE_EXPORTED
 #define XAIE_TXN_AUTO_FLUSH_MASK XAIE_TRANSACTION_ENABLE_AUTO_FLUSH
+#define XAIE_TXN_OPTIMIZE_MASK XAIE_TRANSACTION_ENABLE_OPTIMIZE
+
+/*
+ * Transaction slot table, number of slots must be a power of 2. Transactions
+ * which do not fit in the table are kept in DevInst->TxnList.
+ */
+#define XAIE_TXN_NUM_SLOTS	64U
+#define XAIE_TXN_SLOT_FREE	0U
+#define XAIE_TXN_SLOT_BUSY	1U
+#define XAIE_TXN_SLOT_USED	2U
+#define XAIE_TXN_SLOT_DELETED	3U
 
 /************************** Variable Definitions *****************************/
 /***************************** Macro Definitions *****************************/
@@ -405,32 +417,190 @@ void _XAie_ClrBitInBitmap(u32 *Bitmap, u32 StartBit, u32 NumBit)
 
 /*****************************************************************************/
 /**
-* This API inserts a transaction node to the linked list.
+* This API hashes a thread id to the index of its first probe slot in the
+* transaction slot table.
+*
+* @param        Tid: Thread id.
+*
+* @return       Index of the first slot to probe.
+*
+* @note         Internal only. Thread ids returned by pthread_self() are
+*		aligned pointers, the multiplicative hash spreads the low bits.
+*
+******************************************************************************/
+static inline u32 _XAie_TxnHashTid(u64 Tid)
+{
+	return (u32)((Tid * 0x9E3779B97F4A7C15ULL) >> 32) &
+		(XAIE_TXN_NUM_SLOTS - 1U);
+}
+
+/*****************************************************************************/
+/**
+* This API returns the transaction slot table of the device instance. The table
+* is allocated when the first transaction is started on the device instance.
 *
 * @param        DevInst: Device Instance
-* @param        TxnNode: Pointer to the transaction node to be inserted
 *
-* @return       None
+* @return       Pointer to the slot table on success and NULL on failure.
+*
+* @note         Internal only.
+*
+******************************************************************************/
+static XAie_TxnSlot *_XAie_TxnGetSlots(XAie_DevInst *DevInst)
+{
+	XAie_TxnSlot *Slots, *Expected = NULL;
+
+	Slots = __atomic_load_n(&DevInst->TxnSlots, __ATOMIC_ACQUIRE);
+	if(Slots != NULL) {
+		return Slots;
+	}
+
+	Slots = (XAie_TxnSlot *)calloc(XAIE_TXN_NUM_SLOTS, sizeof(*Slots));
+	if(Slots == NULL) {
+		XAIE_ERROR("Failed to allocate memory for txn slot table\n");
+		return NULL;
+	}
+
+	/* Another thread may have installed the table in the meantime */
+	if(!__atomic_compare_exchange_n(&DevInst->TxnSlots, &Expected, Slots,
+				0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+		free(Slots);
+		return Expected;
+	}
+
+	return Slots;
+}
+
+/*****************************************************************************/
+/**
+* This API acquires the lock of the transaction slot table and of the list of
+* the transactions which do not fit in the table.
+*
+* @param        DevInst: Device Instance
+*
+* @return       None.
+*
+* @note         Internal only. Inserts and removals take the lock, lookups in
+*		the slot table do not.
+*
+******************************************************************************/
+static inline void _XAie_TxnListLock(XAie_DevInst *DevInst)
+{
+	while(__atomic_test_and_set(&DevInst->TxnListLock, __ATOMIC_ACQUIRE)) {
+		;
+	}
+}
+
+static inline void _XAie_TxnListUnlock(XAie_DevInst *DevInst)
+{
+	__atomic_clear(&DevInst->TxnListLock, __ATOMIC_RELEASE);
+}
+
+/*****************************************************************************/
+/**
+* This API inserts a transaction instance to the transaction slot table. When
+* the table is full, the instance is appended to the transaction list.
+*
+* @param        DevInst: Device Instance
+* @param        Inst: Pointer to the transaction instance to be inserted
+*
+* @return       XAIE_OK.
 *
 * @note         Internal only.
 *
 ******************************************************************************/
-static void _XAie_AppendTxnInstToList(XAie_DevInst *DevInst, XAie_TxnInst *Inst)
+static AieRC _XAie_AppendTxnInstToList(XAie_DevInst *DevInst,
+		XAie_TxnInst *Inst)
 {
-	XAie_List *Node = &DevInst->TxnList;
+	XAie_TxnSlot *Slots;
+	XAie_List *Node;
+	u32 Index = _XAie_TxnHashTid(Inst->Tid);
+
+	Slots = _XAie_TxnGetSlots(DevInst);
 
+	_XAie_TxnListLock(DevInst);
+	for(u32 i = 0U; (Slots != NULL) && (i < XAIE_TXN_NUM_SLOTS); i++) {
+		XAie_TxnSlot *Slot = &Slots[(Index + i) &
+			(XAIE_TXN_NUM_SLOTS - 1U)];
+		u32 State = __atomic_load_n(&Slot->State, __ATOMIC_ACQUIRE);
+
+		if((State != XAIE_TXN_SLOT_FREE) &&
+				(State != XAIE_TXN_SLOT_DELETED)) {
+			continue;
+		}
+
+		__atomic_store_n(&Slot->State, XAIE_TXN_SLOT_BUSY,
+				__ATOMIC_RELAXED);
+		__atomic_store_n(&Slot->Tid, Inst->Tid, __ATOMIC_RELAXED);
+		Slot->Inst = Inst;
+		__atomic_store_n(&Slot->State, XAIE_TXN_SLOT_USED,
+				__ATOMIC_RELEASE);
+		__atomic_add_fetch(&DevInst->NumTxns, 1U, __ATOMIC_RELEASE);
+		_XAie_TxnListUnlock(DevInst);
+
+		return XAIE_OK;
+	}
+
+	XAIE_DBG("Transaction slot table is full, using the list\n");
+
+	Node = &DevInst->TxnList;
 	while(Node->Next != NULL) {
 		Node = Node->Next;
 	}
-
-	Node->Next = &Inst->Node;
 	Inst->Node.Next = NULL;
+	__atomic_store_n(&Node->Next, &Inst->Node, __ATOMIC_RELEASE);
+	__atomic_add_fetch(&DevInst->NumTxns, 1U, __ATOMIC_RELEASE);
+	_XAie_TxnListUnlock(DevInst);
+
+	return XAIE_OK;
 }
 
 /*****************************************************************************/
 /**
-* This API returns the transaction list from the linked list based on the thread
-* id.
+* This API returns the slot of the transaction instance with the given thread
+* id from the transaction slot table.
+*
+* @param        DevInst: Device instance pointer
+* @param	Tid: Thread id.
+*
+* @return       Pointer to transaction slot on success and NULL on failure
+*
+* @note         Internal only. Only the owning thread inserts or removes the
+*		slot with its own thread id, so a matching slot cannot be
+*		released while it is being read.
+*
+******************************************************************************/
+static XAie_TxnSlot *_XAie_GetTxnSlot(XAie_DevInst *DevInst, u64 Tid)
+{
+	XAie_TxnSlot *Slots;
+	u32 Index = _XAie_TxnHashTid(Tid);
+
+	Slots = __atomic_load_n(&DevInst->TxnSlots, __ATOMIC_ACQUIRE);
+	if(Slots == NULL) {
+		return NULL;
+	}
+
+	for(u32 i = 0U; i < XAIE_TXN_NUM_SLOTS; i++) {
+		XAie_TxnSlot *Slot = &Slots[(Index + i) &
+			(XAIE_TXN_NUM_SLOTS - 1U)];
+		u32 State = __atomic_load_n(&Slot->State, __ATOMIC_ACQUIRE);
+
+		if(State == XAIE_TXN_SLOT_FREE) {
+			break;
+		}
+
+		if((State == XAIE_TXN_SLOT_USED) &&
+			(__atomic_load_n(&Slot->Tid, __ATOMIC_RELAXED) == Tid)) {
+			return Slot;
+		}
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+* This API returns the transaction instance based on the thread id.
 *
 * @param        DevInst: Device instance pointer
 * @param	Tid: Thread id.
@@ -440,91 +610,356 @@ static void _XAie_AppendTxnInstToList(XAie_DevInst *DevInst, XAie_TxnInst *Inst)
 * @note         Internal only.
 *
 ******************************************************************************/
-static XAie_TxnInst *_XAie_GetTxnInst(XAie_DevInst *DevInst, u64 Tid)
+XAie_TxnInst *_XAie_GetTxnInst(XAie_DevInst *DevInst, u64 Tid)
 {
-	XAie_List *NodePtr = DevInst->TxnList.Next;
-	XAie_TxnInst *TxnInst;
+	XAie_TxnSlot *Slot = _XAie_GetTxnSlot(DevInst, Tid);
+	XAie_TxnInst *Inst = NULL;
+	XAie_List *NodePtr;
+
+	if(Slot != NULL) {
+		return Slot->Inst;
+	}
 
+	if(__atomic_load_n(&DevInst->TxnList.Next, __ATOMIC_ACQUIRE) == NULL) {
+		return NULL;
+	}
+
+	_XAie_TxnListLock(DevInst);
+	NodePtr = DevInst->TxnList.Next;
 	while(NodePtr != NULL) {
-		TxnInst = XAIE_CONTAINER_OF(NodePtr, XAie_TxnInst, Node);
+		XAie_TxnInst *TxnInst = XAIE_CONTAINER_OF(NodePtr,
+				XAie_TxnInst, Node);
+
 		if(TxnInst->Tid == Tid) {
-			return TxnInst;
+			Inst = TxnInst;
+			break;
 		}
 
 		NodePtr = NodePtr->Next;
 	}
+	_XAie_TxnListUnlock(DevInst);
 
-	return NULL;
+	return Inst;
 }
 
 /*****************************************************************************/
 /**
-* This API removes a node from the linked list if the thread id is found.
+* This API returns the transaction instance of the calling thread. When no
+* transaction is open on the device instance, it returns without querying the
+* thread id.
 *
 * @param        DevInst: Device instance pointer
-* @param	Tid: Thread id.
 *
-* @return       XAIE_OK on success and error code on failure.
+* @return       Pointer to transaction instance if the calling thread has an
+*		open transaction, NULL otherwise.
 *
 * @note         Internal only.
 *
 ******************************************************************************/
-static AieRC _XAie_RemoveTxnInstFromList(XAie_DevInst *DevInst, u64 Tid)
+static inline XAie_TxnInst *_XAie_GetCurrentTxnInst(XAie_DevInst *DevInst)
+{
+	if(__atomic_load_n(&DevInst->NumTxns, __ATOMIC_ACQUIRE) == 0U) {
+		return NULL;
+	}
+
+	return _XAie_GetTxnInst(DevInst, DevInst->Backend->Ops.GetTid());
+}
+
+/*****************************************************************************/
+/**
+* This API removes a transaction instance from the transaction slot table.
+*
+* @param        DevInst: Device instance pointer
+* @param	Inst: Pointer to the transaction instance.
+*
+* @return       XAIE_OK on success and error code on failure.
+*
+* @note         Internal only. The slot is marked deleted instead of free to
+*		keep the probe sequence of the other slots intact. A deleted
+*		slot followed by a free slot ends no probe sequence, so it and
+*		the deleted slots before it are freed. Instances which are not
+*		in the table are removed from the transaction list.
+*
+******************************************************************************/
+AieRC _XAie_RemoveTxnInstFromList(XAie_DevInst *DevInst,
+		XAie_TxnInst *Inst)
 {
-	XAie_List *NodePtr = DevInst->TxnList.Next;
+	XAie_TxnSlot *Slot = _XAie_GetTxnSlot(DevInst, Inst->Tid);
 	XAie_List *Prev = &DevInst->TxnList;
-	XAie_TxnInst *Inst;
 
-	while(NodePtr != NULL) {
-		Inst = (XAie_TxnInst *)XAIE_CONTAINER_OF(NodePtr, XAie_TxnInst,
-				Node);
-		if(Inst->Tid == Tid) {
-			break;
+	_XAie_TxnListLock(DevInst);
+	if((Slot != NULL) && (Slot->Inst == Inst)) {
+		XAie_TxnSlot *Slots = DevInst->TxnSlots;
+		u32 Index = (u32)(Slot - Slots);
+
+		Slot->Inst = NULL;
+		__atomic_store_n(&Slot->State, XAIE_TXN_SLOT_DELETED,
+				__ATOMIC_RELEASE);
+
+		for(u32 i = 0U; i < XAIE_TXN_NUM_SLOTS; i++) {
+			u32 Next = (Index + 1U) & (XAIE_TXN_NUM_SLOTS - 1U);
+
+			if((Slots[Index].State != XAIE_TXN_SLOT_DELETED) ||
+					(Slots[Next].State !=
+					 XAIE_TXN_SLOT_FREE)) {
+				break;
+			}
+
+			__atomic_store_n(&Slots[Index].State,
+					XAIE_TXN_SLOT_FREE, __ATOMIC_RELEASE);
+			Index = (Index - 1U) & (XAIE_TXN_NUM_SLOTS - 1U);
 		}
 
-		Prev = NodePtr;
-		NodePtr = NodePtr->Next;
+		__atomic_sub_fetch(&DevInst->NumTxns, 1U, __ATOMIC_RELEASE);
+		_XAie_TxnListUnlock(DevInst);
+		return XAIE_OK;
+	}
+
+	while((Prev->Next != NULL) && (Prev->Next != &Inst->Node)) {
+		Prev = Prev->Next;
 	}
 
-	if(NodePtr == NULL) {
+	if(Prev->Next == NULL) {
+		_XAie_TxnListUnlock(DevInst);
 		XAIE_ERROR("Cannot find node to delete from list\n");
 		return XAIE_ERR;
-	} else {
-		Prev->Next = NodePtr->Next;
 	}
 
+	__atomic_store_n(&Prev->Next, Inst->Node.Next, __ATOMIC_RELEASE);
+	Inst->Node.Next = NULL;
+	__atomic_sub_fetch(&DevInst->NumTxns, 1U, __ATOMIC_RELEASE);
+	_XAie_TxnListUnlock(DevInst);
+
 	return XAIE_OK;
 }
 
 /*****************************************************************************/
 /**
 * This API rellaocates the command buffer associated with the given transaction
-* instance. The command buffer is extended to accomodate an additional
-* XAIE_DEFAULT_NUM_CMDS number of commands.
+* instance. The size of the command buffer is doubled, so that recording N
+* commands copies the buffer O(log N) times.
 *
 * @param        TxnInst: Pointer to the transaction instance
 *
 * @return       XAIE_OK on success and XAIE_ERR on failure
 *
-* @note         Internal only.
+* @note         Internal only. The command buffer is left untouched on failure.
 *
 ******************************************************************************/
 static AieRC _XAie_ReallocCmdBuf(XAie_TxnInst *TxnInst)
 {
-	TxnInst->CmdBuf = (XAie_TxnCmd *)realloc((void *)TxnInst->CmdBuf,
-			sizeof(XAie_TxnCmd) *
-			(TxnInst->MaxCmds + XAIE_DEFAULT_NUM_CMDS));
-	if(TxnInst->CmdBuf == NULL) {
+	XAie_TxnCmd *CmdBuf;
+	u32 MaxCmds;
+
+	if(TxnInst->MaxCmds > XAIE_TXN_MAX_NUM_CMDS / 2U) {
+		XAIE_ERROR("Transaction buffer with id: %ld is full\n",
+				TxnInst->Tid);
+		return XAIE_ERR;
+	}
+
+	MaxCmds = TxnInst->MaxCmds * 2U;
+	CmdBuf = (XAie_TxnCmd *)realloc((void *)TxnInst->CmdBuf,
+			sizeof(XAie_TxnCmd) * MaxCmds);
+	if(CmdBuf == NULL) {
+		XAIE_ERROR("Failed reallocate memory for transaction buffer "
+				"with id: %ld\n", TxnInst->Tid);
+		return XAIE_ERR;
+	}
+
+	TxnInst->CmdBuf = CmdBuf;
+	TxnInst->MaxCmds = MaxCmds;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+* This API makes room in the command buffer of the transaction instance for the
+* given number of commands. The size of the command buffer is doubled until the
+* commands fit.
+*
+* @param        TxnInst: Pointer to the transaction instance
+* @param        NumCmds: Number of commands to be added
+*
+* @return       XAIE_OK on success and XAIE_ERR on failure
+*
+* @note         Internal only. The command buffer is left untouched on failure.
+*
+******************************************************************************/
+static AieRC _XAie_ReserveCmdBuf(XAie_TxnInst *TxnInst, u32 NumCmds)
+{
+	XAie_TxnCmd *CmdBuf;
+	u64 Needed = (u64)TxnInst->NumCmds + NumCmds + 1U;
+	u64 MaxCmds = TxnInst->MaxCmds;
+
+	if(Needed <= MaxCmds) {
+		return XAIE_OK;
+	}
+
+	while(MaxCmds < Needed) {
+		MaxCmds *= 2U;
+	}
+
+	if(MaxCmds > XAIE_TXN_MAX_NUM_CMDS) {
+		XAIE_ERROR("Transaction buffer with id: %ld is full\n",
+				TxnInst->Tid);
+		return XAIE_ERR;
+	}
+
+	CmdBuf = (XAie_TxnCmd *)realloc((void *)TxnInst->CmdBuf,
+			sizeof(XAie_TxnCmd) * MaxCmds);
+	if(CmdBuf == NULL) {
 		XAIE_ERROR("Failed reallocate memory for transaction buffer "
-				"with id: %d\n", TxnInst->Tid);
+				"with id: %ld\n", TxnInst->Tid);
 		return XAIE_ERR;
 	}
 
-	TxnInst->MaxCmds += XAIE_DEFAULT_NUM_CMDS;
+	TxnInst->CmdBuf = CmdBuf;
+	TxnInst->MaxCmds = (u32)MaxCmds;
 
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+* This API adds an empty chunk to the payload arena of the transaction
+* instance. The new chunk becomes the current one.
+*
+* @param        TxnInst: Pointer to the transaction instance
+* @param        ChunkSize: Size of the chunk in bytes
+*
+* @return       Pointer to the chunk on success and NULL on failure
+*
+* @note         Internal only.
+*
+******************************************************************************/
+static XAie_TxnChunk *_XAie_TxnAddChunk(XAie_TxnInst *TxnInst, u64 ChunkSize)
+{
+	XAie_TxnChunk *Chunk;
+
+	Chunk = (XAie_TxnChunk *)malloc(sizeof(*Chunk) + ChunkSize);
+	if(Chunk == NULL) {
+		XAIE_ERROR("Failed to allocate memory for transaction "
+				"payload\n");
+		return NULL;
+	}
+
+	Chunk->Size = ChunkSize;
+	Chunk->Used = 0U;
+	Chunk->Next = TxnInst->Payload;
+	TxnInst->Payload = Chunk;
+
+	return Chunk;
+}
+
+/*****************************************************************************/
+/**
+* This API allocates memory for a block write payload from the payload arena of
+* the transaction instance. A new chunk, twice the size of the current one, is
+* added to the arena when the current chunk cannot hold the payload.
+*
+* @param        TxnInst: Pointer to the transaction instance
+* @param        Size: Size of the payload in bytes
+*
+* @return       Pointer to the payload memory on success and NULL on failure
+*
+* @note         Internal only. The memory is owned by the transaction instance
+*		and released with it.
+*
+******************************************************************************/
+void *_XAie_TxnAllocPayload(XAie_TxnInst *TxnInst, u64 Size)
+{
+	XAie_TxnChunk *Chunk = TxnInst->Payload;
+	void *Ptr;
+
+	Size = (Size + sizeof(u64) - 1U) & ~((u64)sizeof(u64) - 1U);
+
+	if((Chunk == NULL) || (Chunk->Size - Chunk->Used < Size)) {
+		u64 ChunkSize = XAIE_TXN_CHUNK_SIZE;
+
+		if(Chunk != NULL) {
+			ChunkSize = Chunk->Size * 2U;
+			if(ChunkSize > XAIE_TXN_MAX_CHUNK_SIZE) {
+				ChunkSize = XAIE_TXN_MAX_CHUNK_SIZE;
+			}
+		}
+
+		if(ChunkSize < Size) {
+			ChunkSize = Size;
+		}
+
+		Chunk = _XAie_TxnAddChunk(TxnInst, ChunkSize);
+		if(Chunk == NULL) {
+			return NULL;
+		}
+	}
+
+	Ptr = (u8 *)Chunk->Data + Chunk->Used;
+	Chunk->Used += Size;
+
+	return Ptr;
+}
+
+/*****************************************************************************/
+/**
+* This API releases all the chunks of the payload arena of the transaction
+* instance.
+*
+* @param        TxnInst: Pointer to the transaction instance
+*
+* @return       None
+*
+* @note         Internal only.
+*
+******************************************************************************/
+void _XAie_TxnFreePayload(XAie_TxnInst *TxnInst)
+{
+	XAie_TxnChunk *Chunk = TxnInst->Payload;
+
+	while(Chunk != NULL) {
+		XAie_TxnChunk *Next = Chunk->Next;
+
+		free(Chunk);
+		Chunk = Next;
+	}
+
+	TxnInst->Payload = NULL;
+}
+
+/*****************************************************************************/
+/**
+* This API empties the command buffer of the transaction instance after its
+* commands are flushed, the patch points of the flushed commands are dropped.
+* The newest chunk of the payload arena is kept for the
+* commands to come and the older chunks are released.
+*
+* @param        TxnInst: Pointer to the transaction instance
+*
+* @return       None
+*
+* @note         Internal only.
+*
+******************************************************************************/
+static void _XAie_TxnResetCmdBuf(XAie_TxnInst *TxnInst)
+{
+	XAie_TxnChunk *Chunk = TxnInst->Payload;
+
+	TxnInst->NumCmds = 0U;
+	if(TxnInst->Relocs != NULL) {
+		TxnInst->Relocs->NumRelocs = 0U;
+	}
+
+	if(Chunk == NULL) {
+		return;
+	}
+
+	TxnInst->Payload = Chunk->Next;
+	_XAie_TxnFreePayload(TxnInst);
+	Chunk->Used = 0U;
+	Chunk->Next = NULL;
+	TxnInst->Payload = Chunk;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -533,16 +968,27 @@ static AieRC _XAie_ReallocCmdBuf(XAie_TxnInst *TxnInst)
 *
 * @param	DevInst - Device instance pointer.
 * @param	Flags - Flags passed by the user.
+* @param	NumCmds - Expected number of commands, 0 if unknown.
+* @param	PayloadSize - Expected size of the block write payloads in
+*		bytes, 0 if unknown.
 *
 * @return	Pointer to transaction instance on success and NULL on error.
 *
-* @note		Internal Only.
+* @note		Internal Only. The hints only size the initial allocations,
+*		the buffers still grow if they are exceeded.
 *
 ******************************************************************************/
-AieRC _XAie_Txn_Start(XAie_DevInst *DevInst, u32 Flags)
+AieRC _XAie_Txn_Start(XAie_DevInst *DevInst, u32 Flags, u32 NumCmds,
+		u64 PayloadSize)
 {
 	XAie_TxnInst *Inst;
 	const XAie_Backend *Backend = DevInst->Backend;
+	u32 MaxCmds = XAIE_DEFAULT_NUM_CMDS;
+
+	/* The command buffer is grown before its last entry is used */
+	if((NumCmds >= MaxCmds) && (NumCmds < XAIE_TXN_MAX_NUM_CMDS)) {
+		MaxCmds = NumCmds + 1U;
+	}
 
 	Inst = (XAie_TxnInst*)malloc(sizeof(*Inst));
 	if(Inst == NULL) {
@@ -550,8 +996,7 @@ AieRC _XAie_Txn_Start(XAie_DevInst *DevInst, u32 Flags)
 		return XAIE_ERR;
 	}
 
-	Inst->CmdBuf = (XAie_TxnCmd*)calloc(XAIE_DEFAULT_NUM_CMDS,
-			sizeof(*Inst->CmdBuf));
+	Inst->CmdBuf = (XAie_TxnCmd*)calloc(MaxCmds, sizeof(*Inst->CmdBuf));
 	if(Inst->CmdBuf == NULL) {
 		XAIE_ERROR("Failed to allocate memory for command buffer\n");
 		free(Inst);
@@ -559,9 +1004,19 @@ AieRC _XAie_Txn_Start(XAie_DevInst *DevInst, u32 Flags)
 	}
 
 	Inst->NumCmds = 0U;
-	Inst->MaxCmds = XAIE_DEFAULT_NUM_CMDS;
+	Inst->MaxCmds = MaxCmds;
+	Inst->Payload = NULL;
+	Inst->Relocs = NULL;
 	Inst->Tid = Backend->Ops.GetTid();
 
+	if((PayloadSize != 0U) && (_XAie_TxnAddChunk(Inst,
+				(PayloadSize + sizeof(u64) - 1U) &
+				~((u64)sizeof(u64) - 1U)) == NULL)) {
+		free(Inst->CmdBuf);
+		free(Inst);
+		return XAIE_ERR;
+	}
+
 	XAIE_DBG("Transaction buffer allocated with id: %ld\n", Inst->Tid);
 	Inst->Flags = Flags;
 	if(Flags & XAIE_TXN_AUTO_FLUSH_MASK) {
@@ -572,7 +1027,12 @@ AieRC _XAie_Txn_Start(XAie_DevInst *DevInst, u32 Flags)
 				"id: %ld\n", Inst->Tid);
 	}
 
-	_XAie_AppendTxnInstToList(DevInst, Inst);
+	if(_XAie_AppendTxnInstToList(DevInst, Inst) != XAIE_OK) {
+		_XAie_TxnFreePayload(Inst);
+		free(Inst->CmdBuf);
+		free(Inst);
+		return XAIE_ERR;
+	}
 
 	return XAIE_OK;
 }
@@ -583,15 +1043,13 @@ AieRC _XAie_Txn_Start(XAie_DevInst *DevInst, u32 Flags)
 *
 * @param        DevInst: Device instance pointer
 * @param        Cmd: Pointer to the transaction command structure
-* @param	Flags: Transaction instance flags
 *
 * @return       XAIE_OK on success and XAIE_ERR on failure.
 *
 * @note         Internal only.
 *
 ******************************************************************************/
-static AieRC _XAie_ExecuteCmd(XAie_DevInst *DevInst, XAie_TxnCmd *Cmd,
-		u32 Flags)
+static AieRC _XAie_ExecuteCmd(XAie_DevInst *DevInst, XAie_TxnCmd *Cmd)
 {
 	AieRC RC;
 	const XAie_Backend *Backend = DevInst->Backend;
@@ -625,10 +1083,6 @@ static AieRC _XAie_ExecuteCmd(XAie_DevInst *DevInst, XAie_TxnCmd *Cmd,
 						Cmd->RegOff);
 				return RC;
 			}
-
-			if(!(Flags & XAIE_TXN_INST_EXPORTED_MASK)) {
-				free((void *)Cmd->DataPtr);
-			}
 			break;
 		case XAIE_IO_BLOCKSET:
 			RC = Backend->Ops.BlockSet32((void *)DevInst->IOInst,
@@ -640,6 +1094,35 @@ static AieRC _XAie_ExecuteCmd(XAie_DevInst *DevInst, XAie_TxnCmd *Cmd,
 				return RC;
 			}
 			break;
+		case XAIE_IO_MASKPOLL:
+			RC = Backend->Ops.MaskPoll((void *)DevInst->IOInst,
+					Cmd->RegOff, Cmd->Mask, Cmd->Value,
+					Cmd->Size,
+					&DevInst->PollPolicy[Cmd->DataPtr]);
+			if(RC != XAIE_OK) {
+				XAIE_ERROR("MaskPoll failed. Addr: 0x%lx, Mask: "
+						"0x%x, Value: 0x%x\n",
+						Cmd->RegOff, Cmd->Mask,
+						Cmd->Value);
+				return RC;
+			}
+			break;
+		case XAIE_IO_READ:
+		{
+			u32 *Slot = (u32 *)(uintptr_t)Cmd->DataPtr;
+			u32 Discard;
+
+			/* Exported and loaded transactions have no result slot */
+			RC = Backend->Ops.Read32((void *)DevInst->IOInst,
+					Cmd->RegOff,
+					(Slot != NULL) ? Slot : &Discard);
+			if(RC != XAIE_OK) {
+				XAIE_ERROR("Rd failed. Addr: 0x%lx\n",
+						Cmd->RegOff);
+				return RC;
+			}
+			break;
+		}
 		default:
 			XAIE_ERROR("Invalid transaction opcode\n");
 			return XAIE_ERR;
@@ -648,6 +1131,58 @@ static AieRC _XAie_ExecuteCmd(XAie_DevInst *DevInst, XAie_TxnCmd *Cmd,
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+* This API submits the command buffer to a backend with a transaction submit
+* operation. The read and poll commands are not part of the transaction format
+* of the backend, so the command buffer is split around them: the commands
+* between two of them are submitted as one batch, and they are executed from
+* the host in between.
+*
+* @param        DevInst: Device instance pointer
+* @param        TxnInst: Pointer to the transaction instance
+*
+* @return       XAIE_OK on success and error code on failure
+*
+* @note         Internal only.
+*
+******************************************************************************/
+static AieRC _XAie_Txn_SubmitBatches(XAie_DevInst *DevInst,
+		XAie_TxnInst *TxnInst)
+{
+	AieRC RC;
+	XAie_TxnInst Batch = *TxnInst;
+	const XAie_Backend *Backend = DevInst->Backend;
+	u32 Start = 0U;
+
+	for(u32 i = 0U; i <= TxnInst->NumCmds; i++) {
+		if((i < TxnInst->NumCmds) &&
+				(TxnInst->CmdBuf[i].Opcode != XAIE_IO_MASKPOLL) &&
+				(TxnInst->CmdBuf[i].Opcode != XAIE_IO_READ)) {
+			continue;
+		}
+
+		if(i > Start) {
+			Batch.CmdBuf = &TxnInst->CmdBuf[Start];
+			Batch.NumCmds = i - Start;
+			RC = Backend->Ops.SubmitTxn(DevInst->IOInst, &Batch);
+			if(RC != XAIE_OK) {
+				return RC;
+			}
+		}
+
+		if(i < TxnInst->NumCmds) {
+			RC = _XAie_ExecuteCmd(DevInst, &TxnInst->CmdBuf[i]);
+			if(RC != XAIE_OK) {
+				return RC;
+			}
+		}
+		Start = i + 1U;
+	}
+
+	return XAIE_OK;
+}
+
 /*****************************************************************************/
 /**
 * This API executes all the commands in the command buffer and resets the number
@@ -670,19 +1205,39 @@ static AieRC _XAie_Txn_FlushCmdBuf(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst)
 	XAIE_DBG("Flushing %d commands from transaction buffer\n",
 			TxnInst->NumCmds);
 
+	if(TxnInst->Flags & XAIE_TXN_OPTIMIZE_MASK) {
+		_XAie_TxnOptimize(TxnInst);
+	}
+
 	if(Backend->Ops.SubmitTxn != NULL) {
-		return Backend->Ops.SubmitTxn(DevInst->IOInst, TxnInst);
+		RC = _XAie_Txn_SubmitBatches(DevInst, TxnInst);
+	} else {
+		RC = XAIE_OK;
+		for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
+			RC = _XAie_ExecuteCmd(DevInst, &TxnInst->CmdBuf[i]);
+			if (RC != XAIE_OK) {
+				break;
+			}
+		}
 	}
 
-	for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
-		RC = _XAie_ExecuteCmd(DevInst, &TxnInst->CmdBuf[i],
-				TxnInst->Flags);
-		if (RC != XAIE_OK) {
-			 return RC;
+	/* The commands bypass the shadow, drop the registers they wrote */
+	if(DevInst->Shadow != NULL) {
+		if(RC == XAIE_OK) {
+			_XAie_ShadowInvalidateTxn(DevInst, TxnInst);
+		} else {
+			_XAie_ShadowInvalidateAll(DevInst);
+		}
+	}
+	if(DevInst->MemShadow != NULL) {
+		if(RC == XAIE_OK) {
+			_XAie_MemShadowInvalidateTxn(DevInst, TxnInst);
+		} else {
+			_XAie_MemShadowInvalidateAll(DevInst);
 		}
 	}
 
-	return XAIE_OK;
+	return RC;
 }
 
 /*****************************************************************************/
@@ -701,18 +1256,22 @@ static AieRC _XAie_Txn_FlushCmdBuf(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst)
 AieRC _XAie_Txn_Submit(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst)
 {
 	AieRC RC;
-	u64 Tid;
 	XAie_TxnInst *Inst;
 	const XAie_Backend *Backend = DevInst->Backend;
 
 	if(TxnInst == NULL) {
-		Tid = Backend->Ops.GetTid();
-		Inst = _XAie_GetTxnInst(DevInst, Tid);
+		Inst = _XAie_GetTxnInst(DevInst, Backend->Ops.GetTid());
 		if(Inst == NULL) {
 			XAIE_ERROR("Failed to get the correct transaction "
 					"instance\n");
 			return XAIE_ERR;
 		}
+
+		if(Inst->Flags & XAIE_TXN_INST_CHILD_MASK) {
+			XAIE_ERROR("Child transaction must be merged to its "
+					"parent\n");
+			return XAIE_ERR;
+		}
 	} else {
 		if(TxnInst->Flags & XAIE_TXN_INST_EXPORTED_MASK) {
 			Inst = TxnInst;
@@ -728,127 +1287,439 @@ AieRC _XAie_Txn_Submit(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst)
 		return RC;
 	}
 
-	/* Do not free resources if transaction is exported */
-	if(Inst->Flags & XAIE_TXN_INST_EXPORTED_MASK) {
-		return XAIE_OK;
+	/* Do not free resources if transaction is exported */
+	if(Inst->Flags & XAIE_TXN_INST_EXPORTED_MASK) {
+		return XAIE_OK;
+	}
+
+	RC = _XAie_RemoveTxnInstFromList(DevInst, Inst);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	_XAie_TxnFreePayload(Inst);
+	_XAie_TxnFreeRelocs(Inst);
+	free(Inst->CmdBuf);
+	free(Inst);
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+* This API drops the transaction of the calling thread without executing the
+* commands which are still in its command buffer.
+*
+* @param        DevInst: Device instance pointer
+*
+* @return       XAIE_OK on success and XAIE_ERR on failure
+*
+* @note         Internal only. It releases the internal transactions of the
+*		driver APIs which failed to fill or to submit them.
+*
+******************************************************************************/
+AieRC _XAie_Txn_Discard(XAie_DevInst *DevInst)
+{
+	AieRC RC;
+	XAie_TxnInst *Inst;
+
+	Inst = _XAie_GetTxnInst(DevInst, DevInst->Backend->Ops.GetTid());
+	if(Inst == NULL) {
+		XAIE_ERROR("Failed to get the correct transaction instance\n");
+		return XAIE_ERR;
+	}
+
+	RC = _XAie_RemoveTxnInstFromList(DevInst, Inst);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	_XAie_TxnFreePayload(Inst);
+	_XAie_TxnFreeRelocs(Inst);
+	free(Inst->CmdBuf);
+	free(Inst);
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api copies an existing transaction instance and returns a copy of the
+* instance with all the commands for users to save the commands and use them
+* at a later point.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	Pointer to copy of transaction instance on success and NULL
+*		on error.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+XAie_TxnInst* _XAie_TxnExport(XAie_DevInst *DevInst)
+{
+	XAie_TxnInst *Inst, *TmpInst;
+	const XAie_Backend *Backend = DevInst->Backend;
+	u64 PayloadSize = 0U;
+	u8 *Payload = NULL;
+
+	TmpInst = _XAie_GetTxnInst(DevInst, Backend->Ops.GetTid());
+	if(TmpInst == NULL) {
+		XAIE_ERROR("Failed to get the correct transaction instance "
+				"from internal list\n");
+		return NULL;
+	}
+
+	if(TmpInst->Flags & XAIE_TXN_INST_CHILD_MASK) {
+		XAIE_ERROR("Child transaction must be merged to its parent\n");
+		return NULL;
+	}
+
+	Inst = (XAie_TxnInst *)malloc(sizeof(*Inst));
+	if(Inst == NULL) {
+		XAIE_ERROR("Failed to allocate memory for txn instance\n");
+		return NULL;
+	}
+
+	Inst->CmdBuf = (XAie_TxnCmd *)calloc(TmpInst->NumCmds,
+			sizeof(*Inst->CmdBuf));
+	if(Inst->CmdBuf == NULL) {
+		XAIE_ERROR("Failed to allocate memory for command buffer\n");
+		free(Inst);
+		return NULL;
+	}
+
+	Inst->CmdBuf = (XAie_TxnCmd *)memcpy((void *)Inst->CmdBuf,
+			(void *)TmpInst->CmdBuf,
+			TmpInst->NumCmds * sizeof(*Inst->CmdBuf));
+
+	/* Copy all the block write payloads to one contiguous chunk */
+	Inst->Payload = NULL;
+	for(u32 i = 0U; i < TmpInst->NumCmds; i++) {
+		if(TmpInst->CmdBuf[i].Opcode == XAIE_IO_BLOCKWRITE) {
+			PayloadSize += sizeof(u32) * TmpInst->CmdBuf[i].Size;
+		}
+	}
+
+	if(PayloadSize != 0U) {
+		Payload = (u8 *)_XAie_TxnAllocPayload(Inst, PayloadSize);
+		if(Payload == NULL) {
+			free(Inst->CmdBuf);
+			free(Inst);
+			return NULL;
+		}
+	}
+
+	if(_XAie_TxnCopyRelocs(Inst, TmpInst) != XAIE_OK) {
+		_XAie_TxnFreePayload(Inst);
+		free(Inst->CmdBuf);
+		free(Inst);
+		return NULL;
+	}
+
+	for(u32 i = 0U; i < TmpInst->NumCmds; i++) {
+		XAie_TxnCmd *TmpCmd = &TmpInst->CmdBuf[i];
+		XAie_TxnCmd *Cmd = &Inst->CmdBuf[i];
+		if(TmpCmd->Opcode == XAIE_IO_BLOCKWRITE) {
+			Cmd->DataPtr = (u64)(uintptr_t)memcpy((void *)Payload,
+					(void *)(uintptr_t)TmpCmd->DataPtr,
+					sizeof(u32) * TmpCmd->Size);
+			Payload += sizeof(u32) * TmpCmd->Size;
+		} else if(TmpCmd->Opcode == XAIE_IO_READ) {
+			/* The result slot belongs to the submission of TmpInst */
+			Cmd->DataPtr = 0U;
+		}
+	}
+
+	Inst->Tid = TmpInst->Tid;
+	Inst->Flags = TmpInst->Flags;
+	Inst->Flags |= XAIE_TXN_INSTANCE_EXPORTED;
+	Inst->NumCmds = TmpInst->NumCmds;
+	Inst->MaxCmds = TmpInst->MaxCmds;
+	Inst->Node.Next = NULL;
+
+	return Inst;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api releases the memory resources used by exported transaction instance.
+*
+* @param	TxnInst - Existing Transaction instance
+*
+* @return	XAIE_OK on success or error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_TxnFree(XAie_TxnInst *Inst)
+{
+	if(Inst->Flags & XAIE_TXN_INST_ATTACHED_MASK) {
+		XAIE_ERROR("The child transaction is attached to a thread, "
+				"it's resources cannot be released\n");
+		return XAIE_ERR;
+	}
+
+	if(!(Inst->Flags & (XAIE_TXN_INST_EXPORTED_MASK |
+					XAIE_TXN_INST_CHILD_MASK))) {
+		XAIE_ERROR("The transaction instance was not exported, it's "
+				"resources cannot be released\n");
+		return XAIE_ERR;
+	}
+
+	_XAie_TxnFreePayload(Inst);
+	_XAie_TxnFreeRelocs(Inst);
+	if(Inst->Flags & XAIE_TXN_INST_LOADED_MASK) {
+		_XAie_TxnFreeLoaded(Inst);
+		return XAIE_OK;
+	}
+
+	free(Inst->CmdBuf);
+	free(Inst);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api creates a child transaction of the transaction started by the
+* calling thread. The child records IO operations like its parent once it is
+* attached to a thread, and it is merged back into the parent to be submitted
+* with it.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	Pointer to the child transaction instance on success and NULL
+*		on failure.
+*
+* @note		Internal only. The child inherits the flags of the parent,
+*		except auto flush: a child never accesses the device.
+*
+******************************************************************************/
+XAie_TxnInst* _XAie_TxnFork(XAie_DevInst *DevInst)
+{
+	XAie_TxnInst *Parent, *Child;
+
+	Parent = _XAie_GetTxnInst(DevInst, DevInst->Backend->Ops.GetTid());
+	if(Parent == NULL) {
+		XAIE_ERROR("No transaction is open in this thread\n");
+		return NULL;
+	}
+
+	Child = (XAie_TxnInst *)malloc(sizeof(*Child));
+	if(Child == NULL) {
+		XAIE_ERROR("Failed to allocate memory for txn instance\n");
+		return NULL;
+	}
+
+	Child->CmdBuf = (XAie_TxnCmd *)calloc(XAIE_DEFAULT_NUM_CMDS,
+			sizeof(*Child->CmdBuf));
+	if(Child->CmdBuf == NULL) {
+		XAIE_ERROR("Failed to allocate memory for command buffer\n");
+		free(Child);
+		return NULL;
+	}
+
+	Child->Tid = 0U;
+	Child->Flags = (Parent->Flags & ~(XAIE_TXN_AUTO_FLUSH_MASK |
+				XAIE_TXN_INST_ATTACHED_MASK)) |
+		XAIE_TXN_INSTANCE_CHILD;
+	Child->NumCmds = 0U;
+	Child->MaxCmds = XAIE_DEFAULT_NUM_CMDS;
+	Child->Payload = NULL;
+	Child->Relocs = NULL;
+
+	return Child;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api attaches a child transaction to the calling thread. The IO
+* operations of the thread are recorded to the child until it is detached.
+*
+* @param	DevInst - Device instance pointer.
+* @param	Child - Child transaction instance.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only. The thread must not have a transaction open.
+*
+******************************************************************************/
+AieRC _XAie_TxnAttach(XAie_DevInst *DevInst, XAie_TxnInst *Child)
+{
+	u64 Tid = DevInst->Backend->Ops.GetTid();
+	AieRC RC;
+
+	if(!(Child->Flags & XAIE_TXN_INST_CHILD_MASK) ||
+			(Child->Flags & XAIE_TXN_INST_ATTACHED_MASK)) {
+		XAIE_ERROR("Transaction is not a detached child\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(_XAie_GetTxnInst(DevInst, Tid) != NULL) {
+		XAIE_ERROR("A transaction is already open in this thread\n");
+		return XAIE_ERR;
 	}
 
-	RC = _XAie_RemoveTxnInstFromList(DevInst, Tid);
+	Child->Tid = Tid;
+	RC = _XAie_AppendTxnInstToList(DevInst, Child);
 	if(RC != XAIE_OK) {
 		return RC;
 	}
 
-	free(Inst->CmdBuf);
-	free(Inst);
+	Child->Flags |= XAIE_TXN_INSTANCE_ATTACHED;
+
 	return XAIE_OK;
 }
 
 /*****************************************************************************/
 /**
 *
-* This api copies an existing transaction instance and returns a copy of the
-* instance with all the commands for users to save the commands and use them
-* at a later point.
+* This api detaches a child transaction from the calling thread.
 *
 * @param	DevInst - Device instance pointer.
+* @param	Child - Child transaction instance attached to the thread.
 *
-* @return	Pointer to copy of transaction instance on success and NULL
-*		on error.
+* @return	XAIE_OK on success and error code on failure.
 *
 * @note		Internal only.
 *
 ******************************************************************************/
-XAie_TxnInst* _XAie_TxnExport(XAie_DevInst *DevInst)
+AieRC _XAie_TxnDetach(XAie_DevInst *DevInst, XAie_TxnInst *Child)
 {
-	XAie_TxnInst *Inst, *TmpInst;
-	const XAie_Backend *Backend = DevInst->Backend;
-
-	TmpInst = _XAie_GetTxnInst(DevInst, Backend->Ops.GetTid());
-	if(TmpInst == NULL) {
-		XAIE_ERROR("Failed to get the correct transaction instance "
-				"from internal list\n");
-		return NULL;
-	}
-
-	Inst = (XAie_TxnInst *)malloc(sizeof(*Inst));
-	if(Inst == NULL) {
-		XAIE_ERROR("Failed to allocate memory for txn instance\n");
-		return NULL;
-	}
+	AieRC RC;
 
-	Inst->CmdBuf = (XAie_TxnCmd *)calloc(TmpInst->NumCmds,
-			sizeof(*Inst->CmdBuf));
-	if(Inst->CmdBuf == NULL) {
-		XAIE_ERROR("Failed to allocate memory for command buffer\n");
-		free(Inst);
-		return NULL;
+	if(_XAie_GetTxnInst(DevInst, DevInst->Backend->Ops.GetTid()) !=
+			Child) {
+		XAIE_ERROR("Child transaction is not attached to this "
+				"thread\n");
+		return XAIE_INVALID_ARGS;
 	}
 
-	Inst->CmdBuf = (XAie_TxnCmd *)memcpy((void *)Inst->CmdBuf,
-			(void *)TmpInst->CmdBuf,
-			TmpInst->NumCmds * sizeof(*Inst->CmdBuf));
-
-	for(u32 i = 0U; i < TmpInst->NumCmds; i++) {
-		XAie_TxnCmd *TmpCmd = &TmpInst->CmdBuf[i];
-		XAie_TxnCmd *Cmd = &Inst->CmdBuf[i];
-		if(TmpCmd->Opcode == XAIE_IO_BLOCKWRITE) {
-			Cmd->DataPtr = (u64)(uintptr_t)malloc(
-					sizeof(u32) * TmpCmd->Size);
-			if((void *)(uintptr_t)Cmd->DataPtr == NULL) {
-				XAIE_ERROR("Failed to allocate memory to copy "
-						"command %d\n", i);
-				free(Inst->CmdBuf);
-				free(Inst);
-				return NULL;
-			}
-
-			Cmd->DataPtr = (u64)(uintptr_t)memcpy(
-					(void *)Cmd->DataPtr,
-					(void *)TmpCmd->DataPtr,
-					sizeof(u32) * TmpCmd->Size);
-		}
+	RC = _XAie_RemoveTxnInstFromList(DevInst, Child);
+	if(RC != XAIE_OK) {
+		return RC;
 	}
 
-	Inst->Tid = TmpInst->Tid;
-	Inst->Flags = TmpInst->Flags;
-	Inst->Flags |= XAIE_TXN_INSTANCE_EXPORTED;
-	Inst->NumCmds = TmpInst->NumCmds;
-	Inst->MaxCmds = TmpInst->MaxCmds;
-	Inst->Node.Next = NULL;
+	Child->Flags &= ~XAIE_TXN_INST_ATTACHED_MASK;
 
-	return Inst;
+	return XAIE_OK;
 }
 
 /*****************************************************************************/
 /**
 *
-* This api releases the memory resources used by exported transaction instance.
+* This api appends the commands of detached child transactions to the
+* transaction started by the calling thread, in the order of the array, and
+* releases the children. The block write payloads and the patch points of the
+* children are moved to the parent without copying the payloads.
 *
-* @param	TxnInst - Existing Transaction instance
+* @param	DevInst - Device instance pointer.
+* @param	Children - Array of child transaction instances.
+* @param	NumChildren - Number of children in the array.
 *
-* @return	XAIE_OK on success or error code on failure.
+* @return	XAIE_OK on success and error code on failure.
 *
-* @note		Internal only.
+* @note		Internal only. The buffers of the parent are grown before any
+*		child is moved, so on failure no child is merged.
 *
 ******************************************************************************/
-AieRC _XAie_TxnFree(XAie_TxnInst *Inst)
+AieRC _XAie_TxnMerge(XAie_DevInst *DevInst, XAie_TxnInst **Children,
+		u32 NumChildren)
 {
-	if(!(Inst->Flags & XAIE_TXN_INST_EXPORTED_MASK)) {
-		XAIE_ERROR("The transaction instance was not exported, it's "
-				"resources cannot be released\n");
+	XAie_TxnInst *Parent;
+	u64 NumCmds = 0U, NumRelocs = 0U;
+	AieRC RC;
+
+	Parent = _XAie_GetTxnInst(DevInst, DevInst->Backend->Ops.GetTid());
+	if(Parent == NULL) {
+		XAIE_ERROR("No transaction is open in this thread\n");
 		return XAIE_ERR;
 	}
 
-	for(u32 i = 0; i < Inst->NumCmds; i++) {
-		XAie_TxnCmd *Cmd = &Inst->CmdBuf[i];
-		if((Cmd->Opcode == XAIE_IO_BLOCKWRITE) &&
-				((void *)(uintptr_t)Cmd->DataPtr != NULL)) {
-			free((void *)(uintptr_t)Cmd->DataPtr);
+	for(u32 i = 0U; i < NumChildren; i++) {
+		XAie_TxnInst *Child = Children[i];
+
+		if((Child == NULL) || (Child == Parent) ||
+				!(Child->Flags & XAIE_TXN_INST_CHILD_MASK) ||
+				(Child->Flags & XAIE_TXN_INST_ATTACHED_MASK)) {
+			XAIE_ERROR("Transaction %d is not a detached child\n",
+					i);
+			return XAIE_INVALID_ARGS;
+		}
+
+		for(u32 j = 0U; j < i; j++) {
+			if(Children[j] == Child) {
+				XAIE_ERROR("Transaction %d is merged twice\n",
+						i);
+				return XAIE_INVALID_ARGS;
+			}
+		}
+
+		NumCmds += Child->NumCmds;
+		if(Child->Relocs != NULL) {
+			NumRelocs += Child->Relocs->NumRelocs;
 		}
 	}
 
-	free(Inst->CmdBuf);
-	free(Inst);
+	if(NumCmds + Parent->NumCmds >= XAIE_TXN_MAX_NUM_CMDS) {
+		XAIE_ERROR("Merged transaction is too large\n");
+		return XAIE_ERR;
+	}
+
+	RC = _XAie_ReserveCmdBuf(Parent, (u32)NumCmds);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	if(NumRelocs != 0U) {
+		RC = _XAie_TxnReserveRelocs(Parent, (u32)NumRelocs);
+		if(RC != XAIE_OK) {
+			return RC;
+		}
+	}
+
+	for(u32 i = 0U; i < NumChildren; i++) {
+		XAie_TxnInst *Child = Children[i];
+		XAie_TxnChunk *Tail = Child->Payload;
+		u32 CmdOff = Parent->NumCmds;
+
+		memcpy(&Parent->CmdBuf[CmdOff], Child->CmdBuf,
+				sizeof(*Child->CmdBuf) * Child->NumCmds);
+		Parent->NumCmds += Child->NumCmds;
+
+		/* Keep the current chunk of the parent at the head */
+		if(Tail != NULL) {
+			while(Tail->Next != NULL) {
+				Tail = Tail->Next;
+			}
+
+			if(Parent->Payload == NULL) {
+				Parent->Payload = Child->Payload;
+			} else {
+				Tail->Next = Parent->Payload->Next;
+				Parent->Payload->Next = Child->Payload;
+			}
+			Child->Payload = NULL;
+		}
+
+		for(u32 r = 0U; (Child->Relocs != NULL) &&
+				(r < Child->Relocs->NumRelocs); r++) {
+			XAie_TxnReloc *Reloc = &Child->Relocs->Relocs[r];
+
+			/* Cannot fail, the table has room for all the relocs */
+			_XAie_TxnAddReloc(Parent, Reloc->Name,
+					Reloc->CmdIdx + CmdOff, Reloc->WordIdx,
+					(u8)Reloc->Lsb, Reloc->Mask);
+		}
+
+		_XAie_TxnFreeRelocs(Child);
+		free(Child->CmdBuf);
+		free(Child);
+		Children[i] = NULL;
+	}
 
 	return XAIE_OK;
 }
@@ -867,47 +1738,56 @@ AieRC _XAie_TxnFree(XAie_TxnInst *Inst)
 ******************************************************************************/
 void _XAie_TxnResourceCleanup(XAie_DevInst *DevInst)
 {
-	XAie_List *NodePtr = DevInst->TxnList.Next;
+	XAie_List *NodePtr;
+	XAie_TxnSlot *Slots;
 	XAie_TxnInst *TxnInst;
 
+	/* Apply the queued asynchronous submissions first */
+	_XAie_TxnAsyncCleanup(DevInst);
+
+	NodePtr = DevInst->TxnList.Next;
 	while(NodePtr != NULL) {
 		TxnInst = XAIE_CONTAINER_OF(NodePtr, XAie_TxnInst, Node);
+		NodePtr = NodePtr->Next;
 
-		if (TxnInst == NULL) {
-			continue;
-		}
+		_XAie_TxnFreePayload(TxnInst);
+		_XAie_TxnFreeRelocs(TxnInst);
+		free(TxnInst->CmdBuf);
+		free(TxnInst);
+	}
+	DevInst->TxnList.Next = NULL;
 
-		for(u32 i = 0; i < TxnInst->NumCmds; i++) {
-			XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i];
-			if((Cmd->Opcode == XAIE_IO_BLOCKWRITE) &&
-					((void *)(uintptr_t)Cmd->DataPtr != NULL)) {
-				free((void *)(uintptr_t)Cmd->DataPtr);
-			}
+	Slots = DevInst->TxnSlots;
+	if(Slots == NULL) {
+		DevInst->NumTxns = 0U;
+		return;
+	}
+
+	for(u32 Slot = 0U; Slot < XAIE_TXN_NUM_SLOTS; Slot++) {
+		if(Slots[Slot].State != XAIE_TXN_SLOT_USED) {
+			continue;
 		}
 
-		NodePtr = NodePtr->Next;
+		TxnInst = Slots[Slot].Inst;
+		_XAie_TxnFreePayload(TxnInst);
+		_XAie_TxnFreeRelocs(TxnInst);
 		free(TxnInst->CmdBuf);
 		free(TxnInst);
 	}
+
+	free(Slots);
+	DevInst->TxnSlots = NULL;
+	DevInst->NumTxns = 0U;
 }
 
 AieRC XAie_Write32(XAie_DevInst *DevInst, u64 RegOff, u32 Value)
 {
-	u64 Tid;
 	AieRC RC;
 	XAie_TxnInst *TxnInst;
 	const XAie_Backend *Backend = DevInst->Backend;
 
-	if(DevInst->TxnList.Next != NULL) {
-		Tid = Backend->Ops.GetTid();
-		TxnInst = _XAie_GetTxnInst(DevInst, Tid);
-		if(TxnInst == NULL) {
-			XAIE_DBG("Could not find transaction instance "
-					"associated with thread. Mask writing "
-					"to register\n");
-			return Backend->Ops.Write32((void*)(DevInst->IOInst), RegOff, Value);
-		}
-
+	TxnInst = _XAie_GetCurrentTxnInst(DevInst);
+	if(TxnInst != NULL) {
 		if(TxnInst->NumCmds + 1U == TxnInst->MaxCmds) {
 			RC = _XAie_ReallocCmdBuf(TxnInst);
 			if (RC != XAIE_OK) {
@@ -923,26 +1803,24 @@ AieRC XAie_Write32(XAie_DevInst *DevInst, u64 RegOff, u32 Value)
 
 		return XAIE_OK;
 	}
+
+	if(DevInst->MemShadow != NULL) {
+		_XAie_MemShadowInvalidate(DevInst, RegOff, sizeof(u32));
+	}
+	if(DevInst->Shadow != NULL) {
+		return _XAie_ShadowWrite32(DevInst, RegOff, Value);
+	}
 	return Backend->Ops.Write32((void*)(DevInst->IOInst), RegOff, Value);
 }
 
 AieRC XAie_Read32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data)
 {
-	u64 Tid;
 	AieRC RC;
 	XAie_TxnInst *TxnInst;
 	const XAie_Backend *Backend = DevInst->Backend;
 
-	if(DevInst->TxnList.Next != NULL) {
-		Tid = Backend->Ops.GetTid();
-		TxnInst = _XAie_GetTxnInst(DevInst, Tid);
-		if(TxnInst == NULL) {
-			XAIE_DBG("Could not find transaction instance "
-					"associated with thread. Reading "
-					"from register\n");
-			return Backend->Ops.Read32((void*)(DevInst->IOInst), RegOff, Data);
-		}
-
+	TxnInst = _XAie_GetCurrentTxnInst(DevInst);
+	if(TxnInst != NULL) {
 		if((TxnInst->Flags & XAIE_TXN_AUTO_FLUSH_MASK) &&
 				(TxnInst->NumCmds > 0)) {
 			/* Flush command buffer */
@@ -954,9 +1832,10 @@ AieRC XAie_Read32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data)
 				return RC;
 			}
 
-			TxnInst->NumCmds = 0;
+			_XAie_TxnResetCmdBuf(TxnInst);
 			return Backend->Ops.Read32((void*)(DevInst->IOInst), RegOff, Data);
-		} else if(TxnInst->NumCmds == 0) {
+		} else if((TxnInst->NumCmds == 0) &&
+				!(TxnInst->Flags & XAIE_TXN_INST_CHILD_MASK)) {
 			return Backend->Ops.Read32((void*)(DevInst->IOInst), RegOff, Data);
 		} else {
 			XAIE_ERROR("Read operation is not supported "
@@ -967,24 +1846,96 @@ AieRC XAie_Read32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data)
 	return Backend->Ops.Read32((void*)(DevInst->IOInst), RegOff, Data);
 }
 
-AieRC XAie_MaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask, u32 Value)
+/*****************************************************************************/
+/**
+* This API reads a register. If the calling thread records a transaction with
+* auto flush disabled and commands are pending, the read is recorded in the
+* transaction instead, and the value is stored to Data when the transaction is
+* submitted. Otherwise the register is read right away, like XAie_Read32().
+*
+* @param        DevInst: Device instance pointer
+* @param        RegOff: Register offset to read.
+* @param        Data: Pointer to store the value read.
+*
+* @return       XAIE_OK on success and error code on failure
+*
+* @note         Data must stay valid until the transaction is submitted, and
+*		must not be used before. The reads of an exported copy of the
+*		transaction are executed but their values are discarded.
+*
+******************************************************************************/
+AieRC XAie_DeferredRead32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data)
+{
+	AieRC RC;
+	XAie_TxnInst *TxnInst;
+
+	if((DevInst == XAIE_NULL) || (Data == NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	TxnInst = _XAie_GetCurrentTxnInst(DevInst);
+	if((TxnInst == NULL) || (TxnInst->Flags & XAIE_TXN_AUTO_FLUSH_MASK) ||
+			((TxnInst->NumCmds == 0U) &&
+			 !(TxnInst->Flags & XAIE_TXN_INST_CHILD_MASK))) {
+		return XAie_Read32(DevInst, RegOff, Data);
+	}
+
+	if(TxnInst->NumCmds + 1U == TxnInst->MaxCmds) {
+		RC = _XAie_ReallocCmdBuf(TxnInst);
+		if (RC != XAIE_OK) {
+			return RC;
+		}
+	}
+
+	TxnInst->CmdBuf[TxnInst->NumCmds].Opcode = XAIE_IO_READ;
+	TxnInst->CmdBuf[TxnInst->NumCmds].RegOff = RegOff;
+	TxnInst->CmdBuf[TxnInst->NumCmds].DataPtr = (u64)(uintptr_t)Data;
+	TxnInst->CmdBuf[TxnInst->NumCmds].Mask = 0U;
+	TxnInst->CmdBuf[TxnInst->NumCmds].Value = 0U;
+	TxnInst->CmdBuf[TxnInst->NumCmds].Size = 0U;
+	TxnInst->NumCmds++;
+
+	return XAIE_OK;
+}
+
+AieRC XAie_BlockRead32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data, u32 Size)
 {
 	AieRC RC;
-	u64 Tid;
 	XAie_TxnInst *TxnInst;
 	const XAie_Backend *Backend = DevInst->Backend;
 
-	if(DevInst->TxnList.Next != NULL) {
-		Tid = Backend->Ops.GetTid();
-		TxnInst = _XAie_GetTxnInst(DevInst, Tid);
-		if(TxnInst == NULL) {
-			XAIE_DBG("Could not find transaction instance "
-					"associated with thread. Writing "
-					"to register\n");
-			return Backend->Ops.MaskWrite32((void *)(DevInst->IOInst), RegOff, Mask,
-					Value);
+	for(u32 i = 0U; i < Size; i++) {
+		/*
+		 * Once nothing is pending in the transaction, the rest of the
+		 * block is read in one operation. Until then, words are read
+		 * with XAie_Read32() which flushes or fails as configured.
+		 */
+		TxnInst = _XAie_GetCurrentTxnInst(DevInst);
+		if((TxnInst == NULL) || ((TxnInst->NumCmds == 0U) &&
+				!(TxnInst->Flags & XAIE_TXN_INST_CHILD_MASK))) {
+			return Backend->Ops.BlockRead32(
+					(void *)(DevInst->IOInst),
+					RegOff + i * 4U, &Data[i], Size - i);
 		}
 
+		RC = XAie_Read32(DevInst, RegOff + i * 4U, &Data[i]);
+		if(RC != XAIE_OK) {
+			return RC;
+		}
+	}
+
+	return XAIE_OK;
+}
+
+AieRC XAie_MaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask, u32 Value)
+{
+	AieRC RC;
+	XAie_TxnInst *TxnInst;
+	const XAie_Backend *Backend = DevInst->Backend;
+
+	TxnInst = _XAie_GetCurrentTxnInst(DevInst);
+	if(TxnInst != NULL) {
 		if(TxnInst->NumCmds + 1U == TxnInst->MaxCmds) {
 			RC = _XAie_ReallocCmdBuf(TxnInst);
 			if (RC != XAIE_OK) {
@@ -1000,29 +1951,27 @@ AieRC XAie_MaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask, u32 Value)
 
 		return XAIE_OK;
 	}
+
+	if(DevInst->MemShadow != NULL) {
+		_XAie_MemShadowInvalidate(DevInst, RegOff, sizeof(u32));
+	}
+	if(DevInst->Shadow != NULL) {
+		return _XAie_ShadowMaskWrite32(DevInst, RegOff, Mask, Value);
+	}
 	return Backend->Ops.MaskWrite32((void *)(DevInst->IOInst), RegOff, Mask,
 			Value);
 }
 
-AieRC XAie_MaskPoll(XAie_DevInst *DevInst, u64 RegOff, u32 Mask, u32 Value,
-		u32 TimeOutUs)
+AieRC _XAie_MaskPollSite(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 TimeOutUs, XAie_PollSite Site)
 {
 	AieRC RC;
-	u64 Tid;
 	XAie_TxnInst *TxnInst;
 	const XAie_Backend *Backend = DevInst->Backend;
+	const XAie_PollPolicy *Policy = &DevInst->PollPolicy[Site];
 
-	if(DevInst->TxnList.Next != NULL) {
-		Tid = Backend->Ops.GetTid();
-		TxnInst = _XAie_GetTxnInst(DevInst, Tid);
-		if(TxnInst == NULL) {
-			XAIE_DBG("Could not find transaction instance "
-					"associated with thread. Polling "
-					"from register\n");
-			return Backend->Ops.MaskPoll((void*)(DevInst->IOInst), RegOff, Mask,
-					Value, TimeOutUs);
-		}
-
+	TxnInst = _XAie_GetCurrentTxnInst(DevInst);
+	if(TxnInst != NULL) {
 		if((TxnInst->Flags & XAIE_TXN_AUTO_FLUSH_MASK) &&
 				(TxnInst->NumCmds > 0)) {
 			/* Flush command buffer */
@@ -1034,41 +1983,53 @@ AieRC XAie_MaskPoll(XAie_DevInst *DevInst, u64 RegOff, u32 Mask, u32 Value,
 				return RC;
 			}
 
-			TxnInst->NumCmds = 0;
+			_XAie_TxnResetCmdBuf(TxnInst);
 			return Backend->Ops.MaskPoll((void*)(DevInst->IOInst), RegOff, Mask,
-					Value, TimeOutUs);
-		} else if(TxnInst->NumCmds == 0) {
+					Value, TimeOutUs, Policy);
+		} else if(TxnInst->Flags & XAIE_TXN_AUTO_FLUSH_MASK) {
 			return Backend->Ops.MaskPoll((void*)(DevInst->IOInst), RegOff, Mask,
-					Value, TimeOutUs);
-		} else {
-			XAIE_ERROR("MaskPoll operation is not supported "
-					"when auto flush is disabled\n");
-			return XAIE_ERR;
+					Value, TimeOutUs, Policy);
+		}
+
+		/* The poll is executed in order when the txn is submitted */
+		if(TxnInst->NumCmds + 1U == TxnInst->MaxCmds) {
+			RC = _XAie_ReallocCmdBuf(TxnInst);
+			if (RC != XAIE_OK) {
+				return RC;
+			}
 		}
+
+		TxnInst->CmdBuf[TxnInst->NumCmds].Opcode = XAIE_IO_MASKPOLL;
+		TxnInst->CmdBuf[TxnInst->NumCmds].RegOff = RegOff;
+		TxnInst->CmdBuf[TxnInst->NumCmds].Mask = Mask;
+		TxnInst->CmdBuf[TxnInst->NumCmds].Value = Value;
+		TxnInst->CmdBuf[TxnInst->NumCmds].Size = TimeOutUs;
+		TxnInst->CmdBuf[TxnInst->NumCmds].DataPtr = (u64)Site;
+		TxnInst->NumCmds++;
+
+		return XAIE_OK;
 	}
 	return Backend->Ops.MaskPoll((void*)(DevInst->IOInst), RegOff, Mask,
-			Value, TimeOutUs);
+			Value, TimeOutUs, Policy);
 }
 
-AieRC XAie_BlockWrite32(XAie_DevInst *DevInst, u64 RegOff, const u32 *Data, u32 Size)
+AieRC XAie_MaskPoll(XAie_DevInst *DevInst, u64 RegOff, u32 Mask, u32 Value,
+		u32 TimeOutUs)
+{
+	return _XAie_MaskPollSite(DevInst, RegOff, Mask, Value, TimeOutUs,
+			XAIE_POLL_DEFAULT);
+}
+
+static AieRC _XAie_BlockWrite32(XAie_DevInst *DevInst, u64 RegOff,
+		const u32 *Data, u32 Size)
 {
 	AieRC RC;
-	u64 Tid;
 	u32 *Buf;
 	XAie_TxnInst *TxnInst;
 	const XAie_Backend *Backend = DevInst->Backend;
 
-	if(DevInst->TxnList.Next != NULL) {
-		Tid = Backend->Ops.GetTid();
-		TxnInst = _XAie_GetTxnInst(DevInst, Tid);
-		if(TxnInst == NULL) {
-			XAIE_DBG("Could not find transaction instance "
-					"associated with thread. Block write "
-					"to register\n");
-			return Backend->Ops.BlockWrite32((void *)(DevInst->IOInst), RegOff,
-					Data, Size);
-		}
-
+	TxnInst = _XAie_GetCurrentTxnInst(DevInst);
+	if(TxnInst != NULL) {
 		if(TxnInst->Flags & XAIE_TXN_AUTO_FLUSH_MASK) {
 			/* Flush command buffer */
 			XAIE_DBG("Auto flushing contents of the transaction "
@@ -1081,7 +2042,7 @@ AieRC XAie_BlockWrite32(XAie_DevInst *DevInst, u64 RegOff, const u32 *Data, u32
 				}
 			}
 
-			TxnInst->NumCmds = 0;
+			_XAie_TxnResetCmdBuf(TxnInst);
 			return Backend->Ops.BlockWrite32((void *)(DevInst->IOInst), RegOff,
 					Data, Size);
 		}
@@ -1093,7 +2054,7 @@ AieRC XAie_BlockWrite32(XAie_DevInst *DevInst, u64 RegOff, const u32 *Data, u32
 			}
 		}
 
-		Buf = (u32 *)malloc(sizeof(u32) * Size);
+		Buf = (u32 *)_XAie_TxnAllocPayload(TxnInst, sizeof(u32) * Size);
 		if(Buf == NULL) {
 			XAIE_ERROR("Memory allocation for block write failed\n");
 			return XAIE_ERR;
@@ -1113,24 +2074,36 @@ AieRC XAie_BlockWrite32(XAie_DevInst *DevInst, u64 RegOff, const u32 *Data, u32
 			Data, Size);
 }
 
-AieRC XAie_BlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data, u32 Size)
+AieRC XAie_BlockWrite32(XAie_DevInst *DevInst, u64 RegOff, const u32 *Data, u32 Size)
 {
 	AieRC RC;
-	u64 Tid;
-	XAie_TxnInst *TxnInst;
-	const XAie_Backend *Backend = DevInst->Backend;
 
-	if(DevInst->TxnList.Next != NULL) {
-		Tid = Backend->Ops.GetTid();
-		TxnInst = _XAie_GetTxnInst(DevInst, Tid);
-		if(TxnInst == NULL) {
-			XAIE_DBG("Could not find transaction instance "
-					"associated with thread. Block set "
-					"to register\n");
-			return Backend->Ops.BlockSet32((void *)(DevInst->IOInst), RegOff, Data,
-					Size);
+	if((DevInst->MemShadow != NULL) &&
+			(_XAie_GetCurrentTxnInst(DevInst) == NULL)) {
+		RC = _XAie_MemShadowBlockWrite32(DevInst, RegOff, Data, Size);
+	} else {
+		RC = _XAie_BlockWrite32(DevInst, RegOff, Data, Size);
+		if(DevInst->MemShadow != NULL) {
+			_XAie_MemShadowInvalidate(DevInst, RegOff,
+					(u64)Size * sizeof(u32));
 		}
+	}
+	if(DevInst->Shadow != NULL) {
+		_XAie_ShadowInvalidate(DevInst, RegOff, (u64)Size * sizeof(u32));
+	}
+
+	return RC;
+}
+
+static AieRC _XAie_BlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	AieRC RC;
+	XAie_TxnInst *TxnInst;
+	const XAie_Backend *Backend = DevInst->Backend;
 
+	TxnInst = _XAie_GetCurrentTxnInst(DevInst);
+	if(TxnInst != NULL) {
 		if(TxnInst->Flags & XAIE_TXN_AUTO_FLUSH_MASK) {
 			/* Flush command buffer */
 			XAIE_DBG("Auto flushing contents of the transaction "
@@ -1143,7 +2116,7 @@ AieRC XAie_BlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data, u32 Size)
 				}
 			}
 
-			TxnInst->NumCmds = 0;
+			_XAie_TxnResetCmdBuf(TxnInst);
 			return Backend->Ops.BlockSet32((void *)(DevInst->IOInst), RegOff, Data,
 					Size);
 		}
@@ -1168,25 +2141,36 @@ AieRC XAie_BlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data, u32 Size)
 			Size);
 }
 
+AieRC XAie_BlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data, u32 Size)
+{
+	AieRC RC;
+
+	if((DevInst->MemShadow != NULL) &&
+			(_XAie_GetCurrentTxnInst(DevInst) == NULL)) {
+		RC = _XAie_MemShadowBlockSet32(DevInst, RegOff, Data, Size);
+	} else {
+		RC = _XAie_BlockSet32(DevInst, RegOff, Data, Size);
+		if(DevInst->MemShadow != NULL) {
+			_XAie_MemShadowInvalidate(DevInst, RegOff,
+					(u64)Size * sizeof(u32));
+		}
+	}
+	if(DevInst->Shadow != NULL) {
+		_XAie_ShadowInvalidate(DevInst, RegOff, (u64)Size * sizeof(u32));
+	}
+
+	return RC;
+}
+
 AieRC XAie_CmdWrite(XAie_DevInst *DevInst, u8 Col, u8 Row, u8 Command,
 		u32 CmdWd0, u32 CmdWd1, const char *CmdStr)
 {
 	AieRC RC;
-	u64 Tid;
 	XAie_TxnInst *TxnInst;
 	const XAie_Backend *Backend = DevInst->Backend;
 
-	if(DevInst->TxnList.Next != NULL) {
-		Tid = Backend->Ops.GetTid();
-		TxnInst = _XAie_GetTxnInst(DevInst, Tid);
-		if(TxnInst == NULL) {
-			XAIE_DBG("Could not find transaction instance "
-					"associated with thread. Writing cmd "
-					"to register\n");
-			return Backend->Ops.CmdWrite((void *)(DevInst->IOInst), Col, Row,
-					Command, CmdWd0, CmdWd1, CmdStr);
-		}
-
+	TxnInst = _XAie_GetCurrentTxnInst(DevInst);
+	if(TxnInst != NULL) {
 		if((TxnInst->Flags & XAIE_TXN_AUTO_FLUSH_MASK) &&
 				(TxnInst->NumCmds > 0)) {
 			/* Flush command buffer */
@@ -1198,10 +2182,11 @@ AieRC XAie_CmdWrite(XAie_DevInst *DevInst, u8 Col, u8 Row, u8 Command,
 				return RC;
 			}
 
-			TxnInst->NumCmds = 0;
+			_XAie_TxnResetCmdBuf(TxnInst);
 			return Backend->Ops.CmdWrite((void *)(DevInst->IOInst), Col, Row,
 					Command, CmdWd0, CmdWd1, CmdStr);
-		} else if(TxnInst->NumCmds == 0U) {
+		} else if((TxnInst->NumCmds == 0U) &&
+				!(TxnInst->Flags & XAIE_TXN_INST_CHILD_MASK)) {
 			return Backend->Ops.CmdWrite((void *)(DevInst->IOInst), Col, Row,
 					Command, CmdWd0, CmdWd1, CmdStr);
 		} else {
@@ -1214,22 +2199,15 @@ AieRC XAie_CmdWrite(XAie_DevInst *DevInst, u8 Col, u8 Row, u8 Command,
 			Command, CmdWd0, CmdWd1, CmdStr);
 }
 
-AieRC XAie_RunOp(XAie_DevInst *DevInst, XAie_BackendOpCode Op, void *Arg)
+static AieRC _XAie_RunOp(XAie_DevInst *DevInst, XAie_BackendOpCode Op,
+		void *Arg)
 {
 	AieRC RC;
-	u64 Tid;
 	XAie_TxnInst *TxnInst;
 	const XAie_Backend *Backend = DevInst->Backend;
 
-	if(DevInst->TxnList.Next != NULL) {
-		Tid = Backend->Ops.GetTid();
-		TxnInst = _XAie_GetTxnInst(DevInst, Tid);
-		if(TxnInst == NULL) {
-			XAIE_DBG("Could not find transaction instance "
-					"associated with thread. Running Op.\n");
-			return Backend->Ops.RunOp(DevInst->IOInst, DevInst, Op, Arg);
-		}
-
+	TxnInst = _XAie_GetCurrentTxnInst(DevInst);
+	if(TxnInst != NULL) {
 		if((TxnInst->Flags & XAIE_TXN_AUTO_FLUSH_MASK) &&
 				(TxnInst->NumCmds > 0)) {
 			/* Flush command buffer */
@@ -1239,9 +2217,10 @@ AieRC XAie_RunOp(XAie_DevInst *DevInst, XAie_BackendOpCode Op, void *Arg)
 				return RC;
 			}
 
-			TxnInst->NumCmds = 0;
+			_XAie_TxnResetCmdBuf(TxnInst);
 			return Backend->Ops.RunOp(DevInst->IOInst, DevInst, Op, Arg);
-		} else if(TxnInst->NumCmds == 0) {
+		} else if((TxnInst->NumCmds == 0) &&
+				!(TxnInst->Flags & XAIE_TXN_INST_CHILD_MASK)) {
 			return Backend->Ops.RunOp(DevInst->IOInst, DevInst, Op, Arg);
 		} else if((Op == XAIE_BACKEND_OP_CONFIG_SHIMDMABD) &&
 				(Backend->Type != XAIE_IO_BACKEND_LINUX)) {
@@ -1269,4 +2248,65 @@ AieRC XAie_RunOp(XAie_DevInst *DevInst, XAie_BackendOpCode Op, void *Arg)
 	return Backend->Ops.RunOp(DevInst->IOInst, DevInst, Op, Arg);
 }
 
+AieRC XAie_RunOp(XAie_DevInst *DevInst, XAie_BackendOpCode Op, void *Arg)
+{
+	AieRC RC;
+	u8 ResetsMems = XAIE_DISABLE;
+
+	switch(Op) {
+	case XAIE_BACKEND_OP_NPIWR32:
+	case XAIE_BACKEND_OP_RST_PART:
+	case XAIE_BACKEND_OP_REQUEST_TILES:
+	case XAIE_BACKEND_OP_RELEASE_TILES:
+	case XAIE_BACKEND_OP_PARTITION_INITIALIZE:
+	case XAIE_BACKEND_OP_PARTITION_TEARDOWN:
+		ResetsMems = XAIE_ENABLE;
+		break;
+	default:
+		break;
+	}
+
+	/*
+	 * The memories may be reset or zeroized. Forget them before, so that
+	 * the zeroization writes are not skipped, and after.
+	 */
+	if((DevInst->MemShadow != NULL) && (ResetsMems == XAIE_ENABLE)) {
+		_XAie_MemShadowInvalidateAll(DevInst);
+	}
+
+	RC = _XAie_RunOp(DevInst, Op, Arg);
+	if((DevInst->MemShadow != NULL) && (ResetsMems == XAIE_ENABLE)) {
+		_XAie_MemShadowInvalidateAll(DevInst);
+	}
+
+	if(DevInst->Shadow == NULL) {
+		return RC;
+	}
+
+	/* Drop the registers the operation may have changed from the shadow */
+	switch(Op) {
+	case XAIE_BACKEND_OP_CONFIG_SHIMDMABD:
+	{
+		XAie_ShimDmaBdArgs *BdArgs = (XAie_ShimDmaBdArgs *)Arg;
+
+		_XAie_ShadowInvalidate(DevInst, BdArgs->Addr,
+				(u64)BdArgs->NumBdWords * sizeof(u32));
+		break;
+	}
+	case XAIE_BACKEND_OP_NPIWR32:
+	case XAIE_BACKEND_OP_RST_PART:
+	case XAIE_BACKEND_OP_ASSERT_SHIMRST:
+	case XAIE_BACKEND_OP_REQUEST_TILES:
+	case XAIE_BACKEND_OP_RELEASE_TILES:
+	case XAIE_BACKEND_OP_PARTITION_INITIALIZE:
+	case XAIE_BACKEND_OP_PARTITION_TEARDOWN:
+		_XAie_ShadowInvalidateAll(DevInst);
+		break;
+	default:
+		break;
+	}
+
+	return RC;
+}
+
 /** @} */
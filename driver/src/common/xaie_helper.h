@@ -80,6 +80,19 @@
 	    (Index) < (Len);						      \
 	    (Value) &= (Value) - 1, (Index) = first_set_bit((Value)) - 1)
 
+/* Internal flags of the transaction instance */
+#define XAIE_TXN_INSTANCE_EXPORTED	0b10U
+#define XAIE_TXN_INST_EXPORTED_MASK XAIE_TXN_INSTANCE_EXPORTED
+#define XAIE_TXN_INSTANCE_LOADED	0b1000U
+#define XAIE_TXN_INST_LOADED_MASK XAIE_TXN_INSTANCE_LOADED
+#define XAIE_TXN_INSTANCE_CHILD		0b100000U
+#define XAIE_TXN_INST_CHILD_MASK XAIE_TXN_INSTANCE_CHILD
+#define XAIE_TXN_INSTANCE_ATTACHED	0b1000000U
+#define XAIE_TXN_INST_ATTACHED_MASK XAIE_TXN_INSTANCE_ATTACHED
+
+/* Maximum length of a transaction patch point name, including the NUL */
+#define XAIE_TXN_RELOC_NAME_LEN		32U
+
 /* Generate value with a set bit at given Index */
 #define BIT(Index)		(1 << (Index))
 
@@ -88,6 +101,9 @@ typedef enum {
 	XAIE_IO_WRITE,
 	XAIE_IO_BLOCKWRITE,
 	XAIE_IO_BLOCKSET,
+	XAIE_IO_MASKPOLL,	/* Size holds the timeout in microseconds and
+				 * DataPtr the XAie_PollSite */
+	XAIE_IO_READ,		/* DataPtr points to the result slot, or 0 */
 } XAie_TxnOpcode;
 
 struct XAie_TxnCmd {
@@ -99,6 +115,48 @@ struct XAie_TxnCmd {
 	u32 Size;
 };
 
+/*
+ * Chunk of the payload arena of a transaction instance. Block write payloads
+ * are bump allocated from the newest chunk, which is at the head of the list.
+ */
+struct XAie_TxnChunk {
+	struct XAie_TxnChunk *Next;
+	u64 Size;
+	u64 Used;
+	u64 Data[];
+};
+
+/*
+ * Patch point of a transaction. It is a bit field of the word written by a
+ * register write command, or of a word of the payload of a block write command.
+ * The layout is part of the serialized transaction format.
+ */
+typedef struct {
+	char Name[XAIE_TXN_RELOC_NAME_LEN];
+	u32 CmdIdx;
+	u32 WordIdx;
+	u32 Mask;
+	u32 Lsb;
+} XAie_TxnReloc;
+
+/* Table of the patch points of a transaction instance */
+struct XAie_TxnRelocTbl {
+	u32 NumRelocs;
+	u32 MaxRelocs;
+	XAie_TxnReloc Relocs[];
+};
+
+/*
+ * Slot of the per device transaction table. Slots are hashed by thread id and
+ * are claimed and released with atomic operations so that the lookup done on
+ * every register access does not need a lock.
+ */
+struct XAie_TxnSlot {
+	u32 State;
+	u64 Tid;
+	XAie_TxnInst *Inst;
+};
+
 /************************** Function Definitions *****************************/
 /*****************************************************************************/
 /**
@@ -162,20 +220,88 @@ void _XAie_SetBitInBitmap(u32 *Bitmap, u32 StartSetBit, u32 NumSetBit);
 void _XAie_ClrBitInBitmap(u32 *Bitmap, u32 StartSetBit, u32 NumSetBit);
 AieRC XAie_Write32(XAie_DevInst *DevInst, u64 RegOff, u32 Value);
 AieRC XAie_Read32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data);
+AieRC XAie_DeferredRead32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data);
+AieRC XAie_BlockRead32(XAie_DevInst *DevInst, u64 RegOff, u32 *Data, u32 Size);
 AieRC XAie_MaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask, u32 Value);
 AieRC XAie_MaskPoll(XAie_DevInst *DevInst, u64 RegOff, u32 Mask, u32 Value,
 		u32 TimeOutUs);
+AieRC _XAie_MaskPollSite(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 TimeOutUs, XAie_PollSite Site);
 AieRC XAie_BlockWrite32(XAie_DevInst *DevInst, u64 RegOff, const u32 *Data,
 			u32 Size);
 AieRC XAie_BlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data, u32 Size);
 AieRC XAie_CmdWrite(XAie_DevInst *DevInst, u8 Col, u8 Row, u8 Command,
 		u32 CmdWd0, u32 CmdWd1, const char *CmdStr);
 AieRC XAie_RunOp(XAie_DevInst *DevInst, XAie_BackendOpCode Op, void *Arg);
-AieRC _XAie_Txn_Start(XAie_DevInst *DevInst, u32 Flags);
+AieRC _XAie_Txn_Start(XAie_DevInst *DevInst, u32 Flags, u32 NumCmds,
+		u64 PayloadSize);
+void *_XAie_TxnAllocPayload(XAie_TxnInst *TxnInst, u64 Size);
+void _XAie_TxnFreePayload(XAie_TxnInst *TxnInst);
+void _XAie_TxnOptimize(XAie_TxnInst *TxnInst);
+XAie_TxnInst *_XAie_GetTxnInst(XAie_DevInst *DevInst, u64 Tid);
+AieRC _XAie_RemoveTxnInstFromList(XAie_DevInst *DevInst, XAie_TxnInst *Inst);
+AieRC _XAie_TxnReserveRelocs(XAie_TxnInst *TxnInst, u32 NumRelocs);
+AieRC _XAie_TxnAddReloc(XAie_TxnInst *TxnInst, const char *Name, u32 CmdIdx,
+		u32 WordIdx, u8 Lsb, u32 Mask);
+AieRC _XAie_TxnAddPatchPoint(XAie_DevInst *DevInst, const char *Name,
+		u64 RegOff, u8 Lsb, u32 Mask);
+AieRC _XAie_TxnPatch(XAie_TxnInst *TxnInst, const char *Name, u32 Value);
+AieRC _XAie_TxnCopyRelocs(XAie_TxnInst *Dst, const XAie_TxnInst *Src);
+void _XAie_TxnFreeRelocs(XAie_TxnInst *TxnInst);
+XAie_TxnFence *_XAie_TxnSubmitAsync(XAie_DevInst *DevInst,
+		XAie_TxnInst *TxnInst);
+AieRC _XAie_TxnFenceWait(XAie_TxnFence *Fence);
+u8 _XAie_TxnFencePoll(XAie_TxnFence *Fence, AieRC *Status);
+AieRC _XAie_TxnFenceSetCallback(XAie_TxnFence *Fence, XAie_TxnFenceCb Cb,
+		void *Arg);
+void _XAie_TxnFenceFree(XAie_TxnFence *Fence);
+void _XAie_TxnAsyncCleanup(XAie_DevInst *DevInst);
+u8 _XAie_TxnAsyncIsIdle(XAie_DevInst *DevInst);
 AieRC _XAie_Txn_Submit(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst);
+AieRC _XAie_Txn_Discard(XAie_DevInst *DevInst);
 XAie_TxnInst* _XAie_TxnExport(XAie_DevInst *DevInst);
 AieRC _XAie_TxnFree(XAie_TxnInst *Inst);
+XAie_TxnInst* _XAie_TxnFork(XAie_DevInst *DevInst);
+AieRC _XAie_TxnAttach(XAie_DevInst *DevInst, XAie_TxnInst *Child);
+AieRC _XAie_TxnDetach(XAie_DevInst *DevInst, XAie_TxnInst *Child);
+AieRC _XAie_TxnMerge(XAie_DevInst *DevInst, XAie_TxnInst **Children,
+		u32 NumChildren);
 void _XAie_TxnResourceCleanup(XAie_DevInst *DevInst);
+AieRC _XAie_TxnSerialize(XAie_TxnInst *TxnInst, void *Buf, u64 *Size);
+XAie_TxnInst* _XAie_TxnDeserialize(const void *Buf, u64 Size);
+void _XAie_TxnFreeLoaded(XAie_TxnInst *TxnInst);
+AieRC _XAie_TxnSave(XAie_TxnInst *TxnInst, const char *FileName);
+XAie_TxnInst* _XAie_TxnLoad(const char *FileName);
+AieRC _XAie_ShadowEnable(XAie_DevInst *DevInst);
+void _XAie_ShadowDisable(XAie_DevInst *DevInst);
+AieRC _XAie_ShadowWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Value);
+AieRC _XAie_ShadowMaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value);
+void _XAie_ShadowInvalidate(XAie_DevInst *DevInst, u64 RegOff, u64 Size);
+void _XAie_ShadowInvalidateAll(XAie_DevInst *DevInst);
+void _XAie_ShadowInvalidateTxn(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst);
+AieRC _XAie_MemShadowEnable(XAie_DevInst *DevInst);
+void _XAie_MemShadowDisable(XAie_DevInst *DevInst);
+AieRC _XAie_MemShadowBlockWrite32(XAie_DevInst *DevInst, u64 RegOff,
+		const u32 *Data, u32 Size);
+AieRC _XAie_MemShadowBlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
+		u32 Size);
+void _XAie_MemShadowInvalidate(XAie_DevInst *DevInst, u64 RegOff, u64 Size);
+void _XAie_MemShadowInvalidateDataMem(XAie_DevInst *DevInst, XAie_LocType Loc);
+void _XAie_MemShadowInvalidateReach(XAie_DevInst *DevInst, XAie_LocType Loc);
+void _XAie_MemShadowInvalidateAll(XAie_DevInst *DevInst);
+void _XAie_MemShadowInvalidateTxn(XAie_DevInst *DevInst,
+		XAie_TxnInst *TxnInst);
+AieRC _XAie_RecordStart(XAie_DevInst *DevInst, const char *FileName);
+AieRC _XAie_RecordStop(XAie_DevInst *DevInst);
+AieRC _XAie_Replay(XAie_DevInst *DevInst, const char *FileName,
+		XAie_ReplayMode Mode);
+AieRC _XAie_IOStatsStart(XAie_DevInst *DevInst);
+AieRC _XAie_IOStatsStop(XAie_DevInst *DevInst);
+AieRC _XAie_IOStatsGet(XAie_DevInst *DevInst, XAie_IOStats *Stats);
+AieRC _XAie_IOStatsDump(XAie_DevInst *DevInst, const char *FileName);
+AieRC _XAie_FaultStart(XAie_DevInst *DevInst, const XAie_FaultCfg *Cfg);
+AieRC _XAie_FaultStop(XAie_DevInst *DevInst);
 u32 _XAie_GetNumRows(XAie_DevInst *DevInst, u8 TileType);
 u32 _XAie_GetStartRow(XAie_DevInst *DevInst, u8 TileType);
 
@@ -0,0 +1,717 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_memshadow.c
+* @{
+*
+* This file contains routines for the memory shadow of the device instance.
+* The memory shadow keeps a hash of the content last written to each page of
+* the program and data memories of the partition. Block writes and block sets
+* skip the pages whose content is unchanged, so reloading a tile with mostly
+* the same program and data only transfers the pages which differ.
+*
+* A page is known only after it has been written as a whole by a block write
+* or block set. Any other write to a page, and any backend operation which
+* may reset the memories, forgets the page. Writes from the cores and the DMAs
+* are not seen by the driver. The data memories a core or a S2MM DMA channel
+* can write are forgotten when it is enabled or disabled, so data loaded
+* before or after it ran is never skipped against stale hashes.
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+#include "xaie_helper.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_MEMSHADOW_PAGE_SHIFT	8U
+#define XAIE_MEMSHADOW_PAGE_SIZE	(1U << XAIE_MEMSHADOW_PAGE_SHIFT)
+#define XAIE_MEMSHADOW_PAGE_WORDS	(XAIE_MEMSHADOW_PAGE_SIZE / sizeof(u32))
+#define XAIE_MEMSHADOW_MAX_RANGES	2U
+#define XAIE_MEMSHADOW_UNKNOWN		0U
+
+/**************************** Type Definitions *******************************/
+/* Memory within a tile, its pages follow the pages of the previous memory */
+typedef struct {
+	u32 Start;
+	u32 End;
+	u32 FirstPage;
+} XAie_MemShadowRange;
+
+struct XAie_MemShadow {
+#ifdef __linux__
+	pthread_mutex_t Lock;	/* Held across the backend writes */
+#else
+	u8 Lock;
+#endif
+	u8 NumRanges[XAIEGBL_TILE_TYPE_MAX];
+	XAie_MemShadowRange Ranges[XAIEGBL_TILE_TYPE_MAX][XAIE_MEMSHADOW_MAX_RANGES];
+	u32 NumPages[XAIEGBL_TILE_TYPE_MAX];
+	u64 **Tiles;	/* Page hashes of each tile, NULL until written */
+};
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This API acquires the lock of the memory shadow.
+*
+* @param	MemShadow: Pointer to the memory shadow.
+*
+* @return	None.
+*
+* @note		Internal only. The lock is held across the backend operation
+*		so that the page hashes and the memories are updated in the
+*		same order. It is a sleeping lock on Linux, where a block
+*		write may take long enough that spinning waiters would burn
+*		their CPUs.
+*
+******************************************************************************/
+static inline void _XAie_MemShadowLock(XAie_MemShadow *MemShadow)
+{
+#ifdef __linux__
+	pthread_mutex_lock(&MemShadow->Lock);
+#else
+	while(__atomic_test_and_set(&MemShadow->Lock, __ATOMIC_ACQUIRE)) {
+		;
+	}
+#endif
+}
+
+static inline void _XAie_MemShadowUnlock(XAie_MemShadow *MemShadow)
+{
+#ifdef __linux__
+	pthread_mutex_unlock(&MemShadow->Lock);
+#else
+	__atomic_clear(&MemShadow->Lock, __ATOMIC_RELEASE);
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* This API adds a memory to the pages of a tile type.
+*
+* @param	MemShadow: Pointer to the memory shadow.
+* @param	TileType: Tile type.
+* @param	Start: Start offset of the memory within the tile.
+* @param	Size: Size of the memory in bytes.
+*
+* @return	None.
+*
+* @note		Internal only. The memories of the tile modules start on a
+*		page boundary.
+*
+******************************************************************************/
+static void _XAie_MemShadowAddRange(XAie_MemShadow *MemShadow, u8 TileType,
+		u32 Start, u32 Size)
+{
+	XAie_MemShadowRange *Range;
+
+	if(Size == 0U) {
+		return;
+	}
+
+	if(MemShadow->NumRanges[TileType] == XAIE_MEMSHADOW_MAX_RANGES) {
+		/* Cannot happen with the existing tile modules */
+		XAIE_ERROR("Too many memories for tile type %d\n", TileType);
+		return;
+	}
+
+	Range = &MemShadow->Ranges[TileType][MemShadow->NumRanges[TileType]];
+	Range->Start = Start;
+	Range->End = Start + Size;
+	Range->FirstPage = MemShadow->NumPages[TileType];
+	MemShadow->NumPages[TileType] += (Size + XAIE_MEMSHADOW_PAGE_SIZE - 1U) >>
+		XAIE_MEMSHADOW_PAGE_SHIFT;
+	MemShadow->NumRanges[TileType]++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API finds the memory of a tile holding a range of offsets.
+*
+* @param	DevInst: Device instance pointer.
+* @param	MemShadow: Pointer to the memory shadow.
+* @param	RegOff: Offset of the first byte.
+* @param	Size: Size of the range in bytes.
+* @param	TileIdx: Pointer to store the index of the tile.
+* @param	TileOff: Pointer to store the offset of the range in the tile.
+*
+* @return	Pointer to the memory, NULL if the range is not within a single
+*		memory of a tile of the partition.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static const XAie_MemShadowRange *_XAie_MemShadowFind(XAie_DevInst *DevInst,
+		XAie_MemShadow *MemShadow, u64 RegOff, u64 Size, u32 *TileIdx,
+		u32 *TileOff)
+{
+	XAie_LocType Loc;
+	u64 Off;
+	u8 TileType;
+
+	Loc.Col = (u8)(RegOff >> DevInst->DevProp.ColShift);
+	Loc.Row = (u8)((RegOff >> DevInst->DevProp.RowShift) &
+		((1U << (DevInst->DevProp.ColShift -
+			 DevInst->DevProp.RowShift)) - 1U));
+	if((RegOff >> DevInst->DevProp.ColShift >= DevInst->NumCols) ||
+			(Loc.Row >= DevInst->NumRows)) {
+		return NULL;
+	}
+
+	TileType = _XAie_GetTileTypefromLoc(DevInst, Loc);
+	if(TileType == XAIEGBL_TILE_TYPE_MAX) {
+		return NULL;
+	}
+
+	Off = RegOff & ((1ULL << DevInst->DevProp.RowShift) - 1U);
+	for(u8 i = 0U; i < MemShadow->NumRanges[TileType]; i++) {
+		const XAie_MemShadowRange *Range =
+			&MemShadow->Ranges[TileType][i];
+
+		if((Off >= Range->Start) && (Off + Size <= Range->End)) {
+			*TileIdx = (u32)Loc.Col * DevInst->NumRows + Loc.Row;
+			*TileOff = (u32)Off;
+			return Range;
+		}
+	}
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API hashes the content of a page.
+*
+* @param	Data: Words of the page, NULL if all the words are Fill.
+* @param	Fill: Value of the words if Data is NULL.
+*
+* @return	Hash of the page, never XAIE_MEMSHADOW_UNKNOWN.
+*
+* @note		Internal only. The same content hashes the same whether it is
+*		written by a block write or by a block set.
+*
+******************************************************************************/
+static u64 _XAie_MemShadowHash(const u32 *Data, u32 Fill)
+{
+	u64 Hash = 0xCBF29CE484222325ULL;
+
+	for(u32 i = 0U; i < XAIE_MEMSHADOW_PAGE_WORDS; i++) {
+		Hash ^= (Data != NULL) ? Data[i] : Fill;
+		Hash *= 0x9E3779B97F4A7C15ULL;
+		Hash ^= Hash >> 32U;
+	}
+
+	return (Hash == XAIE_MEMSHADOW_UNKNOWN) ? 1U : Hash;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API forgets the pages of a range of offsets.
+*
+* @param	DevInst: Device instance pointer.
+* @param	MemShadow: Pointer to the memory shadow.
+* @param	RegOff: Offset of the first byte.
+* @param	Size: Size of the range in bytes.
+*
+* @return	None.
+*
+* @note		Internal only. The lock of the memory shadow must be held.
+*		Only the part of the range within the memory holding RegOff
+*		is forgotten, the driver never writes across memories.
+*
+******************************************************************************/
+static void _XAie_MemShadowInvalidateLocked(XAie_DevInst *DevInst,
+		XAie_MemShadow *MemShadow, u64 RegOff, u64 Size)
+{
+	const XAie_MemShadowRange *Range;
+	u64 *Pages;
+	u32 TileIdx, TileOff, End;
+
+	Range = _XAie_MemShadowFind(DevInst, MemShadow, RegOff, 1U, &TileIdx,
+			&TileOff);
+	if((Range == NULL) || (MemShadow->Tiles[TileIdx] == NULL)) {
+		return;
+	}
+
+	Pages = MemShadow->Tiles[TileIdx] + Range->FirstPage;
+	End = (TileOff + Size < Range->End) ? (u32)(TileOff + Size) :
+		Range->End;
+	for(u32 Page = (TileOff - Range->Start) >> XAIE_MEMSHADOW_PAGE_SHIFT;
+			(Page << XAIE_MEMSHADOW_PAGE_SHIFT) < End - Range->Start;
+			Page++) {
+		Pages[Page] = XAIE_MEMSHADOW_UNKNOWN;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes a block of words to the device, or sets it to a value.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Offset of the first word.
+* @param	Data: Words to write, NULL to set the words to Fill.
+* @param	Fill: Value of the words if Data is NULL.
+* @param	Size: Number of words.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static AieRC _XAie_MemShadowBackendWrite(XAie_DevInst *DevInst, u64 RegOff,
+		const u32 *Data, u32 Fill, u32 Size)
+{
+	const XAie_Backend *Backend = DevInst->Backend;
+
+	if(Data != NULL) {
+		return Backend->Ops.BlockWrite32(DevInst->IOInst, RegOff, Data,
+				Size);
+	}
+
+	return Backend->Ops.BlockSet32(DevInst->IOInst, RegOff, Fill, Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes a block of words through the memory shadow. The pages fully
+* covered by the block whose hash is unchanged are skipped, the other words
+* are written in as few backend operations as possible.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Offset of the first word.
+* @param	Data: Words to write, NULL to set the words to Fill.
+* @param	Fill: Value of the words if Data is NULL.
+* @param	Size: Number of words.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only. If a backend operation fails, the pages of the
+*		block are forgotten.
+*
+******************************************************************************/
+static AieRC _XAie_MemShadowWrite(XAie_DevInst *DevInst, u64 RegOff,
+		const u32 *Data, u32 Fill, u32 Size)
+{
+	XAie_MemShadow *MemShadow = DevInst->MemShadow;
+	const XAie_MemShadowRange *Range;
+	u64 *Pages;
+	u32 TileIdx, TileOff, Word, RunStart;
+	AieRC RC = XAIE_OK;
+
+	Range = _XAie_MemShadowFind(DevInst, MemShadow, RegOff,
+			(u64)Size * sizeof(u32), &TileIdx, &TileOff);
+	if((Range == NULL) || (Size == 0U)) {
+		RC = _XAie_MemShadowBackendWrite(DevInst, RegOff, Data, Fill,
+				Size);
+		_XAie_MemShadowInvalidate(DevInst, RegOff,
+				(u64)Size * sizeof(u32));
+		return RC;
+	}
+
+	_XAie_MemShadowLock(MemShadow);
+	if(MemShadow->Tiles[TileIdx] == NULL) {
+		u8 TileType = _XAie_GetTileTypefromLoc(DevInst,
+				XAie_TileLoc((u8)(TileIdx / DevInst->NumRows),
+					(u8)(TileIdx % DevInst->NumRows)));
+
+		MemShadow->Tiles[TileIdx] = (u64 *)calloc(
+				MemShadow->NumPages[TileType], sizeof(u64));
+		if(MemShadow->Tiles[TileIdx] == NULL) {
+			_XAie_MemShadowUnlock(MemShadow);
+			XAIE_DBG("Failed to allocate memory shadow pages\n");
+			return _XAie_MemShadowBackendWrite(DevInst, RegOff,
+					Data, Fill, Size);
+		}
+	}
+	Pages = MemShadow->Tiles[TileIdx] + Range->FirstPage;
+
+	/*
+	 * Walk the block page by page. The words to write are accumulated in
+	 * a run which is written when a skipped page or the end is reached.
+	 */
+	RunStart = 0U;
+	Word = 0U;
+	while(Word < Size) {
+		u32 Off = TileOff - Range->Start + Word * (u32)sizeof(u32);
+		u32 Page = Off >> XAIE_MEMSHADOW_PAGE_SHIFT;
+		u32 PageWords = (XAIE_MEMSHADOW_PAGE_SIZE -
+			(Off & (XAIE_MEMSHADOW_PAGE_SIZE - 1U))) / sizeof(u32);
+		u64 Hash;
+
+		if(PageWords > Size - Word) {
+			PageWords = Size - Word;
+		}
+
+		if(PageWords != XAIE_MEMSHADOW_PAGE_WORDS) {
+			Pages[Page] = XAIE_MEMSHADOW_UNKNOWN;
+			Word += PageWords;
+			continue;
+		}
+
+		Hash = _XAie_MemShadowHash((Data != NULL) ? &Data[Word] : NULL,
+				Fill);
+		if(Pages[Page] != Hash) {
+			Pages[Page] = Hash;
+			Word += PageWords;
+			continue;
+		}
+
+		if(Word > RunStart) {
+			RC = _XAie_MemShadowBackendWrite(DevInst,
+					RegOff + RunStart * sizeof(u32),
+					(Data != NULL) ? &Data[RunStart] : NULL,
+					Fill, Word - RunStart);
+			if(RC != XAIE_OK) {
+				break;
+			}
+		}
+		Word += PageWords;
+		RunStart = Word;
+	}
+
+	if((RC == XAIE_OK) && (Size > RunStart)) {
+		RC = _XAie_MemShadowBackendWrite(DevInst,
+				RegOff + RunStart * sizeof(u32),
+				(Data != NULL) ? &Data[RunStart] : NULL, Fill,
+				Size - RunStart);
+	}
+
+	if(RC != XAIE_OK) {
+		_XAie_MemShadowInvalidateLocked(DevInst, MemShadow, RegOff,
+				(u64)Size * sizeof(u32));
+	}
+	_XAie_MemShadowUnlock(MemShadow);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes a block of words through the memory shadow.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Offset of the first word.
+* @param	Data: Words to write.
+* @param	Size: Number of words.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_MemShadowBlockWrite32(XAie_DevInst *DevInst, u64 RegOff,
+		const u32 *Data, u32 Size)
+{
+	return _XAie_MemShadowWrite(DevInst, RegOff, Data, 0U, Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API sets a block of words through the memory shadow.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Offset of the first word.
+* @param	Data: Value of the words.
+* @param	Size: Number of words.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_MemShadowBlockSet32(XAie_DevInst *DevInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	return _XAie_MemShadowWrite(DevInst, RegOff, NULL, Data, Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API forgets the pages of a range of offsets, after they were written
+* without going through the memory shadow.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Offset of the first byte.
+* @param	Size: Size of the range in bytes.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_MemShadowInvalidate(XAie_DevInst *DevInst, u64 RegOff, u64 Size)
+{
+	XAie_MemShadow *MemShadow = DevInst->MemShadow;
+	u32 TileIdx, TileOff;
+
+	/* Most writes are to registers, check without taking the lock */
+	if(_XAie_MemShadowFind(DevInst, MemShadow, RegOff, 1U, &TileIdx,
+				&TileOff) == NULL) {
+		return;
+	}
+
+	_XAie_MemShadowLock(MemShadow);
+	_XAie_MemShadowInvalidateLocked(DevInst, MemShadow, RegOff, Size);
+	_XAie_MemShadowUnlock(MemShadow);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API forgets the pages of the data memory of a tile.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Loc: Location of the tile.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_MemShadowInvalidateDataMem(XAie_DevInst *DevInst, XAie_LocType Loc)
+{
+	const XAie_MemMod *MemMod;
+	u8 TileType;
+
+	TileType = _XAie_GetTileTypefromLoc(DevInst, Loc);
+	if(TileType == XAIEGBL_TILE_TYPE_MAX) {
+		return;
+	}
+
+	MemMod = DevInst->DevProp.DevMod[TileType].MemMod;
+	if(MemMod == NULL) {
+		return;
+	}
+
+	_XAie_MemShadowInvalidate(DevInst, MemMod->MemAddr +
+			_XAie_GetTileAddr(DevInst, Loc.Row, Loc.Col),
+			MemMod->Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API forgets the pages of the data memories which the core or the DMA of
+* a tile can write: the memory of the tile and the ones of its adjacent tiles
+* of the same type.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Loc: Location of the tile.
+*
+* @return	None.
+*
+* @note		Internal only. The cores of AIE tiles and the DMAs of memory
+*		tiles access the memories of their neighbours. Forgetting all
+*		of them is cheaper than telling the generations apart.
+*
+******************************************************************************/
+void _XAie_MemShadowInvalidateReach(XAie_DevInst *DevInst, XAie_LocType Loc)
+{
+	u8 TileType;
+
+	TileType = _XAie_GetTileTypefromLoc(DevInst, Loc);
+	if((TileType != XAIEGBL_TILE_TYPE_AIETILE) &&
+			(TileType != XAIEGBL_TILE_TYPE_MEMTILE)) {
+		return;
+	}
+
+	_XAie_MemShadowInvalidateDataMem(DevInst, Loc);
+	if(Loc.Col > 0U) {
+		_XAie_MemShadowInvalidateDataMem(DevInst,
+				XAie_TileLoc(Loc.Col - 1U, Loc.Row));
+	}
+	if(Loc.Col + 1U < DevInst->NumCols) {
+		_XAie_MemShadowInvalidateDataMem(DevInst,
+				XAie_TileLoc(Loc.Col + 1U, Loc.Row));
+	}
+	if(_XAie_GetTileTypefromLoc(DevInst,
+				XAie_TileLoc(Loc.Col, Loc.Row - 1U)) == TileType) {
+		_XAie_MemShadowInvalidateDataMem(DevInst,
+				XAie_TileLoc(Loc.Col, Loc.Row - 1U));
+	}
+	if((Loc.Row + 1U < DevInst->NumRows) &&
+			(_XAie_GetTileTypefromLoc(DevInst,
+				XAie_TileLoc(Loc.Col, Loc.Row + 1U)) == TileType)) {
+		_XAie_MemShadowInvalidateDataMem(DevInst,
+				XAie_TileLoc(Loc.Col, Loc.Row + 1U));
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API forgets all the pages of the memory shadow.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_MemShadowInvalidateAll(XAie_DevInst *DevInst)
+{
+	XAie_MemShadow *MemShadow = DevInst->MemShadow;
+
+	_XAie_MemShadowLock(MemShadow);
+	for(u32 i = 0U; i < (u32)DevInst->NumCols * DevInst->NumRows; i++) {
+		free(MemShadow->Tiles[i]);
+		MemShadow->Tiles[i] = NULL;
+	}
+	_XAie_MemShadowUnlock(MemShadow);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API forgets the pages written by the commands of a transaction which
+* was applied to the device.
+*
+* @param	DevInst: Device instance pointer.
+* @param	TxnInst: Pointer to the transaction instance.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_MemShadowInvalidateTxn(XAie_DevInst *DevInst,
+		XAie_TxnInst *TxnInst)
+{
+	XAie_MemShadow *MemShadow = DevInst->MemShadow;
+
+	_XAie_MemShadowLock(MemShadow);
+	for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
+		XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i];
+
+		switch(Cmd->Opcode) {
+		case XAIE_IO_WRITE:
+			_XAie_MemShadowInvalidateLocked(DevInst, MemShadow,
+					Cmd->RegOff, sizeof(u32));
+			break;
+		case XAIE_IO_BLOCKWRITE:
+		case XAIE_IO_BLOCKSET:
+			_XAie_MemShadowInvalidateLocked(DevInst, MemShadow,
+					Cmd->RegOff,
+					(u64)Cmd->Size * sizeof(u32));
+			break;
+		default:
+			break;
+		}
+	}
+	_XAie_MemShadowUnlock(MemShadow);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API creates the memory shadow of the device instance. No page is known
+* until it is written.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_MemShadowEnable(XAie_DevInst *DevInst)
+{
+	XAie_MemShadow *MemShadow;
+
+	if(DevInst->MemShadow != NULL) {
+		return XAIE_OK;
+	}
+
+	MemShadow = (XAie_MemShadow *)calloc(1U, sizeof(*MemShadow));
+	if(MemShadow == NULL) {
+		XAIE_ERROR("Failed to allocate memory shadow\n");
+		return XAIE_ERR;
+	}
+
+	MemShadow->Tiles = (u64 **)calloc((u32)DevInst->NumCols *
+			DevInst->NumRows, sizeof(*MemShadow->Tiles));
+	if(MemShadow->Tiles == NULL) {
+		XAIE_ERROR("Failed to allocate memory shadow\n");
+		free(MemShadow);
+		return XAIE_ERR;
+	}
+
+	for(u8 TileType = 0U; TileType < XAIEGBL_TILE_TYPE_MAX; TileType++) {
+		const XAie_TileMod *TileMod =
+			&DevInst->DevProp.DevMod[TileType];
+
+		if(TileMod->MemMod != NULL) {
+			_XAie_MemShadowAddRange(MemShadow, TileType,
+					TileMod->MemMod->MemAddr,
+					TileMod->MemMod->Size);
+		}
+
+		if(TileMod->CoreMod != NULL) {
+			_XAie_MemShadowAddRange(MemShadow, TileType,
+					TileMod->CoreMod->ProgMemHostOffset,
+					TileMod->CoreMod->ProgMemSize);
+		}
+	}
+
+#ifdef __linux__
+	pthread_mutex_init(&MemShadow->Lock, NULL);
+#endif
+	DevInst->MemShadow = MemShadow;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API releases the memory shadow of the device instance.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_MemShadowDisable(XAie_DevInst *DevInst)
+{
+	XAie_MemShadow *MemShadow = DevInst->MemShadow;
+
+	if(MemShadow == NULL) {
+		return;
+	}
+
+	for(u32 i = 0U; i < (u32)DevInst->NumCols * DevInst->NumRows; i++) {
+		free(MemShadow->Tiles[i]);
+	}
+	free(MemShadow->Tiles);
+#ifdef __linux__
+	pthread_mutex_destroy(&MemShadow->Lock);
+#endif
+	free(MemShadow);
+	DevInst->MemShadow = NULL;
+}
+
+/** @} */
@@ -0,0 +1,793 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_shadow.c
+* @{
+*
+* This file contains routines for the register shadow of the device instance.
+* The shadow caches the last value written to the registers of the partition,
+* so that writes which do not change a register are dropped and masked writes
+* are done without reading the register back from the device.
+*
+* Only plain configuration registers, which are not updated by the hardware
+* and have no side effects on write, are cached: stream switch configuration,
+* DMA buffer descriptors, event, trace and performance counter control, and
+* timer trigger values. All the other registers, like strobes, write to clear
+* status, counters and interrupt enables, are always written to the device.
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "xaie_helper.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_SHADOW_INIT_ENTRIES	1024U
+#define XAIE_SHADOW_MAX_RANGES		48U
+
+/**************************** Type Definitions *******************************/
+/*
+ * Entry of the shadow. Entries are never removed, invalidating an entry only
+ * clears Valid, so the probe sequences stay intact. Writers counts the writes
+ * of the register in flight to the backend, Raced is set when they overlap,
+ * as the order in which they reached the device is then unknown.
+ */
+typedef struct {
+	u64 RegOff;
+	u32 Value;
+	u8 Used;
+	u8 Valid;
+	u8 Writers;
+	u8 Raced;
+} XAie_ShadowEntry;
+
+/* Range of offsets within a tile which is cached */
+typedef struct {
+	u32 Start;
+	u32 End;
+} XAie_ShadowRange;
+
+struct XAie_Shadow {
+	u8 Lock;
+	u32 NumEntries;
+	u32 MaxEntries;
+	XAie_ShadowEntry *Entries;
+	u8 NumRanges[XAIEGBL_TILE_TYPE_MAX];
+	XAie_ShadowRange Ranges[XAIEGBL_TILE_TYPE_MAX][XAIE_SHADOW_MAX_RANGES];
+};
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This API acquires the lock of the shadow.
+*
+* @param	Shadow: Pointer to the shadow.
+*
+* @return	None.
+*
+* @note		Internal only. The lock is never held across a backend
+*		operation.
+*
+******************************************************************************/
+static inline void _XAie_ShadowLock(XAie_Shadow *Shadow)
+{
+	while(__atomic_test_and_set(&Shadow->Lock, __ATOMIC_ACQUIRE)) {
+		;
+	}
+}
+
+static inline void _XAie_ShadowUnlock(XAie_Shadow *Shadow)
+{
+	__atomic_clear(&Shadow->Lock, __ATOMIC_RELEASE);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API adds a range of offsets which is cached to a tile type.
+*
+* @param	Shadow: Pointer to the shadow.
+* @param	TileType: Tile type.
+* @param	Start: Start offset of the range within the tile.
+* @param	Size: Size of the range in bytes.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_ShadowAddRange(XAie_Shadow *Shadow, u8 TileType, u32 Start,
+		u32 Size)
+{
+	u8 Idx = Shadow->NumRanges[TileType];
+
+	if(Size == 0U) {
+		return;
+	}
+
+	if(Idx == XAIE_SHADOW_MAX_RANGES) {
+		/* Cannot happen with the existing tile modules */
+		XAIE_ERROR("Too many cached ranges for tile type %d\n",
+				TileType);
+		return;
+	}
+
+	Shadow->Ranges[TileType][Idx].Start = Start;
+	Shadow->Ranges[TileType][Idx].End = Start + Size;
+	Shadow->NumRanges[TileType]++;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API builds the ranges of offsets which are cached from the tile modules
+* of the device. Only plain configuration registers are added, registers which
+* are strobes, write to clear, or updated by the hardware are left out.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Shadow: Pointer to the shadow.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_ShadowInitRanges(XAie_DevInst *DevInst, XAie_Shadow *Shadow)
+{
+	for(u8 TileType = 0U; TileType < XAIEGBL_TILE_TYPE_MAX; TileType++) {
+		const XAie_TileMod *TileMod =
+			&DevInst->DevProp.DevMod[TileType];
+
+		if(TileMod->StrmSw != NULL) {
+			const XAie_StrmMod *StrmMod = TileMod->StrmSw;
+			u32 Start = 0xFFFFFFFFU;
+			u32 End = 0U;
+
+			_XAie_ShadowAddRange(Shadow, TileType,
+					StrmMod->MstrConfigBaseAddr,
+					((u32)StrmMod->MaxMasterPhyPortId + 1U) *
+					StrmMod->PortOffset);
+			_XAie_ShadowAddRange(Shadow, TileType,
+					StrmMod->SlvConfigBaseAddr,
+					((u32)StrmMod->MaxSlavePhyPortId + 1U) *
+					StrmMod->PortOffset);
+
+			/* Slot registers of all the slave ports are contiguous */
+			for(u8 i = 0U; i < SS_PORT_TYPE_MAX; i++) {
+				const XAie_StrmPort *Port =
+					&StrmMod->SlvSlotConfig[i];
+
+				if(Port->NumPorts == 0U) {
+					continue;
+				}
+				if(Port->PortBaseAddr < Start) {
+					Start = Port->PortBaseAddr;
+				}
+				if(Port->PortBaseAddr + Port->NumPorts *
+						StrmMod->SlotOffsetPerPort > End) {
+					End = Port->PortBaseAddr +
+						Port->NumPorts *
+						StrmMod->SlotOffsetPerPort;
+				}
+			}
+			if(End > Start) {
+				_XAie_ShadowAddRange(Shadow, TileType, Start,
+						End - Start);
+			}
+		}
+
+		if(TileMod->DmaMod != NULL) {
+			_XAie_ShadowAddRange(Shadow, TileType,
+					TileMod->DmaMod->BaseAddr,
+					TileMod->DmaMod->NumBds *
+					TileMod->DmaMod->IdxOffset);
+		}
+
+		for(u8 Mod = 0U; Mod < TileMod->NumModules; Mod++) {
+			if(TileMod->EvntMod != NULL) {
+				const XAie_EvntMod *EvntMod =
+					&TileMod->EvntMod[Mod];
+
+				_XAie_ShadowAddRange(Shadow, TileType,
+					EvntMod->ComboInputRegOff, sizeof(u32));
+				_XAie_ShadowAddRange(Shadow, TileType,
+					EvntMod->ComboCtrlRegOff, sizeof(u32));
+				if(EvntMod->StrmPortSelectIdsPerReg != 0U) {
+					_XAie_ShadowAddRange(Shadow, TileType,
+						EvntMod->BaseStrmPortSelectRegOff,
+						(EvntMod->NumStrmPortSelectIds +
+						 EvntMod->StrmPortSelectIdsPerReg -
+						 1U) /
+						EvntMod->StrmPortSelectIdsPerReg *
+						sizeof(u32));
+				}
+				_XAie_ShadowAddRange(Shadow, TileType,
+					EvntMod->BaseBroadcastRegOff,
+					EvntMod->NumBroadcastIds * sizeof(u32));
+				_XAie_ShadowAddRange(Shadow, TileType,
+					EvntMod->BaseGroupEventRegOff,
+					EvntMod->NumGroupEvents * sizeof(u32));
+				_XAie_ShadowAddRange(Shadow, TileType,
+					EvntMod->BasePCEventRegOff,
+					EvntMod->NumPCEvents * sizeof(u32));
+			}
+
+			if(TileMod->TraceMod != NULL) {
+				const XAie_TraceMod *TraceMod =
+					&TileMod->TraceMod[Mod];
+
+				_XAie_ShadowAddRange(Shadow, TileType,
+					TraceMod->CtrlRegOff, sizeof(u32));
+				_XAie_ShadowAddRange(Shadow, TileType,
+					TraceMod->PktConfigRegOff, sizeof(u32));
+				if(TraceMod->NumEventsPerSlot != 0U) {
+					for(u8 i = 0U; i < TraceMod->NumTraceSlotIds /
+							TraceMod->NumEventsPerSlot;
+							i++) {
+						_XAie_ShadowAddRange(Shadow,
+							TileType,
+							TraceMod->EventRegOffs[i],
+							sizeof(u32));
+					}
+				}
+			}
+
+			/* Counter values are updated by the hardware */
+			if(TileMod->PerfMod != NULL) {
+				const XAie_PerfMod *PerfMod =
+					&TileMod->PerfMod[Mod];
+
+				_XAie_ShadowAddRange(Shadow, TileType,
+					PerfMod->PerfCtrlBaseAddr,
+					((u32)PerfMod->MaxCounterVal + 1U) / 2U *
+					PerfMod->PerfCtrlOffsetAdd);
+				_XAie_ShadowAddRange(Shadow, TileType,
+					PerfMod->PerfCtrlResetBaseAddr,
+					sizeof(u32));
+				_XAie_ShadowAddRange(Shadow, TileType,
+					PerfMod->PerfCounterEvtValBaseAddr,
+					PerfMod->MaxCounterVal *
+					PerfMod->PerfCounterOffsetAdd);
+			}
+
+			/* Timer control has the reset strobe */
+			if(TileMod->TimerMod != NULL) {
+				_XAie_ShadowAddRange(Shadow, TileType,
+					TileMod->TimerMod[Mod].TrigEventLowValOff,
+					sizeof(u32));
+				_XAie_ShadowAddRange(Shadow, TileType,
+					TileMod->TimerMod[Mod].TrigEventHighValOff,
+					sizeof(u32));
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API checks a range of registers against the cached ranges of the tile
+* it is in.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Shadow: Pointer to the shadow.
+* @param	RegOff: Offset of the first register.
+* @param	Size: Size of the range in bytes.
+* @param	Whole: 1 if the whole range must be cached, 0 if any register of
+*		the range may be.
+*
+* @return	1 if the range is cached, 0 otherwise.
+*
+* @note		Internal only. Ranges outside of the partition are not cached.
+*		A range crossing tiles is reported as possibly cached.
+*
+******************************************************************************/
+static u8 _XAie_ShadowIsCached(XAie_DevInst *DevInst, XAie_Shadow *Shadow,
+		u64 RegOff, u64 Size, u8 Whole)
+{
+	XAie_LocType Loc;
+	u64 TileOff;
+	u8 TileType;
+
+	Loc.Col = (u8)(RegOff >> DevInst->DevProp.ColShift);
+	Loc.Row = (u8)((RegOff >> DevInst->DevProp.RowShift) &
+		((1U << (DevInst->DevProp.ColShift -
+			 DevInst->DevProp.RowShift)) - 1U));
+	if((RegOff >> DevInst->DevProp.ColShift >= DevInst->NumCols) ||
+			(Loc.Row >= DevInst->NumRows)) {
+		return 0U;
+	}
+
+	TileType = _XAie_GetTileTypefromLoc(DevInst, Loc);
+	if(TileType == XAIEGBL_TILE_TYPE_MAX) {
+		return 0U;
+	}
+
+	TileOff = RegOff & ((1ULL << DevInst->DevProp.RowShift) - 1U);
+	if(TileOff + Size > (1ULL << DevInst->DevProp.RowShift)) {
+		return (Whole != 0U) ? 0U : 1U;
+	}
+
+	for(u8 i = 0U; i < Shadow->NumRanges[TileType]; i++) {
+		const XAie_ShadowRange *Range = &Shadow->Ranges[TileType][i];
+
+		if(Whole != 0U) {
+			if((TileOff >= Range->Start) &&
+					(TileOff + Size <= Range->End)) {
+				return 1U;
+			}
+		} else if((TileOff < Range->End) &&
+				(TileOff + Size > Range->Start)) {
+			return 1U;
+		}
+	}
+
+	return 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API looks up the entry of a register in the shadow. If the register is
+* not in the shadow, the free entry the register hashes to is returned.
+*
+* @param	Shadow: Pointer to the shadow.
+* @param	RegOff: Offset of the register.
+*
+* @return	Pointer to the entry.
+*
+* @note		Internal only. The shadow is kept at most half full, so a free
+*		entry is always found.
+*
+******************************************************************************/
+static XAie_ShadowEntry *_XAie_ShadowLookup(XAie_Shadow *Shadow, u64 RegOff)
+{
+	u32 Mask = Shadow->MaxEntries - 1U;
+	u32 Index = (u32)(((RegOff >> 2U) * 0x9E3779B97F4A7C15ULL) >> 32) & Mask;
+
+	while(Shadow->Entries[Index].Used != 0U) {
+		if(Shadow->Entries[Index].RegOff == RegOff) {
+			break;
+		}
+		Index = (Index + 1U) & Mask;
+	}
+
+	return &Shadow->Entries[Index];
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the entry of a register in the shadow, adding the register
+* if it is missing. The shadow is grown when it gets half full.
+*
+* @param	Shadow: Pointer to the shadow.
+* @param	RegOff: Offset of the register.
+*
+* @return	Pointer to the entry, NULL if the shadow cannot be grown.
+*
+* @note		Internal only. The lock of the shadow must be held. A register
+*		added to the shadow is not valid.
+*
+******************************************************************************/
+static XAie_ShadowEntry *_XAie_ShadowGet(XAie_Shadow *Shadow, u64 RegOff)
+{
+	XAie_ShadowEntry *Entry;
+
+	Entry = _XAie_ShadowLookup(Shadow, RegOff);
+	if(Entry->Used != 0U) {
+		return Entry;
+	}
+
+	if((Shadow->NumEntries + 1U) * 2U > Shadow->MaxEntries) {
+		XAie_ShadowEntry *Old = Shadow->Entries;
+		u32 OldMax = Shadow->MaxEntries;
+
+		Shadow->Entries = (XAie_ShadowEntry *)calloc(OldMax * 2U,
+				sizeof(*Shadow->Entries));
+		if(Shadow->Entries == NULL) {
+			XAIE_DBG("Failed to grow register shadow\n");
+			Shadow->Entries = Old;
+			return NULL;
+		}
+
+		Shadow->MaxEntries = OldMax * 2U;
+		for(u32 i = 0U; i < OldMax; i++) {
+			if(Old[i].Used != 0U) {
+				*_XAie_ShadowLookup(Shadow, Old[i].RegOff) =
+					Old[i];
+			}
+		}
+		free(Old);
+
+		Entry = _XAie_ShadowLookup(Shadow, RegOff);
+	}
+
+	Entry->Used = 1U;
+	Entry->RegOff = RegOff;
+	Shadow->NumEntries++;
+
+	return Entry;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API marks the start of a write of a register to the backend. The
+* register is not valid until the write ends.
+*
+* @param	Entry: Entry of the register, NULL if it could not be added.
+*
+* @return	None.
+*
+* @note		Internal only. The lock of the shadow must be held.
+*
+******************************************************************************/
+static void _XAie_ShadowBeginWrite(XAie_ShadowEntry *Entry)
+{
+	if(Entry == NULL) {
+		return;
+	}
+
+	if(Entry->Writers != 0U) {
+		Entry->Raced = 1U;
+	}
+	Entry->Writers++;
+	Entry->Valid = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API marks the end of a write of a register to the backend. The value
+* is recorded only if the write succeeded and did not overlap with another
+* write of the register.
+*
+* @param	Shadow: Pointer to the shadow.
+* @param	RegOff: Offset of the register.
+* @param	Known: 1 if the value of the register is known, 0 otherwise.
+* @param	Value: Value written to the register.
+*
+* @return	None.
+*
+* @note		Internal only. The lock of the shadow must be held.
+*
+******************************************************************************/
+static void _XAie_ShadowEndWrite(XAie_Shadow *Shadow, u64 RegOff, u8 Known,
+		u32 Value)
+{
+	XAie_ShadowEntry *Entry;
+
+	Entry = _XAie_ShadowLookup(Shadow, RegOff);
+	if((Entry->Used == 0U) || (Entry->Writers == 0U)) {
+		return;
+	}
+
+	Entry->Writers--;
+	if(Entry->Writers != 0U) {
+		return;
+	}
+
+	if((Known != 0U) && (Entry->Raced == 0U)) {
+		Entry->Value = Value;
+		Entry->Valid = 1U;
+	}
+	Entry->Raced = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API invalidates the registers of a range in the shadow.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Shadow: Pointer to the shadow.
+* @param	RegOff: Offset of the first register.
+* @param	Size: Size of the range in bytes.
+*
+* @return	None.
+*
+* @note		Internal only. The lock of the shadow must be held.
+*
+******************************************************************************/
+static void _XAie_ShadowInvalidateLocked(XAie_DevInst *DevInst,
+		XAie_Shadow *Shadow, u64 RegOff, u64 Size)
+{
+	if(_XAie_ShadowIsCached(DevInst, Shadow, RegOff, Size, 0U) == 0U) {
+		return;
+	}
+
+	if(Size / sizeof(u32) < Shadow->NumEntries) {
+		for(u64 Off = 0U; Off < Size; Off += sizeof(u32)) {
+			XAie_ShadowEntry *Entry;
+
+			Entry = _XAie_ShadowLookup(Shadow, RegOff + Off);
+			Entry->Valid = 0U;
+			if(Entry->Writers != 0U) {
+				Entry->Raced = 1U;
+			}
+		}
+		return;
+	}
+
+	for(u32 i = 0U; i < Shadow->MaxEntries; i++) {
+		XAie_ShadowEntry *Entry = &Shadow->Entries[i];
+
+		if((Entry->RegOff >= RegOff) &&
+				(Entry->RegOff < RegOff + Size)) {
+			Entry->Valid = 0U;
+			if(Entry->Writers != 0U) {
+				Entry->Raced = 1U;
+			}
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes a register through the shadow. The write is dropped if the
+* shadow holds the same value for the register.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Offset of the register.
+* @param	Value: Value to be written.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_ShadowWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Value)
+{
+	XAie_Shadow *Shadow = DevInst->Shadow;
+	const XAie_Backend *Backend = DevInst->Backend;
+	XAie_ShadowEntry *Entry;
+	AieRC RC;
+
+	if(_XAie_ShadowIsCached(DevInst, Shadow, RegOff, sizeof(u32),
+				1U) == 0U) {
+		return Backend->Ops.Write32(DevInst->IOInst, RegOff, Value);
+	}
+
+	_XAie_ShadowLock(Shadow);
+	Entry = _XAie_ShadowGet(Shadow, RegOff);
+	if((Entry != NULL) && (Entry->Valid != 0U) && (Entry->Value == Value)) {
+		_XAie_ShadowUnlock(Shadow);
+		return XAIE_OK;
+	}
+	_XAie_ShadowBeginWrite(Entry);
+	_XAie_ShadowUnlock(Shadow);
+
+	RC = Backend->Ops.Write32(DevInst->IOInst, RegOff, Value);
+
+	_XAie_ShadowLock(Shadow);
+	_XAie_ShadowEndWrite(Shadow, RegOff, (RC == XAIE_OK) ? 1U : 0U, Value);
+	_XAie_ShadowUnlock(Shadow);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes a field of a register through the shadow. If the shadow
+* holds the value of the register, the new value is computed from it and
+* written without reading the register from the device, or dropped if it does
+* not change the register.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Offset of the register.
+* @param	Mask: Mask of the field.
+* @param	Value: Value of the field, already shifted.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only. A register which is not valid in the shadow is
+*		written with the masked write operation of the backend and
+*		stays not valid.
+*
+******************************************************************************/
+AieRC _XAie_ShadowMaskWrite32(XAie_DevInst *DevInst, u64 RegOff, u32 Mask,
+		u32 Value)
+{
+	XAie_Shadow *Shadow = DevInst->Shadow;
+	const XAie_Backend *Backend = DevInst->Backend;
+	XAie_ShadowEntry *Entry;
+	u32 NewValue = 0U;
+	u8 Known = 0U;
+	AieRC RC;
+
+	if(_XAie_ShadowIsCached(DevInst, Shadow, RegOff, sizeof(u32),
+				1U) == 0U) {
+		return Backend->Ops.MaskWrite32(DevInst->IOInst, RegOff, Mask,
+				Value);
+	}
+
+	_XAie_ShadowLock(Shadow);
+	Entry = _XAie_ShadowGet(Shadow, RegOff);
+	if((Entry != NULL) && (Entry->Valid != 0U)) {
+		NewValue = (Entry->Value & ~Mask) | (Value & Mask);
+		if(NewValue == Entry->Value) {
+			_XAie_ShadowUnlock(Shadow);
+			return XAIE_OK;
+		}
+		Known = 1U;
+	}
+	_XAie_ShadowBeginWrite(Entry);
+	_XAie_ShadowUnlock(Shadow);
+
+	if(Known != 0U) {
+		RC = Backend->Ops.Write32(DevInst->IOInst, RegOff, NewValue);
+	} else {
+		RC = Backend->Ops.MaskWrite32(DevInst->IOInst, RegOff, Mask,
+				Value);
+	}
+
+	_XAie_ShadowLock(Shadow);
+	_XAie_ShadowEndWrite(Shadow, RegOff,
+			((RC == XAIE_OK) && (Known != 0U)) ? 1U : 0U, NewValue);
+	_XAie_ShadowUnlock(Shadow);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API invalidates a range of registers in the shadow, after they were
+* written without going through the shadow.
+*
+* @param	DevInst: Device instance pointer.
+* @param	RegOff: Offset of the first register.
+* @param	Size: Size of the range in bytes.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_ShadowInvalidate(XAie_DevInst *DevInst, u64 RegOff, u64 Size)
+{
+	XAie_Shadow *Shadow = DevInst->Shadow;
+
+	_XAie_ShadowLock(Shadow);
+	_XAie_ShadowInvalidateLocked(DevInst, Shadow, RegOff, Size);
+	_XAie_ShadowUnlock(Shadow);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API invalidates all the registers in the shadow.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_ShadowInvalidateAll(XAie_DevInst *DevInst)
+{
+	XAie_Shadow *Shadow = DevInst->Shadow;
+
+	_XAie_ShadowLock(Shadow);
+	for(u32 i = 0U; i < Shadow->MaxEntries; i++) {
+		Shadow->Entries[i].Valid = 0U;
+	}
+	_XAie_ShadowUnlock(Shadow);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API invalidates the registers written by the commands of a transaction
+* which was applied to the device.
+*
+* @param	DevInst: Device instance pointer.
+* @param	TxnInst: Pointer to the transaction instance.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_ShadowInvalidateTxn(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst)
+{
+	XAie_Shadow *Shadow = DevInst->Shadow;
+
+	_XAie_ShadowLock(Shadow);
+	for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
+		XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i];
+
+		switch(Cmd->Opcode) {
+		case XAIE_IO_WRITE:
+			_XAie_ShadowInvalidateLocked(DevInst, Shadow,
+					Cmd->RegOff, sizeof(u32));
+			break;
+		case XAIE_IO_BLOCKWRITE:
+		case XAIE_IO_BLOCKSET:
+			_XAie_ShadowInvalidateLocked(DevInst, Shadow,
+					Cmd->RegOff,
+					(u64)Cmd->Size * sizeof(u32));
+			break;
+		default:
+			break;
+		}
+	}
+	_XAie_ShadowUnlock(Shadow);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API creates the register shadow of the device instance.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_ShadowEnable(XAie_DevInst *DevInst)
+{
+	XAie_Shadow *Shadow;
+
+	if(DevInst->Shadow != NULL) {
+		return XAIE_OK;
+	}
+
+	Shadow = (XAie_Shadow *)calloc(1U, sizeof(*Shadow));
+	if(Shadow == NULL) {
+		XAIE_ERROR("Failed to allocate register shadow\n");
+		return XAIE_ERR;
+	}
+
+	Shadow->Entries = (XAie_ShadowEntry *)calloc(XAIE_SHADOW_INIT_ENTRIES,
+			sizeof(*Shadow->Entries));
+	if(Shadow->Entries == NULL) {
+		XAIE_ERROR("Failed to allocate register shadow\n");
+		free(Shadow);
+		return XAIE_ERR;
+	}
+
+	Shadow->MaxEntries = XAIE_SHADOW_INIT_ENTRIES;
+	_XAie_ShadowInitRanges(DevInst, Shadow);
+	DevInst->Shadow = Shadow;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API releases the register shadow of the device instance.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_ShadowDisable(XAie_DevInst *DevInst)
+{
+	if(DevInst->Shadow == NULL) {
+		return;
+	}
+
+	free(DevInst->Shadow->Entries);
+	free(DevInst->Shadow);
+	DevInst->Shadow = NULL;
+}
+
+/** @} */
@@ -0,0 +1,560 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_txn_async.c
+* @{
+*
+* This file contains routines to submit transaction instances asynchronously.
+* Each device instance has one submission worker thread, created on the first
+* asynchronous submission, which applies the queued transactions to the
+* device in submission order. Every submission returns a fence which is
+* signaled with the result once the transaction has been applied.
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdlib.h>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+#include "xaie_helper.h"
+
+#ifdef __linux__
+/************************** Constant Definitions *****************************/
+#define XAIE_TXN_QUEUE_DEPTH		16U
+
+/**************************** Type Definitions *******************************/
+struct XAie_TxnFence {
+	XAie_DevInst *DevInst;
+	XAie_TxnInst *TxnInst;
+	pthread_mutex_t Lock;
+	pthread_cond_t Cond;
+	XAie_TxnFenceCb Cb;
+	void *CbArg;
+	AieRC Status;
+	u8 Signaled;
+	u8 RefCount;	/* References of the caller and of the worker */
+	u8 FreeTxn;	/* Transaction instance is owned by the fence */
+};
+
+struct XAie_TxnQueue {
+	pthread_t Worker;
+	pthread_mutex_t Lock;
+	pthread_cond_t NotEmpty;
+	pthread_cond_t NotFull;
+	u32 Head;
+	u32 NumFences;
+	u8 Stop;
+	u8 Busy;	/* Worker is applying a transaction */
+	XAie_TxnFence *Fences[XAIE_TXN_QUEUE_DEPTH];
+};
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This API drops a reference to a fence and releases it when no reference is
+* left.
+*
+* @param	Fence: Pointer to the fence.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_TxnFencePut(XAie_TxnFence *Fence)
+{
+	u8 RefCount;
+
+	pthread_mutex_lock(&Fence->Lock);
+	RefCount = --Fence->RefCount;
+	pthread_mutex_unlock(&Fence->Lock);
+
+	if(RefCount != 0U) {
+		return;
+	}
+
+	pthread_cond_destroy(&Fence->Cond);
+	pthread_mutex_destroy(&Fence->Lock);
+	free(Fence);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API applies a queued transaction instance to the device and signals its
+* fence. The callback of the fence, if any, is called from the worker thread.
+*
+* @param	Fence: Pointer to the fence of the transaction.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_TxnFenceExecute(XAie_TxnFence *Fence)
+{
+	XAie_TxnFenceCb Cb;
+	void *CbArg;
+	AieRC RC;
+
+	RC = _XAie_Txn_Submit(Fence->DevInst, Fence->TxnInst);
+	if(Fence->FreeTxn != 0U) {
+		_XAie_TxnFree(Fence->TxnInst);
+		Fence->TxnInst = NULL;
+	}
+
+	pthread_mutex_lock(&Fence->Lock);
+	Fence->Status = RC;
+	Fence->Signaled = 1U;
+	Cb = Fence->Cb;
+	CbArg = Fence->CbArg;
+	pthread_cond_broadcast(&Fence->Cond);
+	pthread_mutex_unlock(&Fence->Lock);
+
+	if(Cb != NULL) {
+		Cb(Fence, RC, CbArg);
+	}
+
+	_XAie_TxnFencePut(Fence);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the main routine of the submission worker. It applies the queued
+* transactions in submission order until the queue is stopped and drained.
+*
+* @param	Arg: Pointer to the submission queue.
+*
+* @return	NULL.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void *_XAie_TxnQueueWorker(void *Arg)
+{
+	XAie_TxnQueue *Queue = (XAie_TxnQueue *)Arg;
+	XAie_TxnFence *Fence;
+
+	pthread_mutex_lock(&Queue->Lock);
+	while(1) {
+		while((Queue->NumFences == 0U) && (Queue->Stop == 0U)) {
+			pthread_cond_wait(&Queue->NotEmpty, &Queue->Lock);
+		}
+
+		if(Queue->NumFences == 0U) {
+			break;
+		}
+
+		Fence = Queue->Fences[Queue->Head];
+		Queue->Head = (Queue->Head + 1U) % XAIE_TXN_QUEUE_DEPTH;
+		Queue->NumFences--;
+		Queue->Busy = 1U;
+		pthread_cond_signal(&Queue->NotFull);
+		pthread_mutex_unlock(&Queue->Lock);
+
+		_XAie_TxnFenceExecute(Fence);
+
+		pthread_mutex_lock(&Queue->Lock);
+		Queue->Busy = 0U;
+	}
+	pthread_mutex_unlock(&Queue->Lock);
+
+	return NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API stops the worker of a submission queue, once it has applied all the
+* queued transactions, and releases the queue.
+*
+* @param	Queue: Pointer to the submission queue.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_TxnQueueDestroy(XAie_TxnQueue *Queue)
+{
+	pthread_mutex_lock(&Queue->Lock);
+	Queue->Stop = 1U;
+	pthread_cond_broadcast(&Queue->NotEmpty);
+	pthread_mutex_unlock(&Queue->Lock);
+
+	pthread_join(Queue->Worker, NULL);
+
+	pthread_cond_destroy(&Queue->NotFull);
+	pthread_cond_destroy(&Queue->NotEmpty);
+	pthread_mutex_destroy(&Queue->Lock);
+	free(Queue);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the submission queue of the device instance, and creates it
+* along with its worker thread on the first call.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	Pointer to the submission queue, NULL on failure.
+*
+* @note		Internal only. Concurrent first callers race to install their
+*		queue, the losers release theirs.
+*
+******************************************************************************/
+static XAie_TxnQueue *_XAie_TxnGetQueue(XAie_DevInst *DevInst)
+{
+	XAie_TxnQueue *Queue, *Expected = NULL;
+
+	Queue = __atomic_load_n(&DevInst->TxnQueue, __ATOMIC_ACQUIRE);
+	if(Queue != NULL) {
+		return Queue;
+	}
+
+	Queue = (XAie_TxnQueue *)calloc(1U, sizeof(*Queue));
+	if(Queue == NULL) {
+		XAIE_ERROR("Failed to allocate txn submission queue\n");
+		return NULL;
+	}
+
+	pthread_mutex_init(&Queue->Lock, NULL);
+	pthread_cond_init(&Queue->NotEmpty, NULL);
+	pthread_cond_init(&Queue->NotFull, NULL);
+	if(pthread_create(&Queue->Worker, NULL, _XAie_TxnQueueWorker,
+				Queue) != 0) {
+		XAIE_ERROR("Failed to create txn submission worker\n");
+		pthread_cond_destroy(&Queue->NotFull);
+		pthread_cond_destroy(&Queue->NotEmpty);
+		pthread_mutex_destroy(&Queue->Lock);
+		free(Queue);
+		return NULL;
+	}
+
+	if(!__atomic_compare_exchange_n(&DevInst->TxnQueue, &Expected, Queue,
+				0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+		_XAie_TxnQueueDestroy(Queue);
+		return Expected;
+	}
+
+	return Queue;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API queues a transaction instance for submission by the worker thread
+* of the device instance. If TxnInst is NULL, the transaction started by the
+* calling thread is detached from the thread and queued, so the thread can
+* start its next transaction right away.
+*
+* @param	DevInst: Device instance pointer.
+* @param	TxnInst: Pointer to an exported transaction instance, or NULL.
+*
+* @return	Pointer to the fence of the submission, NULL on failure.
+*
+* @note		Internal only. The call blocks while the queue is full.
+*
+******************************************************************************/
+XAie_TxnFence *_XAie_TxnSubmitAsync(XAie_DevInst *DevInst,
+		XAie_TxnInst *TxnInst)
+{
+	XAie_TxnQueue *Queue;
+	XAie_TxnFence *Fence;
+	u8 FreeTxn = 0U;
+
+	if(TxnInst == NULL) {
+		TxnInst = _XAie_GetTxnInst(DevInst,
+				DevInst->Backend->Ops.GetTid());
+		if(TxnInst == NULL) {
+			XAIE_ERROR("Failed to get the correct transaction "
+					"instance\n");
+			return NULL;
+		}
+
+		if(TxnInst->Flags & XAIE_TXN_INST_CHILD_MASK) {
+			XAIE_ERROR("Child transaction must be merged to its "
+					"parent\n");
+			return NULL;
+		}
+		FreeTxn = 1U;
+	} else if(!(TxnInst->Flags & XAIE_TXN_INST_EXPORTED_MASK)) {
+		XAIE_ERROR("Transaction instance was not exported.\n");
+		return NULL;
+	}
+
+	Queue = _XAie_TxnGetQueue(DevInst);
+	if(Queue == NULL) {
+		return NULL;
+	}
+
+	Fence = (XAie_TxnFence *)calloc(1U, sizeof(*Fence));
+	if(Fence == NULL) {
+		XAIE_ERROR("Failed to allocate txn fence\n");
+		return NULL;
+	}
+
+	if(FreeTxn != 0U) {
+		if(_XAie_RemoveTxnInstFromList(DevInst, TxnInst) != XAIE_OK) {
+			free(Fence);
+			return NULL;
+		}
+		/* The fence owns the detached instance from now on */
+		TxnInst->Flags |= XAIE_TXN_INSTANCE_EXPORTED;
+	}
+
+	pthread_mutex_init(&Fence->Lock, NULL);
+	pthread_cond_init(&Fence->Cond, NULL);
+	Fence->DevInst = DevInst;
+	Fence->TxnInst = TxnInst;
+	Fence->Status = XAIE_OK;
+	Fence->RefCount = 2U;
+	Fence->FreeTxn = FreeTxn;
+
+	pthread_mutex_lock(&Queue->Lock);
+	while(Queue->NumFences == XAIE_TXN_QUEUE_DEPTH) {
+		pthread_cond_wait(&Queue->NotFull, &Queue->Lock);
+	}
+	Queue->Fences[(Queue->Head + Queue->NumFences) %
+		XAIE_TXN_QUEUE_DEPTH] = Fence;
+	Queue->NumFences++;
+	pthread_cond_signal(&Queue->NotEmpty);
+	pthread_mutex_unlock(&Queue->Lock);
+
+	return Fence;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API blocks until a fence is signaled.
+*
+* @param	Fence: Pointer to the fence.
+*
+* @return	Result of the submission of the transaction.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_TxnFenceWait(XAie_TxnFence *Fence)
+{
+	AieRC RC;
+
+	pthread_mutex_lock(&Fence->Lock);
+	while(Fence->Signaled == 0U) {
+		pthread_cond_wait(&Fence->Cond, &Fence->Lock);
+	}
+	RC = Fence->Status;
+	pthread_mutex_unlock(&Fence->Lock);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API checks if a fence is signaled without blocking.
+*
+* @param	Fence: Pointer to the fence.
+* @param	Status: Pointer to return the result of the submission, valid
+*		only if the fence is signaled.
+*
+* @return	1 if the fence is signaled, 0 otherwise.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+u8 _XAie_TxnFencePoll(XAie_TxnFence *Fence, AieRC *Status)
+{
+	u8 Signaled;
+
+	pthread_mutex_lock(&Fence->Lock);
+	Signaled = Fence->Signaled;
+	*Status = Fence->Status;
+	pthread_mutex_unlock(&Fence->Lock);
+
+	return Signaled;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API sets the callback of a fence. If the fence is already signaled, the
+* callback is called right away from the calling thread.
+*
+* @param	Fence: Pointer to the fence.
+* @param	Cb: Callback.
+* @param	Arg: Argument passed to the callback.
+*
+* @return	XAIE_OK on success, XAIE_ERR if a callback is already set.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_TxnFenceSetCallback(XAie_TxnFence *Fence, XAie_TxnFenceCb Cb,
+		void *Arg)
+{
+	u8 Signaled;
+	AieRC RC;
+
+	pthread_mutex_lock(&Fence->Lock);
+	if(Fence->Cb != NULL) {
+		pthread_mutex_unlock(&Fence->Lock);
+		XAIE_ERROR("Fence callback is already set\n");
+		return XAIE_ERR;
+	}
+
+	/* Kept once called too, so that a second callback is rejected */
+	Signaled = Fence->Signaled;
+	RC = Fence->Status;
+	Fence->Cb = Cb;
+	Fence->CbArg = Arg;
+	pthread_mutex_unlock(&Fence->Lock);
+
+	if(Signaled != 0U) {
+		Cb(Fence, RC, Arg);
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API releases the reference of the caller to a fence. The fence does not
+* need to be signaled, the submission completes regardless.
+*
+* @param	Fence: Pointer to the fence.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_TxnFenceFree(XAie_TxnFence *Fence)
+{
+	_XAie_TxnFencePut(Fence);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API applies all the queued transactions, stops the submission worker
+* of the device instance and releases the submission queue.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_TxnAsyncCleanup(XAie_DevInst *DevInst)
+{
+	if(DevInst->TxnQueue == NULL) {
+		return;
+	}
+
+	_XAie_TxnQueueDestroy(DevInst->TxnQueue);
+	DevInst->TxnQueue = NULL;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API checks whether the submission queue of the device instance has
+* applied all the transactions queued so far.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_ENABLE if no transaction is queued or being applied,
+*		XAIE_DISABLE otherwise.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+u8 _XAie_TxnAsyncIsIdle(XAie_DevInst *DevInst)
+{
+	XAie_TxnQueue *Queue;
+	u8 IsIdle;
+
+	Queue = __atomic_load_n(&DevInst->TxnQueue, __ATOMIC_ACQUIRE);
+	if(Queue == NULL) {
+		return XAIE_ENABLE;
+	}
+
+	pthread_mutex_lock(&Queue->Lock);
+	IsIdle = ((Queue->NumFences == 0U) && (Queue->Busy == 0U)) ?
+		XAIE_ENABLE : XAIE_DISABLE;
+	pthread_mutex_unlock(&Queue->Lock);
+
+	return IsIdle;
+}
+
+#else
+
+XAie_TxnFence *_XAie_TxnSubmitAsync(XAie_DevInst *DevInst,
+		XAie_TxnInst *TxnInst)
+{
+	(void)DevInst;
+	(void)TxnInst;
+
+	XAIE_ERROR("Asynchronous transaction submission is not supported\n");
+	return NULL;
+}
+
+AieRC _XAie_TxnFenceWait(XAie_TxnFence *Fence)
+{
+	(void)Fence;
+
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+u8 _XAie_TxnFencePoll(XAie_TxnFence *Fence, AieRC *Status)
+{
+	(void)Fence;
+
+	*Status = XAIE_FEATURE_NOT_SUPPORTED;
+	return 1U;
+}
+
+AieRC _XAie_TxnFenceSetCallback(XAie_TxnFence *Fence, XAie_TxnFenceCb Cb,
+		void *Arg)
+{
+	(void)Fence;
+	(void)Cb;
+	(void)Arg;
+
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+void _XAie_TxnFenceFree(XAie_TxnFence *Fence)
+{
+	(void)Fence;
+}
+
+void _XAie_TxnAsyncCleanup(XAie_DevInst *DevInst)
+{
+	(void)DevInst;
+}
+
+u8 _XAie_TxnAsyncIsIdle(XAie_DevInst *DevInst)
+{
+	(void)DevInst;
+
+	return XAIE_ENABLE;
+}
+
+#endif /* __linux__ */
+
+/** @} */
@@ -0,0 +1,330 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_txn_opt.c
+* @{
+*
+* This file contains the peephole optimizer for the transaction command buffer.
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdlib.h>
+
+#include "xaie_helper.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_TXN_OPT_CMD_DEAD		0xFFFFFFFFU
+#define XAIE_TXN_OPT_MIN_BLOCK		2U
+
+/**************************** Type Definitions *******************************/
+/*
+ * Entry of the map from register offset to the index of the last write
+ * command to the register. Entries written before the last barrier command
+ * are stale and treated as empty.
+ */
+typedef struct {
+	u64 RegOff;
+	u32 CmdIdx;
+	u32 Epoch;
+} XAie_TxnOptEntry;
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This API looks up the entry of a register offset in the optimizer map. If the
+* register is not in the map, the empty entry the register hashes to is
+* returned.
+*
+* @param	Map: Pointer to the optimizer map
+* @param	MapMask: Number of map entries minus 1
+* @param	RegOff: Register offset
+* @param	Epoch: Current epoch
+*
+* @return	Pointer to the map entry.
+*
+* @note		Internal only. The map is at least twice as large as the
+*		number of commands, so an empty entry is always found.
+*
+******************************************************************************/
+static XAie_TxnOptEntry *_XAie_TxnOptLookup(XAie_TxnOptEntry *Map,
+		u32 MapMask, u64 RegOff, u32 Epoch)
+{
+	u32 Index = (u32)(((RegOff >> 2U) * 0x9E3779B97F4A7C15ULL) >> 32) &
+		MapMask;
+
+	while(Map[Index].Epoch == Epoch) {
+		if(Map[Index].RegOff == RegOff) {
+			break;
+		}
+		Index = (Index + 1U) & MapMask;
+	}
+
+	return &Map[Index];
+}
+
+/*****************************************************************************/
+/**
+*
+* This API drops the register writes overwritten by a later write to the same
+* register and folds consecutive mask writes to the same register into the
+* last one of them. Commands other than register writes are barriers, no write
+* is moved across them.
+*
+* @param	TxnInst: Pointer to the transaction instance
+* @param	Pinned: Bitmap of the commands with patch points, or NULL.
+*
+* @return	Number of commands marked dead.
+*
+* @note		Internal only. Dead commands get their Size set to
+*		XAIE_TXN_OPT_CMD_DEAD and are removed by the caller. Commands
+*		with patch points are never dropped.
+*
+******************************************************************************/
+static u32 _XAie_TxnOptFoldWrites(XAie_TxnInst *TxnInst, const u32 *Pinned)
+{
+	XAie_TxnOptEntry *Map;
+	u32 MapSize = 1U, Epoch = 1U, NumDead = 0U;
+
+	while(MapSize < TxnInst->NumCmds * 2U) {
+		MapSize <<= 1U;
+	}
+
+	Map = (XAie_TxnOptEntry *)calloc(MapSize, sizeof(*Map));
+	if(Map == NULL) {
+		XAIE_DBG("Failed to allocate optimizer map, skipping fold\n");
+		return 0U;
+	}
+
+	for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
+		XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i];
+		XAie_TxnOptEntry *Entry;
+		XAie_TxnCmd *Prev;
+
+		if(Cmd->Opcode != XAIE_IO_WRITE) {
+			Epoch++;
+			continue;
+		}
+
+		Entry = _XAie_TxnOptLookup(Map, MapSize - 1U, Cmd->RegOff,
+				Epoch);
+		if((Entry->Epoch == Epoch) && ((Pinned == NULL) ||
+					!CheckBit(Pinned, Entry->CmdIdx))) {
+			Prev = &TxnInst->CmdBuf[Entry->CmdIdx];
+			if(Cmd->Mask != 0U) {
+				/* Merge the previous write under the mask */
+				Cmd->Value |= Prev->Value & ~Cmd->Mask;
+				Cmd->Mask = (Prev->Mask == 0U) ? 0U :
+					(Prev->Mask | Cmd->Mask);
+			}
+			Prev->Size = XAIE_TXN_OPT_CMD_DEAD;
+			NumDead++;
+		}
+
+		Entry->RegOff = Cmd->RegOff;
+		Entry->CmdIdx = i;
+		Entry->Epoch = Epoch;
+	}
+
+	free(Map);
+
+	return NumDead;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API merges runs of full register writes to contiguous addresses into
+* block write commands. The payload of the merged commands is allocated from
+* the payload arena of the transaction instance.
+*
+* @param	TxnInst: Pointer to the transaction instance
+*
+* @return	Number of commands merged away.
+*
+* @note		Internal only. Merged commands get their Size set to
+*		XAIE_TXN_OPT_CMD_DEAD and are removed by the caller. Patch
+*		points of merged commands are moved to the block write.
+*
+******************************************************************************/
+static u32 _XAie_TxnOptMergeWrites(XAie_TxnInst *TxnInst)
+{
+	u32 NumMerged = 0U;
+
+	for(u32 i = 0U; i < TxnInst->NumCmds;) {
+		XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i];
+		u32 *Payload;
+		u32 Len = 1U;
+
+		if((Cmd->Opcode != XAIE_IO_WRITE) || (Cmd->Mask != 0U) ||
+				(Cmd->Size == XAIE_TXN_OPT_CMD_DEAD)) {
+			i++;
+			continue;
+		}
+
+		while(i + Len < TxnInst->NumCmds) {
+			XAie_TxnCmd *Next = &TxnInst->CmdBuf[i + Len];
+
+			if((Next->Opcode != XAIE_IO_WRITE) ||
+					(Next->Mask != 0U) ||
+					(Next->Size == XAIE_TXN_OPT_CMD_DEAD) ||
+					(Next->RegOff != Cmd->RegOff + Len * 4U)) {
+				break;
+			}
+			Len++;
+		}
+
+		if(Len < XAIE_TXN_OPT_MIN_BLOCK) {
+			i += Len;
+			continue;
+		}
+
+		Payload = (u32 *)_XAie_TxnAllocPayload(TxnInst,
+				sizeof(u32) * Len);
+		if(Payload == NULL) {
+			XAIE_DBG("Failed to allocate payload, skipping merge\n");
+			return NumMerged;
+		}
+
+		for(u32 j = 0U; j < Len; j++) {
+			Payload[j] = TxnInst->CmdBuf[i + j].Value;
+			if(j != 0U) {
+				TxnInst->CmdBuf[i + j].Size =
+					XAIE_TXN_OPT_CMD_DEAD;
+			}
+		}
+
+		if(TxnInst->Relocs != NULL) {
+			XAie_TxnRelocTbl *Tbl = TxnInst->Relocs;
+
+			for(u32 r = 0U; r < Tbl->NumRelocs; r++) {
+				if((Tbl->Relocs[r].CmdIdx >= i) &&
+					(Tbl->Relocs[r].CmdIdx < i + Len)) {
+					Tbl->Relocs[r].WordIdx =
+						Tbl->Relocs[r].CmdIdx - i;
+					Tbl->Relocs[r].CmdIdx = i;
+				}
+			}
+		}
+
+		Cmd->Opcode = XAIE_IO_BLOCKWRITE;
+		Cmd->DataPtr = (u64)(uintptr_t)Payload;
+		Cmd->Size = Len;
+		NumMerged += Len - 1U;
+		i += Len;
+	}
+
+	return NumMerged;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API removes the commands marked dead from the command buffer while
+* keeping the order of the remaining commands, and updates the command
+* indices of the patch points.
+*
+* @param	TxnInst: Pointer to the transaction instance
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static void _XAie_TxnOptCompact(XAie_TxnInst *TxnInst)
+{
+	XAie_TxnRelocTbl *Tbl = TxnInst->Relocs;
+	u32 NumCmds = 0U;
+
+	for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
+		if((TxnInst->CmdBuf[i].Opcode == XAIE_IO_WRITE) &&
+			(TxnInst->CmdBuf[i].Size == XAIE_TXN_OPT_CMD_DEAD)) {
+			continue;
+		}
+
+		if(NumCmds != i) {
+			TxnInst->CmdBuf[NumCmds] = TxnInst->CmdBuf[i];
+			for(u32 r = 0U; (Tbl != NULL) && (r < Tbl->NumRelocs);
+					r++) {
+				if(Tbl->Relocs[r].CmdIdx == i) {
+					Tbl->Relocs[r].CmdIdx = NumCmds;
+				}
+			}
+		}
+		NumCmds++;
+	}
+
+	TxnInst->NumCmds = NumCmds;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API runs the peephole optimizer on the command buffer of a transaction
+* instance. The optimizer drops register writes which are overwritten by a
+* later write to the same register, folds mask writes to the same register and
+* merges full register writes to contiguous addresses into block writes.
+*
+* @param	TxnInst: Pointer to the transaction instance
+*
+* @return	None.
+*
+* @note		Internal only. Writes are not moved across block write,
+*		block set, read or poll commands, so the reads and polls observe
+*		the same register values as without optimization. Registers with
+*		side effects on write, such as the DMA queues or the locks,
+*		must not be written more than once in a transaction that is
+*		optimized. Commands with patch points are kept, so they can
+*		still be patched after the optimization.
+*
+******************************************************************************/
+void _XAie_TxnOptimize(XAie_TxnInst *TxnInst)
+{
+	u32 NumCmds = TxnInst->NumCmds;
+	u32 *Pinned = NULL;
+	u32 NumDead;
+
+	if(NumCmds < 2U) {
+		return;
+	}
+
+	if((TxnInst->Relocs != NULL) && (TxnInst->Relocs->NumRelocs != 0U)) {
+		Pinned = (u32 *)calloc((NumCmds + 31U) / 32U, sizeof(u32));
+		if(Pinned == NULL) {
+			XAIE_DBG("Failed to allocate memory, skipping "
+					"optimization\n");
+			return;
+		}
+
+		for(u32 r = 0U; r < TxnInst->Relocs->NumRelocs; r++) {
+			_XAie_SetBitInBitmap(Pinned,
+					TxnInst->Relocs->Relocs[r].CmdIdx, 1U);
+		}
+	}
+
+	/* Write commands do not use the size field, it flags dead commands */
+	for(u32 i = 0U; i < NumCmds; i++) {
+		if(TxnInst->CmdBuf[i].Opcode == XAIE_IO_WRITE) {
+			TxnInst->CmdBuf[i].Size = 0U;
+		}
+	}
+
+	NumDead = _XAie_TxnOptFoldWrites(TxnInst, Pinned);
+	free(Pinned);
+	NumDead += _XAie_TxnOptMergeWrites(TxnInst);
+	if(NumDead == 0U) {
+		return;
+	}
+
+	_XAie_TxnOptCompact(TxnInst);
+
+	XAIE_DBG("Transaction optimizer reduced %d commands to %d\n", NumCmds,
+			TxnInst->NumCmds);
+}
+
+/** @} */
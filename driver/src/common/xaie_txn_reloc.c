@@ -0,0 +1,353 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_txn_reloc.c
+* @{
+*
+* This file contains routines to manage the named patch points of transaction
+* instances. A patch point records a bit field of a word written by the
+* transaction, so the field can be updated in an exported transaction without
+* running the driver APIs that generated it again.
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xaie_helper.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_TXN_DEFAULT_NUM_RELOCS	16U
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This API checks that a patched field lies in the bits written by a command.
+* Masked register writes only write the bits of their mask, a field out of the
+* mask would not reach the register.
+*
+* @param	Cmd: Command writing the patched word.
+* @param	Mask: Mask of the patched field.
+*
+* @return	XAIE_OK if the field can be patched, XAIE_INVALID_ARGS
+*		otherwise.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static AieRC _XAie_TxnCheckRelocMask(const XAie_TxnCmd *Cmd, u32 Mask)
+{
+	if((Cmd->Opcode == XAIE_IO_WRITE) && (Cmd->Mask != 0U) &&
+			((Mask & ~Cmd->Mask) != 0U)) {
+		XAIE_ERROR("Patch mask 0x%x is out of the write mask 0x%x\n",
+				Mask, Cmd->Mask);
+		return XAIE_INVALID_ARGS;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API makes room in the relocation table of a transaction instance for
+* the given number of patch points.
+*
+* @param	TxnInst: Pointer to the transaction instance.
+* @param	NumRelocs: Number of patch points to be added.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only. The table is left untouched on failure.
+*
+******************************************************************************/
+AieRC _XAie_TxnReserveRelocs(XAie_TxnInst *TxnInst, u32 NumRelocs)
+{
+	XAie_TxnRelocTbl *Tbl = TxnInst->Relocs;
+	u64 Needed = (u64)NumRelocs;
+	u64 MaxRelocs = XAIE_TXN_DEFAULT_NUM_RELOCS;
+
+	if(Tbl != NULL) {
+		Needed += Tbl->NumRelocs;
+		if(Needed <= Tbl->MaxRelocs) {
+			return XAIE_OK;
+		}
+		MaxRelocs = (u64)Tbl->MaxRelocs * 2U;
+	}
+
+	while(MaxRelocs < Needed) {
+		MaxRelocs *= 2U;
+	}
+
+	if(MaxRelocs > UINT32_MAX) {
+		XAIE_ERROR("Too many patch points\n");
+		return XAIE_ERR;
+	}
+
+	Tbl = (XAie_TxnRelocTbl *)realloc(Tbl, sizeof(*Tbl) +
+			sizeof(Tbl->Relocs[0]) * MaxRelocs);
+	if(Tbl == NULL) {
+		XAIE_ERROR("Failed to allocate memory for patch points\n");
+		return XAIE_ERR;
+	}
+
+	if(TxnInst->Relocs == NULL) {
+		Tbl->NumRelocs = 0U;
+	}
+	Tbl->MaxRelocs = (u32)MaxRelocs;
+	TxnInst->Relocs = Tbl;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API adds a patch point to the relocation table of a transaction
+* instance.
+*
+* @param	TxnInst: Pointer to the transaction instance.
+* @param	Name: Name of the patch point.
+* @param	CmdIdx: Index of the command writing the patched word.
+* @param	WordIdx: Index of the patched word in the block write payload.
+*		0 for register write commands.
+* @param	Lsb: Least significant bit of the patched field.
+* @param	Mask: Mask of the patched field.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_TxnAddReloc(XAie_TxnInst *TxnInst, const char *Name, u32 CmdIdx,
+		u32 WordIdx, u8 Lsb, u32 Mask)
+{
+	XAie_TxnRelocTbl *Tbl;
+	XAie_TxnReloc *Reloc;
+	AieRC RC;
+
+	if(strlen(Name) >= XAIE_TXN_RELOC_NAME_LEN) {
+		XAIE_ERROR("Patch point name %s is too long\n", Name);
+		return XAIE_INVALID_ARGS;
+	}
+
+	RC = _XAie_TxnReserveRelocs(TxnInst, 1U);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	Tbl = TxnInst->Relocs;
+	Reloc = &Tbl->Relocs[Tbl->NumRelocs];
+	memset(Reloc->Name, 0, sizeof(Reloc->Name));
+	strcpy(Reloc->Name, Name);
+	Reloc->CmdIdx = CmdIdx;
+	Reloc->WordIdx = WordIdx;
+	Reloc->Lsb = Lsb;
+	Reloc->Mask = Mask;
+	Tbl->NumRelocs++;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API records a patch point on the last command of the open transaction
+* of the calling thread which writes the given register.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Name: Name of the patch point.
+* @param	RegOff: Offset of the register.
+* @param	Lsb: Least significant bit of the patched field.
+* @param	Mask: Mask of the patched field.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_TxnAddPatchPoint(XAie_DevInst *DevInst, const char *Name,
+		u64 RegOff, u8 Lsb, u32 Mask)
+{
+	XAie_TxnInst *TxnInst;
+
+	TxnInst = _XAie_GetTxnInst(DevInst, DevInst->Backend->Ops.GetTid());
+	if(TxnInst == NULL) {
+		XAIE_ERROR("No transaction is open in this thread\n");
+		return XAIE_ERR;
+	}
+
+	for(u32 i = TxnInst->NumCmds; i > 0U; i--) {
+		XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i - 1U];
+
+		if((Cmd->Opcode == XAIE_IO_WRITE) && (Cmd->RegOff == RegOff)) {
+			AieRC RC;
+
+			RC = _XAie_TxnCheckRelocMask(Cmd, Mask);
+			if(RC != XAIE_OK) {
+				return RC;
+			}
+
+			return _XAie_TxnAddReloc(TxnInst, Name, i - 1U, 0U,
+					Lsb, Mask);
+		}
+
+		if((Cmd->Opcode == XAIE_IO_BLOCKWRITE) &&
+				(RegOff >= Cmd->RegOff) &&
+				((RegOff - Cmd->RegOff) % sizeof(u32) == 0U) &&
+				((RegOff - Cmd->RegOff) / sizeof(u32) <
+				 Cmd->Size)) {
+			return _XAie_TxnAddReloc(TxnInst, Name, i - 1U,
+					(u32)((RegOff - Cmd->RegOff) /
+						sizeof(u32)), Lsb, Mask);
+		}
+
+		if((Cmd->Opcode == XAIE_IO_BLOCKSET) &&
+				(RegOff >= Cmd->RegOff) &&
+				((RegOff - Cmd->RegOff) / sizeof(u32) <
+				 Cmd->Size)) {
+			break;
+		}
+	}
+
+	XAIE_ERROR("No patchable write to register 0x%lx in transaction\n",
+			RegOff);
+	return XAIE_ERR;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API updates all the patch points of a transaction instance with the
+* given name.
+*
+* @param	TxnInst: Pointer to the transaction instance.
+* @param	Name: Name of the patch points.
+* @param	Value: Value of the patched field. It is shifted to the least
+*		significant bit of the field and masked.
+*
+* @return	XAIE_OK on success, XAIE_INVALID_ARGS if the transaction has no
+*		patch point with the name or if a patched field is out of the
+*		mask of a masked write.
+*
+* @note		Internal only. No patch point is updated on failure.
+*
+******************************************************************************/
+AieRC _XAie_TxnPatch(XAie_TxnInst *TxnInst, const char *Name, u32 Value)
+{
+	XAie_TxnRelocTbl *Tbl = TxnInst->Relocs;
+	u32 NumPatched = 0U;
+
+	if(Tbl == NULL) {
+		XAIE_ERROR("Transaction has no patch point\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	/* Patch points of loaded transactions were not checked when added */
+	for(u32 i = 0U; i < Tbl->NumRelocs; i++) {
+		XAie_TxnReloc *Reloc = &Tbl->Relocs[i];
+		AieRC RC;
+
+		if(strncmp(Reloc->Name, Name, XAIE_TXN_RELOC_NAME_LEN) != 0) {
+			continue;
+		}
+
+		RC = _XAie_TxnCheckRelocMask(&TxnInst->CmdBuf[Reloc->CmdIdx],
+				Reloc->Mask);
+		if(RC != XAIE_OK) {
+			return RC;
+		}
+	}
+
+	for(u32 i = 0U; i < Tbl->NumRelocs; i++) {
+		XAie_TxnReloc *Reloc = &Tbl->Relocs[i];
+		XAie_TxnCmd *Cmd;
+		u32 *Word;
+
+		if(strncmp(Reloc->Name, Name, XAIE_TXN_RELOC_NAME_LEN) != 0) {
+			continue;
+		}
+
+		Cmd = &TxnInst->CmdBuf[Reloc->CmdIdx];
+		if(Cmd->Opcode == XAIE_IO_BLOCKWRITE) {
+			Word = (u32 *)(uintptr_t)Cmd->DataPtr + Reloc->WordIdx;
+		} else {
+			Word = &Cmd->Value;
+		}
+
+		*Word = (*Word & ~Reloc->Mask) |
+			XAie_SetField(Value, Reloc->Lsb, Reloc->Mask);
+		NumPatched++;
+	}
+
+	if(NumPatched == 0U) {
+		XAIE_ERROR("Transaction has no patch point %s\n", Name);
+		return XAIE_INVALID_ARGS;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API copies the relocation table of a transaction instance to another
+* one.
+*
+* @param	Dst: Pointer to the destination transaction instance.
+* @param	Src: Pointer to the source transaction instance.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_TxnCopyRelocs(XAie_TxnInst *Dst, const XAie_TxnInst *Src)
+{
+	const XAie_TxnRelocTbl *Tbl = Src->Relocs;
+	u64 Size;
+
+	Dst->Relocs = NULL;
+	if((Tbl == NULL) || (Tbl->NumRelocs == 0U)) {
+		return XAIE_OK;
+	}
+
+	Size = sizeof(*Tbl) + sizeof(Tbl->Relocs[0]) * Tbl->NumRelocs;
+	Dst->Relocs = (XAie_TxnRelocTbl *)malloc(Size);
+	if(Dst->Relocs == NULL) {
+		XAIE_ERROR("Failed to allocate memory for patch points\n");
+		return XAIE_ERR;
+	}
+
+	memcpy(Dst->Relocs, Tbl, Size);
+	Dst->Relocs->MaxRelocs = Tbl->NumRelocs;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API releases the relocation table of a transaction instance.
+*
+* @param	TxnInst: Pointer to the transaction instance.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_TxnFreeRelocs(XAie_TxnInst *TxnInst)
+{
+	free(TxnInst->Relocs);
+	TxnInst->Relocs = NULL;
+}
+
+/** @} */
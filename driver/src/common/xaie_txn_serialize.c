@@ -0,0 +1,568 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_txn_serialize.c
+* @{
+*
+* This file contains routines to serialize transaction instances to a position
+* independent binary format, and to load them back for submission.
+*
+* The serialized transaction is laid out as below. All fields are in the byte
+* order of the host which serialized the transaction.
+*
+*	+----------------------+ 0
+*	| XAie_TxnFileHdr      |
+*	+----------------------+ CmdOff
+*	| XAie_TxnFileCmd[]    | NumCmds entries
+*	+----------------------+ RelocOff
+*	| XAie_TxnReloc[]      | NumRelocs entries, since version 2
+*	+----------------------+ PayloadOff
+*	| block write payloads | PayloadSize bytes
+*	+----------------------+ TotalSize
+*
+* Block write commands refer to their payload with an offset from PayloadOff,
+* so the serialized transaction can be loaded at any address. Mask poll
+* commands keep their poll site in DataOff. Patch points refer to commands
+* with their index in the command table. The result slots of read commands
+* are not serialized, loaded read commands discard the value.
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "xaie_helper.h"
+
+/************************** Constant Definitions *****************************/
+#define XAIE_TXN_FILE_MAGIC		0x4E585458U /* "XTXN" */
+#define XAIE_TXN_FILE_VERSION		2U
+#define XAIE_TXN_FILE_HDR_SIZE_V1	48U
+#define XAIE_TXN_FILE_FLAGS_MASK	(XAIE_TRANSACTION_ENABLE_AUTO_FLUSH | \
+					 XAIE_TRANSACTION_ENABLE_OPTIMIZE)
+
+/**************************** Type Definitions *******************************/
+/* Header of a serialized transaction */
+typedef struct {
+	u32 Magic;
+	u16 Version;
+	u16 HdrSize;
+	u32 Flags;
+	u32 NumCmds;
+	u64 CmdOff;
+	u64 PayloadOff;
+	u64 PayloadSize;
+	u64 TotalSize;
+	u64 RelocOff;	/* Since version 2 */
+	u32 NumRelocs;	/* Since version 2 */
+	u32 Rsvd;
+} XAie_TxnFileHdr;
+
+/* Command of a serialized transaction */
+typedef struct {
+	u32 Opcode;
+	u32 Mask;
+	u64 RegOff;
+	u32 Value;
+	u32 Size;
+	u64 DataOff;
+} XAie_TxnFileCmd;
+
+/*
+ * Transaction instance loaded from a serialized transaction. The command
+ * buffer is allocated along with the instance, and the block write payloads
+ * stay in the serialized buffer.
+ */
+typedef struct {
+	XAie_TxnInst Inst;
+	void *MapAddr;
+	u64 MapSize;
+	XAie_TxnCmd CmdBuf[];
+} XAie_TxnLoadedInst;
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This API validates a serialized patch point and adds it to a transaction
+* instance being loaded. The payload of a block write command with a patch
+* point is copied to the payload arena of the instance, so that patching it
+* does not write to the serialized transaction.
+*
+* @param	TxnInst: Pointer to the transaction instance being loaded.
+* @param	Reloc: Pointer to the serialized patch point.
+* @param	Payload: Pointer to the payloads of the serialized transaction.
+* @param	PayloadSize: Size of the payloads in bytes.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+static AieRC _XAie_TxnLoadReloc(XAie_TxnInst *TxnInst,
+		const XAie_TxnReloc *Reloc, const u8 *Payload, u64 PayloadSize)
+{
+	XAie_TxnCmd *Cmd;
+
+	if((Reloc->CmdIdx >= TxnInst->NumCmds) || (Reloc->Lsb >= 32U) ||
+			(memchr(Reloc->Name, '\0', sizeof(Reloc->Name)) ==
+			 NULL)) {
+		XAIE_ERROR("Corrupted patch point\n");
+		return XAIE_ERR;
+	}
+
+	Cmd = &TxnInst->CmdBuf[Reloc->CmdIdx];
+	if(Cmd->Opcode == XAIE_IO_BLOCKWRITE) {
+		const u8 *Data = (const u8 *)(uintptr_t)Cmd->DataPtr;
+		void *Copy;
+
+		if(Reloc->WordIdx >= Cmd->Size) {
+			XAIE_ERROR("Corrupted patch point %s\n", Reloc->Name);
+			return XAIE_ERR;
+		}
+
+		/* Payloads of earlier patch points are already copied */
+		if((Data >= Payload) && (Data < Payload + PayloadSize)) {
+			Copy = _XAie_TxnAllocPayload(TxnInst,
+					sizeof(u32) * Cmd->Size);
+			if(Copy == NULL) {
+				return XAIE_ERR;
+			}
+
+			memcpy(Copy, Data, sizeof(u32) * Cmd->Size);
+			Cmd->DataPtr = (u64)(uintptr_t)Copy;
+		}
+	} else if((Cmd->Opcode != XAIE_IO_WRITE) || (Reloc->WordIdx != 0U)) {
+		XAIE_ERROR("Corrupted patch point %s\n", Reloc->Name);
+		return XAIE_ERR;
+	}
+
+	return _XAie_TxnAddReloc(TxnInst, Reloc->Name, Reloc->CmdIdx,
+			Reloc->WordIdx, (u8)Reloc->Lsb, Reloc->Mask);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API serializes a transaction instance to a buffer.
+*
+* @param	TxnInst: Pointer to the transaction instance.
+* @param	Buf: Pointer to the buffer. If NULL, only the size of the
+*		serialized transaction is returned.
+* @param	Size: Pointer to the size of the buffer in bytes. It is
+*		updated with the size of the serialized transaction.
+*
+* @return	XAIE_OK on success, XAIE_INSUFFICIENT_BUFFER_SIZE if the
+*		buffer is too small and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_TxnSerialize(XAie_TxnInst *TxnInst, void *Buf, u64 *Size)
+{
+	XAie_TxnFileHdr Hdr;
+	XAie_TxnFileCmd *FileCmd;
+	u8 *Payload;
+	u64 PayloadOff = 0U;
+	u32 NumRelocs = 0U;
+
+	if(TxnInst->Relocs != NULL) {
+		NumRelocs = TxnInst->Relocs->NumRelocs;
+	}
+
+	Hdr.Magic = XAIE_TXN_FILE_MAGIC;
+	Hdr.Version = XAIE_TXN_FILE_VERSION;
+	Hdr.HdrSize = sizeof(Hdr);
+	Hdr.Flags = TxnInst->Flags & XAIE_TXN_FILE_FLAGS_MASK;
+	Hdr.NumCmds = TxnInst->NumCmds;
+	Hdr.CmdOff = sizeof(Hdr);
+	Hdr.RelocOff = Hdr.CmdOff + sizeof(*FileCmd) * TxnInst->NumCmds;
+	Hdr.NumRelocs = NumRelocs;
+	Hdr.Rsvd = 0U;
+	Hdr.PayloadOff = Hdr.RelocOff + sizeof(XAie_TxnReloc) * NumRelocs;
+	Hdr.PayloadSize = 0U;
+	for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
+		if(TxnInst->CmdBuf[i].Opcode == XAIE_IO_BLOCKWRITE) {
+			Hdr.PayloadSize += sizeof(u32) *
+				TxnInst->CmdBuf[i].Size;
+		}
+	}
+	Hdr.TotalSize = Hdr.PayloadOff + Hdr.PayloadSize;
+
+	if(Buf == NULL) {
+		*Size = Hdr.TotalSize;
+		return XAIE_OK;
+	}
+
+	if(*Size < Hdr.TotalSize) {
+		XAIE_ERROR("Buffer of 0x%lx bytes too small for serialized "
+				"transaction of 0x%lx bytes\n", *Size,
+				Hdr.TotalSize);
+		*Size = Hdr.TotalSize;
+		return XAIE_INSUFFICIENT_BUFFER_SIZE;
+	}
+
+	memcpy(Buf, &Hdr, sizeof(Hdr));
+	if(NumRelocs != 0U) {
+		memcpy((u8 *)Buf + Hdr.RelocOff, TxnInst->Relocs->Relocs,
+				sizeof(XAie_TxnReloc) * NumRelocs);
+	}
+
+	FileCmd = (XAie_TxnFileCmd *)((u8 *)Buf + Hdr.CmdOff);
+	Payload = (u8 *)Buf + Hdr.PayloadOff;
+	for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
+		XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i];
+
+		FileCmd[i].Opcode = (u32)Cmd->Opcode;
+		FileCmd[i].Mask = Cmd->Mask;
+		FileCmd[i].RegOff = Cmd->RegOff;
+		FileCmd[i].Value = Cmd->Value;
+		FileCmd[i].Size = 0U;
+		FileCmd[i].DataOff = 0U;
+
+		switch(Cmd->Opcode) {
+		case XAIE_IO_BLOCKWRITE:
+			FileCmd[i].DataOff = PayloadOff;
+			memcpy(Payload + PayloadOff,
+					(void *)(uintptr_t)Cmd->DataPtr,
+					sizeof(u32) * Cmd->Size);
+			PayloadOff += sizeof(u32) * Cmd->Size;
+			/* Fall through */
+		case XAIE_IO_BLOCKSET:
+			FileCmd[i].Size = Cmd->Size;
+			break;
+		case XAIE_IO_MASKPOLL:
+			FileCmd[i].Size = Cmd->Size;
+			FileCmd[i].DataOff = Cmd->DataPtr;
+			break;
+		default:
+			break;
+		}
+	}
+
+	*Size = Hdr.TotalSize;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API creates a transaction instance from a serialized transaction. The
+* serialized transaction is validated before it is used.
+*
+* @param	Buf: Pointer to the serialized transaction.
+* @param	Size: Size of the buffer in bytes.
+*
+* @return	Pointer to the transaction instance on success, NULL on
+*		failure.
+*
+* @note		Internal only. The block write payloads are not copied, the
+*		buffer must remain valid until the instance is freed. Only the
+*		payloads with patch points are copied, so that patching does
+*		not write to the buffer. The fields added to the header by a
+*		version are only read if the header has this version.
+*
+******************************************************************************/
+XAie_TxnInst* _XAie_TxnDeserialize(const void *Buf, u64 Size)
+{
+	const XAie_TxnFileHdr *Hdr = (const XAie_TxnFileHdr *)Buf;
+	const XAie_TxnFileCmd *FileCmd;
+	const XAie_TxnReloc *Reloc = NULL;
+	const u8 *Payload;
+	XAie_TxnLoadedInst *Loaded;
+	u32 NumRelocs = 0U;
+
+	if((Size < XAIE_TXN_FILE_HDR_SIZE_V1) ||
+			(Hdr->Magic != XAIE_TXN_FILE_MAGIC)) {
+		XAIE_ERROR("Invalid serialized transaction\n");
+		return NULL;
+	}
+
+	if((Hdr->Version == 0U) || (Hdr->Version > XAIE_TXN_FILE_VERSION)) {
+		XAIE_ERROR("Unsupported serialized transaction version %d\n",
+				Hdr->Version);
+		return NULL;
+	}
+
+	if(Hdr->Version >= 2U) {
+		if((Size < sizeof(*Hdr)) || (Hdr->HdrSize < sizeof(*Hdr)) ||
+				(Hdr->RelocOff % sizeof(u32) != 0U) ||
+				(Hdr->RelocOff > Size) ||
+				((Size - Hdr->RelocOff) / sizeof(*Reloc) <
+				 Hdr->NumRelocs)) {
+			XAIE_ERROR("Corrupted serialized transaction header\n");
+			return NULL;
+		}
+		NumRelocs = Hdr->NumRelocs;
+		Reloc = (const XAie_TxnReloc *)((const u8 *)Buf +
+				Hdr->RelocOff);
+	}
+
+	if((Hdr->HdrSize < XAIE_TXN_FILE_HDR_SIZE_V1) ||
+			(Hdr->TotalSize > Size) ||
+			(Hdr->CmdOff % sizeof(u64) != 0U) ||
+			(Hdr->PayloadOff % sizeof(u32) != 0U) ||
+			(Hdr->CmdOff > Hdr->TotalSize) ||
+			((Hdr->TotalSize - Hdr->CmdOff) / sizeof(*FileCmd) <
+			 Hdr->NumCmds) ||
+			(Hdr->PayloadOff > Hdr->TotalSize) ||
+			(Hdr->TotalSize - Hdr->PayloadOff < Hdr->PayloadSize)) {
+		XAIE_ERROR("Corrupted serialized transaction header\n");
+		return NULL;
+	}
+
+	Loaded = (XAie_TxnLoadedInst *)malloc(sizeof(*Loaded) +
+			sizeof(XAie_TxnCmd) * Hdr->NumCmds);
+	if(Loaded == NULL) {
+		XAIE_ERROR("Failed to allocate memory for txn instance\n");
+		return NULL;
+	}
+
+	FileCmd = (const XAie_TxnFileCmd *)((const u8 *)Buf + Hdr->CmdOff);
+	Payload = (const u8 *)Buf + Hdr->PayloadOff;
+	for(u32 i = 0U; i < Hdr->NumCmds; i++) {
+		XAie_TxnCmd *Cmd = &Loaded->CmdBuf[i];
+
+		Cmd->Opcode = (XAie_TxnOpcode)FileCmd[i].Opcode;
+		Cmd->Mask = FileCmd[i].Mask;
+		Cmd->RegOff = FileCmd[i].RegOff;
+		Cmd->Value = FileCmd[i].Value;
+		Cmd->Size = FileCmd[i].Size;
+		Cmd->DataPtr = 0U;
+
+		switch(FileCmd[i].Opcode) {
+		case XAIE_IO_BLOCKWRITE:
+			if((FileCmd[i].DataOff % sizeof(u32) != 0U) ||
+				(FileCmd[i].DataOff > Hdr->PayloadSize) ||
+				((Hdr->PayloadSize - FileCmd[i].DataOff) /
+				 sizeof(u32) < FileCmd[i].Size)) {
+				XAIE_ERROR("Corrupted payload of command %d\n",
+						i);
+				free(Loaded);
+				return NULL;
+			}
+			Cmd->DataPtr = (u64)(uintptr_t)(Payload +
+					FileCmd[i].DataOff);
+			break;
+		case XAIE_IO_MASKPOLL:
+			if(FileCmd[i].DataOff >= XAIE_POLL_MAX) {
+				XAIE_ERROR("Invalid poll site of command %d\n",
+						i);
+				free(Loaded);
+				return NULL;
+			}
+			Cmd->DataPtr = FileCmd[i].DataOff;
+			break;
+		case XAIE_IO_WRITE:
+		case XAIE_IO_BLOCKSET:
+		case XAIE_IO_READ:
+			break;
+		default:
+			XAIE_ERROR("Invalid opcode of command %d\n", i);
+			free(Loaded);
+			return NULL;
+		}
+	}
+
+	Loaded->MapAddr = NULL;
+	Loaded->MapSize = 0U;
+	Loaded->Inst.Tid = 0U;
+	Loaded->Inst.Flags = (Hdr->Flags & XAIE_TXN_FILE_FLAGS_MASK) |
+		XAIE_TXN_INSTANCE_EXPORTED | XAIE_TXN_INSTANCE_LOADED;
+	Loaded->Inst.NumCmds = Hdr->NumCmds;
+	Loaded->Inst.MaxCmds = Hdr->NumCmds;
+	Loaded->Inst.CmdBuf = Loaded->CmdBuf;
+	Loaded->Inst.Payload = NULL;
+	Loaded->Inst.Relocs = NULL;
+
+	for(u32 i = 0U; i < NumRelocs; i++) {
+		if(_XAie_TxnLoadReloc(&Loaded->Inst, &Reloc[i], Payload,
+					Hdr->PayloadSize) != XAIE_OK) {
+			_XAie_TxnFreeLoaded(&Loaded->Inst);
+			return NULL;
+		}
+	}
+
+	return &Loaded->Inst;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API releases a transaction instance created from a serialized
+* transaction, and unmaps the serialized transaction if it was loaded from a
+* file.
+*
+* @param	TxnInst: Pointer to the transaction instance.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+void _XAie_TxnFreeLoaded(XAie_TxnInst *TxnInst)
+{
+	XAie_TxnLoadedInst *Loaded = XAIE_CONTAINER_OF(TxnInst,
+			XAie_TxnLoadedInst, Inst);
+
+#ifdef __linux__
+	if(Loaded->MapAddr != NULL) {
+		munmap(Loaded->MapAddr, Loaded->MapSize);
+	}
+#endif
+
+	_XAie_TxnFreePayload(TxnInst);
+	_XAie_TxnFreeRelocs(TxnInst);
+	free(Loaded);
+}
+
+#ifdef __linux__
+/*****************************************************************************/
+/**
+*
+* This API saves a serialized transaction instance to a file.
+*
+* @param	TxnInst: Pointer to the transaction instance.
+* @param	FileName: Path of the file.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+AieRC _XAie_TxnSave(XAie_TxnInst *TxnInst, const char *FileName)
+{
+	AieRC RC;
+	FILE *Fd;
+	void *Buf;
+	u64 Size;
+
+	RC = _XAie_TxnSerialize(TxnInst, NULL, &Size);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	Buf = malloc(Size);
+	if(Buf == NULL) {
+		XAIE_ERROR("Failed to allocate memory to serialize txn\n");
+		return XAIE_ERR;
+	}
+
+	RC = _XAie_TxnSerialize(TxnInst, Buf, &Size);
+	if(RC != XAIE_OK) {
+		free(Buf);
+		return RC;
+	}
+
+	Fd = fopen(FileName, "wb");
+	if(Fd == NULL) {
+		XAIE_ERROR("Failed to open %s\n", FileName);
+		free(Buf);
+		return XAIE_ERR;
+	}
+
+	if(fwrite(Buf, 1U, Size, Fd) != Size) {
+		XAIE_ERROR("Failed to write transaction to %s\n", FileName);
+		RC = XAIE_ERR;
+	}
+
+	if(fclose(Fd) != 0) {
+		XAIE_ERROR("Failed to close %s\n", FileName);
+		RC = XAIE_ERR;
+	}
+
+	free(Buf);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API loads a serialized transaction from a file. The file is mapped to
+* memory and the block write payloads are used from the mapping.
+*
+* @param	FileName: Path of the file.
+*
+* @return	Pointer to the transaction instance on success, NULL on
+*		failure.
+*
+* @note		Internal only.
+*
+******************************************************************************/
+XAie_TxnInst* _XAie_TxnLoad(const char *FileName)
+{
+	XAie_TxnLoadedInst *Loaded;
+	XAie_TxnInst *TxnInst;
+	struct stat Stat;
+	void *MapAddr;
+	int Fd;
+
+	Fd = open(FileName, O_RDONLY);
+	if(Fd < 0) {
+		XAIE_ERROR("Failed to open %s\n", FileName);
+		return NULL;
+	}
+
+	if((fstat(Fd, &Stat) != 0) || (Stat.st_size == 0)) {
+		XAIE_ERROR("Failed to get size of %s\n", FileName);
+		close(Fd);
+		return NULL;
+	}
+
+	MapAddr = mmap(NULL, (size_t)Stat.st_size, PROT_READ, MAP_PRIVATE, Fd,
+			0);
+	close(Fd);
+	if(MapAddr == MAP_FAILED) {
+		XAIE_ERROR("Failed to map %s\n", FileName);
+		return NULL;
+	}
+
+	TxnInst = _XAie_TxnDeserialize(MapAddr, (u64)Stat.st_size);
+	if(TxnInst == NULL) {
+		munmap(MapAddr, (size_t)Stat.st_size);
+		return NULL;
+	}
+
+	Loaded = XAIE_CONTAINER_OF(TxnInst, XAie_TxnLoadedInst, Inst);
+	Loaded->MapAddr = MapAddr;
+	Loaded->MapSize = (u64)Stat.st_size;
+
+	return TxnInst;
+}
+
+#else
+
+AieRC _XAie_TxnSave(XAie_TxnInst *TxnInst, const char *FileName)
+{
+	(void)TxnInst;
+	(void)FileName;
+
+	XAIE_ERROR("Saving transactions to file is not supported\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+XAie_TxnInst* _XAie_TxnLoad(const char *FileName)
+{
+	(void)FileName;
+
+	XAIE_ERROR("Loading transactions from file is not supported\n");
+	return NULL;
+}
+
+#endif /* __linux__ */
+
+/** @} */
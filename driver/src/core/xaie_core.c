@@ -87,8 +87,8 @@ static AieRC _XAie_CoreWaitStatus(XAie_DevInst *DevInst, XAie_LocType Loc,
 	RegAddr = CoreMod->CoreSts->RegOff +
 		_XAie_GetTileAddr(DevInst, Loc.Row, Loc.Col);
 
-	if(XAie_MaskPoll(DevInst, RegAddr, Mask, Value, TimeOut) !=
-			XAIE_OK) {
+	if(_XAie_MaskPollSite(DevInst, RegAddr, Mask, Value, TimeOut,
+				XAIE_POLL_CORE) != XAIE_OK) {
 		XAIE_DBG("Status poll time out\n");
 		return XAIE_CORE_STATUS_TIMEOUT;
 	}
@@ -133,6 +133,11 @@ AieRC XAie_CoreDisable(XAie_DevInst *DevInst, XAie_LocType Loc)
 
 	CoreMod = DevInst->DevProp.DevMod[TileType].CoreMod;
 
+	/* The core may have written the memories since they were loaded */
+	if(DevInst->MemShadow != NULL) {
+		_XAie_MemShadowInvalidateReach(DevInst, Loc);
+	}
+
 	Mask = CoreMod->CoreCtrl->CtrlEn.Mask;
 	Value = 0U << CoreMod->CoreCtrl->CtrlEn.Lsb;
 	RegAddr = CoreMod->CoreCtrl->RegOff +
@@ -175,6 +180,11 @@ AieRC XAie_CoreEnable(XAie_DevInst *DevInst, XAie_LocType Loc)
 
 	CoreMod = DevInst->DevProp.DevMod[XAIEGBL_TILE_TYPE_AIETILE].CoreMod;
 
+	/* The core writes the memories it can reach from now on */
+	if(DevInst->MemShadow != NULL) {
+		_XAie_MemShadowInvalidateReach(DevInst, Loc);
+	}
+
 	return CoreMod->Enable(DevInst, Loc, CoreMod);
 }
 
@@ -136,8 +136,8 @@ AieRC _XAie_CoreWaitForDone(XAie_DevInst *DevInst, XAie_LocType Loc,
 	EventRegAddr = CoreMod->CoreEvent->EnableEventOff +
 		_XAie_GetTileAddr(DevInst, Loc.Row, Loc.Col);
 
-	if(XAie_MaskPoll(DevInst, EventRegAddr, Mask, Value, TimeOut) !=
-			XAIE_OK) {
+	if(_XAie_MaskPollSite(DevInst, EventRegAddr, Mask, Value, TimeOut,
+				XAIE_POLL_CORE) != XAIE_OK) {
 		XAIE_DBG("Status poll time out\n");
 		return XAIE_CORE_STATUS_TIMEOUT;
 	}
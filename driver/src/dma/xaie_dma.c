@@ -1091,6 +1091,11 @@ AieRC XAie_DmaChannelPushBdToQueue(XAie_DevInst *DevInst, XAie_LocType Loc,
 		DmaMod->ChCtrlBase + ChNum * DmaMod->ChIdxOffset +
 		Dir * DmaMod->ChIdxOffset * DmaMod->NumChannels;
 
+	/* A S2MM channel writes the memories it can reach once started */
+	if((DevInst->MemShadow != NULL) && (Dir == DMA_S2MM)) {
+		_XAie_MemShadowInvalidateReach(DevInst, Loc);
+	}
+
 	return XAie_Write32(DevInst, Addr + (DmaMod->ChProp->StartBd.Idx * 4U),
 			BdNum);
 }
@@ -1145,6 +1150,14 @@ static AieRC _XAie_DmaChannelControl(XAie_DevInst *DevInst, XAie_LocType Loc,
 		DmaMod->ChCtrlBase + ChNum * DmaMod->ChIdxOffset +
 		Dir * DmaMod->ChIdxOffset * DmaMod->NumChannels;
 
+	/*
+	 * A S2MM channel writes the memories it can reach while enabled,
+	 * forget them when it starts and when it stops.
+	 */
+	if((DevInst->MemShadow != NULL) && (Dir == DMA_S2MM)) {
+		_XAie_MemShadowInvalidateReach(DevInst, Loc);
+	}
+
 	return XAie_MaskWrite32(DevInst,
 			Addr + (DmaMod->ChProp->Enable.Idx * 4U),
 			DmaMod->ChProp->Enable.Mask, Enable);
@@ -1463,6 +1476,11 @@ AieRC XAie_DmaChannelSetStartQueueGeneric(XAie_DevInst *DevInst,
 			DmaMod->ChProp->EnToken.Lsb,
 			DmaMod->ChProp->EnToken.Mask);
 
+	/* A S2MM channel writes the memories it can reach once started */
+	if((DevInst->MemShadow != NULL) && (Dir == DMA_S2MM)) {
+		_XAie_MemShadowInvalidateReach(DevInst, Loc);
+	}
+
 	return XAie_Write32(DevInst, Addr, Val);
 }
 
@@ -559,8 +559,8 @@ AieRC _XAie_DmaWaitForDone(XAie_DevInst *DevInst, XAie_LocType Loc,
 	Value = XAIE_DMA_STATUS_IDLE <<
 		DmaMod->ChProp->DmaChStatus[ChNum].AieDmaChStatus.Status.Lsb;
 
-	if(XAie_MaskPoll(DevInst, Addr, Mask, Value, TimeOutUs) !=
-			XAIE_OK) {
+	if(_XAie_MaskPollSite(DevInst, Addr, Mask, Value, TimeOutUs,
+				XAIE_POLL_DMA) != XAIE_OK) {
 		XAIE_DBG("Wait for done timed out\n");
 		return XAIE_ERR;
 	}
@@ -749,8 +749,8 @@ AieRC _XAieMl_DmaWaitForDone(XAie_DevInst *DevInst, XAie_LocType Loc,
 	Value = XAIEML_DMA_STATUS_IDLE <<
 		DmaMod->ChProp->DmaChStatus->AieMlDmaChStatus.Status.Lsb;
 
-	if(XAie_MaskPoll(DevInst, Addr, Mask, Value, TimeOutUs) !=
-			XAIE_OK) {
+	if(_XAie_MaskPollSite(DevInst, Addr, Mask, Value, TimeOutUs,
+				XAIE_POLL_DMA) != XAIE_OK) {
 		XAIE_DBG("Wait for done timed out\n");
 		return XAIE_ERR;
 	}
@@ -45,6 +45,9 @@
 
 /**************************** Macro Definitions ******************************/
 #define XAIE_ECC_BROADCAST_ID		6U
+#define XAIE_POLL_DEFAULT_SPIN_COUNT	8U
+#define XAIE_POLL_DEFAULT_MIN_SLEEP_US	1U
+#define XAIE_POLL_DEFAULT_MAX_SLEEP_US	200U
 
 /************************** Variable Definitions *****************************/
 extern XAie_TileMod AieMod[XAIEGBL_TILE_TYPE_MAX];
@@ -179,6 +182,20 @@ AieRC XAie_CfgInitialize(XAie_DevInst *InstPtr, XAie_Config *ConfigPtr)
 	InstPtr->AieTileNumRows = ConfigPtr->AieTileNumRows;
 	InstPtr->EccStatus = XAIE_ENABLE;
 	InstPtr->TxnList.Next = NULL;
+	InstPtr->NumTxns = 0U;
+	InstPtr->TxnSlots = NULL;
+	InstPtr->TxnListLock = 0U;
+	InstPtr->TxnQueue = NULL;
+	InstPtr->Shadow = NULL;
+	InstPtr->MemShadow = NULL;
+	for(u8 Site = 0U; Site < XAIE_POLL_MAX; Site++) {
+		InstPtr->PollPolicy[Site].SpinCount =
+			XAIE_POLL_DEFAULT_SPIN_COUNT;
+		InstPtr->PollPolicy[Site].MinSleepUs =
+			XAIE_POLL_DEFAULT_MIN_SLEEP_US;
+		InstPtr->PollPolicy[Site].MaxSleepUs =
+			XAIE_POLL_DEFAULT_MAX_SLEEP_US;
+	}
 
 	RC = _XAie_RscMgrInit(InstPtr);
 	if(RC != XAIE_OK) {
@@ -332,6 +349,8 @@ AieRC XAie_Finish(XAie_DevInst *DevInst)
 
 	/* Free transaction mode resources, if any */
 	_XAie_TxnResourceCleanup(DevInst);
+	_XAie_ShadowDisable(DevInst);
+	_XAie_MemShadowDisable(DevInst);
 
 	CurrBackend = DevInst->Backend;
 	RC = CurrBackend->Ops.Finish(DevInst->IOInst);
@@ -743,17 +762,28 @@ AieRC XAie_TurnEccOn(XAie_DevInst *DevInst)
 * @param	DevInst - Device instance pointer.
 * @param	Flags - Flags passed by the user.
 *			XAIE_TRANSACTION_ENABLE/DISBALE_AUTO_FLUSH
+*			XAIE_TRANSACTION_ENABLE_OPTIMIZE
 *
 * @return	XAIE_OK on success and error code on failure.
 *
 * @note		If the ENABLE_AUTO_FLUSH flag is set, the driver will
 *		automatically flush the transaction buffer when an API results
 *		in Read/MaskPoll/BlockWrite/BlockSet/CmdWrite/RunOp operation.
-*		If the DISABLE_AUTO_FLUSH flag is set, the driver will return an
-*		error when an API results in Read/MaskPoll/CmdWrite/RunOp
-*		operation. In both cases, the user has to call
+*		If the DISABLE_AUTO_FLUSH flag is set, MaskPoll operations are
+*		recorded and executed in order when the transaction is
+*		submitted, a poll timeout fails the submission. The driver will
+*		return an error when an API results in Read/CmdWrite/RunOp
+*		operation while commands are pending. Reads whose value is
+*		only used after the submission can be recorded with
+*		XAie_DeferredRead32. In both cases, the user has to call
 *		XAie_SubmitTransaction API to flush all the pending IO
 *		operations stored in the command buffer.
+*		If the ENABLE_OPTIMIZE flag is set, the command buffer is
+*		optimized before it is flushed: overwritten register writes are
+*		dropped, mask writes to the same register are folded and writes
+*		to contiguous registers are merged into block writes. It must
+*		not be set if a register with side effects on write is written
+*		more than once in the transaction.
 *
 ******************************************************************************/
 AieRC XAie_StartTransaction(XAie_DevInst *DevInst, u32 Flags)
@@ -764,7 +794,39 @@ AieRC XAie_StartTransaction(XAie_DevInst *DevInst, u32 Flags)
 		return XAIE_INVALID_ARGS;
 	}
 
-	return _XAie_Txn_Start(DevInst, Flags);
+	return _XAie_Txn_Start(DevInst, Flags, 0U, 0U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api starts the execution of the driver in transaction mode, like
+* XAie_StartTransaction, with the buffers of the transaction preallocated for
+* the expected size of the transaction. Large transactions are then recorded
+* without reallocating the command buffer.
+*
+* @param	DevInst - Device instance pointer.
+* @param	Flags - Flags passed by the user, see XAie_StartTransaction.
+* @param	NumCmds - Expected number of commands, 0 if unknown.
+* @param	PayloadSize - Expected size in bytes of the data written with
+*		block writes, 0 if unknown.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		The hints are not limits, the buffers grow if they are
+*		exceeded.
+*
+******************************************************************************/
+AieRC XAie_StartTransactionWithHint(XAie_DevInst *DevInst, u32 Flags,
+		u32 NumCmds, u64 PayloadSize)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_Txn_Start(DevInst, Flags, NumCmds, PayloadSize);
 }
 
 /*****************************************************************************/
@@ -837,7 +899,8 @@ XAie_TxnInst* XAie_ExportTransactionInstance(XAie_DevInst *DevInst)
 *
 * @return	XAIE_OK on success or error code on failure.
 *
-* @note		None.
+* @note		Detached child transactions which are not merged are released
+*		with this api as well.
 *
 ******************************************************************************/
 AieRC XAie_FreeTransactionInstance(XAie_TxnInst *TxnInst)
@@ -853,34 +916,468 @@ AieRC XAie_FreeTransactionInstance(XAie_TxnInst *TxnInst)
 /*****************************************************************************/
 /**
 *
-* This is the API to return if the device generation has checkboarded tiles for
-* broadcast ungating
+* This api creates a child of the transaction started by the calling thread.
+* Children let several threads build parts of one transaction concurrently:
+* each worker thread attaches a child with XAie_AttachTransaction, calls the
+* driver APIs, and detaches it with XAie_DetachTransaction. The parent thread
+* then merges the children with XAie_MergeTransactions, in an order which does
+* not depend on the scheduling of the workers, and submits the parent once.
 *
-* @param	DevInst - Global AIE device instance pointer.
-* @param	IsCheckerBoard - pointer to be set if tile is checkerboarded
-* @return	XAIE_OK on success
+* @param	DevInst - Device instance pointer.
+*
+* @return	Pointer to the child transaction instance on success and NULL
+*		on failure.
+*
+* @note		Children never access the device, operations which cannot be
+*		recorded fail. The backend must return distinct thread ids,
+*		which the Linux, simulation and debug backends do.
+*
+******************************************************************************/
+XAie_TxnInst* XAie_ForkTransaction(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return NULL;
+	}
+
+	return _XAie_TxnFork(DevInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api attaches a child transaction to the calling thread. The IO
+* operations of the thread are recorded to the child until it is detached.
+*
+* @param	DevInst - Device instance pointer.
+* @param	TxnInst - Child transaction instance.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		The thread must not have a transaction open, and a child can
+*		be attached to one thread at a time.
+*
+******************************************************************************/
+AieRC XAie_AttachTransaction(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst)
+{
+	if((DevInst == XAIE_NULL) || (TxnInst == NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_TxnAttach(DevInst, TxnInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api detaches a child transaction from the calling thread.
+*
+* @param	DevInst - Device instance pointer.
+* @param	TxnInst - Child transaction instance attached to the thread.
+*
+* @return	XAIE_OK on success and error code on failure.
 *
 * @note		None.
 *
 ******************************************************************************/
-AieRC XAie_IsDeviceCheckerboard(XAie_DevInst *DevInst, u8 *IsCheckerBoard)
+AieRC XAie_DetachTransaction(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst)
+{
+	if((DevInst == XAIE_NULL) || (TxnInst == NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_TxnDetach(DevInst, TxnInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api appends the commands of detached child transactions to the
+* transaction started by the calling thread, in the order of the array. The
+* children are released and their entries in the array are set to NULL.
+*
+* @param	DevInst - Device instance pointer.
+* @param	TxnInst - Array of detached child transaction instances.
+* @param	NumTxns - Number of entries in the array.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		On failure, no child is merged or released.
+*
+******************************************************************************/
+AieRC XAie_MergeTransactions(XAie_DevInst *DevInst, XAie_TxnInst **TxnInst,
+		u32 NumTxns)
+{
+	if((DevInst == XAIE_NULL) || (TxnInst == NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_TxnMerge(DevInst, TxnInst, NumTxns);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api serializes a transaction instance to a versioned and position
+* independent binary format. The block write payloads are copied to the
+* serialized transaction, so it can be stored and submitted by another process
+* after it is loaded with XAie_DeserializeTransactionInstance or
+* XAie_LoadTransactionInstance.
+*
+* @param	TxnInst - Transaction instance pointer.
+* @param	Buf - Pointer to the buffer, aligned to 8 bytes. If NULL, only
+*		the size required to serialize the transaction is returned.
+* @param	Size - Pointer to the size of the buffer in bytes. It is updated
+*		with the size of the serialized transaction.
+*
+* @return	XAIE_OK on success, XAIE_INSUFFICIENT_BUFFER_SIZE if the buffer
+*		is too small and error code on failure.
+*
+* @note		The serialized transaction is in the byte order of the host.
+*
+******************************************************************************/
+AieRC XAie_SerializeTransactionInstance(XAie_TxnInst *TxnInst, void *Buf,
+		u64 *Size)
+{
+	if((TxnInst == NULL) || (Size == NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if((uintptr_t)Buf % sizeof(u64) != 0U) {
+		XAIE_ERROR("Serialized transaction buffer is not aligned\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_TxnSerialize(TxnInst, Buf, Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api creates a transaction instance from a transaction serialized with
+* XAie_SerializeTransactionInstance. The instance can be submitted with
+* XAie_SubmitTransaction, and it must be released with
+* XAie_FreeTransactionInstance.
+*
+* @param	Buf - Pointer to the serialized transaction, aligned to 8 bytes.
+* @param	Size - Size of the buffer in bytes.
+*
+* @return	Pointer to the transaction instance on success and NULL on
+*		error.
+*
+* @note		The block write payloads are used in place, the buffer must
+*		remain valid until the transaction instance is freed.
+*
+******************************************************************************/
+XAie_TxnInst* XAie_DeserializeTransactionInstance(const void *Buf, u64 Size)
+{
+	if(Buf == NULL) {
+		XAIE_ERROR("Invalid arguments\n");
+		return NULL;
+	}
+
+	if((uintptr_t)Buf % sizeof(u64) != 0U) {
+		XAIE_ERROR("Serialized transaction buffer is not aligned\n");
+		return NULL;
+	}
+
+	return _XAie_TxnDeserialize(Buf, Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api serializes a transaction instance to a file.
+*
+* @param	TxnInst - Transaction instance pointer.
+* @param	FileName - Path of the file.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Supported on Linux only.
+*
+******************************************************************************/
+AieRC XAie_SaveTransactionInstance(XAie_TxnInst *TxnInst,
+		const char *FileName)
+{
+	if((TxnInst == NULL) || (FileName == NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_TxnSave(TxnInst, FileName);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api loads a transaction saved with XAie_SaveTransactionInstance. The
+* file is mapped to memory, only the command buffer is allocated. The instance
+* can be submitted with XAie_SubmitTransaction, and it must be released with
+* XAie_FreeTransactionInstance.
+*
+* @param	FileName - Path of the file.
+*
+* @return	Pointer to the transaction instance on success and NULL on
+*		error.
+*
+* @note		Supported on Linux only.
+*
+******************************************************************************/
+XAie_TxnInst* XAie_LoadTransactionInstance(const char *FileName)
+{
+	if(FileName == NULL) {
+		XAIE_ERROR("Invalid arguments\n");
+		return NULL;
+	}
+
+	return _XAie_TxnLoad(FileName);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api records a named patch point on the transaction started by the
+* calling thread. The patch point refers to a bit field of the last command of
+* the transaction which writes the register, so the field can be updated with
+* XAie_PatchTransactionInstance once the transaction is exported, without
+* running the driver APIs which generated it again.
+*
+* @param	DevInst - Device instance pointer.
+* @param	Name - Name of the patch point. Several patch points can share
+*		a name, they are patched together.
+* @param	RegOff - Offset of the register from the base of the array.
+* @param	Lsb - Least significant bit of the field.
+* @param	Mask - Mask of the field.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Only register writes and block writes recorded in the command
+*		buffer can be patched. The field of a masked register write must
+*		be within the mask of the write. On the Linux backend, the shim
+*		DMA buffer descriptors are written by the kernel and cannot be
+*		patched.
+*
+******************************************************************************/
+AieRC XAie_AddTransactionPatchPoint(XAie_DevInst *DevInst, const char *Name,
+		u64 RegOff, u8 Lsb, u32 Mask)
+{
+	if((DevInst == XAIE_NULL) || (Name == NULL) || (Lsb >= 32U) ||
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_TxnAddPatchPoint(DevInst, Name, RegOff, Lsb, Mask);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api updates the fields of all the patch points of an exported or loaded
+* transaction instance with the given name.
+*
+* @param	TxnInst - Transaction instance pointer.
+* @param	Name - Name of the patch points.
+* @param	Value - Value of the field, it is shifted to the least
+*		significant bit of the field and masked.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_PatchTransactionInstance(XAie_TxnInst *TxnInst, const char *Name,
+		u32 Value)
+{
+	if((TxnInst == NULL) || (Name == NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_TxnPatch(TxnInst, Name, Value);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api queues a transaction for submission by the submission worker of the
+* device instance, and returns without waiting for the transaction to be
+* applied. Queued transactions are applied in submission order. The calling
+* thread can prepare its next transaction while the worker applies the
+* previous ones.
+*
+* @param	DevInst - Device instance pointer.
+* @param	TxnInst - Exported transaction instance pointer. If NULL, the
+*		transaction started by the calling thread is detached from the
+*		thread and submitted, it is released once applied.
+*
+* @return	Pointer to the fence of the submission on success and NULL on
+*		error.
+*
+* @note		The call blocks while the submission queue is full. An
+*		exported instance must not be modified or released until its
+*		fence is signaled. The fence must be released with
+*		XAie_FreeTransactionFence. Transactions submitted synchronously
+*		are not ordered with the queued ones. Supported on Linux only.
+*
+******************************************************************************/
+XAie_TxnFence* XAie_SubmitTransactionAsync(XAie_DevInst *DevInst,
+		XAie_TxnInst *TxnInst)
 {
 	if((DevInst == XAIE_NULL) ||
-		(DevInst->IsReady != XAIE_COMPONENT_IS_READY) ||
-		(IsCheckerBoard == NULL)) {
+			(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return NULL;
+	}
+
+	return _XAie_TxnSubmitAsync(DevInst, TxnInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api blocks until the transaction of a fence is applied.
+*
+* @param	Fence - Fence pointer.
+*
+* @return	Result of the submission of the transaction.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_WaitTransactionFence(XAie_TxnFence *Fence)
+{
+	if(Fence == NULL) {
 		XAIE_ERROR("Invalid arguments\n");
 		return XAIE_INVALID_ARGS;
 	}
 
-	*IsCheckerBoard = DevInst->DevOps->IsCheckerBoard;
+	return _XAie_TxnFenceWait(Fence);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api checks if the transaction of a fence is applied, without blocking.
+*
+* @param	Fence - Fence pointer.
+* @param	IsSignaled - Pointer to return 1 if the transaction is applied
+*		and 0 otherwise.
+* @param	Status - Pointer to return the result of the submission, valid
+*		only if the transaction is applied.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_PollTransactionFence(XAie_TxnFence *Fence, u8 *IsSignaled,
+		AieRC *Status)
+{
+	if((Fence == NULL) || (IsSignaled == NULL) || (Status == NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	*IsSignaled = _XAie_TxnFencePoll(Fence, Status);
 
 	return XAIE_OK;
 }
 
-AieRC XAie_UpdateNpiAddr(XAie_DevInst *DevInst, u64 NpiAddr)
+/*****************************************************************************/
+/**
+*
+* This api sets the callback called with the result of the submission once the
+* transaction of a fence is applied.
+*
+* @param	Fence - Fence pointer.
+* @param	Cb - Callback.
+* @param	Arg - Argument passed to the callback.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		The callback is called from the submission worker, or from
+*		the calling thread if the transaction is already applied. It
+*		must not wait for fences of the same device instance. Only one
+*		callback can be set per fence.
+*
+******************************************************************************/
+AieRC XAie_SetTransactionFenceCallback(XAie_TxnFence *Fence,
+		XAie_TxnFenceCb Cb, void *Arg)
 {
-	if((DevInst == NULL) || (DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
-		XAIE_ERROR("Invalid Device Instance\n");
+	if((Fence == NULL) || (Cb == NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_TxnFenceSetCallback(Fence, Cb, Arg);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api releases a fence returned by XAie_SubmitTransactionAsync. The
+* transaction is applied even if the fence is released before.
+*
+* @param	Fence - Fence pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_FreeTransactionFence(XAie_TxnFence *Fence)
+{
+	if(Fence == NULL) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	_XAie_TxnFenceFree(Fence);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the API to return if the device generation has checkboarded tiles for
+* broadcast ungating
+*
+* @param	DevInst - Global AIE device instance pointer.
+* @param	IsCheckerBoard - pointer to be set if tile is checkerboarded
+* @return	XAIE_OK on success
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_IsDeviceCheckerboard(XAie_DevInst *DevInst, u8 *IsCheckerBoard)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY) ||
+		(IsCheckerBoard == NULL)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	*IsCheckerBoard = DevInst->DevOps->IsCheckerBoard;
+
+	return XAIE_OK;
+}
+
+AieRC XAie_UpdateNpiAddr(XAie_DevInst *DevInst, u64 NpiAddr)
+{
+	if((DevInst == NULL) || (DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
 		return XAIE_INVALID_ARGS;
 	}
 
@@ -888,4 +1385,593 @@ AieRC XAie_UpdateNpiAddr(XAie_DevInst *DevInst, u64 NpiAddr)
 			(void *)&NpiAddr);
 }
 
+/*****************************************************************************/
+/**
+*
+* This api waits until the writes buffered by the IO backend have been applied
+* to the device.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Backends which do not buffer writes return immediately. The CDO
+*		backend buffers writes when the driver is compiled with
+*		XAIE_CDO_COALESCE, the IO must then be flushed before the CDO is
+*		closed. The Linux backend batches register writes when the
+*		driver is compiled with XAIE_LINUX_BATCH, the IO must then be
+*		flushed before waiting on the device by other means than the
+*		driver. When a transaction is started without auto flush, it
+*		must be submitted before the IO is flushed.
+*
+******************************************************************************/
+AieRC XAie_FlushIO(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return XAie_RunOp(DevInst, XAIE_BACKEND_OP_FLUSH, NULL);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api sets the poll policy used by the mask polls of a call site. A poll
+* reads the register SpinCount times back to back, then sleeps between reads
+* starting with MinSleepUs and doubling the sleep up to MaxSleepUs. By default
+* all the sites spin 8 reads and back off from 1 us to 200 us.
+*
+* @param	DevInst - Device instance pointer.
+* @param	Site - Call site of the polls, XAIE_POLL_DEFAULT for the polls
+*		without a specific site.
+* @param	Policy - Poll policy.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Backends which do not poll from the host, like the CDO backend,
+*		ignore the policy. Polls recorded in a transaction keep their
+*		site, and use its policy when the transaction is submitted.
+*
+******************************************************************************/
+AieRC XAie_SetPollPolicy(XAie_DevInst *DevInst, XAie_PollSite Site,
+		const XAie_PollPolicy *Policy)
+{
+	if((DevInst == XAIE_NULL) || (Policy == NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(Site >= XAIE_POLL_MAX) {
+		XAIE_ERROR("Invalid poll site\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if((Policy->MinSleepUs == 0U) ||
+			(Policy->MaxSleepUs < Policy->MinSleepUs)) {
+		XAIE_ERROR("Invalid poll policy sleep range\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	DevInst->PollPolicy[Site] = *Policy;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api enables the register shadow of the device instance. The shadow
+* caches the values written to the registers of the partition. A register
+* write which does not change the cached value is not sent to the device, and
+* a masked write to a cached register is done without reading the register
+* back from the device.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		The shadow is disabled by default. Only plain configuration
+*		registers are cached: stream switch configuration, DMA buffer
+*		descriptors, event, trace and performance counter control, and
+*		timer trigger values. Strobes, status, counters and interrupt
+*		enables are always written to the device. If a cached register
+*		is changed by another agent, the shadow must be invalidated
+*		with XAie_InvalidateShadow before the register is written
+*		again. Register reads are always sent to the device.
+*		The shadow must be enabled and disabled when no other thread
+*		accesses the device instance.
+*
+******************************************************************************/
+AieRC XAie_EnableShadow(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_ShadowEnable(DevInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api disables the register shadow of the device instance and releases
+* its memory.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		The shadow must be enabled and disabled when no other thread
+*		accesses the device instance.
+*
+******************************************************************************/
+AieRC XAie_DisableShadow(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	_XAie_ShadowDisable(DevInst);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api invalidates all the registers cached in the register shadow, so
+* that the next write to each register is sent to the device.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_InvalidateShadow(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(DevInst->Shadow != NULL) {
+		_XAie_ShadowInvalidateAll(DevInst);
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api enables the memory shadow of the device instance. The memory shadow
+* keeps a hash of the content written to each page of the program and data
+* memories of the partition. Block writes, including the ones of
+* XAie_DataMemBlockWrite and of the ELF loader, skip the pages whose content
+* is unchanged since they were last written.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		The memory shadow is disabled by default. The driver does not
+*		see the writes of the cores and of the DMAs. It forgets the
+*		data memories a core can write when the core is enabled or
+*		disabled, and the ones a S2MM DMA channel can write when the
+*		channel is started or disabled. Memories written otherwise,
+*		like by a core started through an event, must be invalidated
+*		with XAie_InvalidateDataMemShadow or XAie_InvalidateMemShadow
+*		before they are loaded again. The memory shadow must be enabled
+*		and disabled when no other thread accesses the device instance.
+*
+******************************************************************************/
+AieRC XAie_EnableMemShadow(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_MemShadowEnable(DevInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api disables the memory shadow of the device instance and releases its
+* memory.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		The memory shadow must be enabled and disabled when no other
+*		thread accesses the device instance.
+*
+******************************************************************************/
+AieRC XAie_DisableMemShadow(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	_XAie_MemShadowDisable(DevInst);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api invalidates all the pages of the memory shadow, so that the next
+* write to each page is sent to the device.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_InvalidateMemShadow(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(DevInst->MemShadow != NULL) {
+		_XAie_MemShadowInvalidateAll(DevInst);
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api invalidates the pages of the data memory of a tile in the memory
+* shadow. It is meant for the tiles whose data memory was written by the core
+* or by the DMAs since it was loaded.
+*
+* @param	DevInst - Device instance pointer.
+* @param	Loc - Location of the AIE tile or memory tile.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		None.
+*
+******************************************************************************/
+AieRC XAie_InvalidateDataMemShadow(XAie_DevInst *DevInst, XAie_LocType Loc)
+{
+	u8 TileType;
+
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	TileType = DevInst->DevOps->GetTTypefromLoc(DevInst, Loc);
+	if((TileType != XAIEGBL_TILE_TYPE_AIETILE) &&
+			(TileType != XAIEGBL_TILE_TYPE_MEMTILE)) {
+		XAIE_ERROR("Invalid tile type\n");
+		return XAIE_INVALID_TILE;
+	}
+
+	if(DevInst->MemShadow != NULL) {
+		_XAie_MemShadowInvalidateDataMem(DevInst, Loc);
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This api starts to record the accesses issued to the IO backend of the device
+* instance. Every register write, masked write, block write, block set, mask
+* poll and backend operation is appended to the file with the time it was
+* issued at, until the recording is stopped.
+*
+* @param	DevInst - Device instance pointer.
+* @param	FileName - Path of the recording.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Supported on Linux only. Reads are not recorded. While the
+*		backend is recorded, its accesses are serialized. The recording
+*		is closed when the device instance is finished. The recording
+*		must be started when no other thread accesses the device
+*		instance, it fails if a transaction is open or queued for
+*		asynchronous submission.
+*
+******************************************************************************/
+AieRC XAie_StartIORecord(XAie_DevInst *DevInst, const char *FileName)
+{
+	if((DevInst == XAIE_NULL) || (FileName == NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_RecordStart(DevInst, FileName);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api stops the recording of the IO backend of the device instance and
+* closes the recording.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Supported on Linux only. The recording must be stopped when no
+*		other thread accesses the device instance, it fails if a
+*		transaction is open or queued for asynchronous submission.
+*
+******************************************************************************/
+AieRC XAie_StopIORecord(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_RecordStop(DevInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api issues the accesses of a recording to the IO backend of the device
+* instance, either back to back or with the recorded timing. The device
+* instance may use another backend than the recorded one, for example to
+* replay a recording of the hardware on the simulator.
+*
+* @param	DevInst - Device instance pointer.
+* @param	FileName - Path of the recording.
+* @param	Mode - Timing of the replay.
+*
+* @return	XAIE_OK on success and error code on failure. XAIE_ERR is also
+*		returned if a mask poll did not have the recorded result.
+*
+* @note		Supported on Linux only. The accesses bypass transactions and
+*		the register shadow of the device instance.
+*
+******************************************************************************/
+AieRC XAie_ReplayIORecord(XAie_DevInst *DevInst, const char *FileName,
+		XAie_ReplayMode Mode)
+{
+	if((DevInst == XAIE_NULL) || (FileName == NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(Mode >= XAIE_REPLAY_MAX) {
+		XAIE_ERROR("Invalid replay mode\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_Replay(DevInst, FileName, Mode);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api configures the output of the debug backend: the format, the file
+* descriptor written to, and the tiles and modules whose accesses are output.
+* In summary mode the accesses are counted per tile and module, and the
+* counts are output when the configuration changes or the backend finishes.
+*
+* @param	DevInst - Device instance pointer.
+* @param	Cfg - Output configuration. NULL restores the default, which is
+*		the text output of all accesses to stdout.
+*
+* @return	XAIE_OK on success and error code on failure.
+*		XAIE_FEATURE_NOT_SUPPORTED for other backends than the debug
+*		backend.
+*
+* @note		The output is buffered. It is written when the buffer is full,
+*		on XAie_FlushIO() and when the backend finishes. NPI accesses
+*		are not filtered.
+*
+******************************************************************************/
+AieRC XAie_ConfigDebugOutput(XAie_DevInst *DevInst,
+		const XAie_DebugOutputCfg *Cfg)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return XAie_RunOp(DevInst, XAIE_BACKEND_OP_CONFIG_DEBUG_OUTPUT,
+			(void *)Cfg);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api starts to count the operations issued to the IO backend of a device
+* instance. The calls, bytes and latencies are counted per operation, tile type
+* and module, whichever the backend is.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Supported on Linux only. Each thread counts in its own
+*		counters, counting does not take a lock. The counting must be
+*		started when no other thread accesses the device instance, it
+*		fails if a transaction is open or queued for asynchronous
+*		submission.
+*
+******************************************************************************/
+AieRC XAie_StartIOStats(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_IOStatsStart(DevInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api stops counting the operations issued to the IO backend of a device
+* instance. The counters are released.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Supported on Linux only. The statistics are also released when
+*		the device instance is finished. The counting must be stopped
+*		when no other thread accesses the device instance, it fails if
+*		a transaction is open or queued for asynchronous submission.
+*
+******************************************************************************/
+AieRC XAie_StopIOStats(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_IOStatsStop(DevInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api takes a snapshot of the IO statistics of a device instance, summed
+* over all the threads.
+*
+* @param	DevInst - Device instance pointer.
+* @param	Stats - Pointer to the snapshot.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Supported on Linux only. The calls in progress in other threads
+*		may be partially counted.
+*
+******************************************************************************/
+AieRC XAie_GetIOStats(XAie_DevInst *DevInst, XAie_IOStats *Stats)
+{
+	if((DevInst == XAIE_NULL) || (Stats == NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_IOStatsGet(DevInst, Stats);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api writes a snapshot of the IO statistics of a device instance to a
+* text file, with one line per operation, tile type and module called.
+*
+* @param	DevInst - Device instance pointer.
+* @param	FileName - Path of the file.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Supported on Linux only.
+*
+******************************************************************************/
+AieRC XAie_DumpIOStats(XAie_DevInst *DevInst, const char *FileName)
+{
+	if((DevInst == XAIE_NULL) || (FileName == NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_IOStatsDump(DevInst, FileName);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api starts to inject latencies and faults in the operations issued to
+* the IO backend of a device instance: a delay per operation, mask polls which
+* time out and transaction submissions which fail. It is meant to test the
+* timeout and error handling without hardware, for example on top of the
+* shadow device backend.
+*
+* @param	DevInst - Device instance pointer.
+* @param	Cfg - Fault injection configuration.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Supported on Linux only. The injected faults are reproducible
+*		for a given seed when the driver is called from one thread.
+*		The injection must be started when no other thread accesses
+*		the device instance, it fails if a transaction is open or
+*		queued for asynchronous submission.
+*
+******************************************************************************/
+AieRC XAie_StartFaultInjection(XAie_DevInst *DevInst,
+		const XAie_FaultCfg *Cfg)
+{
+	if((DevInst == XAIE_NULL) || (Cfg == NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid arguments\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_FaultStart(DevInst, Cfg);
+}
+
+/*****************************************************************************/
+/**
+*
+* This api stops the fault injection of a device instance.
+*
+* @param	DevInst - Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Supported on Linux only. The injection must be stopped when no
+*		other thread accesses the device instance, it fails if a
+*		transaction is open or queued for asynchronous submission.
+*
+******************************************************************************/
+AieRC XAie_StopFaultInjection(XAie_DevInst *DevInst)
+{
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY)) {
+		XAIE_ERROR("Invalid Device Instance\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	return _XAie_FaultStop(DevInst);
+}
+
 /** @} */
@@ -51,6 +51,7 @@
 
 #define XAIE_TRANSACTION_ENABLE_AUTO_FLUSH	0b1U
 #define XAIE_TRANSACTION_DISABLE_AUTO_FLUSH	0b0U
+#define XAIE_TRANSACTION_ENABLE_OPTIMIZE	0b100U
 
 #define XAIE_PART_INIT_OPT_COLUMN_RST		(1U << 0)
 #define XAIE_PART_INIT_OPT_SHIM_RST		(1U << 1)
@@ -62,6 +63,10 @@
 		XAIE_PART_INIT_OPT_BLOCK_NOCAXIMMERR | \
 		XAIE_PART_INIT_OPT_ISOLATE)
 
+#define XAIE_IOSTATS_NUM_BUCKETS	32U
+#define XAIE_IOSTATS_NUM_TILE_TYPES	(XAIEGBL_TILE_TYPE_MAX + 1U)
+#define XAIE_IOSTATS_NUM_MODS		4U
+
 /**************************** Type Definitions *******************************/
 typedef struct XAie_TileMod XAie_TileMod;
 typedef struct XAie_DeviceOps XAie_DeviceOps;
@@ -69,6 +74,13 @@ typedef struct XAie_DmaMod XAie_DmaMod;
 typedef struct XAie_LockMod XAie_LockMod;
 typedef struct XAie_Backend XAie_Backend;
 typedef struct XAie_TxnCmd XAie_TxnCmd;
+typedef struct XAie_TxnSlot XAie_TxnSlot;
+typedef struct XAie_TxnChunk XAie_TxnChunk;
+typedef struct XAie_TxnRelocTbl XAie_TxnRelocTbl;
+typedef struct XAie_TxnQueue XAie_TxnQueue;
+typedef struct XAie_TxnFence XAie_TxnFence;
+typedef struct XAie_Shadow XAie_Shadow;
+typedef struct XAie_MemShadow XAie_MemShadow;
 typedef struct XAie_ResourceManager XAie_ResourceManager;
 
 /*
@@ -92,6 +104,7 @@ typedef enum {
 	XAIE_IO_BACKEND_DEBUG, /* IO debug backend */
 	XAIE_IO_BACKEND_LINUX, /* Linux kernel backend */
 	XAIE_IO_BACKEND_SOCKET, /* Socket backend */
+	XAIE_IO_BACKEND_SHADOWDEV, /* Sparse shadow device backend */
 	XAIE_IO_BACKEND_MAX
 } XAie_BackendType;
 
@@ -111,6 +124,39 @@ typedef struct {
 			 * is closed. */
 } XAie_PartitionProp;
 
+/*
+ * This typedef captures the call sites of mask polls which can be configured
+ * with their own poll policy.
+ */
+typedef enum {
+	XAIE_POLL_DEFAULT, /* Polls without a specific site */
+	XAIE_POLL_DMA,	   /* DMA channel and BD completion waits */
+	XAIE_POLL_CORE,	   /* Core done and event waits */
+	XAIE_POLL_LOCK,	   /* Lock acquire and release waits */
+	XAIE_POLL_MAX
+} XAie_PollSite;
+
+/*
+ * This typedef contains the policy of a mask poll. The register is first read
+ * SpinCount times back to back. Then the poll sleeps between reads, starting
+ * with MinSleepUs and doubling the sleep after each read, up to MaxSleepUs.
+ */
+typedef struct {
+	u32 SpinCount;	/* Number of reads before the first sleep */
+	u32 MinSleepUs;	/* First sleep in micro seconds, at least 1 */
+	u32 MaxSleepUs;	/* Cap of the sleep in micro seconds */
+} XAie_PollPolicy;
+
+/*
+ * This enum contains the timing of the replay of a recording of the IO
+ * backend.
+ */
+typedef enum {
+	XAIE_REPLAY_FAST,  /* Accesses are issued back to back */
+	XAIE_REPLAY_TIMED, /* Accesses are issued with the recorded timing */
+	XAIE_REPLAY_MAX
+} XAie_ReplayMode;
+
 /* Generic linked list structure */
 typedef struct XAie_List {
 	struct XAie_List *Next;
@@ -139,7 +185,14 @@ typedef struct {
 				     setup to AIE prop during intialization*/
 	XAie_DeviceOps *DevOps; /* Device level operations */
 	XAie_PartitionProp PartProp; /* Partition property */
-	XAie_List TxnList; /* Head of the list of txn buffers */
+	XAie_List TxnList; /* Txn buffers which do not fit in TxnSlots */
+	u32 NumTxns;	   /* Number of open txn buffers */
+	XAie_TxnSlot *TxnSlots; /* Txn buffers hashed by thread id */
+	u8 TxnListLock;	   /* Lock of TxnList */
+	XAie_TxnQueue *TxnQueue; /* Asynchronous txn submission queue */
+	XAie_Shadow *Shadow;	/* Register shadow, NULL if disabled */
+	XAie_MemShadow *MemShadow; /* Memory shadow, NULL if disabled */
+	XAie_PollPolicy PollPolicy[XAIE_POLL_MAX]; /* Poll policy per site */
 } XAie_DevInst;
 
 /* typedef to capture transaction buffer data */
@@ -150,6 +203,8 @@ typedef struct {
 	u32 MaxCmds;
 	XAie_TxnCmd *CmdBuf;
 	XAie_List Node;
+	XAie_TxnChunk *Payload; /* Arena holding block write payloads */
+	XAie_TxnRelocTbl *Relocs; /* Named patch points of the commands */
 } XAie_TxnInst;
 
 /* enum to capture cache property of allocate memory */
@@ -191,6 +246,112 @@ typedef struct {
 	u8 Col;
 } XAie_LocType;
 
+/*
+ * This enum contains the output formats of the debug backend.
+ */
+typedef enum {
+	XAIE_DEBUG_OUTPUT_TEXT,	   /* One line per access, the default */
+	XAIE_DEBUG_OUTPUT_CSV,	   /* One comma separated record per access */
+	XAIE_DEBUG_OUTPUT_BINARY,  /* One XAie_DebugOutputRecord per access */
+	XAIE_DEBUG_OUTPUT_SUMMARY, /* Number of accesses per tile and module */
+	XAIE_DEBUG_OUTPUT_MAX
+} XAie_DebugOutputFormat;
+
+/*
+ * This enum contains the accesses in the output of the debug backend. Block
+ * accesses are output as one access per word.
+ */
+typedef enum {
+	XAIE_DEBUG_ACCESS_WRITE,
+	XAIE_DEBUG_ACCESS_READ,
+	XAIE_DEBUG_ACCESS_MASKWRITE,
+	XAIE_DEBUG_ACCESS_MASKPOLL,
+	XAIE_DEBUG_ACCESS_NPI_WRITE,
+	XAIE_DEBUG_ACCESS_NPI_MASKPOLL,
+	XAIE_DEBUG_ACCESS_MAX
+} XAie_DebugAccess;
+
+/*
+ * This typedef contains the configuration of the output of the debug backend.
+ * Only the accesses to tiles from StartLoc to EndLoc, both included, and to
+ * the modules in ModMask are output. NPI accesses are always output.
+ */
+typedef struct {
+	XAie_DebugOutputFormat Format;
+	int Fd;			/* File descriptor the output is written to */
+	XAie_LocType StartLoc;	/* Tile with the lowest column and row */
+	XAie_LocType EndLoc;	/* Tile with the highest column and row */
+	u32 ModMask;		/* Bit (1 << XAie_ModuleType) per module */
+} XAie_DebugOutputCfg;
+
+/*
+ * This typedef contains an access in the binary output of the debug backend.
+ * Col, Row and Module are 0xFF for NPI accesses and for accesses out of the
+ * partition.
+ */
+typedef struct {
+	u8 Access;	/* XAie_DebugAccess */
+	u8 Col;
+	u8 Row;
+	u8 Module;	/* XAie_ModuleType */
+	u32 Mask;
+	u64 Addr;
+	u32 Value;
+	u32 TimeOutUs;
+} XAie_DebugOutputRecord;
+
+/*
+ * This enum contains the backend operations counted by the IO statistics.
+ */
+typedef enum {
+	XAIE_IOSTATS_WRITE32,
+	XAIE_IOSTATS_READ32,
+	XAIE_IOSTATS_MASKWRITE32,
+	XAIE_IOSTATS_MASKPOLL,
+	XAIE_IOSTATS_BLOCKWRITE32,
+	XAIE_IOSTATS_BLOCKSET32,
+	XAIE_IOSTATS_BLOCKREAD32,
+	XAIE_IOSTATS_RUNOP,
+	XAIE_IOSTATS_SUBMITTXN,
+	XAIE_IOSTATS_OP_MAX
+} XAie_IOStatsOp;
+
+/*
+ * This typedef contains the counters of the IO statistics. Hist[i] counts the
+ * calls with a latency from 2^i to 2^(i + 1) nano seconds, the first bucket
+ * also counts the shorter calls and the last one the longer calls.
+ */
+typedef struct {
+	u64 Calls;
+	u64 Bytes;	/* Bytes written or read by the calls */
+	u64 TotalNs;	/* Sum of the latencies of the calls */
+	u64 MaxNs;	/* Highest latency of a call */
+	u64 Hist[XAIE_IOSTATS_NUM_BUCKETS];
+} XAie_IOStatsCounter;
+
+/*
+ * This typedef contains a snapshot of the IO statistics, indexed by operation,
+ * tile type and module. The last tile type and module count the calls without
+ * a tile address, like backend operations, transactions, NPI accesses and
+ * accesses out of the partition.
+ */
+typedef struct {
+	XAie_IOStatsCounter Cnt[XAIE_IOSTATS_OP_MAX]
+		[XAIE_IOSTATS_NUM_TILE_TYPES][XAIE_IOSTATS_NUM_MODS];
+} XAie_IOStats;
+
+/*
+ * This typedef contains the configuration of the fault injection. The faults
+ * are drawn from a pseudo random sequence started from Seed, so that a run can
+ * be reproduced.
+ */
+typedef struct {
+	u32 DelayNs[XAIE_IOSTATS_OP_MAX]; /* Delay per XAie_IOStatsOp */
+	u16 PollTimeOutPerMille; /* Mask polls timing out, per thousand */
+	u16 TxnFailPerMille;	/* Transaction submissions failing */
+	u32 Seed;
+} XAie_FaultCfg;
+
 /*
  * This typedef contains the attributes for an AIE partition initialization
  * options. The structure is used by the AI engine partition initialization
@@ -491,6 +652,12 @@ typedef struct {
 	u32 ErrorCount;
 } XAie_ErrorMetaData;
 
+/*
+ * Callback called when the fence of an asynchronous transaction submission is
+ * signaled. RC is the result of the submission.
+ */
+typedef void (*XAie_TxnFenceCb)(XAie_TxnFence *Fence, AieRC RC, void *Arg);
+
 /**************************** Function prototypes ***************************/
 AieRC XAie_SetupPartitionConfig(XAie_DevInst *DevInst,
 		u64 PartBaseAddr, u8 PartStartCol, u8 PartNumCols);
@@ -512,11 +679,59 @@ AieRC XAie_MemDetach(XAie_MemInst *MemInst);
 AieRC XAie_TurnEccOff(XAie_DevInst *DevInst);
 AieRC XAie_TurnEccOn(XAie_DevInst *DevInst);
 AieRC XAie_StartTransaction(XAie_DevInst *DevInst, u32 Flags);
+AieRC XAie_StartTransactionWithHint(XAie_DevInst *DevInst, u32 Flags,
+		u32 NumCmds, u64 PayloadSize);
 AieRC XAie_SubmitTransaction(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst);
 XAie_TxnInst* XAie_ExportTransactionInstance(XAie_DevInst *DevInst);
 AieRC XAie_FreeTransactionInstance(XAie_TxnInst *TxnInst);
+XAie_TxnInst* XAie_ForkTransaction(XAie_DevInst *DevInst);
+AieRC XAie_AttachTransaction(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst);
+AieRC XAie_DetachTransaction(XAie_DevInst *DevInst, XAie_TxnInst *TxnInst);
+AieRC XAie_MergeTransactions(XAie_DevInst *DevInst, XAie_TxnInst **TxnInst,
+		u32 NumTxns);
+AieRC XAie_SerializeTransactionInstance(XAie_TxnInst *TxnInst, void *Buf,
+		u64 *Size);
+XAie_TxnInst* XAie_DeserializeTransactionInstance(const void *Buf, u64 Size);
+AieRC XAie_SaveTransactionInstance(XAie_TxnInst *TxnInst,
+		const char *FileName);
+XAie_TxnInst* XAie_LoadTransactionInstance(const char *FileName);
+AieRC XAie_AddTransactionPatchPoint(XAie_DevInst *DevInst, const char *Name,
+		u64 RegOff, u8 Lsb, u32 Mask);
+AieRC XAie_PatchTransactionInstance(XAie_TxnInst *TxnInst, const char *Name,
+		u32 Value);
+XAie_TxnFence* XAie_SubmitTransactionAsync(XAie_DevInst *DevInst,
+		XAie_TxnInst *TxnInst);
+AieRC XAie_WaitTransactionFence(XAie_TxnFence *Fence);
+AieRC XAie_PollTransactionFence(XAie_TxnFence *Fence, u8 *IsSignaled,
+		AieRC *Status);
+AieRC XAie_SetTransactionFenceCallback(XAie_TxnFence *Fence,
+		XAie_TxnFenceCb Cb, void *Arg);
+AieRC XAie_FreeTransactionFence(XAie_TxnFence *Fence);
 AieRC XAie_IsDeviceCheckerboard(XAie_DevInst *DevInst, u8 *IsCheckerBoard);
 AieRC XAie_UpdateNpiAddr(XAie_DevInst *DevInst, u64 NpiAddr);
+AieRC XAie_FlushIO(XAie_DevInst *DevInst);
+AieRC XAie_SetPollPolicy(XAie_DevInst *DevInst, XAie_PollSite Site,
+		const XAie_PollPolicy *Policy);
+AieRC XAie_EnableShadow(XAie_DevInst *DevInst);
+AieRC XAie_DisableShadow(XAie_DevInst *DevInst);
+AieRC XAie_InvalidateShadow(XAie_DevInst *DevInst);
+AieRC XAie_EnableMemShadow(XAie_DevInst *DevInst);
+AieRC XAie_DisableMemShadow(XAie_DevInst *DevInst);
+AieRC XAie_InvalidateMemShadow(XAie_DevInst *DevInst);
+AieRC XAie_InvalidateDataMemShadow(XAie_DevInst *DevInst, XAie_LocType Loc);
+AieRC XAie_StartIORecord(XAie_DevInst *DevInst, const char *FileName);
+AieRC XAie_StopIORecord(XAie_DevInst *DevInst);
+AieRC XAie_ReplayIORecord(XAie_DevInst *DevInst, const char *FileName,
+		XAie_ReplayMode Mode);
+AieRC XAie_ConfigDebugOutput(XAie_DevInst *DevInst,
+		const XAie_DebugOutputCfg *Cfg);
+AieRC XAie_StartIOStats(XAie_DevInst *DevInst);
+AieRC XAie_StopIOStats(XAie_DevInst *DevInst);
+AieRC XAie_GetIOStats(XAie_DevInst *DevInst, XAie_IOStats *Stats);
+AieRC XAie_DumpIOStats(XAie_DevInst *DevInst, const char *FileName);
+AieRC XAie_StartFaultInjection(XAie_DevInst *DevInst,
+		const XAie_FaultCfg *Cfg);
+AieRC XAie_StopFaultInjection(XAie_DevInst *DevInst);
 /*****************************************************************************/
 /*
 *
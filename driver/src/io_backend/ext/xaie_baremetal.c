@@ -44,6 +44,7 @@
 
 /****************************** Type Definitions *****************************/
 typedef struct {
+	XAie_DevInst *DevInst;
 	u64 BaseAddr;
 	u64 NpiBaseAddr;
 } XAie_BaremetalIO;
@@ -87,6 +88,7 @@ static AieRC XAie_BaremetalIO_Init(XAie_DevInst *DevInst)
 {
 	XAie_BaremetalIO *IOInst = &BaremetalIO;
 
+	IOInst->DevInst = DevInst;
 	IOInst->BaseAddr = DevInst->BaseAddr;
 	IOInst->NpiBaseAddr = XAIE_NPI_BASEADDR;
 	DevInst->IOInst = IOInst;
@@ -183,6 +185,7 @@ static AieRC XAie_BaremetalIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 * @param	Mask: Mask to be applied to Data.
 * @param	Value: 32-bit value to poll for
 * @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy.
 *
 * @return	XAIE_OK or XAIE_ERR.
 *
@@ -190,34 +193,10 @@ static AieRC XAie_BaremetalIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 *
 *******************************************************************************/
 static AieRC XAie_BaremetalIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
-		u32 Value, u32 TimeOutUs)
+		u32 Value, u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
-	AieRC Ret = XAIE_ERR;
-	u32 Count, MinTimeOutUs, RegVal;
-
-	/*
-	 * Any value less than 200 us becomes noticable overhead. This is based
-	 * on some profiling, and it may vary between platforms.
-	 */
-	MinTimeOutUs = 200;
-	Count = ((u64)TimeOutUs + MinTimeOutUs - 1) / MinTimeOutUs;
-
-	while (Count > 0U) {
-		XAie_BaremetalIO_Read32(IOInst, RegOff, &RegVal);
-		if((RegVal & Mask) == Value) {
-			return XAIE_OK;
-		}
-		usleep(MinTimeOutUs);
-		Count--;
-	}
-
-	/* Check for the break from timed-out loop */
-	XAie_BaremetalIO_Read32(IOInst, RegOff, &RegVal);
-	if((RegVal & Mask) == Value) {
-		Ret = XAIE_OK;
-	}
-
-	return Ret;
+	return _XAie_IOCommon_MaskPoll(IOInst, XAie_BaremetalIO_Read32, RegOff, Mask,
+			Value, TimeOutUs, Policy);
 }
 
 /*****************************************************************************/
@@ -238,6 +217,18 @@ static AieRC XAie_BaremetalIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
 static AieRC XAie_BaremetalIO_BlockWrite32(void *IOInst, u64 RegOff,
 		const u32 *Data, u32 Size)
 {
+	XAie_BaremetalIO *BaremetalIOInst = (XAie_BaremetalIO *)IOInst;
+
+	/* Handle PM and DM sections */
+	if(_XAie_IOCommon_IsMemRange(BaremetalIOInst->DevInst, RegOff, Size) ==
+			XAIE_ENABLE) {
+		_XAie_IOCommon_CopyDataToMem((u32 *)(UINTPTR)
+				(BaremetalIOInst->BaseAddr + RegOff), Data,
+				Size);
+		return XAIE_OK;
+	}
+
+	/* Handle other registers */
 	for(u32 i = 0U; i < Size; i++) {
 		XAie_BaremetalIO_Write32(IOInst, RegOff + i * 4U, *Data);
 		Data++;
@@ -265,12 +256,49 @@ static AieRC XAie_BaremetalIO_BlockWrite32(void *IOInst, u64 RegOff,
 static AieRC XAie_BaremetalIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
 		u32 Size)
 {
+	XAie_BaremetalIO *BaremetalIOInst = (XAie_BaremetalIO *)IOInst;
+
+	/* Handle PM and DM sections */
+	if(_XAie_IOCommon_IsMemRange(BaremetalIOInst->DevInst, RegOff, Size) ==
+			XAIE_ENABLE) {
+		_XAie_IOCommon_SetDataInMem((u32 *)(UINTPTR)
+				(BaremetalIOInst->BaseAddr + RegOff), Data,
+				Size);
+		return XAIE_OK;
+	}
+
+	/* Handle other registers */
 	for(u32 i = 0U; i < Size; i++)
 		XAie_BaremetalIO_Write32(IOInst, RegOff+ i * 4U, Data);
 
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read a block of data from aie.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Pointer to store the data.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_BaremetalIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	for(u32 i = 0U; i < Size; i++) {
+		XAie_BaremetalIO_Read32(IOInst, RegOff + i * 4U, &Data[i]);
+	}
+
+	return XAIE_OK;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -440,6 +468,7 @@ static AieRC _XAie_BaremetalIO_NpiRead32(void *IOInst, u64 RegOff, u32 *Data)
 * @param	Mask: Mask to be applied to Data.
 * @param	Value: 32-bit value to poll for
 * @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy.
 *
 * @return	XAIE_OK or XAIE_ERR.
 *
@@ -447,34 +476,11 @@ static AieRC _XAie_BaremetalIO_NpiRead32(void *IOInst, u64 RegOff, u32 *Data)
 *
 *******************************************************************************/
 static AieRC _XAie_BaremetalIO_NpiMaskPoll(void *IOInst, u64 RegOff, u32 Mask,
-		u32 Value, u32 TimeOutUs)
+		u32 Value, u32 TimeOutUs,
+		const XAie_PollPolicy *Policy)
 {
-	AieRC Ret = XAIE_ERR;
-	u32 Count, MinTimeOutUs, RegVal;
-
-	/*
-	 * Any value less than 200 us becomes noticable overhead. This is based
-	 * on some profiling, and it may vary between platforms.
-	 */
-	MinTimeOutUs = 200;
-	Count = ((u64)TimeOutUs + MinTimeOutUs - 1) / MinTimeOutUs;
-
-	while (Count > 0U) {
-		_XAie_BaremetalIO_NpiRead32(IOInst, RegOff, &RegVal);
-		if((RegVal & Mask) == Value) {
-			return XAIE_OK;
-		}
-		usleep(MinTimeOutUs);
-		Count--;
-	}
-
-	/* Check for the break from timed-out loop */
-	_XAie_BaremetalIO_NpiRead32(IOInst, RegOff, &RegVal);
-	if((RegVal & Mask) == Value) {
-		Ret = XAIE_OK;
-	}
-
-	return Ret;
+	return _XAie_IOCommon_MaskPoll(IOInst, _XAie_BaremetalIO_NpiRead32, RegOff, Mask,
+			Value, TimeOutUs, Policy);
 }
 
 /*****************************************************************************/
@@ -511,7 +517,8 @@ static AieRC XAie_BaremetalIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 
 			return _XAie_BaremetalIO_NpiMaskPoll(IOInst,
 					Req->NpiRegOff, Req->Mask, Req->Val,
-					Req->TimeOutUs);
+					Req->TimeOutUs,
+					&DevInst->PollPolicy[XAIE_POLL_DEFAULT]);
 		}
 		case XAIE_BACKEND_OP_CONFIG_SHIMDMABD:
 		{
@@ -549,6 +556,9 @@ static AieRC XAie_BaremetalIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 			BaremetalIOInst->NpiBaseAddr = *((u64 *)Arg);
 			break;
 		}
+		case XAIE_BACKEND_OP_FLUSH:
+			/* Writes are not buffered */
+			break;
 		default:
 			XAIE_ERROR("Baremetal backend doesn't support operation"
 					" %d\n", Op);
@@ -608,7 +618,7 @@ static AieRC XAie_BaremetalIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 }
 
 static AieRC XAie_BaremetalIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
-		u32 Value, u32 TimeOutUs)
+		u32 Value, u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
 	/* no-op */
 	(void)IOInst;
@@ -616,6 +626,7 @@ static AieRC XAie_BaremetalIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
 	(void)Mask;
 	(void)Value;
 	(void)TimeOutUs;
+	(void)Policy;
 	return XAIE_ERR;
 }
 
@@ -643,6 +654,18 @@ static AieRC XAie_BaremetalIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
 	return XAIE_ERR;
 }
 
+static AieRC XAie_BaremetalIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Data;
+	(void)Size;
+
+	return XAIE_ERR;
+}
+
 static XAie_MemInst* XAie_BaremetalMemAllocate(XAie_DevInst *DevInst, u64 Size,
 		XAie_MemCacheProp Cache)
 {
@@ -721,6 +744,7 @@ const XAie_Backend BaremetalBackend =
 	.Ops.MaskPoll = XAie_BaremetalIO_MaskPoll,
 	.Ops.BlockWrite32 = XAie_BaremetalIO_BlockWrite32,
 	.Ops.BlockSet32 = XAie_BaremetalIO_BlockSet32,
+	.Ops.BlockRead32 = XAie_BaremetalIO_BlockRead32,
 	.Ops.CmdWrite = XAie_BaremetalIO_CmdWrite,
 	.Ops.RunOp = XAie_BaremetalIO_RunOp,
 	.Ops.MemAllocate = XAie_BaremetalMemAllocate,
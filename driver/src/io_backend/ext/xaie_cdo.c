@@ -40,15 +40,164 @@
 #include "xaie_npi.h"
 
 /************************** Constant Definitions *****************************/
+#define XAIE_CDO_RUN_MAX_WORDS		1024U
+#define XAIE_CDO_SET_MIN_WORDS		8U
+
+/*
+ * Writes are coalesced when the driver is compiled with XAIE_CDO_COALESCE.
+ * The buffered writes are emitted by XAie_FlushIO() and XAie_Finish(), one of
+ * them has to be called before the CDO is closed.
+ */
+#ifdef XAIE_CDO_COALESCE
+#define XAIE_CDO_IS_BUFFERED		1U
+#else
+#define XAIE_CDO_IS_BUFFERED		0U
+#endif
+
 /****************************** Type Definitions *****************************/
+/*
+ * Writes are buffered before they are emitted to the CDO. Register writes to
+ * consecutive addresses are gathered in a run, which is emitted as block
+ * writes and block sets. A masked write is held until the next access so a
+ * repeat of it is dropped. Only one of the run and the masked write is
+ * buffered at a time, so the CDO commands keep the order of the accesses.
+ */
 typedef struct {
 	u64 BaseAddr;
 	u64 NpiBaseAddr;
+	u64 RunAddr;		/* Address of the first word of the run */
+	u32 RunLen;		/* Number of words in the run */
+	u32 Run[XAIE_CDO_RUN_MAX_WORDS];
+	u8 IsMaskPending;	/* Masked write is buffered */
+	u64 MaskAddr;
+	u32 Mask;
+	u32 MaskValue;
 } XAie_CdoIO;
 
 /************************** Function Definitions *****************************/
 #ifdef __AIECDO__
 
+/*****************************************************************************/
+/**
+*
+* This API emits words of the run which are not a block set. A single word is
+* emitted as a register write.
+*
+* @param	CdoIOInst: CDO IO instance pointer
+* @param	Start: Index of the first word in the run.
+* @param	End: Index after the last word in the run.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_CdoIO_EmitWords(XAie_CdoIO *CdoIOInst, u32 Start, u32 End)
+{
+	u64 Addr = CdoIOInst->RunAddr + (u64)Start * 4U;
+
+	if(End - Start == 1U) {
+		cdo_Write32(Addr, CdoIOInst->Run[Start]);
+	} else if(End > Start) {
+		cdo_BlockWrite32(Addr, &CdoIOInst->Run[Start], End - Start);
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API emits the buffered writes to the CDO. Identical words of the run are
+* emitted as a block set when they are the whole run, or when there are at
+* least XAIE_CDO_SET_MIN_WORDS of them. The other words are emitted as block
+* writes.
+*
+* @param	CdoIOInst: CDO IO instance pointer
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_CdoIO_Flush(XAie_CdoIO *CdoIOInst)
+{
+	u32 Len = CdoIOInst->RunLen;
+	u32 Start = 0U;
+
+	if(CdoIOInst->IsMaskPending != 0U) {
+		cdo_MaskWrite32(CdoIOInst->MaskAddr, CdoIOInst->Mask,
+				CdoIOInst->MaskValue);
+		CdoIOInst->IsMaskPending = 0U;
+	}
+
+	for(u32 i = 0U; i < Len;) {
+		u32 j = i + 1U;
+
+		while((j < Len) && (CdoIOInst->Run[j] == CdoIOInst->Run[i])) {
+			j++;
+		}
+
+		if(((j - i) >= XAIE_CDO_SET_MIN_WORDS) ||
+				(((j - i) == Len) && (Len > 1U))) {
+			_XAie_CdoIO_EmitWords(CdoIOInst, Start, i);
+			cdo_BlockSet32(CdoIOInst->RunAddr + (u64)i * 4U,
+					CdoIOInst->Run[i], j - i);
+			Start = j;
+		}
+		i = j;
+	}
+	_XAie_CdoIO_EmitWords(CdoIOInst, Start, Len);
+
+	CdoIOInst->RunLen = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API adds words to the run. The buffered writes are flushed first if the
+* words do not follow the run.
+*
+* @param	CdoIOInst: CDO IO instance pointer
+* @param	Addr: Address of the first word.
+* @param	Data: Pointer to the words.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_CdoIO_AddToRun(XAie_CdoIO *CdoIOInst, u64 Addr,
+		const u32 *Data, u32 Size)
+{
+	while(Size > 0U) {
+		u32 Num;
+
+		if((CdoIOInst->IsMaskPending != 0U) ||
+				(CdoIOInst->RunLen == XAIE_CDO_RUN_MAX_WORDS) ||
+				((CdoIOInst->RunLen > 0U) && (Addr !=
+				  CdoIOInst->RunAddr +
+				  (u64)CdoIOInst->RunLen * 4U))) {
+			_XAie_CdoIO_Flush(CdoIOInst);
+		}
+
+		if(CdoIOInst->RunLen == 0U) {
+			CdoIOInst->RunAddr = Addr;
+		}
+
+		Num = XAIE_CDO_RUN_MAX_WORDS - CdoIOInst->RunLen;
+		if(Num > Size) {
+			Num = Size;
+		}
+
+		memcpy(&CdoIOInst->Run[CdoIOInst->RunLen], Data,
+				Num * sizeof(u32));
+		CdoIOInst->RunLen += Num;
+		Addr += (u64)Num * 4U;
+		Data += Num;
+		Size -= Num;
+	}
+}
+
 /*****************************************************************************/
 /**
 *
@@ -64,6 +213,7 @@ typedef struct {
 *******************************************************************************/
 static AieRC XAie_CdoIO_Finish(void *IOInst)
 {
+	_XAie_CdoIO_Flush((XAie_CdoIO *)IOInst);
 	free(IOInst);
 	return XAIE_OK;
 }
@@ -92,6 +242,8 @@ static AieRC XAie_CdoIO_Init(XAie_DevInst *DevInst)
 
 	IOInst->BaseAddr = DevInst->BaseAddr;
 	IOInst->NpiBaseAddr = XAIE_NPI_BASEADDR;
+	IOInst->RunLen = 0U;
+	IOInst->IsMaskPending = 0U;
 	DevInst->IOInst = IOInst;
 
 	return XAIE_OK;
@@ -108,7 +260,7 @@ static AieRC XAie_CdoIO_Init(XAie_DevInst *DevInst)
 *
 * @return	None.
 *
-* @note		None.
+* @note		The write is buffered if XAIE_CDO_COALESCE is defined.
 * @note		Internal only.
 *
 *******************************************************************************/
@@ -116,7 +268,11 @@ static AieRC XAie_CdoIO_Write32(void *IOInst, u64 RegOff, u32 Value)
 {
 	XAie_CdoIO *CdoIOInst = (XAie_CdoIO *)IOInst;
 
-	cdo_Write32(CdoIOInst->BaseAddr + RegOff, Value);
+	_XAie_CdoIO_AddToRun(CdoIOInst, CdoIOInst->BaseAddr + RegOff, &Value,
+			1U);
+	if(XAIE_CDO_IS_BUFFERED == 0U) {
+		_XAie_CdoIO_Flush(CdoIOInst);
+	}
 
 	return XAIE_OK;
 }
@@ -158,7 +314,8 @@ static AieRC XAie_CdoIO_Read32(void *IOInst, u64 RegOff, u32 *Data)
 *
 * @return	None.
 *
-* @note		None.
+* @note		The write is buffered if XAIE_CDO_COALESCE is defined, and
+*		dropped if it repeats the buffered masked write.
 * @note		Internal only.
 *
 *******************************************************************************/
@@ -166,7 +323,22 @@ static AieRC XAie_CdoIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 		u32 Value)
 {
 	XAie_CdoIO *CdoIOInst = (XAie_CdoIO *)IOInst;
-	cdo_MaskWrite32(CdoIOInst->BaseAddr + RegOff, Mask, Value);
+	u64 Addr = CdoIOInst->BaseAddr + RegOff;
+
+	if((CdoIOInst->IsMaskPending != 0U) && (CdoIOInst->MaskAddr == Addr) &&
+			(CdoIOInst->Mask == Mask) &&
+			(CdoIOInst->MaskValue == Value)) {
+		return XAIE_OK;
+	}
+
+	_XAie_CdoIO_Flush(CdoIOInst);
+	CdoIOInst->IsMaskPending = 1U;
+	CdoIOInst->MaskAddr = Addr;
+	CdoIOInst->Mask = Mask;
+	CdoIOInst->MaskValue = Value;
+	if(XAIE_CDO_IS_BUFFERED == 0U) {
+		_XAie_CdoIO_Flush(CdoIOInst);
+	}
 
 	return XAIE_OK;
 }
@@ -181,6 +353,7 @@ static AieRC XAie_CdoIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 * @param	Mask: Mask to be applied to Data.
 * @param	Value: 32-bit value to poll for
 * @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy, unused as the poll is done by the PLM.
 *
 * @return	XAIE_OK or XAIE_ERR.
 *
@@ -189,9 +362,12 @@ static AieRC XAie_CdoIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 *
 *******************************************************************************/
 static AieRC XAie_CdoIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
-		u32 TimeOutUs)
+		u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
 	XAie_CdoIO *CdoIOInst = (XAie_CdoIO *)IOInst;
+
+	(void)Policy;
+	_XAie_CdoIO_Flush(CdoIOInst);
 	/* Round up to msec */
 	cdo_MaskPoll(CdoIOInst->BaseAddr + RegOff, Mask, Value,
 			(TimeOutUs + 999) / 1000);
@@ -210,7 +386,7 @@ static AieRC XAie_CdoIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
 *
 * @return	None.
 *
-* @note		None.
+* @note		The write is buffered, unless it is larger than the run.
 * @note		Internal only.
 *
 *******************************************************************************/
@@ -219,7 +395,14 @@ static AieRC XAie_CdoIO_BlockWrite32(void *IOInst, u64 RegOff, const u32 *Data,
 {
 	XAie_CdoIO *CdoIOInst = (XAie_CdoIO *)IOInst;
 
-	cdo_BlockWrite32(CdoIOInst->BaseAddr + RegOff, Data, Size);
+	if((XAIE_CDO_IS_BUFFERED == 0U) || (Size > XAIE_CDO_RUN_MAX_WORDS)) {
+		_XAie_CdoIO_Flush(CdoIOInst);
+		cdo_BlockWrite32(CdoIOInst->BaseAddr + RegOff, Data, Size);
+		return XAIE_OK;
+	}
+
+	_XAie_CdoIO_AddToRun(CdoIOInst, CdoIOInst->BaseAddr + RegOff, Data,
+			Size);
 
 	return XAIE_OK;
 }
@@ -245,11 +428,38 @@ static AieRC XAie_CdoIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data, u32 Size)
 {
 	XAie_CdoIO *CdoIOInst = (XAie_CdoIO *)IOInst;
 
+	_XAie_CdoIO_Flush(CdoIOInst);
 	cdo_BlockSet32(CdoIOInst->BaseAddr + RegOff, Data, Size);
 
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read a block of data from aie.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Pointer to store the data.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_CdoIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	memset((void *)Data, 0, Size * sizeof(u32));
+	return XAIE_OK;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -271,6 +481,7 @@ static void _XAie_CdoIO_NpiWrite32(void *IOInst, u32 RegOff, u32 RegVal)
 	u64 RegAddr;
 
 	RegAddr = CdoIOInst->NpiBaseAddr + RegOff;
+	_XAie_CdoIO_Flush(CdoIOInst);
 	cdo_Write32(RegAddr, RegVal);
 	return;
 }
@@ -296,6 +507,8 @@ static AieRC _XAie_CdoIO_NpiMaskPoll(void *IOInst, u64 RegOff, u32 Mask,
 		u32 Value, u32 TimeOutUs)
 {
 	XAie_CdoIO *CdoIOInst = (XAie_CdoIO *)IOInst;
+
+	_XAie_CdoIO_Flush(CdoIOInst);
 	/* Round up to msec */
 	cdo_MaskPoll(CdoIOInst->NpiBaseAddr + RegOff, Mask, Value,
 			(TimeOutUs + 999) / 1000);
@@ -384,6 +597,9 @@ static AieRC XAie_CdoIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 			CdoIOInst->NpiBaseAddr = *((u64 *)Arg);
 			break;
 		}
+		case XAIE_BACKEND_OP_FLUSH:
+			_XAie_CdoIO_Flush((XAie_CdoIO *)IOInst);
+			break;
 		default:
 			XAIE_ERROR("CDO backend doesn't support operation"
 					" %u.\n", Op);
@@ -444,7 +660,7 @@ static AieRC XAie_CdoIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 }
 
 static AieRC XAie_CdoIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
-		u32 TimeOutUs)
+		u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
 	/* no-op */
 	(void)IOInst;
@@ -452,6 +668,7 @@ static AieRC XAie_CdoIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
 	(void)Mask;
 	(void)Value;
 	(void)TimeOutUs;
+	(void)Policy;
 
 	return XAIE_ERR;
 }
@@ -479,6 +696,18 @@ static AieRC XAie_CdoIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data, u32 Size)
 	return XAIE_ERR;
 }
 
+static AieRC XAie_CdoIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Data;
+	(void)Size;
+
+	return XAIE_ERR;
+}
+
 static AieRC XAie_CdoIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 		     XAie_BackendOpCode Op, void *Arg)
 {
@@ -557,6 +786,7 @@ const XAie_Backend CdoBackend =
 	.Ops.MaskPoll = XAie_CdoIO_MaskPoll,
 	.Ops.BlockWrite32 = XAie_CdoIO_BlockWrite32,
 	.Ops.BlockSet32 = XAie_CdoIO_BlockSet32,
+	.Ops.BlockRead32 = XAie_CdoIO_BlockRead32,
 	.Ops.CmdWrite = XAie_CdoIO_CmdWrite,
 	.Ops.RunOp = XAie_CdoIO_RunOp,
 	.Ops.MemAllocate = XAie_CdoMemAllocate,
@@ -24,9 +24,12 @@
 /***************************** Include Files *********************************/
 #ifdef __linux__
 #include <pthread.h>
+#include <unistd.h>
 #endif
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "xaie_helper.h"
 #include "xaie_io.h"
@@ -34,13 +37,385 @@
 #include "xaie_io_privilege.h"
 #include "xaie_npi.h"
 
+/***************************** Macro Definitions *****************************/
+#define XAIE_DEBUG_BUF_SIZE		65536U
+#define XAIE_DEBUG_MAX_LINE		128U
+#define XAIE_DEBUG_NUM_MODS		3U
+#define XAIE_DEBUG_NO_LOC		0xFFU
+
 /****************************** Type Definitions *****************************/
+/*
+ * The output is formatted to a buffer which is written to the file descriptor
+ * when it is full, on flush and on finish. In summary mode, Counts has one
+ * counter per tile, module and access, which are output on finish. On Linux,
+ * Lock serializes the threads sharing the instance.
+ */
 typedef struct {
 	u64 BaseAddr;
 	u64 NpiBaseAddr;
+	XAie_DevInst *DevInst;
+	XAie_DebugOutputCfg Cfg;
+	u64 *Counts;
+	u64 NpiCounts[XAIE_DEBUG_ACCESS_MAX];
+	u32 BufLen;
+	char Buf[XAIE_DEBUG_BUF_SIZE];
+#ifdef __linux__
+	pthread_mutex_t Lock;
+#endif
 } XAie_DebugIO;
 
+/************************** Variable Definitions *****************************/
+static const char *XAie_DebugAccessStr[XAIE_DEBUG_ACCESS_MAX] = {
+	"W", "R", "MW", "MP", "NPIMW", "MP",
+};
+
+static const char *XAie_DebugModStr[XAIE_DEBUG_NUM_MODS] = {
+	"mem", "core", "pl",
+};
+
 /************************** Function Definitions *****************************/
+static inline void _XAie_DebugIO_Lock(XAie_DebugIO *DebugIOInst)
+{
+#ifdef __linux__
+	pthread_mutex_lock(&DebugIOInst->Lock);
+#else
+	(void)DebugIOInst;
+#endif
+}
+
+static inline void _XAie_DebugIO_Unlock(XAie_DebugIO *DebugIOInst)
+{
+#ifdef __linux__
+	pthread_mutex_unlock(&DebugIOInst->Lock);
+#else
+	(void)DebugIOInst;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* This API formats a line at the end of the buffered output. A line longer
+* than XAIE_DEBUG_MAX_LINE is truncated.
+*
+* @param	DebugIOInst: Debug IO instance pointer.
+* @param	Fmt: Format of the line.
+*
+* @return	None.
+*
+* @note		Internal only. The lock must be held and the buffer must have
+*		room for XAIE_DEBUG_MAX_LINE bytes.
+*
+*******************************************************************************/
+static void _XAie_DebugIO_Printf(XAie_DebugIO *DebugIOInst,
+		const char *Fmt, ...)
+{
+	va_list Args;
+	int Len;
+
+	va_start(Args, Fmt);
+	Len = vsnprintf(&DebugIOInst->Buf[DebugIOInst->BufLen],
+			XAIE_DEBUG_MAX_LINE, Fmt, Args);
+	va_end(Args);
+
+	/* snprintf returns the length the line would have had untruncated */
+	if(Len < 0) {
+		Len = 0;
+	} else if((u32)Len >= XAIE_DEBUG_MAX_LINE) {
+		Len = (int)XAIE_DEBUG_MAX_LINE - 1;
+	}
+	DebugIOInst->BufLen += (u32)Len;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes the buffered output to the file descriptor.
+*
+* @param	DebugIOInst: Debug IO instance pointer.
+*
+* @return	None.
+*
+* @note		Internal only. The lock must be held. The output is written to
+*		stdout on hosts other than Linux.
+*
+*******************************************************************************/
+static void _XAie_DebugIO_FlushBuf(XAie_DebugIO *DebugIOInst)
+{
+	u32 Off = 0U;
+
+	if(DebugIOInst->BufLen == 0U) {
+		return;
+	}
+
+#ifdef __linux__
+	/* Keep the order with the output of the application */
+	if(DebugIOInst->Cfg.Fd == STDOUT_FILENO) {
+		fflush(stdout);
+	}
+
+	while(Off < DebugIOInst->BufLen) {
+		ssize_t Ret = write(DebugIOInst->Cfg.Fd,
+				&DebugIOInst->Buf[Off],
+				DebugIOInst->BufLen - Off);
+		if(Ret <= 0) {
+			break;
+		}
+		Off += (u32)Ret;
+	}
+#else
+	Off = (u32)fwrite(DebugIOInst->Buf, 1U, DebugIOInst->BufLen, stdout);
+#endif
+
+	if(Off < DebugIOInst->BufLen) {
+		XAIE_ERROR("Failed to write debug backend output\n");
+	}
+	DebugIOInst->BufLen = 0U;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API outputs the summary of the accesses and resets the counters.
+*
+* @param	DebugIOInst: Debug IO instance pointer.
+*
+* @return	None.
+*
+* @note		Internal only. The lock must be held.
+*
+*******************************************************************************/
+static void _XAie_DebugIO_OutputSummary(XAie_DebugIO *DebugIOInst)
+{
+	XAie_DevInst *DevInst = DebugIOInst->DevInst;
+	u32 NumTileMods = DevInst->NumCols * DevInst->NumRows *
+		XAIE_DEBUG_NUM_MODS;
+	u64 *Counts = DebugIOInst->NpiCounts;
+
+	if(DebugIOInst->Counts == NULL) {
+		return;
+	}
+
+	for(u32 i = 0U; i <= NumTileMods; i++) {
+		u64 Total = 0U;
+
+		if(i < NumTileMods) {
+			Counts = &DebugIOInst->Counts[i * XAIE_DEBUG_ACCESS_MAX];
+		} else {
+			Counts = DebugIOInst->NpiCounts;
+		}
+
+		for(u32 j = 0U; j < XAIE_DEBUG_ACCESS_MAX; j++) {
+			Total += Counts[j];
+		}
+		if(Total == 0U) {
+			continue;
+		}
+
+		if(XAIE_DEBUG_BUF_SIZE - DebugIOInst->BufLen <
+				XAIE_DEBUG_MAX_LINE) {
+			_XAie_DebugIO_FlushBuf(DebugIOInst);
+		}
+
+		if(i < NumTileMods) {
+			u32 Tile = i / XAIE_DEBUG_NUM_MODS;
+
+			_XAie_DebugIO_Printf(DebugIOInst, "Tile(%u, %u) %s: "
+				"W %lu, R %lu, MW %lu, MP %lu\n",
+				Tile / DevInst->NumRows,
+				Tile % DevInst->NumRows,
+				XAie_DebugModStr[i % XAIE_DEBUG_NUM_MODS],
+				Counts[XAIE_DEBUG_ACCESS_WRITE],
+				Counts[XAIE_DEBUG_ACCESS_READ],
+				Counts[XAIE_DEBUG_ACCESS_MASKWRITE],
+				Counts[XAIE_DEBUG_ACCESS_MASKPOLL]);
+		} else {
+			_XAie_DebugIO_Printf(DebugIOInst,
+				"NPI: W %lu, MP %lu\n",
+				Counts[XAIE_DEBUG_ACCESS_NPI_WRITE],
+				Counts[XAIE_DEBUG_ACCESS_NPI_MASKPOLL]);
+		}
+	}
+
+	memset(DebugIOInst->Counts, 0, NumTileMods * XAIE_DEBUG_ACCESS_MAX *
+			sizeof(u64));
+	memset(DebugIOInst->NpiCounts, 0, sizeof(DebugIOInst->NpiCounts));
+}
+
+/*****************************************************************************/
+/**
+*
+* This API outputs an access in the configured format, or counts it in summary
+* mode. Accesses to tiles or modules which are filtered out are dropped.
+*
+* @param	DebugIOInst: Debug IO instance pointer.
+* @param	Access: Type of the access.
+* @param	RegOff: Register offset, or NPI register offset.
+* @param	Mask: Mask of the access, 0xFFFFFFFF for writes and reads.
+* @param	Value: Value of the access.
+* @param	TimeOutUs: Timeout of polls.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_DebugIO_Log(XAie_DebugIO *DebugIOInst,
+		XAie_DebugAccess Access, u64 RegOff, u32 Mask, u32 Value,
+		u32 TimeOutUs)
+{
+	const XAie_DebugOutputCfg *Cfg = &DebugIOInst->Cfg;
+	XAie_DebugOutputRecord Rec;
+	XAie_ModuleType Mod = XAIE_MEM_MOD;
+	XAie_LocType Loc = XAie_TileLoc(XAIE_DEBUG_NO_LOC, XAIE_DEBUG_NO_LOC);
+	u8 IsNpi = (Access >= XAIE_DEBUG_ACCESS_NPI_WRITE);
+	u8 TileType = XAIEGBL_TILE_TYPE_MAX;
+	u64 Addr;
+
+	if(IsNpi != 0U) {
+		Addr = DebugIOInst->NpiBaseAddr + RegOff;
+	} else {
+		Addr = DebugIOInst->BaseAddr + RegOff;
+		TileType = _XAie_IOCommon_GetTileMod(DebugIOInst->DevInst,
+				RegOff, &Loc, &Mod);
+		if((TileType != XAIEGBL_TILE_TYPE_MAX) && (
+				(Loc.Col < Cfg->StartLoc.Col) ||
+				(Loc.Col > Cfg->EndLoc.Col) ||
+				(Loc.Row < Cfg->StartLoc.Row) ||
+				(Loc.Row > Cfg->EndLoc.Row) ||
+				((Cfg->ModMask & (1U << Mod)) == 0U))) {
+			return;
+		}
+	}
+
+	_XAie_DebugIO_Lock(DebugIOInst);
+
+	if(Cfg->Format == XAIE_DEBUG_OUTPUT_SUMMARY) {
+		if(IsNpi != 0U) {
+			DebugIOInst->NpiCounts[Access]++;
+		} else if(TileType != XAIEGBL_TILE_TYPE_MAX) {
+			u32 Idx = ((u32)Loc.Col * DebugIOInst->DevInst->NumRows +
+					Loc.Row) * XAIE_DEBUG_NUM_MODS + Mod;
+
+			DebugIOInst->Counts[Idx * XAIE_DEBUG_ACCESS_MAX +
+				Access]++;
+		}
+		_XAie_DebugIO_Unlock(DebugIOInst);
+		return;
+	}
+
+	if(XAIE_DEBUG_BUF_SIZE - DebugIOInst->BufLen < XAIE_DEBUG_MAX_LINE) {
+		_XAie_DebugIO_FlushBuf(DebugIOInst);
+	}
+
+	switch(Cfg->Format) {
+	case XAIE_DEBUG_OUTPUT_BINARY:
+		Rec.Access = (u8)Access;
+		Rec.Col = Loc.Col;
+		Rec.Row = Loc.Row;
+		Rec.Module = (TileType == XAIEGBL_TILE_TYPE_MAX) ?
+			XAIE_DEBUG_NO_LOC : (u8)Mod;
+		Rec.Mask = Mask;
+		Rec.Addr = Addr;
+		Rec.Value = Value;
+		Rec.TimeOutUs = TimeOutUs;
+		memcpy(&DebugIOInst->Buf[DebugIOInst->BufLen], &Rec,
+				sizeof(Rec));
+		DebugIOInst->BufLen += sizeof(Rec);
+		break;
+	case XAIE_DEBUG_OUTPUT_CSV:
+		_XAie_DebugIO_Printf(DebugIOInst,
+				"%s,0x%lx,%d,%d,%s,0x%x,0x%x,%u\n",
+				XAie_DebugAccessStr[Access], Addr,
+				(TileType == XAIEGBL_TILE_TYPE_MAX) ? -1 :
+				Loc.Col,
+				(TileType == XAIEGBL_TILE_TYPE_MAX) ? -1 :
+				Loc.Row,
+				(IsNpi != 0U) ? "npi" :
+				(TileType == XAIEGBL_TILE_TYPE_MAX) ? "" :
+				XAie_DebugModStr[Mod], Mask, Value, TimeOutUs);
+		break;
+	default:
+		if(Access == XAIE_DEBUG_ACCESS_MASKWRITE) {
+			_XAie_DebugIO_Printf(DebugIOInst,
+					"MW: %p, 0x%x, 0x%x\n",
+					(void *)(uintptr_t)Addr, Mask, Value);
+		} else if((Access == XAIE_DEBUG_ACCESS_MASKPOLL) ||
+				(Access == XAIE_DEBUG_ACCESS_NPI_MASKPOLL)) {
+			_XAie_DebugIO_Printf(DebugIOInst,
+					"MP: %p, 0x%x, 0x%x, 0x%d\n",
+					(void *)(uintptr_t)Addr, Mask, Value,
+					TimeOutUs);
+		} else {
+			_XAie_DebugIO_Printf(DebugIOInst, "%s: %p, 0x%x\n",
+					XAie_DebugAccessStr[Access],
+					(void *)(uintptr_t)Addr, Value);
+		}
+		break;
+	}
+
+	_XAie_DebugIO_Unlock(DebugIOInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API configures the output of the debug backend. The buffered output is
+* written and the summary is output before the configuration changes.
+*
+* @param	DebugIOInst: Debug IO instance pointer.
+* @param	Cfg: Output configuration, NULL for the default configuration.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_DebugIO_ConfigOutput(XAie_DebugIO *DebugIOInst,
+		const XAie_DebugOutputCfg *Cfg)
+{
+	XAie_DevInst *DevInst = DebugIOInst->DevInst;
+	XAie_DebugOutputCfg Default = {
+		.Format = XAIE_DEBUG_OUTPUT_TEXT,
+		.Fd = 1,
+		.StartLoc = {0U, 0U},
+		.EndLoc = {XAIE_DEBUG_NO_LOC, XAIE_DEBUG_NO_LOC},
+		.ModMask = ~0U,
+	};
+	u64 *Counts = NULL;
+
+	if(Cfg == NULL) {
+		Cfg = &Default;
+	}
+
+	if((Cfg->Format >= XAIE_DEBUG_OUTPUT_MAX) || (Cfg->Fd < 0)) {
+		XAIE_ERROR("Invalid debug backend output configuration\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(Cfg->Format == XAIE_DEBUG_OUTPUT_SUMMARY) {
+		Counts = (u64 *)calloc((u64)DevInst->NumCols *
+				DevInst->NumRows * XAIE_DEBUG_NUM_MODS *
+				XAIE_DEBUG_ACCESS_MAX, sizeof(*Counts));
+		if(Counts == NULL) {
+			XAIE_ERROR("Memory allocation failed\n");
+			return XAIE_ERR;
+		}
+	}
+
+	_XAie_DebugIO_Lock(DebugIOInst);
+	_XAie_DebugIO_OutputSummary(DebugIOInst);
+	_XAie_DebugIO_FlushBuf(DebugIOInst);
+
+	free(DebugIOInst->Counts);
+	DebugIOInst->Counts = Counts;
+	memset(DebugIOInst->NpiCounts, 0, sizeof(DebugIOInst->NpiCounts));
+	DebugIOInst->Cfg = *Cfg;
+	_XAie_DebugIO_Unlock(DebugIOInst);
+
+	return XAIE_OK;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -56,6 +431,14 @@ typedef struct {
 *******************************************************************************/
 static AieRC XAie_DebugIO_Finish(void *IOInst)
 {
+	XAie_DebugIO *DebugIOInst = (XAie_DebugIO *)IOInst;
+
+	_XAie_DebugIO_OutputSummary(DebugIOInst);
+	_XAie_DebugIO_FlushBuf(DebugIOInst);
+	free(DebugIOInst->Counts);
+#ifdef __linux__
+	pthread_mutex_destroy(&DebugIOInst->Lock);
+#endif
 	free(IOInst);
 	return XAIE_OK;
 }
@@ -76,7 +459,7 @@ static AieRC XAie_DebugIO_Init(XAie_DevInst *DevInst)
 {
 	XAie_DebugIO *IOInst;
 
-	IOInst = (XAie_DebugIO *)malloc(sizeof(*IOInst));
+	IOInst = (XAie_DebugIO *)calloc(1U, sizeof(*IOInst));
 	if(IOInst == NULL) {
 		XAIE_ERROR("Memory allocation failed\n");
 		return XAIE_ERR;
@@ -84,6 +467,11 @@ static AieRC XAie_DebugIO_Init(XAie_DevInst *DevInst)
 
 	IOInst->BaseAddr = DevInst->BaseAddr;
 	IOInst->NpiBaseAddr = XAIE_NPI_BASEADDR;
+	IOInst->DevInst = DevInst;
+#ifdef __linux__
+	pthread_mutex_init(&IOInst->Lock, NULL);
+#endif
+	_XAie_DebugIO_ConfigOutput(IOInst, NULL);
 	DevInst->IOInst = IOInst;
 
 	return XAIE_OK;
@@ -105,9 +493,8 @@ static AieRC XAie_DebugIO_Init(XAie_DevInst *DevInst)
 *******************************************************************************/
 static AieRC XAie_DebugIO_Write32(void *IOInst, u64 RegOff, u32 Value)
 {
-	XAie_DebugIO *DebugIOInst = (XAie_DebugIO *)IOInst;
-
-	printf("W: %p, 0x%x\n", (void *) DebugIOInst->BaseAddr + RegOff, Value);
+	_XAie_DebugIO_Log((XAie_DebugIO *)IOInst, XAIE_DEBUG_ACCESS_WRITE,
+			RegOff, ~0U, Value, 0U);
 
 	return XAIE_OK;
 }
@@ -128,10 +515,9 @@ static AieRC XAie_DebugIO_Write32(void *IOInst, u64 RegOff, u32 Value)
 *******************************************************************************/
 static AieRC XAie_DebugIO_Read32(void *IOInst, u64 RegOff, u32 *Data)
 {
-	XAie_DebugIO *DebugIOInst = (XAie_DebugIO *)IOInst;
-
 	*Data = 0U;
-	printf("R: %p, 0x%x\n", (void *) DebugIOInst->BaseAddr + RegOff, 0);
+	_XAie_DebugIO_Log((XAie_DebugIO *)IOInst, XAIE_DEBUG_ACCESS_READ,
+			RegOff, ~0U, 0U, 0U);
 
 	return XAIE_OK;
 }
@@ -155,10 +541,8 @@ static AieRC XAie_DebugIO_Read32(void *IOInst, u64 RegOff, u32 *Data)
 static AieRC XAie_DebugIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 		u32 Value)
 {
-	XAie_DebugIO *DebugIOInst = (XAie_DebugIO *)IOInst;
-
-	printf("MW: %p, 0x%x, 0x%x\n", (void *) DebugIOInst->BaseAddr + RegOff,
-			Mask, Value);
+	_XAie_DebugIO_Log((XAie_DebugIO *)IOInst, XAIE_DEBUG_ACCESS_MASKWRITE,
+			RegOff, Mask, Value, 0U);
 
 	return XAIE_OK;
 }
@@ -173,6 +557,7 @@ static AieRC XAie_DebugIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 * @param	Mask: Mask to be applied to Data.
 * @param	Value: 32-bit value to poll for
 * @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy, unused.
 *
 * @return	XAIE_ERR.
 *
@@ -180,11 +565,10 @@ static AieRC XAie_DebugIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 *
 *******************************************************************************/
 static AieRC XAie_DebugIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
-		u32 TimeOutUs)
+		u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
-	XAie_DebugIO *DebugIOInst = (XAie_DebugIO *)IOInst;
-
-	printf("MP: %p, 0x%x, 0x%x, 0x%d\n", (void *) DebugIOInst->BaseAddr +
+	(void)Policy;
+	_XAie_DebugIO_Log((XAie_DebugIO *)IOInst, XAIE_DEBUG_ACCESS_MASKPOLL,
 			RegOff, Mask, Value, TimeOutUs);
 
 	return XAIE_ERR;
@@ -241,6 +625,30 @@ static AieRC XAie_DebugIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read a block of data from aie.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Pointer to store the data.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		None.
+*
+*******************************************************************************/
+static AieRC XAie_DebugIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	for(u32 i = 0U; i < Size; i++)
+		XAie_DebugIO_Read32(IOInst, RegOff + i * 4U, &Data[i]);
+
+	return XAIE_OK;
+}
+
 static AieRC XAie_DebugIO_CmdWrite(void *IOInst, u8 Col, u8 Row, u8 Command,
 		u32 CmdWd0, u32 CmdWd1, const char *CmdStr)
 {
@@ -273,11 +681,8 @@ static AieRC XAie_DebugIO_CmdWrite(void *IOInst, u8 Col, u8 Row, u8 Command,
 static void _XAie_DebugIO_NpiWrite32(void *IOInst, u32 RegOff,
 		u32 RegVal)
 {
-	XAie_DebugIO *DebugIOInst = (XAie_DebugIO *)IOInst;
-	u64 RegAddr;
-
-	RegAddr = DebugIOInst->NpiBaseAddr + RegOff;
-	printf("NPIMW: %p, 0x%x\n", (void *) RegAddr, RegVal);
+	_XAie_DebugIO_Log((XAie_DebugIO *)IOInst, XAIE_DEBUG_ACCESS_NPI_WRITE,
+			RegOff, ~0U, RegVal, 0U);
 }
 
 /*****************************************************************************/
@@ -299,10 +704,9 @@ static void _XAie_DebugIO_NpiWrite32(void *IOInst, u32 RegOff,
 static AieRC _XAie_DebugIO_NpiMaskPoll(void *IOInst, u64 RegOff, u32 Mask,
 		u32 Value, u32 TimeOutUs)
 {
-	XAie_DebugIO *DebugIOInst = (XAie_DebugIO *)IOInst;
-
-	printf("MP: %p, 0x%x, 0x%x, 0x%d\n", (void *) DebugIOInst->NpiBaseAddr +
-			RegOff, Mask, Value, TimeOutUs);
+	_XAie_DebugIO_Log((XAie_DebugIO *)IOInst,
+			XAIE_DEBUG_ACCESS_NPI_MASKPOLL, RegOff, Mask, Value,
+			TimeOutUs);
 
 	return XAIE_OK;
 }
@@ -385,6 +789,14 @@ static AieRC XAie_DebugIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 			return _XAie_PrivilegeTeardownPart(DevInst);
 		case XAIE_BACKEND_OP_GET_RSC_STAT:
 			return _XAie_GetRscStatCommon(DevInst, Arg);
+		case XAIE_BACKEND_OP_FLUSH:
+			_XAie_DebugIO_Lock((XAie_DebugIO *)IOInst);
+			_XAie_DebugIO_FlushBuf((XAie_DebugIO *)IOInst);
+			_XAie_DebugIO_Unlock((XAie_DebugIO *)IOInst);
+			break;
+		case XAIE_BACKEND_OP_CONFIG_DEBUG_OUTPUT:
+			return _XAie_DebugIO_ConfigOutput((XAie_DebugIO *)IOInst,
+					(const XAie_DebugOutputCfg *)Arg);
 		default:
 			XAIE_ERROR("Debug backend doesn't support operation"
 					" %u.\n", Op);
@@ -533,6 +945,7 @@ const XAie_Backend DebugBackend =
 	.Ops.MaskPoll = XAie_DebugIO_MaskPoll,
 	.Ops.BlockWrite32 = XAie_DebugIO_BlockWrite32,
 	.Ops.BlockSet32 = XAie_DebugIO_BlockSet32,
+	.Ops.BlockRead32 = XAie_DebugIO_BlockRead32,
 	.Ops.CmdWrite = XAie_DebugIO_CmdWrite,
 	.Ops.RunOp = XAie_DebugIO_RunOp,
 	.Ops.MemAllocate = XAie_DebugMemAllocate,
@@ -0,0 +1,409 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_fault.c
+* @{
+*
+* This file contains the routines to inject latencies and faults in the
+* operations issued to the IO backend of a device instance. It is meant to
+* test the timeouts and error paths of the driver and of the applications
+* without hardware, typically on top of the shadow device or debug backend.
+*
+* The fault injection is an IO wrapper. Each operation is delayed by the delay
+* configured for its type. Mask polls time out intermittently without reaching
+* the backend: they wait for the timeout of the poll and fail like a poll of a
+* register which never reaches the value. Transaction submissions fail
+* intermittently before any of their commands is issued.
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#ifdef __linux__
+#define _XOPEN_SOURCE 600
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+#endif
+
+#include "xaie_helper.h"
+#include "xaie_io.h"
+#include "xaie_io_wrap.h"
+
+#ifdef __linux__
+/************************** Constant Definitions *****************************/
+#define XAIE_FAULT_PER_MILLE		1000U
+
+/**************************** Type Definitions *******************************/
+/* IO instance of the fault injection */
+typedef struct {
+	XAie_IOWrap Wrap;
+	XAie_FaultCfg Cfg;
+	pthread_mutex_t Lock;	/* Protects the random state */
+	u32 Rand;		/* State of the pseudo random sequence */
+} XAie_FaultInst;
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This API sleeps for the configured delay of an operation.
+*
+* @param	Inst: Fault injection instance.
+* @param	Op: Operation.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_FaultDelay(XAie_FaultInst *Inst, XAie_IOStatsOp Op)
+{
+	struct timespec Delay;
+	u32 Ns = Inst->Cfg.DelayNs[Op];
+
+	if(Ns == 0U) {
+		return;
+	}
+
+	Delay.tv_sec = Ns / 1000000000U;
+	Delay.tv_nsec = Ns % 1000000000U;
+	while(nanosleep(&Delay, &Delay) != 0) {
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API draws whether a fault is injected.
+*
+* @param	Inst: Fault injection instance.
+* @param	PerMille: Rate of the fault, per thousand.
+*
+* @return	XAIE_ENABLE if the fault is injected, XAIE_DISABLE otherwise.
+*
+* @note		Internal only. The sequence is a xorshift32 sequence shared by
+*		all the threads.
+*
+*******************************************************************************/
+static u8 _XAie_FaultDraw(XAie_FaultInst *Inst, u16 PerMille)
+{
+	u32 Rand;
+
+	if(PerMille == 0U) {
+		return XAIE_DISABLE;
+	}
+
+	pthread_mutex_lock(&Inst->Lock);
+	Rand = Inst->Rand;
+	Rand ^= Rand << 13U;
+	Rand ^= Rand >> 17U;
+	Rand ^= Rand << 5U;
+	Inst->Rand = Rand;
+	pthread_mutex_unlock(&Inst->Lock);
+
+	return ((Rand % XAIE_FAULT_PER_MILLE) < PerMille) ?
+		XAIE_ENABLE : XAIE_DISABLE;
+}
+
+static AieRC _XAie_Fault_Write32(void *IOInst, u64 RegOff, u32 Value)
+{
+	XAie_FaultInst *Inst = (XAie_FaultInst *)IOInst;
+
+	_XAie_FaultDelay(Inst, XAIE_IOSTATS_WRITE32);
+
+	return Inst->Wrap.Inner->Ops.Write32(Inst->Wrap.InnerIOInst, RegOff,
+			Value);
+}
+
+static AieRC _XAie_Fault_Read32(void *IOInst, u64 RegOff, u32 *Data)
+{
+	XAie_FaultInst *Inst = (XAie_FaultInst *)IOInst;
+
+	_XAie_FaultDelay(Inst, XAIE_IOSTATS_READ32);
+
+	return Inst->Wrap.Inner->Ops.Read32(Inst->Wrap.InnerIOInst, RegOff,
+			Data);
+}
+
+static AieRC _XAie_Fault_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value)
+{
+	XAie_FaultInst *Inst = (XAie_FaultInst *)IOInst;
+
+	_XAie_FaultDelay(Inst, XAIE_IOSTATS_MASKWRITE32);
+
+	return Inst->Wrap.Inner->Ops.MaskWrite32(Inst->Wrap.InnerIOInst, RegOff,
+			Mask, Value);
+}
+
+static AieRC _XAie_Fault_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 TimeOutUs, const XAie_PollPolicy *Policy)
+{
+	XAie_FaultInst *Inst = (XAie_FaultInst *)IOInst;
+
+	_XAie_FaultDelay(Inst, XAIE_IOSTATS_MASKPOLL);
+
+	if(_XAie_FaultDraw(Inst, Inst->Cfg.PollTimeOutPerMille) ==
+			XAIE_ENABLE) {
+		struct timespec TimeOut = {
+			.tv_sec = TimeOutUs / 1000000U,
+			.tv_nsec = (TimeOutUs % 1000000U) * 1000U,
+		};
+
+		while(nanosleep(&TimeOut, &TimeOut) != 0) {
+		}
+		XAIE_DBG("Injected poll timeout. Addr: 0x%lx\n", RegOff);
+		return XAIE_ERR;
+	}
+
+	return Inst->Wrap.Inner->Ops.MaskPoll(Inst->Wrap.InnerIOInst, RegOff,
+			Mask, Value, TimeOutUs, Policy);
+}
+
+static AieRC _XAie_Fault_BlockWrite32(void *IOInst, u64 RegOff,
+		const u32 *Data, u32 Size)
+{
+	XAie_FaultInst *Inst = (XAie_FaultInst *)IOInst;
+
+	_XAie_FaultDelay(Inst, XAIE_IOSTATS_BLOCKWRITE32);
+
+	return Inst->Wrap.Inner->Ops.BlockWrite32(Inst->Wrap.InnerIOInst,
+			RegOff, Data, Size);
+}
+
+static AieRC _XAie_Fault_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	XAie_FaultInst *Inst = (XAie_FaultInst *)IOInst;
+
+	_XAie_FaultDelay(Inst, XAIE_IOSTATS_BLOCKSET32);
+
+	return Inst->Wrap.Inner->Ops.BlockSet32(Inst->Wrap.InnerIOInst, RegOff,
+			Data, Size);
+}
+
+static AieRC _XAie_Fault_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	XAie_FaultInst *Inst = (XAie_FaultInst *)IOInst;
+
+	_XAie_FaultDelay(Inst, XAIE_IOSTATS_BLOCKREAD32);
+
+	return Inst->Wrap.Inner->Ops.BlockRead32(Inst->Wrap.InnerIOInst,
+			RegOff, Data, Size);
+}
+
+static AieRC _XAie_Fault_RunOp(void *IOInst, XAie_DevInst *DevInst,
+		XAie_BackendOpCode Op, void *Arg)
+{
+	XAie_FaultInst *Inst = (XAie_FaultInst *)IOInst;
+
+	_XAie_FaultDelay(Inst, XAIE_IOSTATS_RUNOP);
+
+	return Inst->Wrap.Inner->Ops.RunOp(Inst->Wrap.InnerIOInst, DevInst, Op,
+			Arg);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API submits a transaction, or fails it at the configured rate. If the
+* wrapped backend has no transaction submission, the commands are issued one by
+* one to the backend.
+*
+* @param	IOInst: IO instance pointer of the fault injection.
+* @param	TxnInst: Transaction instance.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only. The driver submits the commands between the
+*		polls and reads of a transaction, so only writes are issued.
+*
+*******************************************************************************/
+static AieRC _XAie_Fault_SubmitTxn(void *IOInst, XAie_TxnInst *TxnInst)
+{
+	XAie_FaultInst *Inst = (XAie_FaultInst *)IOInst;
+	const XAie_BackendOps *Ops = &Inst->Wrap.Inner->Ops;
+	void *InnerIOInst = Inst->Wrap.InnerIOInst;
+	AieRC RC = XAIE_OK;
+
+	_XAie_FaultDelay(Inst, XAIE_IOSTATS_SUBMITTXN);
+
+	if(_XAie_FaultDraw(Inst, Inst->Cfg.TxnFailPerMille) == XAIE_ENABLE) {
+		XAIE_DBG("Injected transaction submission failure\n");
+		return XAIE_ERR;
+	}
+
+	if(Ops->SubmitTxn != NULL) {
+		return Ops->SubmitTxn(InnerIOInst, TxnInst);
+	}
+
+	for(u32 i = 0U; (i < TxnInst->NumCmds) && (RC == XAIE_OK); i++) {
+		const XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i];
+
+		switch(Cmd->Opcode) {
+			case XAIE_IO_WRITE:
+				if(Cmd->Mask == 0U) {
+					RC = Ops->Write32(InnerIOInst,
+							Cmd->RegOff,
+							Cmd->Value);
+				} else {
+					RC = Ops->MaskWrite32(InnerIOInst,
+							Cmd->RegOff, Cmd->Mask,
+							Cmd->Value);
+				}
+				break;
+			case XAIE_IO_BLOCKWRITE:
+				RC = Ops->BlockWrite32(InnerIOInst, Cmd->RegOff,
+						(u32 *)(uintptr_t)Cmd->DataPtr,
+						Cmd->Size);
+				break;
+			case XAIE_IO_BLOCKSET:
+				RC = Ops->BlockSet32(InnerIOInst, Cmd->RegOff,
+						Cmd->Value, Cmd->Size);
+				break;
+			default:
+				XAIE_ERROR("Invalid transaction opcode\n");
+				RC = XAIE_ERR;
+				break;
+		}
+	}
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API releases the fault injection.
+*
+* @param	Wrap: Wrapper of the fault injection.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_FaultRelease(XAie_IOWrap *Wrap)
+{
+	XAie_FaultInst *Inst = (XAie_FaultInst *)Wrap;
+
+	pthread_mutex_destroy(&Inst->Lock);
+	free(Inst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API starts to inject latencies and faults in the operations issued to
+* the IO backend of a device instance.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Cfg: Fault injection configuration.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+AieRC _XAie_FaultStart(XAie_DevInst *DevInst, const XAie_FaultCfg *Cfg)
+{
+	static const XAie_BackendOps Ops = {
+		.Write32 = _XAie_Fault_Write32,
+		.Read32 = _XAie_Fault_Read32,
+		.MaskWrite32 = _XAie_Fault_MaskWrite32,
+		.MaskPoll = _XAie_Fault_MaskPoll,
+		.BlockWrite32 = _XAie_Fault_BlockWrite32,
+		.BlockSet32 = _XAie_Fault_BlockSet32,
+		.BlockRead32 = _XAie_Fault_BlockRead32,
+		.RunOp = _XAie_Fault_RunOp,
+		.SubmitTxn = _XAie_Fault_SubmitTxn,
+	};
+	XAie_FaultInst *Inst;
+	AieRC RC;
+
+	if((Cfg->PollTimeOutPerMille > XAIE_FAULT_PER_MILLE) ||
+			(Cfg->TxnFailPerMille > XAIE_FAULT_PER_MILLE)) {
+		XAIE_ERROR("Invalid fault rate\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	if(_XAie_IOWrapFind(DevInst, _XAie_FaultRelease) != NULL) {
+		XAIE_ERROR("Fault injection is already started\n");
+		return XAIE_ERR;
+	}
+
+	Inst = (XAie_FaultInst *)calloc(1U, sizeof(*Inst));
+	if(Inst == NULL) {
+		XAIE_ERROR("Failed to allocate memory for the fault injection\n");
+		return XAIE_ERR;
+	}
+
+	Inst->Cfg = *Cfg;
+	/* xorshift32 never leaves the zero state */
+	Inst->Rand = (Cfg->Seed != 0U) ? Cfg->Seed : 1U;
+	pthread_mutex_init(&Inst->Lock, NULL);
+
+	RC = _XAie_IOWrapInstall(DevInst, &Inst->Wrap, &Ops,
+			_XAie_FaultRelease);
+	if(RC != XAIE_OK) {
+		pthread_mutex_destroy(&Inst->Lock);
+		free(Inst);
+	}
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API stops the fault injection of a device instance.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success, XAIE_ERR if the fault injection is not
+*		started.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+AieRC _XAie_FaultStop(XAie_DevInst *DevInst)
+{
+	XAie_IOWrap *Wrap;
+
+	Wrap = _XAie_IOWrapFind(DevInst, _XAie_FaultRelease);
+	if(Wrap == NULL) {
+		XAIE_ERROR("Fault injection is not started\n");
+		return XAIE_ERR;
+	}
+
+	return _XAie_IOWrapRemove(DevInst, Wrap);
+}
+
+#else
+
+AieRC _XAie_FaultStart(XAie_DevInst *DevInst, const XAie_FaultCfg *Cfg)
+{
+	(void)DevInst;
+	(void)Cfg;
+
+	XAIE_ERROR("Fault injection is not supported\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+AieRC _XAie_FaultStop(XAie_DevInst *DevInst)
+{
+	(void)DevInst;
+
+	XAIE_ERROR("Fault injection is not supported\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+#endif /* __linux__ */
+
+/** @} */
@@ -25,6 +25,14 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define XAIE_IO_MEM_X86
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define XAIE_IO_MEM_NEON
+#endif
+
 #include "xaie_feature_config.h"
 #include "xaie_io.h"
 #include "xaie_helper.h"
@@ -32,6 +40,11 @@
 /*****************************************************************************/
 /***************************** Macro Definitions *****************************/
 #define XAIE_BROADCAST_CHANNEL_MASK     0xFFFFU
+#define XAIE_IO_128BIT_ALIGN_MASK	0xFU
+#define XAIE_IO_256BIT_ALIGN_MASK	0x1FU
+
+/************************** Variable Definitions *****************************/
+extern int usleep(unsigned int usec);
 
 /************************** Function Definitions *****************************/
 #ifdef XAIE_FEATURE_RSC_ENABLE
@@ -663,4 +676,480 @@ void _XAie_IOCommon_MarkTilesInUse(XAie_DevInst *DevInst,
 	}
 }
 
+/*****************************************************************************/
+/**
+* This API polls a register until the masked value matches, following the poll
+* policy. The register is read back to back for the spin phase of the policy,
+* then the sleep between reads grows exponentially up to the cap of the policy.
+*
+* @param	IOInst: IO instance pointer
+* @param	Read32: Read operation of the backend
+* @param	RegOff: Register offset to read from.
+* @param	Mask: Mask to be applied to Data.
+* @param	Value: 32-bit value to poll for
+* @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy.
+*
+* @return	XAIE_OK or XAIE_ERR.
+*
+* @note		Internal only. The register is read once more after the
+*		timeout expires. The time spent in reads is not accounted for.
+*
+*******************************************************************************/
+AieRC _XAie_IOCommon_MaskPoll(void *IOInst,
+		AieRC (*Read32)(void *IOInst, u64 RegOff, u32 *Data),
+		u64 RegOff, u32 Mask, u32 Value, u32 TimeOutUs,
+		const XAie_PollPolicy *Policy)
+{
+	u32 Spin = Policy->SpinCount;
+	u32 SleepUs = Policy->MinSleepUs;
+	u32 ElapsedUs = 0U;
+	u32 RegVal;
+
+	while(1) {
+		if((Read32(IOInst, RegOff, &RegVal) == XAIE_OK) &&
+				((RegVal & Mask) == Value)) {
+			return XAIE_OK;
+		}
+
+		if(ElapsedUs >= TimeOutUs) {
+			return XAIE_ERR;
+		}
+
+		if(Spin > 0U) {
+			Spin--;
+			continue;
+		}
+
+		if(SleepUs > TimeOutUs - ElapsedUs) {
+			SleepUs = TimeOutUs - ElapsedUs;
+		}
+		usleep(SleepUs);
+		ElapsedUs += SleepUs;
+
+		if(SleepUs < Policy->MaxSleepUs / 2U) {
+			SleepUs *= 2U;
+		} else {
+			SleepUs = Policy->MaxSleepUs;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+* This API decodes the tile and the module of a register offset. Offsets of
+* AIE tiles from the program memory up belong to the core module, the other
+* offsets of AIE tiles and memory tiles belong to the memory module. Offsets of
+* shim tiles belong to the PL module.
+*
+* @param	DevInst: Device instance pointer
+* @param	RegOff: Register offset.
+* @param	Loc: Pointer to store the tile location.
+* @param	Mod: Pointer to store the module.
+*
+* @return	Tile type, XAIEGBL_TILE_TYPE_MAX if the offset is not in a tile
+*		of the partition.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+u8 _XAie_IOCommon_GetTileMod(XAie_DevInst *DevInst, u64 RegOff,
+		XAie_LocType *Loc, XAie_ModuleType *Mod)
+{
+	const XAie_CoreMod *CoreMod;
+	u8 RowShift = DevInst->DevProp.RowShift;
+	u8 ColShift = DevInst->DevProp.ColShift;
+	u64 Col = RegOff >> ColShift;
+	u64 Row = (RegOff >> RowShift) & ((1ULL << (ColShift - RowShift)) - 1U);
+	u8 TileType;
+
+	*Mod = XAIE_MEM_MOD;
+	if((Col >= DevInst->NumCols) || (Row >= DevInst->NumRows)) {
+		*Loc = XAie_TileLoc(0xFFU, 0xFFU);
+		return XAIEGBL_TILE_TYPE_MAX;
+	}
+
+	*Loc = XAie_TileLoc((u8)Col, (u8)Row);
+	TileType = DevInst->DevOps->GetTTypefromLoc(DevInst, *Loc);
+	if(TileType == XAIEGBL_TILE_TYPE_AIETILE) {
+		CoreMod = DevInst->DevProp.DevMod[TileType].CoreMod;
+		if((RegOff & ((1ULL << RowShift) - 1U)) >=
+				CoreMod->ProgMemHostOffset) {
+			*Mod = XAIE_CORE_MOD;
+		}
+	} else if((TileType == XAIEGBL_TILE_TYPE_SHIMNOC) ||
+			(TileType == XAIEGBL_TILE_TYPE_SHIMPL)) {
+		*Mod = XAIE_PL_MOD;
+	}
+
+	return TileType;
+}
+
+/*****************************************************************************/
+/**
+* This API checks if a block of words lies within the program memory or data
+* memory of a single tile. Such blocks can be written to the mapped array with
+* wide stores.
+*
+* @param	DevInst: Device instance pointer
+* @param	RegOff: Register offset of the first word.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_ENABLE if the block is in a memory, XAIE_DISABLE otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+u8 _XAie_IOCommon_IsMemRange(XAie_DevInst *DevInst, u64 RegOff, u32 Size)
+{
+	const XAie_CoreMod *CoreMod;
+	const XAie_MemMod *MemMod;
+	u64 TileOff, EndOff;
+	u8 RowShift = DevInst->DevProp.RowShift;
+	u8 ColShift = DevInst->DevProp.ColShift;
+	u8 TileType;
+
+	TileOff = RegOff & ((1ULL << RowShift) - 1U);
+	EndOff = TileOff + (u64)Size * sizeof(u32);
+	TileType = DevInst->DevOps->GetTTypefromLoc(DevInst,
+			XAie_TileLoc((u8)(RegOff >> ColShift),
+				(u8)((RegOff >> RowShift) &
+				((1ULL << (ColShift - RowShift)) - 1U))));
+
+	if(TileType == XAIEGBL_TILE_TYPE_AIETILE) {
+		CoreMod = DevInst->DevProp.DevMod[TileType].CoreMod;
+		if((TileOff >= CoreMod->ProgMemHostOffset) &&
+				(EndOff <= (u64)CoreMod->ProgMemHostOffset +
+				 CoreMod->ProgMemSize)) {
+			return XAIE_ENABLE;
+		}
+	} else if(TileType != XAIEGBL_TILE_TYPE_MEMTILE) {
+		return XAIE_DISABLE;
+	}
+
+	MemMod = DevInst->DevProp.DevMod[TileType].MemMod;
+	if((TileOff >= MemMod->MemAddr) &&
+			(EndOff <= (u64)MemMod->MemAddr + MemMod->Size)) {
+		return XAIE_ENABLE;
+	}
+
+	return XAIE_DISABLE;
+}
+
+#ifdef XAIE_IO_MEM_X86
+/*****************************************************************************/
+/**
+* This API copies a 128-bit aligned block to device memory with SSE2 streaming
+* stores.
+*
+* @param	Dest: Pointer to the 128-bit aligned destination address.
+* @param	Src: Pointer to the source buffer.
+* @param	Size: Number of 32-bit words. Must be a multiple of 4.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_IOCommon_CopyBodySse2(u32 *Dest, const u32 *Src, u32 Size)
+{
+	for(u32 i = 0U; i < Size; i += 4U) {
+		_mm_stream_si128((__m128i *)(Dest + i),
+				_mm_loadu_si128((const __m128i *)(Src + i)));
+	}
+
+	_mm_sfence();
+}
+
+/*****************************************************************************/
+/**
+* This API copies a 128-bit aligned block to device memory with AVX2 streaming
+* stores. A 128-bit store is used at either end of the block to reach and
+* leave 256-bit alignment.
+*
+* @param	Dest: Pointer to the 128-bit aligned destination address.
+* @param	Src: Pointer to the source buffer.
+* @param	Size: Number of 32-bit words. Must be a multiple of 4.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+__attribute__((target("avx2")))
+static void _XAie_IOCommon_CopyBodyAvx2(u32 *Dest, const u32 *Src, u32 Size)
+{
+	u32 i = 0U;
+
+	if(((u64)Dest & XAIE_IO_256BIT_ALIGN_MASK) != 0U) {
+		_mm_stream_si128((__m128i *)Dest,
+				_mm_loadu_si128((const __m128i *)Src));
+		i = 4U;
+	}
+
+	for(; i + 8U <= Size; i += 8U) {
+		_mm256_stream_si256((__m256i *)(Dest + i),
+				_mm256_loadu_si256((const __m256i *)(Src + i)));
+	}
+
+	if(i < Size) {
+		_mm_stream_si128((__m128i *)(Dest + i),
+				_mm_loadu_si128((const __m128i *)(Src + i)));
+	}
+
+	_mm_sfence();
+}
+
+/*****************************************************************************/
+/**
+* This API initializes a 128-bit aligned block of device memory with SSE2
+* streaming stores.
+*
+* @param	Dest: Pointer to the 128-bit aligned destination address.
+* @param	Data: Value to write to each word.
+* @param	Size: Number of 32-bit words. Must be a multiple of 4.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_IOCommon_SetBodySse2(u32 *Dest, u32 Data, u32 Size)
+{
+	__m128i Val = _mm_set1_epi32((int)Data);
+
+	for(u32 i = 0U; i < Size; i += 4U) {
+		_mm_stream_si128((__m128i *)(Dest + i), Val);
+	}
+
+	_mm_sfence();
+}
+
+/*****************************************************************************/
+/**
+* This API initializes a 128-bit aligned block of device memory with AVX2
+* streaming stores.
+*
+* @param	Dest: Pointer to the 128-bit aligned destination address.
+* @param	Data: Value to write to each word.
+* @param	Size: Number of 32-bit words. Must be a multiple of 4.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+__attribute__((target("avx2")))
+static void _XAie_IOCommon_SetBodyAvx2(u32 *Dest, u32 Data, u32 Size)
+{
+	__m256i Val = _mm256_set1_epi32((int)Data);
+	u32 i = 0U;
+
+	if(((u64)Dest & XAIE_IO_256BIT_ALIGN_MASK) != 0U) {
+		_mm_stream_si128((__m128i *)Dest, _mm256_castsi256_si128(Val));
+		i = 4U;
+	}
+
+	for(; i + 8U <= Size; i += 8U) {
+		_mm256_stream_si256((__m256i *)(Dest + i), Val);
+	}
+
+	if(i < Size) {
+		_mm_stream_si128((__m128i *)(Dest + i),
+				_mm256_castsi256_si128(Val));
+	}
+
+	_mm_sfence();
+}
+#endif /* XAIE_IO_MEM_X86 */
+
+#if defined(XAIE_IO_MEM_NEON) && defined(__aarch64__)
+/*****************************************************************************/
+/**
+* This API writes 128 bits to device memory with a non-temporal store pair.
+*
+* @param	Dest: Pointer to the 128-bit aligned destination address.
+* @param	Lo: Lower 64 bits.
+* @param	Hi: Upper 64 bits.
+*
+* @return	None.
+*
+* @note		Internal only. A store barrier must follow the last store, as
+*		_mm_sfence() does on x86.
+*
+*******************************************************************************/
+static inline void _XAie_IOCommon_StoreNt(u32 *Dest, u64 Lo, u64 Hi)
+{
+	__asm__ volatile("stnp %x0, %x1, [%2]" : : "r"(Lo), "r"(Hi),
+			"r"(Dest) : "memory");
+}
+#endif
+
+/*****************************************************************************/
+/**
+* This API copies the 128-bit aligned body of a block to device memory. On x86
+* the AVX2 or SSE2 kernel is picked at runtime, on AArch64 non-temporal store
+* pairs are used, on 32-bit ARM NEON stores are used and other targets use
+* 64-bit stores.
+*
+* @param	Dest: Pointer to the 128-bit aligned destination address.
+* @param	Src: Pointer to the source buffer.
+* @param	Size: Number of 32-bit words. Must be a multiple of 4.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_IOCommon_CopyBody(u32 *Dest, const u32 *Src, u32 Size)
+{
+#if defined(XAIE_IO_MEM_X86)
+	if(__builtin_cpu_supports("avx2")) {
+		_XAie_IOCommon_CopyBodyAvx2(Dest, Src, Size);
+	} else {
+		_XAie_IOCommon_CopyBodySse2(Dest, Src, Size);
+	}
+#elif defined(XAIE_IO_MEM_NEON) && defined(__aarch64__)
+	u64 Val[2];
+
+	for(u32 i = 0U; i < Size; i += 4U) {
+		memcpy(Val, Src + i, sizeof(Val));
+		_XAie_IOCommon_StoreNt(Dest + i, Val[0], Val[1]);
+	}
+
+	__asm__ volatile("dmb oshst" : : : "memory");
+#elif defined(XAIE_IO_MEM_NEON)
+	for(u32 i = 0U; i < Size; i += 4U) {
+		vst1q_u32(Dest + i, vld1q_u32(Src + i));
+	}
+#else
+	u64 Val;
+
+	for(u32 i = 0U; i < Size; i += 2U) {
+		memcpy(&Val, Src + i, sizeof(Val));
+		*(u64 *)(Dest + i) = Val;
+	}
+#endif
+}
+
+/*****************************************************************************/
+/**
+* This API initializes the 128-bit aligned body of a block of device memory.
+* The kernel is picked the same way as for _XAie_IOCommon_CopyBody().
+*
+* @param	Dest: Pointer to the 128-bit aligned destination address.
+* @param	Data: Value to write to each word.
+* @param	Size: Number of 32-bit words. Must be a multiple of 4.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_IOCommon_SetBody(u32 *Dest, u32 Data, u32 Size)
+{
+#if defined(XAIE_IO_MEM_X86)
+	if(__builtin_cpu_supports("avx2")) {
+		_XAie_IOCommon_SetBodyAvx2(Dest, Data, Size);
+	} else {
+		_XAie_IOCommon_SetBodySse2(Dest, Data, Size);
+	}
+#elif defined(XAIE_IO_MEM_NEON) && defined(__aarch64__)
+	u64 Val = ((u64)Data << 32U) | Data;
+
+	for(u32 i = 0U; i < Size; i += 4U) {
+		_XAie_IOCommon_StoreNt(Dest + i, Val, Val);
+	}
+
+	__asm__ volatile("dmb oshst" : : : "memory");
+#elif defined(XAIE_IO_MEM_NEON)
+	uint32x4_t Val = vdupq_n_u32(Data);
+
+	for(u32 i = 0U; i < Size; i += 4U) {
+		vst1q_u32(Dest + i, Val);
+	}
+#else
+	u64 Val = ((u64)Data << 32U) | Data;
+
+	for(u32 i = 0U; i < Size; i += 2U) {
+		*(u64 *)(Dest + i) = Val;
+	}
+#endif
+}
+
+/*****************************************************************************/
+/**
+* This API copies a block of words to mapped device memory. Words are written
+* one at a time up to the first 128-bit boundary of the destination, the
+* aligned body is written with the widest stores of the host and the
+* remaining words are written one at a time.
+*
+* @param	Dest: Pointer to the destination address.
+* @param	Src: Pointer to the source buffer.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only. The destination has to be 32-bit aligned.
+*
+*******************************************************************************/
+void _XAie_IOCommon_CopyDataToMem(u32 *Dest, const u32 *Src, u32 Size)
+{
+	u32 BodySize;
+
+	while((Size > 0U) && (((u64)Dest & XAIE_IO_128BIT_ALIGN_MASK) != 0U)) {
+		*Dest++ = *Src++;
+		Size--;
+	}
+
+	BodySize = Size & ~3U;
+	if(BodySize > 0U) {
+		_XAie_IOCommon_CopyBody(Dest, Src, BodySize);
+		Dest += BodySize;
+		Src += BodySize;
+		Size -= BodySize;
+	}
+
+	while(Size > 0U) {
+		*Dest++ = *Src++;
+		Size--;
+	}
+}
+
+/*****************************************************************************/
+/**
+* This API initializes a block of mapped device memory with a 32-bit value,
+* using the same head, body and tail split as _XAie_IOCommon_CopyDataToMem().
+*
+* @param	Dest: Pointer to the destination address.
+* @param	Data: Value to write to each word.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only. The destination has to be 32-bit aligned.
+*
+*******************************************************************************/
+void _XAie_IOCommon_SetDataInMem(u32 *Dest, u32 Data, u32 Size)
+{
+	u32 BodySize;
+
+	while((Size > 0U) && (((u64)Dest & XAIE_IO_128BIT_ALIGN_MASK) != 0U)) {
+		*Dest++ = Data;
+		Size--;
+	}
+
+	BodySize = Size & ~3U;
+	if(BodySize > 0U) {
+		_XAie_IOCommon_SetBody(Dest, Data, BodySize);
+		Dest += BodySize;
+		Size -= BodySize;
+	}
+
+	while(Size > 0U) {
+		*Dest++ = Data;
+		Size--;
+	}
+}
+
 /** @} */
@@ -31,6 +31,15 @@ static inline u64 XAie_IODummyGetTid(void)
 
 void _XAie_IOCommon_MarkTilesInUse(XAie_DevInst *DevInst,
 		XAie_BackendTilesArray *Args);
+AieRC _XAie_IOCommon_MaskPoll(void *IOInst,
+		AieRC (*Read32)(void *IOInst, u64 RegOff, u32 *Data),
+		u64 RegOff, u32 Mask, u32 Value, u32 TimeOutUs,
+		const XAie_PollPolicy *Policy);
+u8 _XAie_IOCommon_GetTileMod(XAie_DevInst *DevInst, u64 RegOff,
+		XAie_LocType *Loc, XAie_ModuleType *Mod);
+u8 _XAie_IOCommon_IsMemRange(XAie_DevInst *DevInst, u64 RegOff, u32 Size);
+void _XAie_IOCommon_CopyDataToMem(u32 *Dest, const u32 *Src, u32 Size);
+void _XAie_IOCommon_SetDataInMem(u32 *Dest, u32 Data, u32 Size);
 
 #ifndef XAIE_FEATURE_RSC_ENABLE
 static inline AieRC _XAie_RequestRscCommon(XAie_DevInst *DevInst,
@@ -0,0 +1,460 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_io_wrap.c
+* @{
+*
+* This file contains the routines to stack wrappers on top of the IO backend of
+* a device instance. A wrapper only implements the ops it is interested in, the
+* other ops are forwarded to the wrapped backend by the routines of this file.
+* Wrappers can be stacked on top of each other.
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#include "xaie_helper.h"
+#include "xaie_io.h"
+#include "xaie_io_wrap.h"
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This is the init op of the wrappers. Wrappers are installed on a device
+* instance whose backend is initialized, they can't be selected as backend.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_INVALID_BACKEND.
+*
+* @note		Internal only. The op is also used to tell wrappers apart from
+*		backends.
+*
+*******************************************************************************/
+static AieRC _XAie_IOWrap_Init(XAie_DevInst *DevInst)
+{
+	(void)DevInst;
+
+	XAIE_ERROR("IO wrapper can't be used as backend\n");
+	return XAIE_INVALID_BACKEND;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the finish op of the wrappers. It releases the wrapper and finishes
+* the wrapped backend.
+*
+* @param	IOInst: IO instance pointer of the wrapper.
+*
+* @return	Return code of the finish op of the wrapped backend.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_IOWrap_Finish(void *IOInst)
+{
+	XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+	const XAie_Backend *Inner = Wrap->Inner;
+	void *InnerIOInst = Wrap->InnerIOInst;
+
+	Wrap->DevInst->Backend = Inner;
+	Wrap->DevInst->IOInst = InnerIOInst;
+	Wrap->Release(Wrap);
+
+	return Inner->Ops.Finish(InnerIOInst);
+}
+
+static AieRC _XAie_IOWrap_Write32(void *IOInst, u64 RegOff, u32 Value)
+{
+	XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+
+	return Wrap->Inner->Ops.Write32(Wrap->InnerIOInst, RegOff, Value);
+}
+
+static AieRC _XAie_IOWrap_Read32(void *IOInst, u64 RegOff, u32 *Data)
+{
+	XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+
+	return Wrap->Inner->Ops.Read32(Wrap->InnerIOInst, RegOff, Data);
+}
+
+static AieRC _XAie_IOWrap_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value)
+{
+	XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+
+	return Wrap->Inner->Ops.MaskWrite32(Wrap->InnerIOInst, RegOff, Mask,
+			Value);
+}
+
+static AieRC _XAie_IOWrap_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 TimeOutUs, const XAie_PollPolicy *Policy)
+{
+	XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+
+	return Wrap->Inner->Ops.MaskPoll(Wrap->InnerIOInst, RegOff, Mask,
+			Value, TimeOutUs, Policy);
+}
+
+static AieRC _XAie_IOWrap_BlockWrite32(void *IOInst, u64 RegOff,
+		const u32 *Data, u32 Size)
+{
+	XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+
+	return Wrap->Inner->Ops.BlockWrite32(Wrap->InnerIOInst, RegOff, Data,
+			Size);
+}
+
+static AieRC _XAie_IOWrap_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+
+	return Wrap->Inner->Ops.BlockSet32(Wrap->InnerIOInst, RegOff, Data,
+			Size);
+}
+
+static AieRC _XAie_IOWrap_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+
+	return Wrap->Inner->Ops.BlockRead32(Wrap->InnerIOInst, RegOff, Data,
+			Size);
+}
+
+static AieRC _XAie_IOWrap_CmdWrite(void *IOInst, u8 Col, u8 Row, u8 Command,
+		u32 CmdWd0, u32 CmdWd1, const char *CmdStr)
+{
+	XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+
+	return Wrap->Inner->Ops.CmdWrite(Wrap->InnerIOInst, Col, Row, Command,
+			CmdWd0, CmdWd1, CmdStr);
+}
+
+static AieRC _XAie_IOWrap_RunOp(void *IOInst, XAie_DevInst *DevInst,
+		XAie_BackendOpCode Op, void *Arg)
+{
+	XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+
+	return Wrap->Inner->Ops.RunOp(Wrap->InnerIOInst, DevInst, Op, Arg);
+}
+
+static AieRC _XAie_IOWrap_SubmitTxn(void *IOInst, XAie_TxnInst *TxnInst)
+{
+	XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+
+	return Wrap->Inner->Ops.SubmitTxn(Wrap->InnerIOInst, TxnInst);
+}
+
+/*****************************************************************************/
+/**
+*
+* The memory ops of the backends find their IO instance through the device
+* instance. This API fills a private copy of the device instance which points
+* to the wrapped backend, for the memory ops of the wrapped backend to run on.
+*
+* @param	DevInst: Device instance pointer, whose IO instance is the
+*		wrapper.
+* @param	Inner: Pointer to the copy of the device instance.
+*
+* @return	None.
+*
+* @note		Internal only. The device instance itself is never modified, so
+*		memory ops may run concurrently with the other ops.
+*
+*******************************************************************************/
+static void _XAie_IOWrapInnerDevInst(const XAie_DevInst *DevInst,
+		XAie_DevInst *Inner)
+{
+	const XAie_IOWrap *Wrap = (const XAie_IOWrap *)DevInst->IOInst;
+
+	*Inner = *DevInst;
+	Inner->Backend = Wrap->Inner;
+	Inner->IOInst = Wrap->InnerIOInst;
+}
+
+static XAie_MemInst* _XAie_IOWrap_MemAllocate(XAie_DevInst *DevInst, u64 Size,
+		XAie_MemCacheProp Cache)
+{
+	XAie_DevInst Inner;
+	XAie_MemInst *MemInst;
+
+	_XAie_IOWrapInnerDevInst(DevInst, &Inner);
+	MemInst = Inner.Backend->Ops.MemAllocate(&Inner, Size, Cache);
+	if(MemInst != NULL) {
+		MemInst->DevInst = DevInst;
+	}
+
+	return MemInst;
+}
+
+static AieRC _XAie_IOWrap_MemFree(XAie_MemInst *MemInst)
+{
+	XAie_DevInst Inner;
+
+	_XAie_IOWrapInnerDevInst(MemInst->DevInst, &Inner);
+	MemInst->DevInst = &Inner;
+
+	return Inner.Backend->Ops.MemFree(MemInst);
+}
+
+static AieRC _XAie_IOWrap_MemSyncForCPU(XAie_MemInst *MemInst)
+{
+	XAie_DevInst *DevInst = MemInst->DevInst;
+	XAie_DevInst Inner;
+	AieRC RC;
+
+	_XAie_IOWrapInnerDevInst(DevInst, &Inner);
+	MemInst->DevInst = &Inner;
+	RC = Inner.Backend->Ops.MemSyncForCPU(MemInst);
+	MemInst->DevInst = DevInst;
+
+	return RC;
+}
+
+static AieRC _XAie_IOWrap_MemSyncForDev(XAie_MemInst *MemInst)
+{
+	XAie_DevInst *DevInst = MemInst->DevInst;
+	XAie_DevInst Inner;
+	AieRC RC;
+
+	_XAie_IOWrapInnerDevInst(DevInst, &Inner);
+	MemInst->DevInst = &Inner;
+	RC = Inner.Backend->Ops.MemSyncForDev(MemInst);
+	MemInst->DevInst = DevInst;
+
+	return RC;
+}
+
+static AieRC _XAie_IOWrap_MemAttach(XAie_MemInst *MemInst, u64 MemHandle)
+{
+	XAie_DevInst *DevInst = MemInst->DevInst;
+	XAie_DevInst Inner;
+	AieRC RC;
+
+	_XAie_IOWrapInnerDevInst(DevInst, &Inner);
+	MemInst->DevInst = &Inner;
+	RC = Inner.Backend->Ops.MemAttach(MemInst, MemHandle);
+	MemInst->DevInst = DevInst;
+
+	return RC;
+}
+
+static AieRC _XAie_IOWrap_MemDetach(XAie_MemInst *MemInst)
+{
+	XAie_DevInst *DevInst = MemInst->DevInst;
+	XAie_DevInst Inner;
+	AieRC RC;
+
+	_XAie_IOWrapInnerDevInst(DevInst, &Inner);
+	MemInst->DevInst = &Inner;
+	RC = Inner.Backend->Ops.MemDetach(MemInst);
+	MemInst->DevInst = DevInst;
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API checks that a device instance is idle, so that a wrapper can be
+* installed or removed. The ops of the device instance find the backend
+* without any lock, the backend can only be changed when no transaction is
+* open and no asynchronous submission is pending.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK if the device instance is idle, XAIE_ERR otherwise.
+*
+* @note		Internal only. Accesses of other threads can't be detected, the
+*		caller must not access the device instance from another thread
+*		meanwhile.
+*
+*******************************************************************************/
+static AieRC _XAie_IOWrapCheckIdle(XAie_DevInst *DevInst)
+{
+	if(__atomic_load_n(&DevInst->NumTxns, __ATOMIC_ACQUIRE) != 0U) {
+		XAIE_ERROR("IO wrappers can't be changed while a transaction "
+				"is open\n");
+		return XAIE_ERR;
+	}
+
+	if(_XAie_TxnAsyncIsIdle(DevInst) != XAIE_ENABLE) {
+		XAIE_ERROR("IO wrappers can't be changed while transactions "
+				"are queued\n");
+		return XAIE_ERR;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API installs a wrapper on top of the IO backend of a device instance.
+* The ops of the wrapper which are NULL forward to the wrapped backend.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Wrap: Wrapper. The IO instance of the wrapper starts with it.
+* @param	Ops: Ops of the wrapper. Init, Finish and GetTid are ignored.
+* @param	Release: Function to free the wrapper.
+*
+* @return	XAIE_OK on success, XAIE_ERR if the device instance is not idle.
+*
+* @note		Internal only. The wrapper has the type of the wrapped backend,
+*		and has a SubmitTxn op only if the wrapped backend or Ops have
+*		one. The wrapper is released by the caller on failure.
+*
+*******************************************************************************/
+AieRC _XAie_IOWrapInstall(XAie_DevInst *DevInst, XAie_IOWrap *Wrap,
+		const XAie_BackendOps *Ops,
+		void (*Release)(XAie_IOWrap *Wrap))
+{
+	XAie_BackendOps *WrapOps = &Wrap->Backend.Ops;
+
+	if(_XAie_IOWrapCheckIdle(DevInst) != XAIE_OK) {
+		return XAIE_ERR;
+	}
+
+	Wrap->Backend.Type = DevInst->Backend->Type;
+	Wrap->Inner = DevInst->Backend;
+	Wrap->InnerIOInst = DevInst->IOInst;
+	Wrap->DevInst = DevInst;
+	Wrap->Release = Release;
+
+	*WrapOps = *Ops;
+	WrapOps->Init = _XAie_IOWrap_Init;
+	WrapOps->Finish = _XAie_IOWrap_Finish;
+	WrapOps->GetTid = Wrap->Inner->Ops.GetTid;
+	if(WrapOps->Write32 == NULL) {
+		WrapOps->Write32 = _XAie_IOWrap_Write32;
+	}
+	if(WrapOps->Read32 == NULL) {
+		WrapOps->Read32 = _XAie_IOWrap_Read32;
+	}
+	if(WrapOps->MaskWrite32 == NULL) {
+		WrapOps->MaskWrite32 = _XAie_IOWrap_MaskWrite32;
+	}
+	if(WrapOps->MaskPoll == NULL) {
+		WrapOps->MaskPoll = _XAie_IOWrap_MaskPoll;
+	}
+	if(WrapOps->BlockWrite32 == NULL) {
+		WrapOps->BlockWrite32 = _XAie_IOWrap_BlockWrite32;
+	}
+	if(WrapOps->BlockSet32 == NULL) {
+		WrapOps->BlockSet32 = _XAie_IOWrap_BlockSet32;
+	}
+	if(WrapOps->BlockRead32 == NULL) {
+		WrapOps->BlockRead32 = _XAie_IOWrap_BlockRead32;
+	}
+	if(WrapOps->CmdWrite == NULL) {
+		WrapOps->CmdWrite = _XAie_IOWrap_CmdWrite;
+	}
+	if(WrapOps->RunOp == NULL) {
+		WrapOps->RunOp = _XAie_IOWrap_RunOp;
+	}
+	if(WrapOps->MemAllocate == NULL) {
+		WrapOps->MemAllocate = _XAie_IOWrap_MemAllocate;
+	}
+	if(WrapOps->MemFree == NULL) {
+		WrapOps->MemFree = _XAie_IOWrap_MemFree;
+	}
+	if(WrapOps->MemSyncForCPU == NULL) {
+		WrapOps->MemSyncForCPU = _XAie_IOWrap_MemSyncForCPU;
+	}
+	if(WrapOps->MemSyncForDev == NULL) {
+		WrapOps->MemSyncForDev = _XAie_IOWrap_MemSyncForDev;
+	}
+	if(WrapOps->MemAttach == NULL) {
+		WrapOps->MemAttach = _XAie_IOWrap_MemAttach;
+	}
+	if(WrapOps->MemDetach == NULL) {
+		WrapOps->MemDetach = _XAie_IOWrap_MemDetach;
+	}
+	if((WrapOps->SubmitTxn == NULL) &&
+			(Wrap->Inner->Ops.SubmitTxn != NULL)) {
+		WrapOps->SubmitTxn = _XAie_IOWrap_SubmitTxn;
+	}
+
+	DevInst->Backend = &Wrap->Backend;
+	DevInst->IOInst = Wrap;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API removes a wrapper from the top of the IO backend of a device
+* instance and releases it.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Wrap: Wrapper.
+*
+* @return	XAIE_OK on success, XAIE_ERR if the wrapper is not the last one
+*		installed or if the device instance is not idle.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+AieRC _XAie_IOWrapRemove(XAie_DevInst *DevInst, XAie_IOWrap *Wrap)
+{
+	if(_XAie_IOWrapCheckIdle(DevInst) != XAIE_OK) {
+		return XAIE_ERR;
+	}
+
+	if(DevInst->IOInst != (void *)Wrap) {
+		XAIE_ERROR("Only the last installed IO wrapper can be "
+				"removed\n");
+		return XAIE_ERR;
+	}
+
+	DevInst->Backend = Wrap->Inner;
+	DevInst->IOInst = Wrap->InnerIOInst;
+	Wrap->Release(Wrap);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API finds a wrapper installed on a device instance. Wrappers are told
+* apart by their release function.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Release: Release function of the wrapper.
+*
+* @return	Last installed wrapper with the release function, NULL if there
+*		is none.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+XAie_IOWrap *_XAie_IOWrapFind(XAie_DevInst *DevInst,
+		void (*Release)(XAie_IOWrap *Wrap))
+{
+	const XAie_Backend *Backend = DevInst->Backend;
+	void *IOInst = DevInst->IOInst;
+
+	while(Backend->Ops.Init == _XAie_IOWrap_Init) {
+		XAie_IOWrap *Wrap = (XAie_IOWrap *)IOInst;
+
+		if(Wrap->Release == Release) {
+			return Wrap;
+		}
+
+		Backend = Wrap->Inner;
+		IOInst = Wrap->InnerIOInst;
+	}
+
+	return NULL;
+}
+
+/** @} */
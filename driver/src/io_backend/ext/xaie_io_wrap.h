@@ -0,0 +1,54 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_io_wrap.h
+* @{
+*
+* This file contains the data structures and routines to stack a wrapper on
+* top of the IO backend of a device instance. A wrapper sees every operation
+* issued to the backend and forwards it to the backend it wraps.
+*
+******************************************************************************/
+#ifndef XAIE_IO_WRAP_H
+#define XAIE_IO_WRAP_H
+
+/***************************** Include Files *********************************/
+#include "xaie_io.h"
+#include "xaiegbl.h"
+
+/****************************** Type Definitions *****************************/
+/*
+ * Typedef for the state shared by all wrappers. It has to be the first member
+ * of the IO instance of a wrapper, the IO instance pointer passed to the ops
+ * of the wrapper is the pointer to this structure.
+ * Backend    : Ops of the wrapper. The type is the one of the wrapped backend.
+ * Inner      : Wrapped backend, which may be another wrapper.
+ * InnerIOInst: IO instance of the wrapped backend.
+ * DevInst    : Device instance the wrapper is installed on.
+ * Release    : Frees the wrapper. Called once the wrapper is removed from the
+ *              device instance.
+ */
+typedef struct XAie_IOWrap {
+	XAie_Backend Backend;
+	const XAie_Backend *Inner;
+	void *InnerIOInst;
+	XAie_DevInst *DevInst;
+	void (*Release)(struct XAie_IOWrap *Wrap);
+} XAie_IOWrap;
+
+/************************** Function Prototypes  *****************************/
+AieRC _XAie_IOWrapInstall(XAie_DevInst *DevInst, XAie_IOWrap *Wrap,
+		const XAie_BackendOps *Ops,
+		void (*Release)(XAie_IOWrap *Wrap));
+AieRC _XAie_IOWrapRemove(XAie_DevInst *DevInst, XAie_IOWrap *Wrap);
+XAie_IOWrap *_XAie_IOWrapFind(XAie_DevInst *DevInst,
+		void (*Release)(XAie_IOWrap *Wrap));
+
+#endif /* XAIE_IO_WRAP_H */
+
+/** @} */
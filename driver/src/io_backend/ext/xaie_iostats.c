@@ -0,0 +1,720 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_iostats.c
+* @{
+*
+* This file contains the routines to count the calls, bytes and latencies of
+* the operations issued to the IO backend of a device instance, per operation,
+* tile type and module.
+*
+* The statistics are an IO wrapper, so they work on top of any backend. Each
+* thread counts in its own block of counters, which only this thread writes,
+* so that counting does not take a lock. A snapshot sums the blocks of all the
+* running threads and the totals of the instance. The block of a thread is
+* merged into these totals and freed when the thread exits. The latency of a
+* backend operation includes the accesses the operation issues, which are also
+* counted on their own.
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#ifdef __linux__
+#define _XOPEN_SOURCE 600
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#endif
+
+#include "xaie_helper.h"
+#include "xaie_io.h"
+#include "xaie_io_common.h"
+#include "xaie_io_wrap.h"
+
+#ifdef __linux__
+/************************** Constant Definitions *****************************/
+#define XAIE_IOSTATS_NO_TILE		XAIEGBL_TILE_TYPE_MAX
+#define XAIE_IOSTATS_NO_MOD		(XAIE_IOSTATS_NUM_MODS - 1U)
+#define XAIE_IOSTATS_NO_REGOFF		(~0ULL)
+
+/**************************** Type Definitions *******************************/
+struct XAie_IOStatsInst;
+
+/* Counters of a thread */
+typedef struct XAie_IOStatsBlock {
+	struct XAie_IOStatsBlock *Next;
+	struct XAie_IOStatsInst *Inst;
+	XAie_IOStats Stats;
+} XAie_IOStatsBlock;
+
+/* IO instance of the statistics */
+typedef struct XAie_IOStatsInst {
+	XAie_IOWrap Wrap;
+	pthread_key_t Key;	/* Counter block of the calling thread */
+	pthread_mutex_t Lock;	/* Protects the list of blocks and the totals */
+	XAie_IOStatsBlock *Blocks; /* Counter blocks of the running threads */
+	XAie_IOStats Exited;	/* Counters of the threads which exited */
+} XAie_IOStatsInst;
+
+/************************** Variable Definitions *****************************/
+static const char *XAie_IOStatsOpStr[XAIE_IOSTATS_OP_MAX] = {
+	"Write32", "Read32", "MaskWrite32", "MaskPoll", "BlockWrite32",
+	"BlockSet32", "BlockRead32", "RunOp", "SubmitTxn",
+};
+
+static const char *XAie_IOStatsTileStr[XAIE_IOSTATS_NUM_TILE_TYPES] = {
+	"aie", "shimnoc", "shimpl", "memtile", "-",
+};
+
+static const char *XAie_IOStatsModStr[XAIE_IOSTATS_NUM_MODS] = {
+	"mem", "core", "pl", "-",
+};
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This API returns the monotonic time in nano seconds.
+*
+* @return	Time in nano seconds.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static u64 _XAie_IOStatsNowNs(void)
+{
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+
+	return (u64)Now.tv_sec * 1000000000ULL + (u64)Now.tv_nsec;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the counter block of the calling thread, and allocates it on
+* the first call of the thread.
+*
+* @param	Inst: Statistics instance.
+*
+* @return	Counter block, NULL if the allocation failed.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static XAie_IOStatsBlock *_XAie_IOStatsGetBlock(XAie_IOStatsInst *Inst)
+{
+	XAie_IOStatsBlock *Block;
+
+	Block = (XAie_IOStatsBlock *)pthread_getspecific(Inst->Key);
+	if(Block != NULL) {
+		return Block;
+	}
+
+	Block = (XAie_IOStatsBlock *)calloc(1U, sizeof(*Block));
+	if(Block == NULL) {
+		XAIE_ERROR("Failed to allocate memory for the IO statistics\n");
+		return NULL;
+	}
+
+	Block->Inst = Inst;
+	pthread_mutex_lock(&Inst->Lock);
+	Block->Next = Inst->Blocks;
+	Inst->Blocks = Block;
+	pthread_mutex_unlock(&Inst->Lock);
+	pthread_setspecific(Inst->Key, Block);
+
+	return Block;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API adds the counters of a block to a snapshot.
+*
+* @param	Stats: Snapshot.
+* @param	Src: Counters to add.
+*
+* @return	None.
+*
+* @note		Internal only. The counters may be updated concurrently by the
+*		thread owning them.
+*
+*******************************************************************************/
+static void _XAie_IOStatsMerge(XAie_IOStats *Stats, const XAie_IOStats *Src)
+{
+	u32 NumCnts = sizeof(Stats->Cnt) / sizeof(XAie_IOStatsCounter);
+	XAie_IOStatsCounter *Cnt = &Stats->Cnt[0U][0U][0U];
+	const XAie_IOStatsCounter *SrcCnt = &Src->Cnt[0U][0U][0U];
+
+	for(u32 i = 0U; i < NumCnts; i++) {
+		u64 MaxNs = __atomic_load_n(&SrcCnt[i].MaxNs, __ATOMIC_RELAXED);
+
+		Cnt[i].Calls += __atomic_load_n(&SrcCnt[i].Calls,
+				__ATOMIC_RELAXED);
+		Cnt[i].Bytes += __atomic_load_n(&SrcCnt[i].Bytes,
+				__ATOMIC_RELAXED);
+		Cnt[i].TotalNs += __atomic_load_n(&SrcCnt[i].TotalNs,
+				__ATOMIC_RELAXED);
+		for(u32 j = 0U; j < XAIE_IOSTATS_NUM_BUCKETS; j++) {
+			Cnt[i].Hist[j] += __atomic_load_n(&SrcCnt[i].Hist[j],
+					__ATOMIC_RELAXED);
+		}
+		if(MaxNs > Cnt[i].MaxNs) {
+			Cnt[i].MaxNs = MaxNs;
+		}
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API is the destructor of the thread key. It merges the counter block of
+* an exiting thread into the totals of the instance and frees it.
+*
+* @param	Arg: Counter block of the thread.
+*
+* @return	None.
+*
+* @note		Internal only. The destructor is not called for the threads
+*		which exit after the statistics are stopped, their blocks are
+*		freed with the instance.
+*
+*******************************************************************************/
+static void _XAie_IOStatsThreadExit(void *Arg)
+{
+	XAie_IOStatsBlock *Block = (XAie_IOStatsBlock *)Arg;
+	XAie_IOStatsInst *Inst = Block->Inst;
+	XAie_IOStatsBlock **Prev;
+
+	pthread_mutex_lock(&Inst->Lock);
+	for(Prev = &Inst->Blocks; *Prev != NULL; Prev = &(*Prev)->Next) {
+		if(*Prev == Block) {
+			*Prev = Block->Next;
+			break;
+		}
+	}
+	_XAie_IOStatsMerge(&Inst->Exited, &Block->Stats);
+	pthread_mutex_unlock(&Inst->Lock);
+
+	free(Block);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API adds a value to a counter of the calling thread.
+*
+* @param	Cnt: Counter.
+* @param	Val: Value to add.
+*
+* @return	None.
+*
+* @note		Internal only. Only the thread owning the counter writes it, the
+*		atomic store keeps the snapshots from reading a torn value.
+*
+*******************************************************************************/
+static inline void _XAie_IOStatsAdd(u64 *Cnt, u64 Val)
+{
+	__atomic_store_n(Cnt, *Cnt + Val, __ATOMIC_RELAXED);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API counts a call of the calling thread.
+*
+* @param	Inst: Statistics instance.
+* @param	Op: Operation.
+* @param	RegOff: Register offset of the call, or XAIE_IOSTATS_NO_REGOFF
+*		if the call has no tile address.
+* @param	Bytes: Bytes written or read by the call.
+* @param	StartNs: Time the call was issued at.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_IOStatsCount(XAie_IOStatsInst *Inst, XAie_IOStatsOp Op,
+		u64 RegOff, u64 Bytes, u64 StartNs)
+{
+	u64 Ns = _XAie_IOStatsNowNs() - StartNs;
+	XAie_ModuleType Mod = XAIE_MEM_MOD;
+	XAie_IOStatsBlock *Block;
+	XAie_IOStatsCounter *Cnt;
+	XAie_LocType Loc;
+	u8 TileType = XAIE_IOSTATS_NO_TILE;
+	u32 ModIdx = XAIE_IOSTATS_NO_MOD;
+	u32 Bucket = 0U;
+
+	Block = _XAie_IOStatsGetBlock(Inst);
+	if(Block == NULL) {
+		return;
+	}
+
+	if(RegOff != XAIE_IOSTATS_NO_REGOFF) {
+		TileType = _XAie_IOCommon_GetTileMod(Inst->Wrap.DevInst, RegOff,
+				&Loc, &Mod);
+		if(TileType != XAIEGBL_TILE_TYPE_MAX) {
+			ModIdx = (u32)Mod;
+		}
+	}
+
+	if(Ns > 1U) {
+		Bucket = 63U - (u32)__builtin_clzll(Ns);
+		if(Bucket >= XAIE_IOSTATS_NUM_BUCKETS) {
+			Bucket = XAIE_IOSTATS_NUM_BUCKETS - 1U;
+		}
+	}
+
+	Cnt = &Block->Stats.Cnt[Op][TileType][ModIdx];
+	_XAie_IOStatsAdd(&Cnt->Calls, 1U);
+	_XAie_IOStatsAdd(&Cnt->Bytes, Bytes);
+	_XAie_IOStatsAdd(&Cnt->TotalNs, Ns);
+	_XAie_IOStatsAdd(&Cnt->Hist[Bucket], 1U);
+	if(Ns > Cnt->MaxNs) {
+		__atomic_store_n(&Cnt->MaxNs, Ns, __ATOMIC_RELAXED);
+	}
+}
+
+static AieRC _XAie_IOStats_Write32(void *IOInst, u64 RegOff, u32 Value)
+{
+	XAie_IOStatsInst *Inst = (XAie_IOStatsInst *)IOInst;
+	u64 StartNs = _XAie_IOStatsNowNs();
+	AieRC RC;
+
+	RC = Inst->Wrap.Inner->Ops.Write32(Inst->Wrap.InnerIOInst, RegOff,
+			Value);
+	_XAie_IOStatsCount(Inst, XAIE_IOSTATS_WRITE32, RegOff, sizeof(u32),
+			StartNs);
+
+	return RC;
+}
+
+static AieRC _XAie_IOStats_Read32(void *IOInst, u64 RegOff, u32 *Data)
+{
+	XAie_IOStatsInst *Inst = (XAie_IOStatsInst *)IOInst;
+	u64 StartNs = _XAie_IOStatsNowNs();
+	AieRC RC;
+
+	RC = Inst->Wrap.Inner->Ops.Read32(Inst->Wrap.InnerIOInst, RegOff, Data);
+	_XAie_IOStatsCount(Inst, XAIE_IOSTATS_READ32, RegOff, sizeof(u32),
+			StartNs);
+
+	return RC;
+}
+
+static AieRC _XAie_IOStats_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value)
+{
+	XAie_IOStatsInst *Inst = (XAie_IOStatsInst *)IOInst;
+	u64 StartNs = _XAie_IOStatsNowNs();
+	AieRC RC;
+
+	RC = Inst->Wrap.Inner->Ops.MaskWrite32(Inst->Wrap.InnerIOInst, RegOff,
+			Mask, Value);
+	_XAie_IOStatsCount(Inst, XAIE_IOSTATS_MASKWRITE32, RegOff, sizeof(u32),
+			StartNs);
+
+	return RC;
+}
+
+static AieRC _XAie_IOStats_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 TimeOutUs, const XAie_PollPolicy *Policy)
+{
+	XAie_IOStatsInst *Inst = (XAie_IOStatsInst *)IOInst;
+	u64 StartNs = _XAie_IOStatsNowNs();
+	AieRC RC;
+
+	RC = Inst->Wrap.Inner->Ops.MaskPoll(Inst->Wrap.InnerIOInst, RegOff,
+			Mask, Value, TimeOutUs, Policy);
+	_XAie_IOStatsCount(Inst, XAIE_IOSTATS_MASKPOLL, RegOff, sizeof(u32),
+			StartNs);
+
+	return RC;
+}
+
+static AieRC _XAie_IOStats_BlockWrite32(void *IOInst, u64 RegOff,
+		const u32 *Data, u32 Size)
+{
+	XAie_IOStatsInst *Inst = (XAie_IOStatsInst *)IOInst;
+	u64 StartNs = _XAie_IOStatsNowNs();
+	AieRC RC;
+
+	RC = Inst->Wrap.Inner->Ops.BlockWrite32(Inst->Wrap.InnerIOInst, RegOff,
+			Data, Size);
+	_XAie_IOStatsCount(Inst, XAIE_IOSTATS_BLOCKWRITE32, RegOff,
+			(u64)Size * sizeof(u32), StartNs);
+
+	return RC;
+}
+
+static AieRC _XAie_IOStats_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	XAie_IOStatsInst *Inst = (XAie_IOStatsInst *)IOInst;
+	u64 StartNs = _XAie_IOStatsNowNs();
+	AieRC RC;
+
+	RC = Inst->Wrap.Inner->Ops.BlockSet32(Inst->Wrap.InnerIOInst, RegOff,
+			Data, Size);
+	_XAie_IOStatsCount(Inst, XAIE_IOSTATS_BLOCKSET32, RegOff,
+			(u64)Size * sizeof(u32), StartNs);
+
+	return RC;
+}
+
+static AieRC _XAie_IOStats_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	XAie_IOStatsInst *Inst = (XAie_IOStatsInst *)IOInst;
+	u64 StartNs = _XAie_IOStatsNowNs();
+	AieRC RC;
+
+	RC = Inst->Wrap.Inner->Ops.BlockRead32(Inst->Wrap.InnerIOInst, RegOff,
+			Data, Size);
+	_XAie_IOStatsCount(Inst, XAIE_IOSTATS_BLOCKREAD32, RegOff,
+			(u64)Size * sizeof(u32), StartNs);
+
+	return RC;
+}
+
+static AieRC _XAie_IOStats_RunOp(void *IOInst, XAie_DevInst *DevInst,
+		XAie_BackendOpCode Op, void *Arg)
+{
+	XAie_IOStatsInst *Inst = (XAie_IOStatsInst *)IOInst;
+	u64 StartNs = _XAie_IOStatsNowNs();
+	u64 Bytes = 0U;
+	AieRC RC;
+
+	if((Op == XAIE_BACKEND_OP_NPIWR32) ||
+			(Op == XAIE_BACKEND_OP_NPIMASKPOLL32)) {
+		Bytes = sizeof(u32);
+	}
+
+	RC = Inst->Wrap.Inner->Ops.RunOp(Inst->Wrap.InnerIOInst, DevInst, Op,
+			Arg);
+	_XAie_IOStatsCount(Inst, XAIE_IOSTATS_RUNOP, XAIE_IOSTATS_NO_REGOFF,
+			Bytes, StartNs);
+
+	return RC;
+}
+
+static AieRC _XAie_IOStats_SubmitTxn(void *IOInst, XAie_TxnInst *TxnInst)
+{
+	XAie_IOStatsInst *Inst = (XAie_IOStatsInst *)IOInst;
+	u64 StartNs = _XAie_IOStatsNowNs();
+	u64 Bytes = 0U;
+	AieRC RC;
+
+	for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
+		const XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i];
+
+		if((Cmd->Opcode == XAIE_IO_BLOCKWRITE) ||
+				(Cmd->Opcode == XAIE_IO_BLOCKSET)) {
+			Bytes += (u64)Cmd->Size * sizeof(u32);
+		} else {
+			Bytes += sizeof(u32);
+		}
+	}
+
+	RC = Inst->Wrap.Inner->Ops.SubmitTxn(Inst->Wrap.InnerIOInst, TxnInst);
+	_XAie_IOStatsCount(Inst, XAIE_IOSTATS_SUBMITTXN,
+			XAIE_IOSTATS_NO_REGOFF, Bytes, StartNs);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API releases the statistics and the counter blocks of all the threads.
+*
+* @param	Wrap: Wrapper of the statistics.
+*
+* @return	None.
+*
+* @note		Internal only. The statistics must not be stopped while a
+*		thread which used them is exiting.
+*
+*******************************************************************************/
+static void _XAie_IOStatsRelease(XAie_IOWrap *Wrap)
+{
+	XAie_IOStatsInst *Inst = (XAie_IOStatsInst *)Wrap;
+	XAie_IOStatsBlock *Block;
+
+	/* No destructor is called once the key is deleted */
+	pthread_key_delete(Inst->Key);
+
+	Block = Inst->Blocks;
+	while(Block != NULL) {
+		XAie_IOStatsBlock *Next = Block->Next;
+
+		free(Block);
+		Block = Next;
+	}
+	pthread_mutex_destroy(&Inst->Lock);
+	free(Inst);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API starts to count the operations issued to the IO backend of a device
+* instance.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+AieRC _XAie_IOStatsStart(XAie_DevInst *DevInst)
+{
+	static const XAie_BackendOps Ops = {
+		.Write32 = _XAie_IOStats_Write32,
+		.Read32 = _XAie_IOStats_Read32,
+		.MaskWrite32 = _XAie_IOStats_MaskWrite32,
+		.MaskPoll = _XAie_IOStats_MaskPoll,
+		.BlockWrite32 = _XAie_IOStats_BlockWrite32,
+		.BlockSet32 = _XAie_IOStats_BlockSet32,
+		.BlockRead32 = _XAie_IOStats_BlockRead32,
+		.RunOp = _XAie_IOStats_RunOp,
+		.SubmitTxn = _XAie_IOStats_SubmitTxn,
+	};
+	XAie_IOStatsInst *Inst;
+	AieRC RC;
+
+	if(_XAie_IOWrapFind(DevInst, _XAie_IOStatsRelease) != NULL) {
+		XAIE_ERROR("IO statistics are already started\n");
+		return XAIE_ERR;
+	}
+
+	Inst = (XAie_IOStatsInst *)calloc(1U, sizeof(*Inst));
+	if(Inst == NULL) {
+		XAIE_ERROR("Failed to allocate memory for the IO statistics\n");
+		return XAIE_ERR;
+	}
+
+	if(pthread_mutex_init(&Inst->Lock, NULL) != 0) {
+		XAIE_ERROR("Failed to create the IO statistics lock\n");
+		free(Inst);
+		return XAIE_ERR;
+	}
+
+	if(pthread_key_create(&Inst->Key, _XAie_IOStatsThreadExit) != 0) {
+		XAIE_ERROR("Failed to create the IO statistics thread key\n");
+		pthread_mutex_destroy(&Inst->Lock);
+		free(Inst);
+		return XAIE_ERR;
+	}
+
+	RC = _XAie_IOWrapInstall(DevInst, &Inst->Wrap, &Ops,
+			_XAie_IOStatsRelease);
+	if(RC != XAIE_OK) {
+		pthread_key_delete(Inst->Key);
+		pthread_mutex_destroy(&Inst->Lock);
+		free(Inst);
+		return RC;
+	}
+
+	/* Transactions are executed by the driver if the backend can't */
+	if(Inst->Wrap.Inner->Ops.SubmitTxn == NULL) {
+		Inst->Wrap.Backend.Ops.SubmitTxn = NULL;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API stops counting the operations of a device instance and releases the
+* statistics.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success, XAIE_ERR if the statistics are not started.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+AieRC _XAie_IOStatsStop(XAie_DevInst *DevInst)
+{
+	XAie_IOWrap *Wrap;
+
+	Wrap = _XAie_IOWrapFind(DevInst, _XAie_IOStatsRelease);
+	if(Wrap == NULL) {
+		XAIE_ERROR("IO statistics are not started\n");
+		return XAIE_ERR;
+	}
+
+	return _XAie_IOWrapRemove(DevInst, Wrap);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API takes a snapshot of the statistics of a device instance, summed over
+* all the threads.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Stats: Snapshot of the statistics.
+*
+* @return	XAIE_OK on success, XAIE_ERR if the statistics are not started.
+*
+* @note		Internal only. The counters of the calls in progress may be
+*		partially updated.
+*
+*******************************************************************************/
+AieRC _XAie_IOStatsGet(XAie_DevInst *DevInst, XAie_IOStats *Stats)
+{
+	XAie_IOStatsInst *Inst;
+	XAie_IOStatsBlock *Block;
+
+	Inst = (XAie_IOStatsInst *)_XAie_IOWrapFind(DevInst,
+			_XAie_IOStatsRelease);
+	if(Inst == NULL) {
+		XAIE_ERROR("IO statistics are not started\n");
+		return XAIE_ERR;
+	}
+
+	memset(Stats, 0, sizeof(*Stats));
+	pthread_mutex_lock(&Inst->Lock);
+	_XAie_IOStatsMerge(Stats, &Inst->Exited);
+	for(Block = Inst->Blocks; Block != NULL; Block = Block->Next) {
+		_XAie_IOStatsMerge(Stats, &Block->Stats);
+	}
+	pthread_mutex_unlock(&Inst->Lock);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes a snapshot of the statistics of a device instance to a text
+* file. There is one line per operation, tile type and module which was
+* called, followed by the non empty latency buckets.
+*
+* @param	DevInst: Device instance pointer.
+* @param	FileName: Path of the file.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+AieRC _XAie_IOStatsDump(XAie_DevInst *DevInst, const char *FileName)
+{
+	XAie_IOStats *Stats;
+	FILE *Fd;
+	AieRC RC;
+
+	Stats = (XAie_IOStats *)malloc(sizeof(*Stats));
+	if(Stats == NULL) {
+		XAIE_ERROR("Failed to allocate memory for the IO statistics\n");
+		return XAIE_ERR;
+	}
+
+	RC = _XAie_IOStatsGet(DevInst, Stats);
+	if(RC != XAIE_OK) {
+		free(Stats);
+		return RC;
+	}
+
+	Fd = fopen(FileName, "w");
+	if(Fd == NULL) {
+		XAIE_ERROR("Failed to open %s\n", FileName);
+		free(Stats);
+		return XAIE_ERR;
+	}
+
+	fprintf(Fd, "# op tile module calls bytes total_ns max_ns "
+			"log2_ns:calls...\n");
+	for(u32 Op = 0U; Op < XAIE_IOSTATS_OP_MAX; Op++) {
+		for(u32 Tile = 0U; Tile < XAIE_IOSTATS_NUM_TILE_TYPES; Tile++) {
+			for(u32 Mod = 0U; Mod < XAIE_IOSTATS_NUM_MODS; Mod++) {
+				const XAie_IOStatsCounter *Cnt =
+					&Stats->Cnt[Op][Tile][Mod];
+
+				if(Cnt->Calls == 0U) {
+					continue;
+				}
+
+				fprintf(Fd, "%s %s %s %lu %lu %lu %lu",
+						XAie_IOStatsOpStr[Op],
+						XAie_IOStatsTileStr[Tile],
+						XAie_IOStatsModStr[Mod],
+						Cnt->Calls, Cnt->Bytes,
+						Cnt->TotalNs, Cnt->MaxNs);
+				for(u32 i = 0U; i < XAIE_IOSTATS_NUM_BUCKETS;
+						i++) {
+					if(Cnt->Hist[i] != 0U) {
+						fprintf(Fd, " %u:%lu", i,
+							Cnt->Hist[i]);
+					}
+				}
+				fprintf(Fd, "\n");
+			}
+		}
+	}
+
+	if(fclose(Fd) != 0) {
+		XAIE_ERROR("Failed to write %s\n", FileName);
+		RC = XAIE_ERR;
+	}
+	free(Stats);
+
+	return RC;
+}
+
+#else
+
+AieRC _XAie_IOStatsStart(XAie_DevInst *DevInst)
+{
+	(void)DevInst;
+
+	XAIE_ERROR("IO statistics are not supported\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+AieRC _XAie_IOStatsStop(XAie_DevInst *DevInst)
+{
+	(void)DevInst;
+
+	XAIE_ERROR("IO statistics are not supported\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+AieRC _XAie_IOStatsGet(XAie_DevInst *DevInst, XAie_IOStats *Stats)
+{
+	(void)DevInst;
+	(void)Stats;
+
+	XAIE_ERROR("IO statistics are not supported\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+AieRC _XAie_IOStatsDump(XAie_DevInst *DevInst, const char *FileName)
+{
+	(void)DevInst;
+	(void)FileName;
+
+	XAIE_ERROR("IO statistics are not supported\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+#endif /* __linux__ */
+
+/** @} */
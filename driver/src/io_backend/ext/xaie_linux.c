@@ -47,7 +47,19 @@
 #include "xaie_npi.h"
 
 /***************************** Macro Definitions *****************************/
-#define XAIE_128BIT_ALIGN_MASK 0xFF
+/*
+ * Register writes are batched and submitted with the transaction ioctl when
+ * the driver is compiled with XAIE_LINUX_BATCH. The batch is submitted before
+ * any other access to the partition, and on XAie_FlushIO().
+ */
+#ifdef XAIE_LINUX_BATCH
+#define XAIE_LINUX_IS_BATCHED		1U
+#else
+#define XAIE_LINUX_IS_BATCHED		0U
+#endif
+
+#define XAIE_LINUX_BATCH_MAX_CMDS	256U
+#define XAIE_LINUX_BATCH_MAX_WORDS	4096U
 
 /****************************** Type Definitions *****************************/
 #ifdef __AIELINUX__
@@ -78,6 +90,12 @@ typedef struct XAie_LinuxIO {
 	u8 RowShift;
 	u8 ColShift;
 	u64 BaseAddr;
+	pthread_mutex_t BatchLock; /* Protects the batch */
+	u8 BatchEnable;		/* Cleared if the kernel has no txn ioctl */
+	u32 BatchNumCmds;	/* Number of batched writes */
+	u32 BatchNumWords;	/* Number of words of the block write payloads */
+	XAie_TxnCmd BatchCmds[XAIE_LINUX_BATCH_MAX_CMDS];
+	u32 BatchData[XAIE_LINUX_BATCH_MAX_WORDS];
 } XAie_LinuxIO;
 
 typedef struct XAie_LinuxMem {
@@ -89,6 +107,248 @@ typedef struct XAie_LinuxMem {
 /************************** Function Definitions *****************************/
 #ifdef __AIELINUX__
 
+/*****************************************************************************/
+/**
+*
+* This function writes a register with the register ioctl.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to write.
+* @param	Mask: Mask of the write, 0 to write the whole register.
+* @param	Value: 32-bit value to write.
+*
+* @return	XAIE_OK on success, XAIE_ERR on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_LinuxIO_RegWrite(XAie_LinuxIO *IOInst, u64 RegOff, u32 Mask,
+		u32 Value)
+{
+	int Ret;
+	struct aie_reg_args Args;
+
+	Args.op = AIE_REG_WRITE;
+	Args.offset = RegOff;
+	Args.val = Value;
+	Args.mask = Mask;
+
+	/*
+	 * TBD: Is the check of ioctl call required here? Other backends do not
+	 * check for errors. Kernels prints error messages anyway.
+	 */
+	Ret = ioctl(IOInst->PartitionFd, AIE_REG_IOCTL, &Args);
+	if(Ret < 0) {
+		XAIE_ERROR("Register write failed for offset 0x%lx, %d: %s\n",
+			RegOff, errno, strerror(errno));
+		return XAIE_ERR;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function executes a write command one register at a time.
+*
+* @param	IOInst: IO instance pointer
+* @param	Cmd: Write, block write or block set command.
+*
+* @return	XAIE_OK on success, XAIE_ERR on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_LinuxIO_ExecCmd(XAie_LinuxIO *IOInst,
+		const XAie_TxnCmd *Cmd)
+{
+	const u32 *Data = (const u32 *)(uintptr_t)Cmd->DataPtr;
+	AieRC RC = XAIE_OK;
+
+	if(Cmd->Opcode == XAIE_IO_WRITE) {
+		return _XAie_LinuxIO_RegWrite(IOInst, Cmd->RegOff, Cmd->Mask,
+				Cmd->Value);
+	}
+
+	for(u32 i = 0U; (i < Cmd->Size) && (RC == XAIE_OK); i++) {
+		RC = _XAie_LinuxIO_RegWrite(IOInst, Cmd->RegOff + i * 4U, 0U,
+				(Cmd->Opcode == XAIE_IO_BLOCKWRITE) ?
+				Data[i] : Cmd->Value);
+	}
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function submits write commands with the transaction ioctl. If the
+* kernel does not support the ioctl, batching is disabled and the commands are
+* executed one register at a time.
+*
+* @param	IOInst: IO instance pointer
+* @param	Cmds: Write commands.
+* @param	NumCmds: Number of commands.
+*
+* @return	XAIE_OK on success, XAIE_ERR on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_LinuxIO_SubmitCmds(XAie_LinuxIO *IOInst,
+		XAie_TxnCmd *Cmds, u32 NumCmds)
+{
+	struct aie_txn_inst Args;
+	AieRC RC = XAIE_OK;
+	int Ret;
+
+	Args.num_cmds = NumCmds;
+	Args.cmdsptr = (u64)Cmds;
+
+	Ret = ioctl(IOInst->PartitionFd, AIE_TRANSACTION_IOCTL, &Args);
+	if(Ret == 0) {
+		return XAIE_OK;
+	}
+
+	if(errno != ENOTTY) {
+		XAIE_ERROR("Submitting batched writes failed, %d: %s\n",
+			errno, strerror(errno));
+		return XAIE_ERR;
+	}
+
+	XAIE_DBG("Kernel has no transaction ioctl, writes are not batched\n");
+	__atomic_store_n(&IOInst->BatchEnable, XAIE_DISABLE, __ATOMIC_RELAXED);
+	for(u32 i = 0U; (i < NumCmds) && (RC == XAIE_OK); i++) {
+		RC = _XAie_LinuxIO_ExecCmd(IOInst, &Cmds[i]);
+	}
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function submits the batched writes and empties the batch.
+*
+* @param	IOInst: IO instance pointer
+*
+* @return	XAIE_OK on success, XAIE_ERR on failure.
+*
+* @note		Internal only. The batch lock must be held.
+*
+*******************************************************************************/
+static AieRC _XAie_LinuxIO_BatchSubmit(XAie_LinuxIO *IOInst)
+{
+	AieRC RC = XAIE_OK;
+
+	if(IOInst->BatchNumCmds > 0U) {
+		RC = _XAie_LinuxIO_SubmitCmds(IOInst, IOInst->BatchCmds,
+				IOInst->BatchNumCmds);
+	}
+
+	IOInst->BatchNumWords = 0U;
+	__atomic_store_n(&IOInst->BatchNumCmds, 0U, __ATOMIC_RELAXED);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function submits the batched writes, if any. It is called before any
+* access to the partition which is not a register write, so that the accesses
+* are issued in order.
+*
+* @param	IOInst: IO instance pointer
+*
+* @return	XAIE_OK on success, XAIE_ERR if a batched write failed.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_LinuxIO_BatchFlush(XAie_LinuxIO *IOInst)
+{
+	AieRC RC;
+
+	if(__atomic_load_n(&IOInst->BatchNumCmds, __ATOMIC_RELAXED) == 0U) {
+		return XAIE_OK;
+	}
+
+	pthread_mutex_lock(&IOInst->BatchLock);
+	RC = _XAie_LinuxIO_BatchSubmit(IOInst);
+	pthread_mutex_unlock(&IOInst->BatchLock);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This function adds a write command to the batch. The payload of a block
+* write is copied to the batch, the batch is submitted first if it is full.
+*
+* @param	IOInst: IO instance pointer
+* @param	Opcode: XAIE_IO_WRITE, XAIE_IO_BLOCKWRITE or XAIE_IO_BLOCKSET.
+* @param	RegOff: Register offset to write.
+* @param	Mask: Mask of the write, 0 to write the whole register.
+* @param	Value: Value of a write or block set.
+* @param	Data: Payload of a block write.
+* @param	Size: Number of words of a block write or block set.
+*
+* @return	XAIE_OK on success, XAIE_ERR on failure.
+*
+* @note		Internal only. A block write larger than the payload buffer is
+*		submitted on its own.
+*
+*******************************************************************************/
+static AieRC _XAie_LinuxIO_BatchAdd(XAie_LinuxIO *IOInst,
+		XAie_TxnOpcode Opcode, u64 RegOff, u32 Mask, u32 Value,
+		const u32 *Data, u32 Size)
+{
+	XAie_TxnCmd Cmd = {
+		.Opcode = Opcode,
+		.Mask = Mask,
+		.RegOff = RegOff,
+		.Value = Value,
+		.DataPtr = (u64)(uintptr_t)Data,
+		.Size = Size,
+	};
+	u32 NumWords = (Opcode == XAIE_IO_BLOCKWRITE) ? Size : 0U;
+	AieRC RC = XAIE_OK;
+
+	pthread_mutex_lock(&IOInst->BatchLock);
+
+	if((IOInst->BatchNumCmds == XAIE_LINUX_BATCH_MAX_CMDS) ||
+			(IOInst->BatchNumWords + NumWords >
+			 XAIE_LINUX_BATCH_MAX_WORDS)) {
+		RC = _XAie_LinuxIO_BatchSubmit(IOInst);
+	}
+
+	if(RC != XAIE_OK) {
+		/* The write is dropped with the failed batch */
+	} else if(IOInst->BatchEnable == XAIE_DISABLE) {
+		RC = _XAie_LinuxIO_ExecCmd(IOInst, &Cmd);
+	} else if(NumWords > XAIE_LINUX_BATCH_MAX_WORDS) {
+		RC = _XAie_LinuxIO_SubmitCmds(IOInst, &Cmd, 1U);
+	} else {
+		if(NumWords > 0U) {
+			u32 *Payload = &IOInst->BatchData[IOInst->BatchNumWords];
+
+			memcpy(Payload, Data, NumWords * sizeof(u32));
+			Cmd.DataPtr = (u64)(uintptr_t)Payload;
+			IOInst->BatchNumWords += NumWords;
+		}
+		IOInst->BatchCmds[IOInst->BatchNumCmds] = Cmd;
+		__atomic_store_n(&IOInst->BatchNumCmds,
+				IOInst->BatchNumCmds + 1U, __ATOMIC_RELAXED);
+	}
+
+	pthread_mutex_unlock(&IOInst->BatchLock);
+
+	return RC;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -106,6 +366,9 @@ static AieRC XAie_LinuxIO_Finish(void *IOInst)
 {
 	XAie_LinuxIO *LinuxIOInst = (XAie_LinuxIO *)IOInst;
 
+	_XAie_LinuxIO_BatchFlush(LinuxIOInst);
+	pthread_mutex_destroy(&LinuxIOInst->BatchLock);
+
 	munmap(LinuxIOInst->RegMap.VAddr, LinuxIOInst->RegMap.MapSize);
 	munmap(LinuxIOInst->ProgMem.VAddr, LinuxIOInst->ProgMem.MapSize);
 	munmap(LinuxIOInst->DataMem.VAddr, LinuxIOInst->DataMem.MapSize);
@@ -347,6 +610,11 @@ static AieRC XAie_LinuxIO_Init(XAie_DevInst *DevInst)
 		return XAIE_ERR;
 	}
 
+	IOInst->BatchEnable = XAIE_LINUX_IS_BATCHED;
+	IOInst->BatchNumCmds = 0U;
+	IOInst->BatchNumWords = 0U;
+	pthread_mutex_init(&IOInst->BatchLock, NULL);
+
 	DevInst->IOInst = (void *)IOInst;
 	IOInst->DevInst = DevInst;
 
@@ -370,26 +638,14 @@ static AieRC XAie_LinuxIO_Init(XAie_DevInst *DevInst)
 static AieRC XAie_LinuxIO_Write32(void *IOInst, u64 RegOff, u32 Value)
 {
 	XAie_LinuxIO *LinuxIOInst = (XAie_LinuxIO *)IOInst;
-	int Ret;
-	struct aie_reg_args Args;
 
-	Args.op = AIE_REG_WRITE;
-	Args.offset = RegOff;
-	Args.val = Value;
-	Args.mask = 0; /* mask must be 0 for register write */
-
-	/*
-	 * TBD: Is the check of ioctl call required here? Other backends do not
-	 * check for errors. Kernels prints error messages anyway.
-	 */
-	Ret = ioctl(LinuxIOInst->PartitionFd, AIE_REG_IOCTL, &Args);
-	if(Ret < 0) {
-		XAIE_ERROR("Register write failed for offset 0x%lx, %d: %s\n",
-			RegOff, errno, strerror(errno));
-		return XAIE_ERR;
+	if(__atomic_load_n(&LinuxIOInst->BatchEnable, __ATOMIC_RELAXED) ==
+			XAIE_ENABLE) {
+		return _XAie_LinuxIO_BatchAdd(LinuxIOInst, XAIE_IO_WRITE,
+				RegOff, 0U, Value, NULL, 0U);
 	}
 
-	return XAIE_OK;
+	return _XAie_LinuxIO_RegWrite(LinuxIOInst, RegOff, 0U, Value);
 }
 
 /*****************************************************************************/
@@ -409,10 +665,12 @@ static AieRC XAie_LinuxIO_Write32(void *IOInst, u64 RegOff, u32 Value)
 static AieRC XAie_LinuxIO_Read32(void *IOInst, u64 RegOff, u32 *Data)
 {
 	XAie_LinuxIO *LinuxIOInst = (XAie_LinuxIO *)IOInst;
+	AieRC RC;
 
+	RC = _XAie_LinuxIO_BatchFlush(LinuxIOInst);
 	*Data = *((u32 *)(LinuxIOInst->RegMap.VAddr + RegOff));
 
-	return XAIE_OK;
+	return RC;
 }
 
 /*****************************************************************************/
@@ -435,26 +693,14 @@ static AieRC XAie_LinuxIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 		u32 Value)
 {
 	XAie_LinuxIO *LinuxIOInst = (XAie_LinuxIO *)IOInst;
-	int Ret;
-	struct aie_reg_args Args;
 
-	Args.op = AIE_REG_WRITE;
-	Args.offset = RegOff;
-	Args.val = Value;
-	Args.mask = Mask;
-
-	/*
-	 * TBD: Is the check of ioctl call required here? Other backends do not
-	 * check for errors. Kernels prints error messages anyway.
-	 */
-	Ret = ioctl(LinuxIOInst->PartitionFd, AIE_REG_IOCTL, &Args);
-	if(Ret < 0) {
-		XAIE_ERROR("Register write failed for offset 0x%lx, %d: %s\n",
-			RegOff, errno, strerror(errno));
-		return XAIE_ERR;
+	if(__atomic_load_n(&LinuxIOInst->BatchEnable, __ATOMIC_RELAXED) ==
+			XAIE_ENABLE) {
+		return _XAie_LinuxIO_BatchAdd(LinuxIOInst, XAIE_IO_WRITE,
+				RegOff, Mask, Value, NULL, 0U);
 	}
 
-	return XAIE_OK;
+	return _XAie_LinuxIO_RegWrite(LinuxIOInst, RegOff, Mask, Value);
 }
 
 /*****************************************************************************/
@@ -467,6 +713,7 @@ static AieRC XAie_LinuxIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 * @param	Mask: Mask to be applied to Data.
 * @param	Value: 32-bit value to poll for
 * @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy.
 *
 * @return	XAIE_OK or XAIE_ERR.
 *
@@ -474,36 +721,10 @@ static AieRC XAie_LinuxIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 *
 *******************************************************************************/
 static AieRC XAie_LinuxIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
-		u32 TimeOutUs)
+		u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
-	AieRC Ret = XAIE_ERR;
-	u32 Count, MinTimeOutUs, RegVal;
-
-	/*
-	 * Any value less than 200 us becomes noticable overhead. This is based
-	 * on some profiling, and it may vary between platforms.
-	 */
-	MinTimeOutUs = 200;
-	Count = ((u64)TimeOutUs + MinTimeOutUs - 1) / MinTimeOutUs;
-
-	while (Count > 0U) {
-		XAie_LinuxIO_Read32(IOInst, RegOff, &RegVal);
-		if((RegVal & Mask) == Value) {
-			Ret = XAIE_OK;
-			break;
-		}
-		usleep(MinTimeOutUs);
-		Count--;
-	}
-
-	/* Check for the break from timed-out loop */
-	XAie_LinuxIO_Read32(IOInst, RegOff, &RegVal);
-	if((Ret == XAIE_ERR) && ((RegVal & Mask) ==
-			 Value)) {
-		Ret = XAIE_OK;
-	}
-
-	return Ret;
+	return _XAie_IOCommon_MaskPoll(IOInst, XAie_LinuxIO_Read32, RegOff, Mask,
+			Value, TimeOutUs, Policy);
 }
 
 /*****************************************************************************/
@@ -596,68 +817,6 @@ static inline u64 _XAie_GetMemOffset(XAie_LinuxIO *IOInst, u8 TileType, u8 Col,
 	return 0;
 }
 
-/*****************************************************************************/
-/**
-*
-* This function copies data to the device using memcpy. The function accepts
-* a 32 bit aligned address. 128bit unaligned addresses are managed within the
-* funtion.
-*
-* @param	Dest: Pointer to the destination address.
-* @param	Src: Pointer to the source buffer.
-* @param	Size: Number of 32-bit words.
-*
-* @return	None.
-*
-* @note		Internal only.
-*
-*******************************************************************************/
-static void _XAie_CopyDataToMem(u32 *Dest, const u32 *Src, u32 Size)
-{
-	u32 StartExtraWrds = 0, EndExtraWrds = 0;
-
-	if((u64)Dest & XAIE_128BIT_ALIGN_MASK) {
-		StartExtraWrds = ((XAIE_128BIT_ALIGN_MASK + 1) -
-				(((u64)Dest) & XAIE_128BIT_ALIGN_MASK)) / 4;
-	}
-
-	if(StartExtraWrds > 0) {
-		for(u8 i = 0; i < StartExtraWrds && Size > 0;  i++) {
-			*Dest = *Src;
-			Dest++;
-			Src++;
-			Size--;
-		}
-	}
-
-	if((u64)(Dest + Size) & XAIE_128BIT_ALIGN_MASK) {
-		EndExtraWrds = (((u64)(Dest + Size)) &
-				XAIE_128BIT_ALIGN_MASK) / 4;
-	}
-
-	if(Size >= (XAIE_128BIT_ALIGN_MASK + 1)) {
-		memcpy((void *)Dest, (void *)Src,
-				(Size - EndExtraWrds) * sizeof(u32));
-		Dest += Size - EndExtraWrds;
-		Src += Size - EndExtraWrds;
-		Size -= Size - EndExtraWrds;
-	}
-
-	if(Size > 0) {
-		for(u8 i = 0; Size > 0; i++) {
-			*Dest = *Src;
-			Dest++;
-			Src++;
-			Size--;
-		}
-	}
-
-	if(Size != 0) {
-		XAIE_ERROR("Copying data to memory failed. %u words not"
-				"written to device\n", Size);
-	}
-}
-
 /*****************************************************************************/
 /**
 *
@@ -735,15 +894,23 @@ static AieRC XAie_LinuxIO_BlockWrite32(void *IOInst, u64 RegOff,
 {
 	XAie_LinuxIO *Inst = (XAie_LinuxIO *)IOInst;
 	u32 *VirtAddr;
+	AieRC RC;
 
 	/* Handle PM and DM sections */
 	VirtAddr =  _XAie_GetVirtAddrFromOffset(Inst, RegOff, Size);
 	if(VirtAddr != NULL) {
-		_XAie_CopyDataToMem(VirtAddr, Data, Size);
-		return XAIE_OK;
+		RC = _XAie_LinuxIO_BatchFlush(Inst);
+		_XAie_IOCommon_CopyDataToMem(VirtAddr, Data, Size);
+		return RC;
 	}
 
 	/* Handle other registers */
+	if(__atomic_load_n(&Inst->BatchEnable, __ATOMIC_RELAXED) ==
+			XAIE_ENABLE) {
+		return _XAie_LinuxIO_BatchAdd(Inst, XAIE_IO_BLOCKWRITE, RegOff,
+				0U, 0U, Data, Size);
+	}
+
 	for(u32 i = 0; i < Size; i++) {
 		XAie_LinuxIO_Write32(IOInst, RegOff + i * 4U, *Data);
 		Data++;
@@ -773,17 +940,23 @@ static AieRC XAie_LinuxIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
 {
 	XAie_LinuxIO *Inst = (XAie_LinuxIO *)IOInst;
 	u32 *VirtAddr;
+	AieRC RC;
 
 	/* Handle PM and DM sections */
 	VirtAddr =  _XAie_GetVirtAddrFromOffset(Inst, RegOff, Size);
 	if(VirtAddr != NULL) {
-		for(u32 i = 0; i < Size; i++) {
-			*VirtAddr++ = Data;
-		}
-		return XAIE_OK;
+		RC = _XAie_LinuxIO_BatchFlush(Inst);
+		_XAie_IOCommon_SetDataInMem(VirtAddr, Data, Size);
+		return RC;
 	}
 
 	/* Handle other registers */
+	if(__atomic_load_n(&Inst->BatchEnable, __ATOMIC_RELAXED) ==
+			XAIE_ENABLE) {
+		return _XAie_LinuxIO_BatchAdd(Inst, XAIE_IO_BLOCKSET, RegOff,
+				0U, Data, NULL, Size);
+	}
+
 	for(u32 i = 0; i < Size; i++) {
 		XAie_LinuxIO_Write32(IOInst, RegOff + i * 4U, Data);
 	}
@@ -791,6 +964,44 @@ static AieRC XAie_LinuxIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read a block of data from aie.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Pointer to store the data.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_LinuxIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	XAie_LinuxIO *Inst = (XAie_LinuxIO *)IOInst;
+	u32 *VirtAddr;
+	AieRC RC;
+
+	/* Handle PM and DM sections */
+	VirtAddr =  _XAie_GetVirtAddrFromOffset(Inst, RegOff, Size);
+	if(VirtAddr != NULL) {
+		RC = _XAie_LinuxIO_BatchFlush(Inst);
+		memcpy((void *)Data, (void *)VirtAddr, Size * sizeof(u32));
+		return RC;
+	}
+
+	/* Handle other registers */
+	for(u32 i = 0; i < Size; i++) {
+		XAie_LinuxIO_Read32(IOInst, RegOff + i * 4U, &Data[i]);
+	}
+
+	return XAIE_OK;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -1352,6 +1563,12 @@ static AieRC XAie_LinuxIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 {
 	AieRC RC;
 
+	/* The operations are ordered after the batched writes */
+	RC = _XAie_LinuxIO_BatchFlush((XAie_LinuxIO *)IOInst);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
 	switch(Op) {
 	case XAIE_BACKEND_OP_CONFIG_SHIMDMABD:
 		return _XAie_LinuxIO_ConfigShimDmaBd(IOInst, Arg);
@@ -1373,6 +1590,9 @@ static AieRC XAie_LinuxIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 		return _XAie_LinuxIO_RequestAllocatedRsc(IOInst, Arg);
 	case XAIE_BACKEND_OP_GET_RSC_STAT:
 		return _XAie_LinuxIO_GetRscStat(IOInst, Arg);
+	case XAIE_BACKEND_OP_FLUSH:
+		/* The batched writes are submitted above */
+		return XAIE_OK;
 	default:
 		XAIE_ERROR("Linux backend does not support operation %d\n", Op);
 		return XAIE_FEATURE_NOT_SUPPORTED;
@@ -1404,6 +1624,10 @@ static AieRC XAie_LinuxSubmitTxn(void *IOInst, XAie_TxnInst *TxnInst)
 	int Ret;
 	struct aie_txn_inst Args;
 
+	if(_XAie_LinuxIO_BatchFlush(LinuxIOInst) != XAIE_OK) {
+		return XAIE_ERR;
+	}
+
 	Args.num_cmds = TxnInst->NumCmds;
 	Args.cmdsptr = (u64)TxnInst->CmdBuf;
 
@@ -1467,7 +1691,7 @@ static AieRC XAie_LinuxIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 }
 
 static AieRC XAie_LinuxIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
-		u32 TimeOutUs)
+		u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
 	/* no-op */
 	(void)IOInst;
@@ -1475,6 +1699,7 @@ static AieRC XAie_LinuxIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value
 	(void)Mask;
 	(void)Value;
 	(void)TimeOutUs;
+	(void)Policy;
 	return XAIE_ERR;
 }
 
@@ -1502,6 +1727,18 @@ static AieRC XAie_LinuxIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
 	return XAIE_ERR;
 }
 
+static AieRC XAie_LinuxIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Data;
+	(void)Size;
+
+	return XAIE_ERR;
+}
+
 static AieRC XAie_LinuxIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 		XAie_BackendOpCode Op, void *Arg)
 {
@@ -1592,6 +1829,7 @@ const XAie_Backend LinuxBackend =
 	.Ops.MaskPoll = XAie_LinuxIO_MaskPoll,
 	.Ops.BlockWrite32 = XAie_LinuxIO_BlockWrite32,
 	.Ops.BlockSet32 = XAie_LinuxIO_BlockSet32,
+	.Ops.BlockRead32 = XAie_LinuxIO_BlockRead32,
 	.Ops.CmdWrite = XAie_LinuxIO_CmdWrite,
 	.Ops.RunOp = XAie_LinuxIO_RunOp,
 	.Ops.MemAllocate = XAie_LinuxMemAllocate,
@@ -52,6 +52,7 @@
 #ifdef __AIEMETAL__
 
 typedef struct XAie_MetalIO {
+	XAie_DevInst *DevInst;
 	int DevFd;
 	u64 BaseAddr;
 	u64 MapSize;
@@ -208,6 +209,7 @@ static AieRC XAie_MetalIO_Init(XAie_DevInst *DevInst)
 		return XAIE_ERR;
 	}
 
+	MetalIOInst->DevInst = DevInst;
 	MetalIOInst->BaseAddr = (u64)Addr;
 	MetalIOInst->DevFd = Fd;
 	MetalIOInst->MapSize = Size;
@@ -309,6 +311,7 @@ static AieRC XAie_MetalIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 * @param	Mask: Mask to be applied to Data.
 * @param	Value: 32-bit value to poll for
 * @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy.
 *
 * @return	XAIE_OK or XAIE_ERR.
 *
@@ -316,34 +319,10 @@ static AieRC XAie_MetalIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 *
 *******************************************************************************/
 static AieRC XAie_MetalIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
-		u32 TimeOutUs)
-{
-	AieRC Ret = XAIE_ERR;
-	u32 Count, MinTimeOutUs, RegVal;
-
-	/*
-	 * Any value less than 200 us becomes noticable overhead. This is based
-	 * on some profiling, and it may vary between platforms.
-	 */
-	MinTimeOutUs = 200;
-	Count = ((u64)TimeOutUs + MinTimeOutUs - 1) / MinTimeOutUs;
-
-	while (Count > 0U) {
-		XAie_MetalIO_Read32(IOInst, RegOff, &RegVal);
-		if((RegVal & Mask) == Value) {
-			return XAIE_OK;
-		}
-		usleep(MinTimeOutUs);
-		Count--;
-	}
-
-	/* Check for the break from timed-out loop */
-	XAie_MetalIO_Read32(IOInst, RegOff, &RegVal);
-	if((RegVal & Mask) == Value) {
-		Ret = XAIE_OK;
-	}
-
-	return Ret;
+		u32 TimeOutUs, const XAie_PollPolicy *Policy)
+{
+	return _XAie_IOCommon_MaskPoll(IOInst, XAie_MetalIO_Read32, RegOff, Mask,
+			Value, TimeOutUs, Policy);
 }
 
 /*****************************************************************************/
@@ -364,6 +343,18 @@ static AieRC XAie_MetalIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value
 static AieRC XAie_MetalIO_BlockWrite32(void *IOInst, u64 RegOff,
 		const u32 *Data, u32 Size)
 {
+	XAie_MetalIO *MetalIOInst = (XAie_MetalIO *)IOInst;
+
+	/* Handle PM and DM sections */
+	if(_XAie_IOCommon_IsMemRange(MetalIOInst->DevInst, RegOff, Size) ==
+			XAIE_ENABLE) {
+		_XAie_IOCommon_CopyDataToMem(
+				(u32 *)(MetalIOInst->BaseAddr + RegOff), Data,
+				Size);
+		return XAIE_OK;
+	}
+
+	/* Handle other registers */
 	for(u32 i = 0; i < Size; i++) {
 		XAie_MetalIO_Write32(IOInst, RegOff + i * 4U, *Data);
 		Data++;
@@ -391,6 +382,18 @@ static AieRC XAie_MetalIO_BlockWrite32(void *IOInst, u64 RegOff,
 static AieRC XAie_MetalIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
 		u32 Size)
 {
+	XAie_MetalIO *MetalIOInst = (XAie_MetalIO *)IOInst;
+
+	/* Handle PM and DM sections */
+	if(_XAie_IOCommon_IsMemRange(MetalIOInst->DevInst, RegOff, Size) ==
+			XAIE_ENABLE) {
+		_XAie_IOCommon_SetDataInMem(
+				(u32 *)(MetalIOInst->BaseAddr + RegOff), Data,
+				Size);
+		return XAIE_OK;
+	}
+
+	/* Handle other registers */
 	for(u32 i = 0; i < Size; i++) {
 		XAie_MetalIO_Write32(IOInst, RegOff + i * 4U, Data);
 	}
@@ -398,6 +401,42 @@ static AieRC XAie_MetalIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read a block of data from aie.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Pointer to store the data.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_MetalIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	XAie_MetalIO *MetalIOInst = (XAie_MetalIO *)IOInst;
+
+	/* Handle PM and DM sections */
+	if(_XAie_IOCommon_IsMemRange(MetalIOInst->DevInst, RegOff, Size) ==
+			XAIE_ENABLE) {
+		memcpy((void *)Data, (void *)(MetalIOInst->BaseAddr + RegOff),
+				Size * sizeof(u32));
+		return XAIE_OK;
+	}
+
+	/* Handle other registers */
+	for(u32 i = 0; i < Size; i++) {
+		XAie_MetalIO_Read32(IOInst, RegOff + i * 4U, &Data[i]);
+	}
+
+	return XAIE_OK;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -453,6 +492,7 @@ static AieRC XAie_MetalIO_NpiRead32(void *IOInst, u64 RegOff, u32 *Data)
 * @param	Mask: Mask to be applied to Data.
 * @param	Value: 32-bit value to poll for
 * @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy.
 *
 * @return	XAIE_OK or XAIE_ERR.
 *
@@ -460,34 +500,11 @@ static AieRC XAie_MetalIO_NpiRead32(void *IOInst, u64 RegOff, u32 *Data)
 *
 *******************************************************************************/
 static AieRC _XAie_MetalIO_NpiMaskPoll(void *IOInst, u64 RegOff, u32 Mask,
-		u32 Value, u32 TimeOutUs)
-{
-	AieRC Ret = XAIE_ERR;
-	u32 Count, MinTimeOutUs, RegVal;
-
-	/*
-	 * Any value less than 200 us becomes noticable overhead. This is based
-	 * on some profiling, and it may vary between platforms.
-	 */
-	MinTimeOutUs = 200;
-	Count = ((u64)TimeOutUs + MinTimeOutUs - 1) / MinTimeOutUs;
-
-	while (Count > 0U) {
-		XAie_MetalIO_NpiRead32(IOInst, RegOff, &RegVal);
-		if((RegVal & Mask) == Value) {
-			return XAIE_OK;
-		}
-		usleep(MinTimeOutUs);
-		Count--;
-	}
-
-	/* Check for the break from timed-out loop */
-	XAie_MetalIO_NpiRead32(IOInst, RegOff, &RegVal);
-	if((RegVal & Mask) == Value) {
-		Ret = XAIE_OK;
-	}
-
-	return Ret;
+		u32 Value, u32 TimeOutUs,
+		const XAie_PollPolicy *Policy)
+{
+	return _XAie_IOCommon_MaskPoll(IOInst, XAie_MetalIO_NpiRead32, RegOff, Mask,
+			Value, TimeOutUs, Policy);
 }
 
 /*****************************************************************************/
@@ -528,7 +545,8 @@ static AieRC XAie_MetalIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 			XAie_BackendNpiMaskPollReq *Req = Arg;
 
 			return _XAie_MetalIO_NpiMaskPoll(IOInst, Req->NpiRegOff,
-					Req->Mask, Req->Val, Req->TimeOutUs);
+					Req->Mask, Req->Val, Req->TimeOutUs,
+					&DevInst->PollPolicy[XAIE_POLL_DEFAULT]);
 		}
 		case XAIE_BACKEND_OP_ASSERT_SHIMRST:
 		{
@@ -577,6 +595,10 @@ static AieRC XAie_MetalIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 			return _XAie_PrivilegeTeardownPart(DevInst);
 		case XAIE_BACKEND_OP_GET_RSC_STAT:
 			return _XAie_GetRscStatCommon(DevInst, Arg);
+		case XAIE_BACKEND_OP_FLUSH:
+			/* Writes are not buffered */
+			RC = XAIE_OK;
+			break;
 		default:
 			RC = XAIE_FEATURE_NOT_SUPPORTED;
 			break;
@@ -639,7 +661,7 @@ static AieRC XAie_MetalIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 }
 
 static AieRC XAie_MetalIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
-		u32 TimeOutUs)
+		u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
 	/* no-op */
 	(void)IOInst;
@@ -647,6 +669,7 @@ static AieRC XAie_MetalIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value
 	(void)Mask;
 	(void)Value;
 	(void)TimeOutUs;
+	(void)Policy;
 
 	return XAIE_ERR;
 }
@@ -675,6 +698,18 @@ static AieRC XAie_MetalIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
 	return XAIE_ERR;
 }
 
+static AieRC XAie_MetalIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Data;
+	(void)Size;
+
+	return XAIE_ERR;
+}
+
 static AieRC XAie_MetalIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 		XAie_BackendOpCode Op, void *Arg)
 {
@@ -753,6 +788,7 @@ const XAie_Backend MetalBackend =
 	.Ops.MaskPoll = XAie_MetalIO_MaskPoll,
 	.Ops.BlockWrite32 = XAie_MetalIO_BlockWrite32,
 	.Ops.BlockSet32 = XAie_MetalIO_BlockSet32,
+	.Ops.BlockRead32 = XAie_MetalIO_BlockRead32,
 	.Ops.CmdWrite = XAie_MetalIO_CmdWrite,
 	.Ops.RunOp = XAie_MetalIO_RunOp,
 	.Ops.MemAllocate = XAie_MetalMemAllocate,
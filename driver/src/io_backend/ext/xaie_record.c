@@ -0,0 +1,1096 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_record.c
+* @{
+*
+* This file contains the routines to record the accesses issued to the IO
+* backend of a device instance to a file, and to replay a recording on the
+* backend of another device instance.
+*
+* The recorder is an IO wrapper. A recording is laid out as below, all fields
+* are in the byte order of the host which recorded it.
+*
+*	+----------------------+
+*	| XAie_RecordFileHdr   |
+*	+----------------------+
+*	| XAie_RecordEntry     | entry of the first access
+*	| u32[NumWords]        | payload of the first access
+*	+----------------------+
+*	| ...                  |
+*
+* Transactions submitted to the backend are recorded as the accesses of their
+* commands. Backend operations are recorded once. The accesses a backend operation issues
+* to the backend while it runs, such as the NPI writes of a shim reset, are
+* not recorded and are issued again by the operation on replay. Reads are not
+* recorded. Resource management operations only update state of the host and
+* are not recorded.
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#ifdef __linux__
+#define _XOPEN_SOURCE 600
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#endif
+
+#include "xaie_helper.h"
+#include "xaie_io.h"
+#include "xaie_io_wrap.h"
+#include "xaie_npi.h"
+
+#ifdef __linux__
+/************************** Constant Definitions *****************************/
+#define XAIE_RECORD_FILE_MAGIC		0x43455258U /* "XREC" */
+#define XAIE_RECORD_FILE_VERSION	1U
+#define XAIE_RECORD_MAX_HEAD_WORDS	4U
+
+/**************************** Type Definitions *******************************/
+/* Header of a recording */
+typedef struct {
+	u32 Magic;
+	u16 Version;
+	u16 HdrSize;
+} XAie_RecordFileHdr;
+
+/* Accesses of a recording */
+typedef enum {
+	XAIE_RECORD_WRITE32 = 1U,
+	XAIE_RECORD_MASKWRITE32,
+	XAIE_RECORD_BLOCKWRITE32,
+	XAIE_RECORD_BLOCKSET32,
+	XAIE_RECORD_MASKPOLL,
+	XAIE_RECORD_RUNOP,
+} XAie_RecordOp;
+
+/*
+ * Entry of an access. The payload words of each access are:
+ * XAIE_RECORD_WRITE32		: Value
+ * XAIE_RECORD_MASKWRITE32	: Mask, Value
+ * XAIE_RECORD_BLOCKWRITE32	: Data[]
+ * XAIE_RECORD_BLOCKSET32	: Data, Size
+ * XAIE_RECORD_MASKPOLL		: Mask, Value, TimeOutUs, 1 if the poll passed,
+ *				  XAie_PollSite of the poll
+ * XAIE_RECORD_RUNOP		: arguments of the operation, RegOff is the
+ *				  operation code
+ */
+typedef struct {
+	u8 Op;
+	u8 Rsvd[3U];
+	u32 NumWords;	/* Number of payload words */
+	u64 TimeNs;	/* Time from the start of the recording */
+	u64 RegOff;
+} XAie_RecordEntry;
+
+/* IO instance of the recorder */
+typedef struct {
+	XAie_IOWrap Wrap;
+	FILE *Fd;
+	struct timespec Start;
+	pthread_mutex_t Lock;	/* Recursive, held while an access is issued */
+	u32 Depth;		/* Nesting of the backend operations */
+	AieRC Status;		/* XAIE_ERR once writing the file failed */
+} XAie_Recorder;
+
+/************************** Function Definitions *****************************/
+/*****************************************************************************/
+/**
+*
+* This API returns the site of a poll from the policy it is issued with.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Policy: Poll policy of the poll.
+*
+* @return	Poll site, XAIE_POLL_DEFAULT if the policy is not the policy of
+*		a site of the device instance.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static u32 _XAie_RecordPollSite(const XAie_DevInst *DevInst,
+		const XAie_PollPolicy *Policy)
+{
+	for(u32 Site = 0U; Site < XAIE_POLL_MAX; Site++) {
+		if(Policy == &DevInst->PollPolicy[Site]) {
+			return Site;
+		}
+	}
+
+	return XAIE_POLL_DEFAULT;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the time elapsed from a start time in nano seconds.
+*
+* @param	Start: Start time.
+*
+* @return	Elapsed time in nano seconds.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static u64 _XAie_RecordElapsedNs(const struct timespec *Start)
+{
+	struct timespec Now;
+
+	clock_gettime(CLOCK_MONOTONIC, &Now);
+
+	return (u64)(Now.tv_sec - Start->tv_sec) * 1000000000ULL +
+		(u64)Now.tv_nsec - (u64)Start->tv_nsec;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API appends an access to the recording. The payload is made of the head
+* words followed by the data words.
+*
+* @param	Rec: Recorder.
+* @param	Op: Access.
+* @param	TimeNs: Time the access was issued at.
+* @param	RegOff: Register offset or backend operation code.
+* @param	Head: Head words of the payload.
+* @param	NumHead: Number of head words.
+* @param	Data: Data words of the payload.
+* @param	NumData: Number of data words.
+*
+* @return	None.
+*
+* @note		Internal only. The lock of the recorder must be held. Accesses
+*		issued by a backend operation are dropped.
+*
+*******************************************************************************/
+static void _XAie_RecordLog(XAie_Recorder *Rec, XAie_RecordOp Op, u64 TimeNs,
+		u64 RegOff, const u32 *Head, u32 NumHead, const u32 *Data,
+		u32 NumData)
+{
+	XAie_RecordEntry Entry = {0};
+
+	if((Rec->Depth > 0U) || (Rec->Status != XAIE_OK)) {
+		return;
+	}
+
+	Entry.Op = (u8)Op;
+	Entry.NumWords = NumHead + NumData;
+	Entry.TimeNs = TimeNs;
+	Entry.RegOff = RegOff;
+
+	if((fwrite(&Entry, sizeof(Entry), 1U, Rec->Fd) != 1U) ||
+			(fwrite(Head, sizeof(u32), NumHead, Rec->Fd) != NumHead) ||
+			(fwrite(Data, sizeof(u32), NumData, Rec->Fd) != NumData)) {
+		XAIE_ERROR("Failed to write the recording, recording stopped\n");
+		Rec->Status = XAIE_ERR;
+	}
+}
+
+static AieRC _XAie_Record_Write32(void *IOInst, u64 RegOff, u32 Value)
+{
+	XAie_Recorder *Rec = (XAie_Recorder *)IOInst;
+	u64 TimeNs;
+	AieRC RC;
+
+	pthread_mutex_lock(&Rec->Lock);
+	TimeNs = _XAie_RecordElapsedNs(&Rec->Start);
+	RC = Rec->Wrap.Inner->Ops.Write32(Rec->Wrap.InnerIOInst, RegOff, Value);
+	_XAie_RecordLog(Rec, XAIE_RECORD_WRITE32, TimeNs, RegOff, &Value, 1U,
+			NULL, 0U);
+	pthread_mutex_unlock(&Rec->Lock);
+
+	return RC;
+}
+
+static AieRC _XAie_Record_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value)
+{
+	XAie_Recorder *Rec = (XAie_Recorder *)IOInst;
+	u32 Head[2U] = {Mask, Value};
+	u64 TimeNs;
+	AieRC RC;
+
+	pthread_mutex_lock(&Rec->Lock);
+	TimeNs = _XAie_RecordElapsedNs(&Rec->Start);
+	RC = Rec->Wrap.Inner->Ops.MaskWrite32(Rec->Wrap.InnerIOInst, RegOff,
+			Mask, Value);
+	_XAie_RecordLog(Rec, XAIE_RECORD_MASKWRITE32, TimeNs, RegOff, Head, 2U,
+			NULL, 0U);
+	pthread_mutex_unlock(&Rec->Lock);
+
+	return RC;
+}
+
+static AieRC _XAie_Record_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 TimeOutUs, const XAie_PollPolicy *Policy)
+{
+	XAie_Recorder *Rec = (XAie_Recorder *)IOInst;
+	u32 Head[5U] = {Mask, Value, TimeOutUs, 0U,
+		_XAie_RecordPollSite(Rec->Wrap.DevInst, Policy)};
+	u64 TimeNs;
+	AieRC RC;
+
+	pthread_mutex_lock(&Rec->Lock);
+	TimeNs = _XAie_RecordElapsedNs(&Rec->Start);
+	RC = Rec->Wrap.Inner->Ops.MaskPoll(Rec->Wrap.InnerIOInst, RegOff, Mask,
+			Value, TimeOutUs, Policy);
+	Head[3U] = (RC == XAIE_OK) ? 1U : 0U;
+	_XAie_RecordLog(Rec, XAIE_RECORD_MASKPOLL, TimeNs, RegOff, Head, 5U,
+			NULL, 0U);
+	pthread_mutex_unlock(&Rec->Lock);
+
+	return RC;
+}
+
+static AieRC _XAie_Record_BlockWrite32(void *IOInst, u64 RegOff,
+		const u32 *Data, u32 Size)
+{
+	XAie_Recorder *Rec = (XAie_Recorder *)IOInst;
+	u64 TimeNs;
+	AieRC RC;
+
+	pthread_mutex_lock(&Rec->Lock);
+	TimeNs = _XAie_RecordElapsedNs(&Rec->Start);
+	RC = Rec->Wrap.Inner->Ops.BlockWrite32(Rec->Wrap.InnerIOInst, RegOff,
+			Data, Size);
+	_XAie_RecordLog(Rec, XAIE_RECORD_BLOCKWRITE32, TimeNs, RegOff, NULL, 0U,
+			Data, Size);
+	pthread_mutex_unlock(&Rec->Lock);
+
+	return RC;
+}
+
+static AieRC _XAie_Record_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	XAie_Recorder *Rec = (XAie_Recorder *)IOInst;
+	u32 Head[2U] = {Data, Size};
+	u64 TimeNs;
+	AieRC RC;
+
+	pthread_mutex_lock(&Rec->Lock);
+	TimeNs = _XAie_RecordElapsedNs(&Rec->Start);
+	RC = Rec->Wrap.Inner->Ops.BlockSet32(Rec->Wrap.InnerIOInst, RegOff,
+			Data, Size);
+	_XAie_RecordLog(Rec, XAIE_RECORD_BLOCKSET32, TimeNs, RegOff, Head, 2U,
+			NULL, 0U);
+	pthread_mutex_unlock(&Rec->Lock);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the transaction submission of the recorder. The transaction is
+* submitted to the wrapped backend, and each of its commands is recorded as the
+* access it stands for, so that a recording does not depend on the backend
+* having transaction support.
+*
+* @param	IOInst: IO instance pointer of the recorder.
+* @param	TxnInst: Transaction instance.
+*
+* @return	Return code of the submission.
+*
+* @note		Internal only. Reads of the transaction are not recorded, polls
+*		are recorded with the result of the submission.
+*
+*******************************************************************************/
+static AieRC _XAie_Record_SubmitTxn(void *IOInst, XAie_TxnInst *TxnInst)
+{
+	XAie_Recorder *Rec = (XAie_Recorder *)IOInst;
+	u64 TimeNs;
+	AieRC RC;
+
+	pthread_mutex_lock(&Rec->Lock);
+	TimeNs = _XAie_RecordElapsedNs(&Rec->Start);
+	Rec->Depth++;
+	RC = Rec->Wrap.Inner->Ops.SubmitTxn(Rec->Wrap.InnerIOInst, TxnInst);
+	Rec->Depth--;
+
+	for(u32 i = 0U; i < TxnInst->NumCmds; i++) {
+		const XAie_TxnCmd *Cmd = &TxnInst->CmdBuf[i];
+		u32 Head[5U];
+
+		switch(Cmd->Opcode) {
+			case XAIE_IO_WRITE:
+				if(Cmd->Mask == 0U) {
+					_XAie_RecordLog(Rec,
+						XAIE_RECORD_WRITE32, TimeNs,
+						Cmd->RegOff, &Cmd->Value, 1U,
+						NULL, 0U);
+				} else {
+					Head[0U] = Cmd->Mask;
+					Head[1U] = Cmd->Value;
+					_XAie_RecordLog(Rec,
+						XAIE_RECORD_MASKWRITE32, TimeNs,
+						Cmd->RegOff, Head, 2U, NULL,
+						0U);
+				}
+				break;
+			case XAIE_IO_BLOCKWRITE:
+				_XAie_RecordLog(Rec, XAIE_RECORD_BLOCKWRITE32,
+						TimeNs, Cmd->RegOff, NULL, 0U,
+						(const u32 *)(uintptr_t)Cmd->DataPtr,
+						Cmd->Size);
+				break;
+			case XAIE_IO_BLOCKSET:
+				Head[0U] = Cmd->Value;
+				Head[1U] = Cmd->Size;
+				_XAie_RecordLog(Rec, XAIE_RECORD_BLOCKSET32,
+						TimeNs, Cmd->RegOff, Head, 2U,
+						NULL, 0U);
+				break;
+			case XAIE_IO_MASKPOLL:
+				Head[0U] = Cmd->Mask;
+				Head[1U] = Cmd->Value;
+				Head[2U] = Cmd->Size;
+				Head[3U] = (RC == XAIE_OK) ? 1U : 0U;
+				Head[4U] = (u32)Cmd->DataPtr;
+				_XAie_RecordLog(Rec, XAIE_RECORD_MASKPOLL,
+						TimeNs, Cmd->RegOff, Head, 5U,
+						NULL, 0U);
+				break;
+			default:
+				break;
+		}
+	}
+	pthread_mutex_unlock(&Rec->Lock);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API packs tile locations to payload words, one word per tile with the
+* column in bits 15:8 and the row in bits 7:0.
+*
+* @param	Locs: Tile locations.
+* @param	NumTiles: Number of tiles.
+*
+* @return	Allocated payload words, NULL if there are no tiles or the
+*		allocation failed.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static u32 *_XAie_RecordPackLocs(const XAie_LocType *Locs, u32 NumTiles)
+{
+	u32 *Words;
+
+	if((Locs == NULL) || (NumTiles == 0U)) {
+		return NULL;
+	}
+
+	Words = (u32 *)malloc(NumTiles * sizeof(*Words));
+	if(Words == NULL) {
+		XAIE_ERROR("Failed to allocate memory to record tiles\n");
+		return NULL;
+	}
+
+	for(u32 i = 0U; i < NumTiles; i++) {
+		Words[i] = ((u32)Locs[i].Col << 8U) | Locs[i].Row;
+	}
+
+	return Words;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the run op of the recorder. The operation is recorded with its
+* arguments, and the accesses it issues to the backend are not recorded.
+*
+* @param	IOInst: IO instance pointer of the recorder.
+* @param	DevInst: Device instance pointer.
+* @param	Op: Backend operation code.
+* @param	Arg: Backend operation argument.
+*
+* @return	Return code of the operation.
+*
+* @note		Internal only. The shim DMA BD configuration is recorded as a
+*		block write of the BD words.
+*
+*******************************************************************************/
+static AieRC _XAie_Record_RunOp(void *IOInst, XAie_DevInst *DevInst,
+		XAie_BackendOpCode Op, void *Arg)
+{
+	XAie_Recorder *Rec = (XAie_Recorder *)IOInst;
+	XAie_RecordOp RecOp = XAIE_RECORD_RUNOP;
+	u32 Head[XAIE_RECORD_MAX_HEAD_WORDS + 1U];
+	u32 NumHead = 0U, NumData = 0U;
+	u32 *Data = NULL;
+	u64 RegOff = Op;
+	u8 IsRecorded = XAIE_ENABLE;
+	u64 TimeNs;
+	AieRC RC;
+
+	switch(Op) {
+		case XAIE_BACKEND_OP_NPIWR32:
+		{
+			XAie_BackendNpiWrReq *Req = Arg;
+
+			Head[0U] = Req->NpiRegOff;
+			Head[1U] = Req->Val;
+			NumHead = 2U;
+			break;
+		}
+		case XAIE_BACKEND_OP_NPIMASKPOLL32:
+		{
+			XAie_BackendNpiMaskPollReq *Req = Arg;
+
+			Head[0U] = Req->NpiRegOff;
+			Head[1U] = Req->Mask;
+			Head[2U] = Req->Val;
+			Head[3U] = Req->TimeOutUs;
+			/* Result of the poll is added after the operation */
+			NumHead = 5U;
+			break;
+		}
+		case XAIE_BACKEND_OP_ASSERT_SHIMRST:
+			Head[0U] = (u32)((uintptr_t)Arg & 0xFF);
+			NumHead = 1U;
+			break;
+		case XAIE_BACKEND_OP_SET_PROTREG:
+		{
+			XAie_NpiProtRegReq *Req = Arg;
+
+			Head[0U] = Req->StartCol;
+			Head[1U] = Req->NumCols;
+			Head[2U] = Req->Enable;
+			NumHead = 3U;
+			break;
+		}
+		case XAIE_BACKEND_OP_CONFIG_SHIMDMABD:
+		{
+			XAie_ShimDmaBdArgs *BdArgs = Arg;
+
+			RecOp = XAIE_RECORD_BLOCKWRITE32;
+			RegOff = BdArgs->Addr;
+			Data = BdArgs->BdWords;
+			NumData = BdArgs->NumBdWords;
+			break;
+		}
+		case XAIE_BACKEND_OP_REQUEST_TILES:
+		case XAIE_BACKEND_OP_RELEASE_TILES:
+		{
+			XAie_BackendTilesArray *Tiles = Arg;
+
+			Head[0U] = Tiles->NumTiles;
+			NumHead = 1U;
+			Data = _XAie_RecordPackLocs(Tiles->Locs,
+					Tiles->NumTiles);
+			NumData = (Data == NULL) ? 0U : Tiles->NumTiles;
+			break;
+		}
+		case XAIE_BACKEND_OP_PARTITION_INITIALIZE:
+		{
+			XAie_PartInitOpts *Opts = Arg;
+
+			Head[0U] = (Opts == NULL) ? 0U : 1U;
+			Head[1U] = (Opts == NULL) ? 0U : Opts->InitOpts;
+			Head[2U] = (Opts == NULL) ? 0U : Opts->NumUseTiles;
+			NumHead = 3U;
+			if(Opts != NULL) {
+				Data = _XAie_RecordPackLocs(Opts->Locs,
+						Opts->NumUseTiles);
+				NumData = (Data == NULL) ? 0U :
+					Opts->NumUseTiles;
+			}
+			break;
+		}
+		case XAIE_BACKEND_OP_UPDATE_NPI_ADDR:
+		{
+			u64 NpiAddr = *(u64 *)Arg;
+
+			Head[0U] = (u32)NpiAddr;
+			Head[1U] = (u32)(NpiAddr >> 32U);
+			NumHead = 2U;
+			break;
+		}
+		case XAIE_BACKEND_OP_RST_PART:
+		case XAIE_BACKEND_OP_PARTITION_TEARDOWN:
+		case XAIE_BACKEND_OP_FLUSH:
+			break;
+		default:
+			IsRecorded = XAIE_DISABLE;
+			break;
+	}
+
+	pthread_mutex_lock(&Rec->Lock);
+	TimeNs = _XAie_RecordElapsedNs(&Rec->Start);
+	Rec->Depth++;
+	RC = Rec->Wrap.Inner->Ops.RunOp(Rec->Wrap.InnerIOInst, DevInst, Op,
+			Arg);
+	Rec->Depth--;
+	if(IsRecorded == XAIE_ENABLE) {
+		if(Op == XAIE_BACKEND_OP_NPIMASKPOLL32) {
+			Head[4U] = (RC == XAIE_OK) ? 1U : 0U;
+		}
+		_XAie_RecordLog(Rec, RecOp, TimeNs, RegOff, Head, NumHead,
+				Data, NumData);
+	}
+	pthread_mutex_unlock(&Rec->Lock);
+
+	if((Op != XAIE_BACKEND_OP_CONFIG_SHIMDMABD) && (Data != NULL)) {
+		free(Data);
+	}
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API releases the recorder and closes the recording.
+*
+* @param	Wrap: Wrapper of the recorder.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_RecordRelease(XAie_IOWrap *Wrap)
+{
+	XAie_Recorder *Rec = (XAie_Recorder *)Wrap;
+
+	if(fclose(Rec->Fd) != 0) {
+		XAIE_ERROR("Failed to close the recording\n");
+	}
+	pthread_mutex_destroy(&Rec->Lock);
+	free(Rec);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API starts to record the accesses issued to the IO backend of a device
+* instance.
+*
+* @param	DevInst: Device instance pointer.
+* @param	FileName: Path of the recording.
+*
+* @return	XAIE_OK on success and error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+AieRC _XAie_RecordStart(XAie_DevInst *DevInst, const char *FileName)
+{
+	static const XAie_BackendOps Ops = {
+		.Write32 = _XAie_Record_Write32,
+		.MaskWrite32 = _XAie_Record_MaskWrite32,
+		.MaskPoll = _XAie_Record_MaskPoll,
+		.BlockWrite32 = _XAie_Record_BlockWrite32,
+		.BlockSet32 = _XAie_Record_BlockSet32,
+		.RunOp = _XAie_Record_RunOp,
+		.SubmitTxn = _XAie_Record_SubmitTxn,
+	};
+	XAie_RecordFileHdr Hdr = {
+		.Magic = XAIE_RECORD_FILE_MAGIC,
+		.Version = XAIE_RECORD_FILE_VERSION,
+		.HdrSize = sizeof(XAie_RecordFileHdr),
+	};
+	pthread_mutexattr_t Attr;
+	XAie_Recorder *Rec;
+	AieRC RC;
+
+	if(_XAie_IOWrapFind(DevInst, _XAie_RecordRelease) != NULL) {
+		XAIE_ERROR("IO backend is already recorded\n");
+		return XAIE_ERR;
+	}
+
+	Rec = (XAie_Recorder *)calloc(1U, sizeof(*Rec));
+	if(Rec == NULL) {
+		XAIE_ERROR("Failed to allocate memory for the recorder\n");
+		return XAIE_ERR;
+	}
+
+	Rec->Fd = fopen(FileName, "wb");
+	if(Rec->Fd == NULL) {
+		XAIE_ERROR("Failed to open %s\n", FileName);
+		free(Rec);
+		return XAIE_ERR;
+	}
+
+	if(fwrite(&Hdr, sizeof(Hdr), 1U, Rec->Fd) != 1U) {
+		XAIE_ERROR("Failed to write %s\n", FileName);
+		fclose(Rec->Fd);
+		free(Rec);
+		return XAIE_ERR;
+	}
+
+	pthread_mutexattr_init(&Attr);
+	pthread_mutexattr_settype(&Attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&Rec->Lock, &Attr);
+	pthread_mutexattr_destroy(&Attr);
+	clock_gettime(CLOCK_MONOTONIC, &Rec->Start);
+	Rec->Status = XAIE_OK;
+
+	RC = _XAie_IOWrapInstall(DevInst, &Rec->Wrap, &Ops,
+			_XAie_RecordRelease);
+	if(RC != XAIE_OK) {
+		_XAie_RecordRelease(&Rec->Wrap);
+		return RC;
+	}
+
+	/* Transactions are executed by the driver if the backend can't */
+	if(Rec->Wrap.Inner->Ops.SubmitTxn == NULL) {
+		Rec->Wrap.Backend.Ops.SubmitTxn = NULL;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API stops the recording of a device instance and closes the file.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success, XAIE_ERR if the device instance is not
+*		recorded or if the recording could not be written.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+AieRC _XAie_RecordStop(XAie_DevInst *DevInst)
+{
+	XAie_Recorder *Rec;
+	AieRC RC;
+
+	Rec = (XAie_Recorder *)_XAie_IOWrapFind(DevInst, _XAie_RecordRelease);
+	if(Rec == NULL) {
+		XAIE_ERROR("IO backend is not recorded\n");
+		return XAIE_ERR;
+	}
+
+	RC = Rec->Status;
+	if(fflush(Rec->Fd) != 0) {
+		XAIE_ERROR("Failed to write the recording\n");
+		RC = XAIE_ERR;
+	}
+
+	if(_XAie_IOWrapRemove(DevInst, &Rec->Wrap) != XAIE_OK) {
+		return XAIE_ERR;
+	}
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API unpacks tile locations from payload words.
+*
+* @param	Words: Payload words.
+* @param	NumTiles: Number of tiles.
+*
+* @return	Allocated tile locations, NULL if there are no tiles or the
+*		allocation failed.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static XAie_LocType *_XAie_ReplayUnpackLocs(const u32 *Words, u32 NumTiles)
+{
+	XAie_LocType *Locs;
+
+	if(NumTiles == 0U) {
+		return NULL;
+	}
+
+	Locs = (XAie_LocType *)malloc(NumTiles * sizeof(*Locs));
+	if(Locs == NULL) {
+		XAIE_ERROR("Failed to allocate memory to replay tiles\n");
+		return NULL;
+	}
+
+	for(u32 i = 0U; i < NumTiles; i++) {
+		Locs[i] = XAie_TileLoc((u8)(Words[i] >> 8U), (u8)Words[i]);
+	}
+
+	return Locs;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API issues a recorded backend operation to the backend of a device
+* instance.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Entry: Entry of the operation.
+* @param	Words: Payload words of the operation.
+* @param	IsPassed: Set to 1 if a recorded poll passed, else 0.
+*
+* @return	XAIE_OK on success and error code on failure. Polls return the
+*		result of the poll.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_ReplayRunOp(XAie_DevInst *DevInst,
+		const XAie_RecordEntry *Entry, const u32 *Words, u8 *IsPassed)
+{
+	const XAie_Backend *Backend = DevInst->Backend;
+	XAie_BackendOpCode Op = (XAie_BackendOpCode)Entry->RegOff;
+	u32 NumWords = Entry->NumWords;
+	void *Arg = NULL;
+	XAie_BackendNpiWrReq WrReq;
+	XAie_BackendNpiMaskPollReq PollReq;
+	XAie_NpiProtRegReq ProtRegReq;
+	XAie_BackendTilesArray Tiles;
+	XAie_PartInitOpts Opts;
+	XAie_LocType *Locs = NULL;
+	u64 NpiAddr;
+	u32 MinWords = 0U;
+	AieRC RC;
+
+	switch(Op) {
+		case XAIE_BACKEND_OP_NPIWR32:
+			MinWords = 2U;
+			break;
+		case XAIE_BACKEND_OP_NPIMASKPOLL32:
+			MinWords = 5U;
+			break;
+		case XAIE_BACKEND_OP_ASSERT_SHIMRST:
+			MinWords = 1U;
+			break;
+		case XAIE_BACKEND_OP_SET_PROTREG:
+			MinWords = 3U;
+			break;
+		case XAIE_BACKEND_OP_REQUEST_TILES:
+		case XAIE_BACKEND_OP_RELEASE_TILES:
+			MinWords = 1U;
+			break;
+		case XAIE_BACKEND_OP_PARTITION_INITIALIZE:
+			MinWords = 3U;
+			break;
+		case XAIE_BACKEND_OP_UPDATE_NPI_ADDR:
+			MinWords = 2U;
+			break;
+		case XAIE_BACKEND_OP_RST_PART:
+		case XAIE_BACKEND_OP_PARTITION_TEARDOWN:
+		case XAIE_BACKEND_OP_FLUSH:
+			break;
+		default:
+			XAIE_ERROR("Invalid backend operation %u in recording\n",
+					Op);
+			return XAIE_ERR;
+	}
+
+	if(NumWords < MinWords) {
+		XAIE_ERROR("Corrupted backend operation %u in recording\n",
+				Op);
+		return XAIE_ERR;
+	}
+
+	switch(Op) {
+		case XAIE_BACKEND_OP_NPIWR32:
+			WrReq.NpiRegOff = Words[0U];
+			WrReq.Val = Words[1U];
+			Arg = &WrReq;
+			break;
+		case XAIE_BACKEND_OP_NPIMASKPOLL32:
+			PollReq.NpiRegOff = Words[0U];
+			PollReq.Mask = Words[1U];
+			PollReq.Val = Words[2U];
+			PollReq.TimeOutUs = Words[3U];
+			*IsPassed = (u8)Words[4U];
+			Arg = &PollReq;
+			break;
+		case XAIE_BACKEND_OP_ASSERT_SHIMRST:
+			Arg = (void *)(uintptr_t)Words[0U];
+			break;
+		case XAIE_BACKEND_OP_SET_PROTREG:
+			ProtRegReq.StartCol = Words[0U];
+			ProtRegReq.NumCols = Words[1U];
+			ProtRegReq.Enable = (u8)Words[2U];
+			Arg = &ProtRegReq;
+			break;
+		case XAIE_BACKEND_OP_REQUEST_TILES:
+		case XAIE_BACKEND_OP_RELEASE_TILES:
+			Tiles.NumTiles = (NumWords - 1U < Words[0U]) ?
+				NumWords - 1U : Words[0U];
+			Locs = _XAie_ReplayUnpackLocs(&Words[1U],
+					Tiles.NumTiles);
+			Tiles.Locs = Locs;
+			if(Locs == NULL) {
+				Tiles.NumTiles = 0U;
+			}
+			Arg = &Tiles;
+			break;
+		case XAIE_BACKEND_OP_PARTITION_INITIALIZE:
+			if(Words[0U] == 0U) {
+				break;
+			}
+			Opts.InitOpts = Words[1U];
+			Opts.NumUseTiles = (NumWords - 3U < Words[2U]) ?
+				NumWords - 3U : Words[2U];
+			Locs = _XAie_ReplayUnpackLocs(&Words[3U],
+					Opts.NumUseTiles);
+			Opts.Locs = Locs;
+			if(Locs == NULL) {
+				Opts.NumUseTiles = 0U;
+			}
+			Arg = &Opts;
+			break;
+		case XAIE_BACKEND_OP_UPDATE_NPI_ADDR:
+			NpiAddr = ((u64)Words[1U] << 32U) | Words[0U];
+			Arg = &NpiAddr;
+			break;
+		default:
+			break;
+	}
+
+	RC = Backend->Ops.RunOp(DevInst->IOInst, DevInst, Op, Arg);
+	free(Locs);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API issues a recorded access to the backend of a device instance.
+*
+* @param	DevInst: Device instance pointer.
+* @param	Entry: Entry of the access.
+* @param	Words: Payload words of the access.
+* @param	IsPoll: Set to XAIE_ENABLE if the access is a poll.
+* @param	IsPassed: Set to 1 if a recorded poll passed, else 0.
+*
+* @return	XAIE_OK on success and error code on failure. Polls return the
+*		result of the poll.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_ReplayEntry(XAie_DevInst *DevInst,
+		const XAie_RecordEntry *Entry, const u32 *Words, u8 *IsPoll,
+		u8 *IsPassed)
+{
+	const XAie_Backend *Backend = DevInst->Backend;
+	void *IOInst = DevInst->IOInst;
+	u32 NumWords = Entry->NumWords;
+	u32 Site = XAIE_POLL_DEFAULT;
+
+	*IsPoll = XAIE_DISABLE;
+
+	switch(Entry->Op) {
+		case XAIE_RECORD_WRITE32:
+			if(NumWords < 1U) {
+				break;
+			}
+			return Backend->Ops.Write32(IOInst, Entry->RegOff,
+					Words[0U]);
+		case XAIE_RECORD_MASKWRITE32:
+			if(NumWords < 2U) {
+				break;
+			}
+			return Backend->Ops.MaskWrite32(IOInst, Entry->RegOff,
+					Words[0U], Words[1U]);
+		case XAIE_RECORD_BLOCKWRITE32:
+			if(NumWords == 0U) {
+				return XAIE_OK;
+			}
+			return Backend->Ops.BlockWrite32(IOInst, Entry->RegOff,
+					Words, NumWords);
+		case XAIE_RECORD_BLOCKSET32:
+			if(NumWords < 2U) {
+				break;
+			}
+			return Backend->Ops.BlockSet32(IOInst, Entry->RegOff,
+					Words[0U], Words[1U]);
+		case XAIE_RECORD_MASKPOLL:
+			if(NumWords < 4U) {
+				break;
+			}
+			/* Polls recorded without their site use the default */
+			if((NumWords > 4U) && (Words[4U] < XAIE_POLL_MAX)) {
+				Site = Words[4U];
+			}
+			*IsPoll = XAIE_ENABLE;
+			*IsPassed = (u8)Words[3U];
+			return Backend->Ops.MaskPoll(IOInst, Entry->RegOff,
+					Words[0U], Words[1U], Words[2U],
+					&DevInst->PollPolicy[Site]);
+		case XAIE_RECORD_RUNOP:
+			*IsPoll = (Entry->RegOff ==
+					XAIE_BACKEND_OP_NPIMASKPOLL32) ?
+				XAIE_ENABLE : XAIE_DISABLE;
+			return _XAie_ReplayRunOp(DevInst, Entry, Words,
+					IsPassed);
+		default:
+			XAIE_ERROR("Invalid access %u in recording\n",
+					Entry->Op);
+			return XAIE_ERR;
+	}
+
+	XAIE_ERROR("Corrupted access %u in recording\n", Entry->Op);
+	return XAIE_ERR;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API replays a recording on the IO backend of a device instance.
+*
+* @param	DevInst: Device instance pointer.
+* @param	FileName: Path of the recording.
+* @param	Mode: Timing of the replay.
+*
+* @return	XAIE_OK on success. XAIE_ERR if the recording is invalid, or if
+*		a poll did not have the recorded result. Error code of the
+*		backend if an access failed.
+*
+* @note		Internal only. The replay stops at the first failed access.
+*		A poll with another result than the recorded one is reported
+*		and the replay continues.
+*
+*******************************************************************************/
+AieRC _XAie_Replay(XAie_DevInst *DevInst, const char *FileName,
+		XAie_ReplayMode Mode)
+{
+	XAie_RecordFileHdr Hdr;
+	XAie_RecordEntry Entry;
+	struct timespec Start;
+	u32 *Words = NULL;
+	u32 MaxWords = 0U;
+	u64 NumEntries = 0U;
+	u32 NumMismatches = 0U;
+	AieRC RC = XAIE_OK;
+	FILE *Fd;
+
+	Fd = fopen(FileName, "rb");
+	if(Fd == NULL) {
+		XAIE_ERROR("Failed to open %s\n", FileName);
+		return XAIE_ERR;
+	}
+
+	if((fread(&Hdr, sizeof(Hdr), 1U, Fd) != 1U) ||
+			(Hdr.Magic != XAIE_RECORD_FILE_MAGIC) ||
+			(Hdr.Version != XAIE_RECORD_FILE_VERSION) ||
+			(Hdr.HdrSize != sizeof(Hdr))) {
+		XAIE_ERROR("%s is not a recording\n", FileName);
+		fclose(Fd);
+		return XAIE_ERR;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &Start);
+
+	while(fread(&Entry, sizeof(Entry), 1U, Fd) == 1U) {
+		u8 IsPoll, IsPassed = 0U;
+
+		if(Entry.NumWords > MaxWords) {
+			u32 *NewWords;
+
+			NewWords = (u32 *)realloc(Words,
+					(u64)Entry.NumWords * sizeof(u32));
+			if(NewWords == NULL) {
+				XAIE_ERROR("Failed to allocate memory to "
+						"replay\n");
+				RC = XAIE_ERR;
+				break;
+			}
+			Words = NewWords;
+			MaxWords = Entry.NumWords;
+		}
+
+		if(fread(Words, sizeof(u32), Entry.NumWords, Fd) !=
+				Entry.NumWords) {
+			XAIE_ERROR("Recording %s is truncated\n", FileName);
+			RC = XAIE_ERR;
+			break;
+		}
+
+		if(Mode == XAIE_REPLAY_TIMED) {
+			struct timespec Target;
+			u64 Ns = (u64)Start.tv_nsec + Entry.TimeNs;
+
+			Target.tv_sec = Start.tv_sec +
+				(time_t)(Ns / 1000000000ULL);
+			Target.tv_nsec = (long)(Ns % 1000000000ULL);
+			while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+						&Target, NULL) != 0) {
+			}
+		}
+
+		RC = _XAie_ReplayEntry(DevInst, &Entry, Words, &IsPoll,
+				&IsPassed);
+		if(IsPoll == XAIE_ENABLE) {
+			if((RC == XAIE_OK) != (IsPassed == 1U)) {
+				XAIE_ERROR("Poll of access %lu at 0x%lx %s, it "
+						"%s when recorded\n",
+						NumEntries, Entry.RegOff,
+						(RC == XAIE_OK) ? "passed" :
+						"failed", (IsPassed == 1U) ?
+						"passed" : "failed");
+				NumMismatches++;
+			}
+			RC = XAIE_OK;
+		} else if(RC != XAIE_OK) {
+			XAIE_ERROR("Failed to replay access %lu at 0x%lx\n",
+					NumEntries, Entry.RegOff);
+			break;
+		}
+
+		NumEntries++;
+	}
+
+	free(Words);
+	fclose(Fd);
+
+	XAIE_DBG("Replayed %lu accesses of %s\n", NumEntries, FileName);
+
+	if((RC == XAIE_OK) && (NumMismatches > 0U)) {
+		RC = XAIE_ERR;
+	}
+
+	return RC;
+}
+
+#else
+
+AieRC _XAie_RecordStart(XAie_DevInst *DevInst, const char *FileName)
+{
+	(void)DevInst;
+	(void)FileName;
+
+	XAIE_ERROR("Recording the IO backend is not supported\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+AieRC _XAie_RecordStop(XAie_DevInst *DevInst)
+{
+	(void)DevInst;
+
+	XAIE_ERROR("Recording the IO backend is not supported\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+AieRC _XAie_Replay(XAie_DevInst *DevInst, const char *FileName,
+		XAie_ReplayMode Mode)
+{
+	(void)DevInst;
+	(void)FileName;
+	(void)Mode;
+
+	XAIE_ERROR("Replaying a recording is not supported\n");
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+#endif /* __linux__ */
+
+/** @} */
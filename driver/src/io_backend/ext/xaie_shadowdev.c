@@ -0,0 +1,1081 @@
+/******************************************************************************
+* Copyright (C) 2022 Xilinx, Inc.  All rights reserved.
+* SPDX-License-Identifier: MIT
+******************************************************************************/
+
+
+/*****************************************************************************/
+/**
+* @file xaie_shadowdev.c
+* @{
+*
+* This file contains the data structures and routines for the shadow device
+* backend. The backend models the address space of the partition and of the
+* NPI as sparse memories made of pages which are allocated on first write, so
+* reads return what was written. It runs the driver on hosts without hardware
+* or a simulator, for tests and for measuring the overhead of the driver.
+*
+* Registers do not have side effects. A mask poll on a value which is not
+* written by the application waits for its timeout and fails.
+*
+******************************************************************************/
+/***************************** Include Files *********************************/
+#ifdef __AIESHADOWDEV__
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#endif /* __AIESHADOWDEV__ */
+
+#include "xaie_helper.h"
+#include "xaie_io.h"
+#include "xaie_io_common.h"
+#include "xaie_io_privilege.h"
+#include "xaie_npi.h"
+
+/***************************** Macro Definitions *****************************/
+#define XAIE_SHADOWDEV_PAGE_SHIFT	12U
+#define XAIE_SHADOWDEV_PAGE_WORDS	((1U << XAIE_SHADOWDEV_PAGE_SHIFT) / 4U)
+#define XAIE_SHADOWDEV_INIT_SLOTS	64U
+#define XAIE_SHADOWDEV_NO_PAGE		(~0ULL)
+
+/****************************** Type Definitions *****************************/
+#ifdef __AIESHADOWDEV__
+
+/*
+ * Sparse memory. Pages are kept in an open addressing table indexed by the
+ * page number, which is grown when it is half full.
+ */
+typedef struct XAie_ShadowDevMem {
+	u64 NumPages;	/* Number of allocated pages */
+	u64 NumSlots;	/* Size of the table, a power of 2 */
+	u64 *PageNums;	/* Page number of each slot, or XAIE_SHADOWDEV_NO_PAGE */
+	u32 **Pages;	/* Words of the page of each slot */
+} XAie_ShadowDevMem;
+
+typedef struct XAie_ShadowDevIO {
+	XAie_DevInst *DevInst;
+	XAie_ShadowDevMem Mem;		/* Address space of the partition */
+	XAie_ShadowDevMem NpiMem;	/* Address space of the NPI */
+	pthread_mutex_t Lock;		/* Protects both memories */
+} XAie_ShadowDevIO;
+
+#endif /* __AIESHADOWDEV__ */
+
+/************************** Function Definitions *****************************/
+#ifdef __AIESHADOWDEV__
+
+/*****************************************************************************/
+/**
+*
+* This API returns the slot of a page in the table of a sparse memory. The slot
+* is either the one of the page or the empty slot where the page goes.
+*
+* @param	Mem: Sparse memory.
+* @param	PageNum: Page number.
+*
+* @return	Slot index.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static u64 _XAie_ShadowDevFindSlot(const XAie_ShadowDevMem *Mem, u64 PageNum)
+{
+	u64 Slot = PageNum ^ (PageNum >> 17U);
+
+	Slot *= 0x9E3779B97F4A7C15ULL;
+	Slot ^= Slot >> 29U;
+
+	for(Slot &= Mem->NumSlots - 1U;
+			(Mem->PageNums[Slot] != XAIE_SHADOWDEV_NO_PAGE) &&
+			(Mem->PageNums[Slot] != PageNum);
+			Slot = (Slot + 1U) & (Mem->NumSlots - 1U)) {
+	}
+
+	return Slot;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API allocates the page table of a sparse memory.
+*
+* @param	Mem: Sparse memory.
+* @param	NumSlots: Number of slots, a power of 2.
+*
+* @return	XAIE_OK on success, XAIE_ERR on allocation failure.
+*
+* @note		Internal only. The pages are not moved to the new table.
+*
+*******************************************************************************/
+static AieRC _XAie_ShadowDevAllocTable(XAie_ShadowDevMem *Mem, u64 NumSlots)
+{
+	Mem->PageNums = (u64 *)malloc(NumSlots * sizeof(*Mem->PageNums));
+	Mem->Pages = (u32 **)calloc(NumSlots, sizeof(*Mem->Pages));
+	if((Mem->PageNums == NULL) || (Mem->Pages == NULL)) {
+		free(Mem->PageNums);
+		free(Mem->Pages);
+		XAIE_ERROR("Failed to allocate shadow device page table\n");
+		return XAIE_ERR;
+	}
+
+	for(u64 i = 0U; i < NumSlots; i++) {
+		Mem->PageNums[i] = XAIE_SHADOWDEV_NO_PAGE;
+	}
+	Mem->NumSlots = NumSlots;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API doubles the page table of a sparse memory.
+*
+* @param	Mem: Sparse memory.
+*
+* @return	XAIE_OK on success, XAIE_ERR on allocation failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_ShadowDevGrow(XAie_ShadowDevMem *Mem)
+{
+	XAie_ShadowDevMem Old = *Mem;
+	AieRC RC;
+
+	RC = _XAie_ShadowDevAllocTable(Mem, Old.NumSlots * 2U);
+	if(RC != XAIE_OK) {
+		*Mem = Old;
+		return RC;
+	}
+
+	for(u64 i = 0U; i < Old.NumSlots; i++) {
+		u64 Slot;
+
+		if(Old.PageNums[i] == XAIE_SHADOWDEV_NO_PAGE) {
+			continue;
+		}
+
+		Slot = _XAie_ShadowDevFindSlot(Mem, Old.PageNums[i]);
+		Mem->PageNums[Slot] = Old.PageNums[i];
+		Mem->Pages[Slot] = Old.Pages[i];
+	}
+
+	free(Old.PageNums);
+	free(Old.Pages);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API returns the words of a page of a sparse memory.
+*
+* @param	Mem: Sparse memory.
+* @param	PageNum: Page number.
+* @param	Alloc: XAIE_ENABLE to allocate a zeroed page if there is none.
+*
+* @return	Pointer to the words of the page. NULL if the page does not exist
+*		and is not allocated.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static u32 *_XAie_ShadowDevGetPage(XAie_ShadowDevMem *Mem, u64 PageNum,
+		u8 Alloc)
+{
+	u64 Slot;
+	u32 *Page;
+
+	Slot = _XAie_ShadowDevFindSlot(Mem, PageNum);
+	if((Mem->PageNums[Slot] == PageNum) || (Alloc == XAIE_DISABLE)) {
+		return Mem->Pages[Slot];
+	}
+
+	if((Mem->NumPages + 1U) * 2U > Mem->NumSlots) {
+		if(_XAie_ShadowDevGrow(Mem) != XAIE_OK) {
+			return NULL;
+		}
+		Slot = _XAie_ShadowDevFindSlot(Mem, PageNum);
+	}
+
+	Page = (u32 *)calloc(XAIE_SHADOWDEV_PAGE_WORDS, sizeof(*Page));
+	if(Page == NULL) {
+		XAIE_ERROR("Failed to allocate shadow device page\n");
+		return NULL;
+	}
+
+	Mem->PageNums[Slot] = PageNum;
+	Mem->Pages[Slot] = Page;
+	Mem->NumPages++;
+
+	return Page;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API frees the pages and the page table of a sparse memory.
+*
+* @param	Mem: Sparse memory.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_ShadowDevFreeMem(XAie_ShadowDevMem *Mem)
+{
+	for(u64 i = 0U; i < Mem->NumSlots; i++) {
+		free(Mem->Pages[i]);
+	}
+
+	free(Mem->PageNums);
+	free(Mem->Pages);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes a block of words to a sparse memory.
+*
+* @param	Mem: Sparse memory.
+* @param	Addr: Address of the first word.
+* @param	Data: Words to write, or NULL to write Fill to every word.
+* @param	Fill: Value to write if Data is NULL.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, XAIE_ERR on allocation failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_ShadowDevWriteMem(XAie_ShadowDevMem *Mem, u64 Addr,
+		const u32 *Data, u32 Fill, u32 Size)
+{
+	while(Size > 0U) {
+		u32 Word = (u32)(Addr >> 2U) & (XAIE_SHADOWDEV_PAGE_WORDS - 1U);
+		u32 Num = XAIE_SHADOWDEV_PAGE_WORDS - Word;
+		u32 *Page;
+
+		Page = _XAie_ShadowDevGetPage(Mem,
+				Addr >> XAIE_SHADOWDEV_PAGE_SHIFT, XAIE_ENABLE);
+		if(Page == NULL) {
+			return XAIE_ERR;
+		}
+
+		if(Num > Size) {
+			Num = Size;
+		}
+
+		if(Data != NULL) {
+			memcpy(&Page[Word], Data, Num * sizeof(u32));
+			Data += Num;
+		} else {
+			for(u32 i = 0U; i < Num; i++) {
+				Page[Word + i] = Fill;
+			}
+		}
+
+		Addr += (u64)Num * 4U;
+		Size -= Num;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API reads a block of words from a sparse memory. Words which were never
+* written read as zero.
+*
+* @param	Mem: Sparse memory.
+* @param	Addr: Address of the first word.
+* @param	Data: Pointer to store the words.
+* @param	Size: Number of 32-bit words.
+*
+* @return	None.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static void _XAie_ShadowDevReadMem(XAie_ShadowDevMem *Mem, u64 Addr,
+		u32 *Data, u32 Size)
+{
+	while(Size > 0U) {
+		u32 Word = (u32)(Addr >> 2U) & (XAIE_SHADOWDEV_PAGE_WORDS - 1U);
+		u32 Num = XAIE_SHADOWDEV_PAGE_WORDS - Word;
+		u32 *Page;
+
+		Page = _XAie_ShadowDevGetPage(Mem,
+				Addr >> XAIE_SHADOWDEV_PAGE_SHIFT, XAIE_DISABLE);
+
+		if(Num > Size) {
+			Num = Size;
+		}
+
+		if(Page != NULL) {
+			memcpy(Data, &Page[Word], Num * sizeof(u32));
+		} else {
+			memset(Data, 0, Num * sizeof(u32));
+		}
+
+		Data += Num;
+		Addr += (u64)Num * 4U;
+		Size -= Num;
+	}
+}
+
+/*****************************************************************************/
+/**
+*
+* This API checks that a block of words is within the tiles of the partition.
+* The tile of the first and of the last word are decoded from the offset.
+*
+* @param	ShadowDevIOInst: Shadow device IO instance pointer.
+* @param	RegOff: Register offset of the first word.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK if the block is within the partition, XAIE_INVALID_ADDRESS
+*		otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_ShadowDevCheckAddr(XAie_ShadowDevIO *ShadowDevIOInst,
+		u64 RegOff, u32 Size)
+{
+	XAie_DevInst *DevInst = ShadowDevIOInst->DevInst;
+	u8 RowShift = DevInst->DevProp.RowShift;
+	u8 ColShift = DevInst->DevProp.ColShift;
+	u64 Ends[2U] = {RegOff, RegOff + ((u64)Size - 1U) * 4U};
+
+	for(u8 i = 0U; i < 2U; i++) {
+		u64 Col = Ends[i] >> ColShift;
+		u64 Row = (Ends[i] >> RowShift) &
+			((1ULL << (ColShift - RowShift)) - 1U);
+
+		if((Col >= DevInst->NumCols) || (Row >= DevInst->NumRows)) {
+			XAIE_ERROR("Offset 0x%lx is not in a tile of the "
+					"partition\n", Ends[i]);
+			return XAIE_INVALID_ADDRESS;
+		}
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to free the global IO instance
+*
+* @param	IOInst: IO Instance pointer.
+*
+* @return	XAIE_OK.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_ShadowDevIO_Finish(void *IOInst)
+{
+	XAie_ShadowDevIO *ShadowDevIOInst = (XAie_ShadowDevIO *)IOInst;
+
+	_XAie_ShadowDevFreeMem(&ShadowDevIOInst->Mem);
+	_XAie_ShadowDevFreeMem(&ShadowDevIOInst->NpiMem);
+	pthread_mutex_destroy(&ShadowDevIOInst->Lock);
+	free(ShadowDevIOInst);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to initialize the global IO instance. Both
+* memories start empty, so every register reads as zero.
+*
+* @param	DevInst: Device instance pointer.
+*
+* @return	XAIE_OK on success. Error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_ShadowDevIO_Init(XAie_DevInst *DevInst)
+{
+	XAie_ShadowDevIO *IOInst;
+
+	IOInst = (XAie_ShadowDevIO *)calloc(1U, sizeof(*IOInst));
+	if(IOInst == NULL) {
+		XAIE_ERROR("Memory allocation failed\n");
+		return XAIE_ERR;
+	}
+
+	if(_XAie_ShadowDevAllocTable(&IOInst->Mem,
+				XAIE_SHADOWDEV_INIT_SLOTS) != XAIE_OK) {
+		free(IOInst);
+		return XAIE_ERR;
+	}
+
+	if(_XAie_ShadowDevAllocTable(&IOInst->NpiMem,
+				XAIE_SHADOWDEV_INIT_SLOTS) != XAIE_OK) {
+		_XAie_ShadowDevFreeMem(&IOInst->Mem);
+		free(IOInst);
+		return XAIE_ERR;
+	}
+
+	pthread_mutex_init(&IOInst->Lock, NULL);
+	IOInst->DevInst = DevInst;
+	DevInst->IOInst = IOInst;
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write a block of data to aie.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to write to.
+* @param	Data: Pointer to the data buffer.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_ShadowDevIO_BlockWrite32(void *IOInst, u64 RegOff,
+		const u32 *Data, u32 Size)
+{
+	XAie_ShadowDevIO *ShadowDevIOInst = (XAie_ShadowDevIO *)IOInst;
+	AieRC RC;
+
+	if(Size == 0U) {
+		return XAIE_OK;
+	}
+
+	RC = _XAie_ShadowDevCheckAddr(ShadowDevIOInst, RegOff, Size);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	pthread_mutex_lock(&ShadowDevIOInst->Lock);
+	RC = _XAie_ShadowDevWriteMem(&ShadowDevIOInst->Mem, RegOff, Data, 0U,
+			Size);
+	pthread_mutex_unlock(&ShadowDevIOInst->Lock);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to initialize a chunk of aie address space with
+* a specified value.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to write to.
+* @param	Data: Data to initialize a chunk of aie address space..
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_ShadowDevIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	XAie_ShadowDevIO *ShadowDevIOInst = (XAie_ShadowDevIO *)IOInst;
+	AieRC RC;
+
+	if(Size == 0U) {
+		return XAIE_OK;
+	}
+
+	RC = _XAie_ShadowDevCheckAddr(ShadowDevIOInst, RegOff, Size);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	pthread_mutex_lock(&ShadowDevIOInst->Lock);
+	RC = _XAie_ShadowDevWriteMem(&ShadowDevIOInst->Mem, RegOff, NULL, Data,
+			Size);
+	pthread_mutex_unlock(&ShadowDevIOInst->Lock);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read a block of data from aie.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Pointer to store the data.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_ShadowDevIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	XAie_ShadowDevIO *ShadowDevIOInst = (XAie_ShadowDevIO *)IOInst;
+	AieRC RC;
+
+	if(Size == 0U) {
+		return XAIE_OK;
+	}
+
+	RC = _XAie_ShadowDevCheckAddr(ShadowDevIOInst, RegOff, Size);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	pthread_mutex_lock(&ShadowDevIOInst->Lock);
+	_XAie_ShadowDevReadMem(&ShadowDevIOInst->Mem, RegOff, Data, Size);
+	pthread_mutex_unlock(&ShadowDevIOInst->Lock);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write 32bit data to the specified address.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to write to.
+* @param	Value: 32-bit data to be written.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_ShadowDevIO_Write32(void *IOInst, u64 RegOff, u32 Value)
+{
+	return XAie_ShadowDevIO_BlockWrite32(IOInst, RegOff, &Value, 1U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read 32bit data from the specified address.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Pointer to store the 32 bit value
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_ShadowDevIO_Read32(void *IOInst, u64 RegOff, u32 *Data)
+{
+	return XAie_ShadowDevIO_BlockRead32(IOInst, RegOff, Data, 1U);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to write masked 32bit data to the specified
+* address. The read and the write are atomic with respect to other accesses
+* of the backend.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to write to.
+* @param	Mask: Mask to be applied to Data.
+* @param	Value: 32-bit data to be written.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_ShadowDevIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value)
+{
+	XAie_ShadowDevIO *ShadowDevIOInst = (XAie_ShadowDevIO *)IOInst;
+	u32 RegVal;
+	AieRC RC;
+
+	RC = _XAie_ShadowDevCheckAddr(ShadowDevIOInst, RegOff, 1U);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	pthread_mutex_lock(&ShadowDevIOInst->Lock);
+	_XAie_ShadowDevReadMem(&ShadowDevIOInst->Mem, RegOff, &RegVal, 1U);
+	RegVal &= ~Mask;
+	RegVal |= Value;
+	RC = _XAie_ShadowDevWriteMem(&ShadowDevIOInst->Mem, RegOff, &RegVal, 0U,
+			1U);
+	pthread_mutex_unlock(&ShadowDevIOInst->Lock);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to mask poll an address for a value.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Mask: Mask to be applied to Data.
+* @param	Value: 32-bit value to poll for
+* @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy.
+*
+* @return	XAIE_OK or XAIE_ERR.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_ShadowDevIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 TimeOutUs, const XAie_PollPolicy *Policy)
+{
+	return _XAie_IOCommon_MaskPoll(IOInst, XAie_ShadowDevIO_Read32, RegOff,
+			Mask, Value, TimeOutUs, Policy);
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the function to write to AI engine NPI registers
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to write.
+* @param	RegVal: Register value to write
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_ShadowDevIO_NpiWrite32(void *IOInst, u32 RegOff,
+		u32 RegVal)
+{
+	XAie_ShadowDevIO *ShadowDevIOInst = (XAie_ShadowDevIO *)IOInst;
+	AieRC RC;
+
+	pthread_mutex_lock(&ShadowDevIOInst->Lock);
+	RC = _XAie_ShadowDevWriteMem(&ShadowDevIOInst->NpiMem, RegOff, &RegVal,
+			0U, 1U);
+	pthread_mutex_unlock(&ShadowDevIOInst->Lock);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the function to read from AI engine NPI registers
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Pointer to store the 32 bit value
+*
+* @return	XAIE_OK.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_ShadowDevIO_NpiRead32(void *IOInst, u64 RegOff, u32 *Data)
+{
+	XAie_ShadowDevIO *ShadowDevIOInst = (XAie_ShadowDevIO *)IOInst;
+
+	pthread_mutex_lock(&ShadowDevIOInst->Lock);
+	_XAie_ShadowDevReadMem(&ShadowDevIOInst->NpiMem, RegOff, Data, 1U);
+	pthread_mutex_unlock(&ShadowDevIOInst->Lock);
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the function to run backend operations
+*
+* @param	IOInst: IO instance pointer
+* @param	DevInst: AI engine partition device instance
+* @param	Op: Backend operation code
+* @param	Arg: Backend operation argument
+*
+* @return	XAIE_OK for success and error code for failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_ShadowDevIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
+		     XAie_BackendOpCode Op, void *Arg)
+{
+	AieRC RC = XAIE_OK;
+
+	switch(Op) {
+		case XAIE_BACKEND_OP_NPIWR32:
+		{
+			XAie_BackendNpiWrReq *Req = Arg;
+
+			RC = _XAie_ShadowDevIO_NpiWrite32(IOInst,
+					Req->NpiRegOff, Req->Val);
+			break;
+		}
+		case XAIE_BACKEND_OP_NPIMASKPOLL32:
+		{
+			XAie_BackendNpiMaskPollReq *Req = Arg;
+
+			return _XAie_IOCommon_MaskPoll(IOInst,
+					_XAie_ShadowDevIO_NpiRead32,
+					Req->NpiRegOff, Req->Mask, Req->Val,
+					Req->TimeOutUs,
+					&DevInst->PollPolicy[XAIE_POLL_DEFAULT]);
+		}
+		case XAIE_BACKEND_OP_ASSERT_SHIMRST:
+		{
+			u8 RstEnable = (u8)((uintptr_t)Arg & 0xFF);
+
+			RC = _XAie_NpiSetShimReset(DevInst, RstEnable);
+			break;
+		}
+		case XAIE_BACKEND_OP_SET_PROTREG:
+			RC = _XAie_NpiSetProtectedRegEnable(DevInst, Arg);
+			break;
+		case XAIE_BACKEND_OP_CONFIG_SHIMDMABD:
+		{
+			XAie_ShimDmaBdArgs *BdArgs = (XAie_ShimDmaBdArgs *)Arg;
+
+			RC = XAie_ShadowDevIO_BlockWrite32(IOInst, BdArgs->Addr,
+					BdArgs->BdWords, BdArgs->NumBdWords);
+			break;
+		}
+		case XAIE_BACKEND_OP_REQUEST_TILES:
+			return _XAie_PrivilegeRequestTiles(DevInst,
+					(XAie_BackendTilesArray *)Arg);
+		case XAIE_BACKEND_OP_REQUEST_RESOURCE:
+			return _XAie_RequestRscCommon(DevInst, Arg);
+		case XAIE_BACKEND_OP_RELEASE_RESOURCE:
+			return _XAie_ReleaseRscCommon(Arg);
+		case XAIE_BACKEND_OP_FREE_RESOURCE:
+			return _XAie_FreeRscCommon(Arg);
+		case XAIE_BACKEND_OP_REQUEST_ALLOCATED_RESOURCE:
+			return _XAie_RequestAllocatedRscCommon(DevInst, Arg);
+		case XAIE_BACKEND_OP_PARTITION_INITIALIZE:
+			return _XAie_PrivilegeInitPart(DevInst,
+					(XAie_PartInitOpts *)Arg);
+		case XAIE_BACKEND_OP_PARTITION_TEARDOWN:
+			return _XAie_PrivilegeTeardownPart(DevInst);
+		case XAIE_BACKEND_OP_GET_RSC_STAT:
+			return _XAie_GetRscStatCommon(DevInst, Arg);
+		case XAIE_BACKEND_OP_FLUSH:
+			/* Writes are not buffered */
+			break;
+		default:
+			XAIE_ERROR("Shadow device backend doesn't support "
+					"operation %u.\n", Op);
+			RC = XAIE_FEATURE_NOT_SUPPORTED;
+			break;
+	}
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory function to allocate a memory
+*
+* @param	DevInst: Device Instance
+* @param	Size: Size of the memory
+* @param	Cache: Buffer to be cacheable or not
+*
+* @return	Pointer to the allocated memory instance.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static XAie_MemInst* XAie_ShadowDevMemAllocate(XAie_DevInst *DevInst, u64 Size,
+		XAie_MemCacheProp Cache)
+{
+	XAie_MemInst *MemInst;
+
+	MemInst = (XAie_MemInst *)malloc(sizeof(*MemInst));
+	if(MemInst == NULL) {
+		XAIE_ERROR("memory allocation failed\n");
+		return NULL;
+	}
+
+	MemInst->VAddr = (void *)malloc(Size);
+	if(MemInst->VAddr == NULL) {
+		XAIE_ERROR("malloc failed\n");
+		free(MemInst);
+		return NULL;
+	}
+	MemInst->DevAddr = (u64)MemInst->VAddr;
+	MemInst->Size = Size;
+	MemInst->DevInst = DevInst;
+
+	(void)Cache;
+
+	return MemInst;
+}
+
+/*****************************************************************************/
+/**
+*
+* This is the memory function to free the memory
+*
+* @param	MemInst: Memory instance pointer.
+*
+* @return	XAIE_OK.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_ShadowDevMemFree(XAie_MemInst *MemInst)
+{
+	free(MemInst->VAddr);
+	free(MemInst);
+
+	return XAIE_OK;
+}
+
+static AieRC XAie_ShadowDevMemSyncForCPU(XAie_MemInst *MemInst)
+{
+	(void)MemInst;
+	return XAIE_OK;
+}
+
+static AieRC XAie_ShadowDevMemSyncForDev(XAie_MemInst *MemInst)
+{
+	(void)MemInst;
+	return XAIE_OK;
+}
+
+static AieRC XAie_ShadowDevMemAttach(XAie_MemInst *MemInst, u64 MemHandle)
+{
+	(void)MemInst;
+	(void)MemHandle;
+	return XAIE_OK;
+}
+
+static AieRC XAie_ShadowDevMemDetach(XAie_MemInst *MemInst)
+{
+	(void)MemInst;
+	return XAIE_OK;
+}
+
+static u64 XAie_ShadowDevGetTid(void)
+{
+	return (u64)pthread_self();
+}
+
+#else
+
+static AieRC XAie_ShadowDevIO_Finish(void *IOInst)
+{
+	/* no-op */
+	(void)IOInst;
+	return XAIE_OK;
+}
+
+static AieRC XAie_ShadowDevIO_Init(XAie_DevInst *DevInst)
+{
+	/* no-op */
+	(void)DevInst;
+	XAIE_ERROR("Driver is not compiled with shadow device backend "
+			"(__AIESHADOWDEV__)\n");
+	return XAIE_INVALID_BACKEND;
+}
+
+static AieRC XAie_ShadowDevIO_Write32(void *IOInst, u64 RegOff, u32 Value)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Value;
+
+	return XAIE_ERR;
+}
+
+static AieRC XAie_ShadowDevIO_Read32(void *IOInst, u64 RegOff, u32 *Data)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Data;
+	return XAIE_ERR;
+}
+
+static AieRC XAie_ShadowDevIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Mask;
+	(void)Value;
+
+	return XAIE_ERR;
+}
+
+static AieRC XAie_ShadowDevIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
+		u32 Value, u32 TimeOutUs, const XAie_PollPolicy *Policy)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Mask;
+	(void)Value;
+	(void)TimeOutUs;
+	(void)Policy;
+
+	return XAIE_ERR;
+}
+
+static AieRC XAie_ShadowDevIO_BlockWrite32(void *IOInst, u64 RegOff,
+		const u32 *Data, u32 Size)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Data;
+	(void)Size;
+
+	return XAIE_ERR;
+}
+
+static AieRC XAie_ShadowDevIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
+		u32 Size)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Data;
+	(void)Size;
+
+	return XAIE_ERR;
+}
+
+static AieRC XAie_ShadowDevIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Data;
+	(void)Size;
+
+	return XAIE_ERR;
+}
+
+static AieRC XAie_ShadowDevIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
+		XAie_BackendOpCode Op, void *Arg)
+{
+	(void)IOInst;
+	(void)DevInst;
+	(void)Op;
+	(void)Arg;
+	return XAIE_FEATURE_NOT_SUPPORTED;
+}
+
+static XAie_MemInst* XAie_ShadowDevMemAllocate(XAie_DevInst *DevInst, u64 Size,
+		XAie_MemCacheProp Cache)
+{
+	(void)DevInst;
+	(void)Size;
+	(void)Cache;
+	return NULL;
+}
+
+static AieRC XAie_ShadowDevMemFree(XAie_MemInst *MemInst)
+{
+	(void)MemInst;
+	return XAIE_ERR;
+}
+
+static AieRC XAie_ShadowDevMemSyncForCPU(XAie_MemInst *MemInst)
+{
+	(void)MemInst;
+	return XAIE_ERR;
+}
+
+static AieRC XAie_ShadowDevMemSyncForDev(XAie_MemInst *MemInst)
+{
+	(void)MemInst;
+	return XAIE_ERR;
+}
+
+static AieRC XAie_ShadowDevMemAttach(XAie_MemInst *MemInst, u64 MemHandle)
+{
+	(void)MemInst;
+	(void)MemHandle;
+	return XAIE_ERR;
+}
+
+static AieRC XAie_ShadowDevMemDetach(XAie_MemInst *MemInst)
+{
+	(void)MemInst;
+	return XAIE_ERR;
+}
+
+static u64 XAie_ShadowDevGetTid(void)
+{
+	return 0;
+}
+
+#endif /* __AIESHADOWDEV__ */
+
+static AieRC XAie_ShadowDevIO_CmdWrite(void *IOInst, u8 Col, u8 Row,
+		u8 Command, u32 CmdWd0, u32 CmdWd1, const char *CmdStr)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)Col;
+	(void)Row;
+	(void)Command;
+	(void)CmdWd0;
+	(void)CmdWd1;
+	(void)CmdStr;
+
+	return XAIE_OK;
+}
+
+const XAie_Backend ShadowDevBackend =
+{
+	.Type = XAIE_IO_BACKEND_SHADOWDEV,
+	.Ops.Init = XAie_ShadowDevIO_Init,
+	.Ops.Finish = XAie_ShadowDevIO_Finish,
+	.Ops.Write32 = XAie_ShadowDevIO_Write32,
+	.Ops.Read32 = XAie_ShadowDevIO_Read32,
+	.Ops.MaskWrite32 = XAie_ShadowDevIO_MaskWrite32,
+	.Ops.MaskPoll = XAie_ShadowDevIO_MaskPoll,
+	.Ops.BlockWrite32 = XAie_ShadowDevIO_BlockWrite32,
+	.Ops.BlockSet32 = XAie_ShadowDevIO_BlockSet32,
+	.Ops.BlockRead32 = XAie_ShadowDevIO_BlockRead32,
+	.Ops.CmdWrite = XAie_ShadowDevIO_CmdWrite,
+	.Ops.RunOp = XAie_ShadowDevIO_RunOp,
+	.Ops.MemAllocate = XAie_ShadowDevMemAllocate,
+	.Ops.MemFree = XAie_ShadowDevMemFree,
+	.Ops.MemSyncForCPU = XAie_ShadowDevMemSyncForCPU,
+	.Ops.MemSyncForDev = XAie_ShadowDevMemSyncForDev,
+	.Ops.MemAttach = XAie_ShadowDevMemAttach,
+	.Ops.MemDetach = XAie_ShadowDevMemDetach,
+	.Ops.GetTid = XAie_ShadowDevGetTid,
+	.Ops.SubmitTxn = NULL,
+};
+
+/** @} */
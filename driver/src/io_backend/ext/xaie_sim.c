@@ -184,6 +184,7 @@ static AieRC XAie_SimIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 * @param	Mask: Mask to be applied to Data.
 * @param	Value: 32-bit value to poll for
 * @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy.
 *
 * @return	XAIE_OK or XAIE_ERR.
 *
@@ -191,26 +192,10 @@ static AieRC XAie_SimIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 *
 *******************************************************************************/
 static AieRC XAie_SimIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
-		u32 TimeOutUs)
+		u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
-	AieRC Ret = XAIE_ERR;
-	u32 RegVal;
-
-	/* Increment Timeout value to 1 if user passed value is 1 */
-	if(TimeOutUs == 0U)
-		TimeOutUs++;
-
-	while(TimeOutUs > 0U) {
-		XAie_SimIO_Read32(IOInst, RegOff, &RegVal);
-		if((RegVal & Mask) == Value) {
-			Ret = XAIE_OK;
-			break;
-		}
-		usleep(1);
-		TimeOutUs--;
-	}
-
-	return Ret;
+	return _XAie_IOCommon_MaskPoll(IOInst, XAie_SimIO_Read32, RegOff, Mask,
+			Value, TimeOutUs, Policy);
 }
 
 /*****************************************************************************/
@@ -263,6 +248,31 @@ static AieRC XAie_SimIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data, u32 Size)
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read a block of data from aie.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Pointer to store the data.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_SimIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	for(u32 i = 0U; i < Size; i++) {
+		XAie_SimIO_Read32(IOInst, RegOff + i * 4U, &Data[i]);
+	}
+
+	return XAIE_OK;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -349,6 +359,7 @@ static AieRC XAie_SimIO_NpiRead32(void *IOInst, u64 RegOff, u32 *Data)
 * @param	Mask: Mask to be applied to Data.
 * @param	Value: 32-bit value to poll for
 * @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy.
 *
 * @return	XAIE_OK or XAIE_ERR.
 *
@@ -356,27 +367,11 @@ static AieRC XAie_SimIO_NpiRead32(void *IOInst, u64 RegOff, u32 *Data)
 *
 *******************************************************************************/
 static AieRC _XAie_SimIO_NpiMaskPoll(void *IOInst, u64 RegOff, u32 Mask,
-		u32 Value, u32 TimeOutUs)
+		u32 Value, u32 TimeOutUs,
+		const XAie_PollPolicy *Policy)
 {
-	AieRC Ret = XAIE_ERR;
-	u32 RegVal;
-
-
-	/* Increment Timeout value to 1 if user passed value is 1 */
-	if(TimeOutUs == 0U)
-		TimeOutUs++;
-
-	while(TimeOutUs > 0U) {
-		XAie_SimIO_NpiRead32(IOInst, RegOff, &RegVal);
-		if((RegVal & Mask) == Value) {
-			Ret = XAIE_OK;
-			break;
-		}
-		usleep(1);
-		TimeOutUs--;
-	}
-
-	return Ret;
+	return _XAie_IOCommon_MaskPoll(IOInst, XAie_SimIO_NpiRead32, RegOff, Mask,
+			Value, TimeOutUs, Policy);
 }
 
 static AieRC XAie_SimIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
@@ -397,7 +392,8 @@ static AieRC XAie_SimIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 		XAie_BackendNpiMaskPollReq *Req = Arg;
 
 		return _XAie_SimIO_NpiMaskPoll(IOInst, Req->NpiRegOff,
-				Req->Mask, Req->Val, Req->TimeOutUs);
+				Req->Mask, Req->Val, Req->TimeOutUs,
+				&DevInst->PollPolicy[XAIE_POLL_DEFAULT]);
 	}
 	case XAIE_BACKEND_OP_CONFIG_SHIMDMABD:
 	{
@@ -432,6 +428,9 @@ static AieRC XAie_SimIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 		SimIOInst->NpiBaseAddr = *((u64 *)Arg);
 		break;
 	}
+	case XAIE_BACKEND_OP_FLUSH:
+		/* Writes are not buffered */
+		break;
 	default:
 		XAIE_ERROR("Simulation backend doesn't support operation %d\n",
 				Op);
@@ -496,7 +495,7 @@ static AieRC XAie_SimIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 }
 
 static AieRC XAie_SimIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
-		u32 TimeOutUs)
+		u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
 	/* no-op */
 	(void)IOInst;
@@ -504,6 +503,7 @@ static AieRC XAie_SimIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
 	(void)Mask;
 	(void)Value;
 	(void)TimeOutUs;
+	(void)Policy;
 	return XAIE_ERR;
 }
 
@@ -530,6 +530,18 @@ static AieRC XAie_SimIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data, u32 Size)
 	return XAIE_ERR;
 }
 
+static AieRC XAie_SimIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Data;
+	(void)Size;
+
+	return XAIE_ERR;
+}
+
 static AieRC XAie_SimIO_CmdWrite(void *IOInst, u8 Col, u8 Row, u8 Command,
 		u32 CmdWd0, u32 CmdWd1, const char *CmdStr)
 {
@@ -613,6 +625,7 @@ const XAie_Backend SimBackend =
 	.Ops.MaskPoll = XAie_SimIO_MaskPoll,
 	.Ops.BlockWrite32 = XAie_SimIO_BlockWrite32,
 	.Ops.BlockSet32 = XAie_SimIO_BlockSet32,
+	.Ops.BlockRead32 = XAie_SimIO_BlockRead32,
 	.Ops.CmdWrite = XAie_SimIO_CmdWrite,
 	.Ops.RunOp = XAie_SimIO_RunOp,
 	.Ops.MemAllocate = XAie_SimMemAllocate,
@@ -11,6 +11,19 @@
 *
 * This file contains the low level layer IO interface for socket io backend.
 *
+* The backend talks a line based text protocol by default. If the environment
+* variable XAIE_SOCKET_PROTOCOL is set to "binary", the binary protocol is
+* requested from the server when the backend is initialized, and the text
+* protocol is kept if the server does not accept it or does not reply in time.
+* In text mode, mask polls are done by the client with reads. In binary mode,
+* each access is a frame of a fixed header followed by the payload words, all
+* converted to little endian. Write frames are buffered and sent when a read or
+* a poll needs a reply from the server, when the buffer is full, or on an
+* explicit flush with XAie_FlushIO(). Mask polls are done by the server, which
+* replies once the condition is met or the timeout expires.
+* examples/xaie_socket_server.c is a stand-in server which implements both
+* protocols.
+*
 * <pre>
 * MODIFICATION HISTORY:
 *
@@ -28,6 +41,7 @@
 
 #include <errno.h>
 #include <netdb.h>
+#include <poll.h>
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -47,20 +61,516 @@
 /***************************** Macro Definitions *****************************/
 #define XAIE_IO_SOCKET_CMDBUFSIZE	48U
 #define XAIE_IO_SOCKET_RDBUFSIZE	11U /* "0xDEADBEEF\n" */
+#define XAIE_IO_SOCKET_SNDBUFSIZE	0x10000U
+#define XAIE_IO_SOCKET_PROTO_ENV	"XAIE_SOCKET_PROTOCOL"
+#define XAIE_IO_SOCKET_PROTO_VERSION	1U
+#define XAIE_IO_SOCKET_PROTO_TIMEOUT_MS	1000 /* Wait for the version reply */
+
+/* Opcodes of the binary protocol frames */
+#define XAIE_IO_SOCKET_OP_WRITE		0x1U /* Payload: 1 word */
+#define XAIE_IO_SOCKET_OP_BLOCKWRITE	0x2U /* Payload: Size words */
+#define XAIE_IO_SOCKET_OP_BLOCKSET	0x3U /* Payload: 1 word */
+#define XAIE_IO_SOCKET_OP_READ		0x4U /* Reply: 1 word */
+#define XAIE_IO_SOCKET_OP_SYNC		0x5U /* Reply: 1 word status */
+#define XAIE_IO_SOCKET_OP_MASKPOLL	0x6U /* Payload: mask, value, timeout */
+					     /* Reply: 1 word status */
+#define XAIE_IO_SOCKET_OP_BLOCKREAD	0x7U /* Reply: Size words */
 
 /****************************** Type Definitions *****************************/
 #ifdef __AIESOCKET__
 
+/*
+ * Header of a binary protocol frame. Size is the number of words written by
+ * the frame, and Addr is the absolute address of the first word.
+ */
+typedef struct XAie_SocketFrameHdr {
+	u8 Opcode;
+	u8 Rsvd[3];
+	u32 Size;
+	u64 Addr;
+} XAie_SocketFrameHdr;
+
 typedef struct XAie_SocketIO {
 	u64 BaseAddr;
 	u64 NpiBaseAddr;
 	int SocketFd;
+	u8 IsBinary;		/* Binary protocol is in use */
+	u32 SndLen;		/* Number of buffered bytes */
+	pthread_mutex_t Lock;	/* Protects the send buffer and the socket */
+	u8 SndBuf[XAIE_IO_SOCKET_SNDBUFSIZE];
 } XAie_SocketIO;
 
 #endif /* __AIESOCKET__ */
 /************************** Function Definitions *****************************/
 #ifdef __AIESOCKET__
 
+/*****************************************************************************/
+/**
+*
+* This API sends a buffer over the socket, retrying partial writes.
+*
+* @param	SocketIOInst: Socket IO instance pointer.
+* @param	Buf: Pointer to the buffer.
+* @param	Len: Number of bytes to send.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_SocketIO_Send(XAie_SocketIO *SocketIOInst, const void *Buf,
+		size_t Len)
+{
+	const u8 *Ptr = (const u8 *)Buf;
+	ssize_t Ret;
+
+	while(Len > 0U) {
+		Ret = write(SocketIOInst->SocketFd, Ptr, Len);
+		if(Ret < 0) {
+			if(errno == EINTR) {
+				continue;
+			}
+			XAIE_ERROR("Failed to write to socket, %d: %s\n",
+					errno, strerror(errno));
+			return XAIE_ERR;
+		}
+
+		Ptr += Ret;
+		Len -= (size_t)Ret;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API receives a number of bytes from the socket.
+*
+* @param	SocketIOInst: Socket IO instance pointer.
+* @param	Buf: Pointer to the buffer.
+* @param	Len: Number of bytes to receive.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_SocketIO_Recv(XAie_SocketIO *SocketIOInst, void *Buf,
+		size_t Len)
+{
+	u8 *Ptr = (u8 *)Buf;
+	ssize_t Ret;
+
+	while(Len > 0U) {
+		Ret = read(SocketIOInst->SocketFd, Ptr, Len);
+		if(Ret < 0) {
+			if(errno == EINTR) {
+				continue;
+			}
+			XAIE_ERROR("Failed to read from socket, %d: %s\n",
+					errno, strerror(errno));
+			return XAIE_ERR;
+		}
+
+		if(Ret == 0) {
+			XAIE_ERROR("Socket closed by the server\n");
+			return XAIE_ERR;
+		}
+
+		Ptr += Ret;
+		Len -= (size_t)Ret;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API sends the buffered frames to the server.
+*
+* @param	SocketIOInst: Socket IO instance pointer.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only. The lock of the instance must be held.
+*
+*******************************************************************************/
+static AieRC _XAie_SocketIO_FlushBuf(XAie_SocketIO *SocketIOInst)
+{
+	AieRC RC;
+
+	if(SocketIOInst->SndLen == 0U) {
+		return XAIE_OK;
+	}
+
+	XAIE_DBG("SEND: %u bytes of frames\n", SocketIOInst->SndLen);
+	RC = _XAie_SocketIO_Send(SocketIOInst, SocketIOInst->SndBuf,
+			SocketIOInst->SndLen);
+	SocketIOInst->SndLen = 0U;
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API converts a word between the host byte order and the little endian
+* byte order of the binary protocol.
+*
+* @param	Val: Word to convert.
+*
+* @return	Converted word.
+*
+* @note		Internal only. The conversion is its own inverse.
+*
+*******************************************************************************/
+static inline u32 _XAie_SocketIO_Le32(u32 Val)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return __builtin_bswap32(Val);
+#else
+	return Val;
+#endif
+}
+
+static inline u64 _XAie_SocketIO_Le64(u64 Val)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return __builtin_bswap64(Val);
+#else
+	return Val;
+#endif
+}
+
+/*****************************************************************************/
+/**
+*
+* This API queues a binary frame in the send buffer, in little endian. The
+* buffer is sent whenever it gets full, so a frame may be split across several
+* sends.
+*
+* @param	SocketIOInst: Socket IO instance pointer.
+* @param	Opcode: Opcode of the frame.
+* @param	Addr: Absolute address of the first word.
+* @param	Size: Number of words accessed by the frame.
+* @param	Payload: Pointer to the payload words, NULL if there is none.
+* @param	NumWords: Number of payload words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only. The lock of the instance must be held.
+*
+*******************************************************************************/
+static AieRC _XAie_SocketIO_QueueFrame(XAie_SocketIO *SocketIOInst, u8 Opcode,
+		u64 Addr, u32 Size, const u32 *Payload, size_t NumWords)
+{
+	XAie_SocketFrameHdr Hdr;
+	AieRC RC;
+
+	memset(&Hdr, 0, sizeof(Hdr));
+	Hdr.Opcode = Opcode;
+	Hdr.Size = _XAie_SocketIO_Le32(Size);
+	Hdr.Addr = _XAie_SocketIO_Le64(Addr);
+
+	if(SocketIOInst->SndLen + sizeof(Hdr) > XAIE_IO_SOCKET_SNDBUFSIZE) {
+		RC = _XAie_SocketIO_FlushBuf(SocketIOInst);
+		if(RC != XAIE_OK) {
+			return RC;
+		}
+	}
+
+	memcpy(&SocketIOInst->SndBuf[SocketIOInst->SndLen], &Hdr, sizeof(Hdr));
+	SocketIOInst->SndLen += sizeof(Hdr);
+
+	while(NumWords > 0U) {
+		size_t Room = (XAIE_IO_SOCKET_SNDBUFSIZE -
+				SocketIOInst->SndLen) / sizeof(u32);
+
+		if(Room == 0U) {
+			RC = _XAie_SocketIO_FlushBuf(SocketIOInst);
+			if(RC != XAIE_OK) {
+				return RC;
+			}
+			continue;
+		}
+
+		if(Room > NumWords) {
+			Room = NumWords;
+		}
+
+		for(size_t i = 0U; i < Room; i++) {
+			u32 Word = _XAie_SocketIO_Le32(Payload[i]);
+
+			memcpy(&SocketIOInst->SndBuf[SocketIOInst->SndLen],
+					&Word, sizeof(Word));
+			SocketIOInst->SndLen += sizeof(Word);
+		}
+		Payload += Room;
+		NumWords -= Room;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API queues a binary frame and takes the lock of the instance.
+*
+* @param	SocketIOInst: Socket IO instance pointer.
+* @param	Opcode: Opcode of the frame.
+* @param	Addr: Absolute address of the first word.
+* @param	Size: Number of words accessed by the frame.
+* @param	Payload: Pointer to the payload words, NULL if there is none.
+* @param	NumWords: Number of payload words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_SocketIO_SendFrame(XAie_SocketIO *SocketIOInst, u8 Opcode,
+		u64 Addr, u32 Size, const u32 *Payload, size_t NumWords)
+{
+	AieRC RC;
+
+	pthread_mutex_lock(&SocketIOInst->Lock);
+	RC = _XAie_SocketIO_QueueFrame(SocketIOInst, Opcode, Addr, Size,
+			Payload, NumWords);
+	pthread_mutex_unlock(&SocketIOInst->Lock);
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API sends a binary frame which expects a reply, together with the
+* buffered frames, and receives the reply of Size words.
+*
+* @param	SocketIOInst: Socket IO instance pointer.
+* @param	Opcode: Opcode of the frame.
+* @param	Addr: Absolute address of the register.
+* @param	Size: Number of words of the frame and of the reply.
+* @param	Payload: Pointer to the payload words, NULL if there is none.
+* @param	NumWords: Number of payload words.
+* @param	Data: Pointer to store the reply.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_SocketIO_Transact(XAie_SocketIO *SocketIOInst, u8 Opcode,
+		u64 Addr, u32 Size, const u32 *Payload, size_t NumWords,
+		u32 *Data)
+{
+	AieRC RC;
+
+	pthread_mutex_lock(&SocketIOInst->Lock);
+	RC = _XAie_SocketIO_QueueFrame(SocketIOInst, Opcode, Addr, Size,
+			Payload, NumWords);
+	if(RC == XAIE_OK) {
+		RC = _XAie_SocketIO_FlushBuf(SocketIOInst);
+	}
+	if(RC == XAIE_OK) {
+		RC = _XAie_SocketIO_Recv(SocketIOInst, Data,
+				(size_t)Size * sizeof(*Data));
+	}
+	pthread_mutex_unlock(&SocketIOInst->Lock);
+
+	for(u32 i = 0U; (RC == XAIE_OK) && (i < Size); i++) {
+		Data[i] = _XAie_SocketIO_Le32(Data[i]);
+	}
+
+	return RC;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API waits until the server has applied all the frames sent so far.
+*
+* @param	SocketIOInst: Socket IO instance pointer.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_SocketIO_Sync(XAie_SocketIO *SocketIOInst)
+{
+	u32 Status;
+	AieRC RC;
+
+	RC = _XAie_SocketIO_Transact(SocketIOInst, XAIE_IO_SOCKET_OP_SYNC, 0U,
+			1U, NULL, 0U, &Status);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	if(Status != 0U) {
+		XAIE_ERROR("Server failed to apply frames, status %u\n",
+				Status);
+		return XAIE_ERR;
+	}
+
+	return XAIE_OK;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API sends a mask poll frame. The server polls the register until the
+* masked value matches or the timeout expires, and replies once.
+*
+* @param	SocketIOInst: Socket IO instance pointer.
+* @param	Addr: Absolute address of the register.
+* @param	Mask: Mask to be applied to the register value.
+* @param	Value: 32-bit value to poll for.
+* @param	TimeOutUs: Timeout in micro seconds.
+*
+* @return	XAIE_OK if the value matched, XAIE_ERR otherwise.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_SocketIO_RemotePoll(XAie_SocketIO *SocketIOInst, u64 Addr,
+		u32 Mask, u32 Value, u32 TimeOutUs)
+{
+	u32 Payload[3U] = {Mask, Value, TimeOutUs};
+	u32 Status;
+	AieRC RC;
+
+	RC = _XAie_SocketIO_Transact(SocketIOInst, XAIE_IO_SOCKET_OP_MASKPOLL,
+			Addr, 1U, Payload, 3U, &Status);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	return (Status == 0U) ? XAIE_OK : XAIE_ERR;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API connects to the first address of a list which accepts the
+* connection.
+*
+* @param	AddrList: List of the addresses of the server.
+*
+* @return	Connected socket on success, -1 on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static int _XAie_SocketIO_Connect(const struct addrinfo *AddrList)
+{
+	const struct addrinfo *p;
+	int SocketFd;
+
+	for(p = AddrList; p != NULL; p = p->ai_next) {
+
+		SocketFd = socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+		if(SocketFd < 0)
+			continue;
+
+		if(connect(SocketFd, p->ai_addr, p->ai_addrlen) != -1)
+			return SocketFd;
+
+		close(SocketFd);
+	}
+
+	return -1;
+}
+
+/*****************************************************************************/
+/**
+*
+* This API requests the binary protocol from the server if it is enabled in
+* the environment. The request is the text command "P <version>", to which a
+* server which supports the binary protocol replies with the version. Any other
+* reply keeps the text protocol, and so does no reply within
+* XAIE_IO_SOCKET_PROTO_TIMEOUT_MS, as servers which only know the text
+* protocol may ignore the request. Mask polls are then done by the client
+* with register reads. On a timeout, the connection is closed and a new one is
+* opened, so a late reply to the request cannot be taken for the reply of a
+* read.
+*
+* @param	SocketIOInst: Socket IO instance pointer.
+* @param	AddrList: List of the addresses of the server, to reconnect.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC _XAie_SocketIO_Negotiate(XAie_SocketIO *SocketIOInst,
+		const struct addrinfo *AddrList)
+{
+	char CmdBuf[XAIE_IO_SOCKET_CMDBUFSIZE];
+	char RdBuf[XAIE_IO_SOCKET_RDBUFSIZE + 1U];
+	struct pollfd Pfd;
+	const char *Proto;
+	int Ret;
+	AieRC RC;
+
+	SocketIOInst->IsBinary = 0U;
+	Proto = getenv(XAIE_IO_SOCKET_PROTO_ENV);
+	if((Proto == NULL) || (strcmp(Proto, "binary") != 0)) {
+		return XAIE_OK;
+	}
+
+	sprintf(CmdBuf, "P 0X%08X\n", XAIE_IO_SOCKET_PROTO_VERSION);
+	RC = _XAie_SocketIO_Send(SocketIOInst, CmdBuf, strlen(CmdBuf));
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	Pfd.fd = SocketIOInst->SocketFd;
+	Pfd.events = POLLIN;
+	do {
+		Ret = poll(&Pfd, 1U, XAIE_IO_SOCKET_PROTO_TIMEOUT_MS);
+	} while((Ret < 0) && (errno == EINTR));
+
+	if(Ret < 0) {
+		XAIE_ERROR("Failed to poll socket, %d: %s\n", errno,
+				strerror(errno));
+		return XAIE_ERR;
+	}
+
+	if(Ret == 0) {
+		XAIE_DBG("No reply to the binary socket protocol request\n");
+		close(SocketIOInst->SocketFd);
+		SocketIOInst->SocketFd = _XAie_SocketIO_Connect(AddrList);
+		if(SocketIOInst->SocketFd < 0) {
+			XAIE_ERROR("failed to reconnect to sim\n");
+			return XAIE_ERR;
+		}
+
+		return XAIE_OK;
+	}
+
+	RC = _XAie_SocketIO_Recv(SocketIOInst, RdBuf,
+			XAIE_IO_SOCKET_RDBUFSIZE);
+	if(RC != XAIE_OK) {
+		return RC;
+	}
+
+	RdBuf[XAIE_IO_SOCKET_RDBUFSIZE] = '\0';
+	if((u32)strtol(RdBuf, NULL, 0) == XAIE_IO_SOCKET_PROTO_VERSION) {
+		SocketIOInst->IsBinary = 1U;
+		printf("[AIE INFO]: Using binary socket protocol version %u\n",
+				XAIE_IO_SOCKET_PROTO_VERSION);
+	} else {
+		XAIE_DBG("Binary socket protocol rejected by the server\n");
+	}
+
+	return XAIE_OK;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -78,7 +588,12 @@ static AieRC XAie_SocketIO_Finish(void *IOInst)
 {
 	XAie_SocketIO *SocketIOInst = (XAie_SocketIO *)IOInst;
 
+	if(SocketIOInst->IsBinary != 0U) {
+		_XAie_SocketIO_Sync(SocketIOInst);
+	}
+
 	close(SocketIOInst->SocketFd);
+	pthread_mutex_destroy(&SocketIOInst->Lock);
 	free(IOInst);
 
 	return XAIE_OK;
@@ -100,12 +615,13 @@ static AieRC XAie_SocketIO_Finish(void *IOInst)
 static AieRC XAie_SocketIO_Init(XAie_DevInst *DevInst)
 {
 	XAie_SocketIO *IOInst;
-	struct addrinfo hints, *slist, *p;
+	struct addrinfo hints, *slist;
 	u32 FileSize;
 	char *PortNum;
 	int ret;
 	int SocketFd;
 	FILE *Fd;
+	AieRC RC;
 
 	IOInst = (XAie_SocketIO *)malloc(sizeof(*IOInst));
 	if(IOInst == NULL) {
@@ -168,20 +684,8 @@ static AieRC XAie_SocketIO_Init(XAie_DevInst *DevInst)
 		return XAIE_ERR;
 	}
 
-	for(p = slist; p != NULL; p = p->ai_next) {
-
-		SocketFd = socket(p->ai_family, p->ai_socktype, p->ai_protocol);
-		if(SocketFd < 0)
-			continue;
-
-		ret = connect(SocketFd, p->ai_addr, p->ai_addrlen);
-		if(ret != -1)
-			break;
-
-		close(SocketFd);
-	}
-
-	if(p == NULL) {
+	SocketFd = _XAie_SocketIO_Connect(slist);
+	if(SocketFd < 0) {
 		XAIE_ERROR("failed to connect to sim\n");
 		return XAIE_ERR;
 	}
@@ -189,10 +693,24 @@ static AieRC XAie_SocketIO_Init(XAie_DevInst *DevInst)
 	IOInst->SocketFd = SocketFd;
 	IOInst->BaseAddr = DevInst->BaseAddr;
 	IOInst->NpiBaseAddr = XAIE_NPI_BASEADDR;
-	DevInst->IOInst = IOInst;
+	IOInst->SndLen = 0U;
 
-	freeaddrinfo(slist);
 	free(PortNum);
+
+	RC = _XAie_SocketIO_Negotiate(IOInst, slist);
+	freeaddrinfo(slist);
+	if(RC != XAIE_OK) {
+		XAIE_ERROR("Failed to negotiate socket protocol\n");
+		if(IOInst->SocketFd >= 0) {
+			close(IOInst->SocketFd);
+		}
+		free(IOInst);
+		return XAIE_ERR;
+	}
+
+	pthread_mutex_init(&IOInst->Lock, NULL);
+	DevInst->IOInst = IOInst;
+
 	return XAIE_OK;
 }
 
@@ -216,6 +734,12 @@ static AieRC XAie_SocketIO_Write32(void *IOInst, u64 RegOff, u32 Value)
 	char CmdBuf[XAIE_IO_SOCKET_CMDBUFSIZE];
 	size_t Len;
 
+	if(SocketIOInst->IsBinary != 0U) {
+		return _XAie_SocketIO_SendFrame(SocketIOInst,
+				XAIE_IO_SOCKET_OP_WRITE,
+				SocketIOInst->BaseAddr + RegOff, 1U, &Value, 1U);
+	}
+
 	sprintf(CmdBuf, "W 0X%016lX 0X%08X\n", SocketIOInst->BaseAddr + RegOff,
 			Value);
 	Len = write(SocketIOInst->SocketFd, CmdBuf, strlen(CmdBuf));
@@ -251,6 +775,13 @@ static AieRC XAie_SocketIO_Read32(void *IOInst, u64 RegOff, u32 *Data)
 	size_t Len;
 	int Ret;
 
+	if(SocketIOInst->IsBinary != 0U) {
+		return _XAie_SocketIO_Transact(SocketIOInst,
+				XAIE_IO_SOCKET_OP_READ,
+				SocketIOInst->BaseAddr + RegOff, 1U, NULL, 0U,
+				Data);
+	}
+
 	sprintf(CmdBuf, "R 0X%016lX\n", SocketIOInst->BaseAddr + RegOff);
 	Len = write(SocketIOInst->SocketFd, CmdBuf, strlen(CmdBuf));
 	if(Len != strlen(CmdBuf)) {
@@ -316,6 +847,8 @@ static AieRC XAie_SocketIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 * @param	Mask: Mask to be applied to Data.
 * @param	Value: 32-bit value to poll for
 * @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy, unused with the binary protocol where the
+*		server polls the register.
 *
 * @return	XAIE_OK or XAIE_ERR.
 *
@@ -323,34 +856,18 @@ static AieRC XAie_SocketIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 *
 *******************************************************************************/
 static AieRC XAie_SocketIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
-		u32 Value, u32 TimeOutUs)
+		u32 Value, u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
-	AieRC Ret = XAIE_ERR;
-	u32 Count, MinTimeOutUs, RegVal;
-
-	/*
-	 * Any value less than 200 us becomes noticable overhead. This is based
-	 * on some profiling, and it may vary between platforms.
-	 */
-	MinTimeOutUs = 200;
-	Count = ((u64)TimeOutUs + MinTimeOutUs - 1) / MinTimeOutUs;
-
-	while (Count > 0U) {
-		XAie_SocketIO_Read32(IOInst, RegOff, &RegVal);
-		if((RegVal & Mask) == Value) {
-			return XAIE_OK;
-		}
-		usleep(MinTimeOutUs);
-		Count--;
-	}
+	XAie_SocketIO *SocketIOInst = (XAie_SocketIO *)IOInst;
 
-	/* Check for the break from timed-out loop */
-	XAie_SocketIO_Read32(IOInst, RegOff, &RegVal);
-	if((RegVal & Mask) == Value) {
-		Ret = XAIE_OK;
+	if(SocketIOInst->IsBinary != 0U) {
+		return _XAie_SocketIO_RemotePoll(SocketIOInst,
+				SocketIOInst->BaseAddr + RegOff, Mask, Value,
+				TimeOutUs);
 	}
 
-	return Ret;
+	return _XAie_IOCommon_MaskPoll(IOInst, XAie_SocketIO_Read32, RegOff,
+			Mask, Value, TimeOutUs, Policy);
 }
 
 /*****************************************************************************/
@@ -371,6 +888,15 @@ static AieRC XAie_SocketIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
 static AieRC XAie_SocketIO_BlockWrite32(void *IOInst, u64 RegOff,
 		const u32 *Data, u32 Size)
 {
+	XAie_SocketIO *SocketIOInst = (XAie_SocketIO *)IOInst;
+
+	if(SocketIOInst->IsBinary != 0U) {
+		return _XAie_SocketIO_SendFrame(SocketIOInst,
+				XAIE_IO_SOCKET_OP_BLOCKWRITE,
+				SocketIOInst->BaseAddr + RegOff, Size, Data,
+				Size);
+	}
+
 	for(u32 i = 0U; i < Size; i++) {
 		XAie_SocketIO_Write32(IOInst, RegOff + i * 4U, *Data);
 		Data++;
@@ -398,12 +924,58 @@ static AieRC XAie_SocketIO_BlockWrite32(void *IOInst, u64 RegOff,
 static AieRC XAie_SocketIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
 		u32 Size)
 {
+	XAie_SocketIO *SocketIOInst = (XAie_SocketIO *)IOInst;
+
+	if(SocketIOInst->IsBinary != 0U) {
+		return _XAie_SocketIO_SendFrame(SocketIOInst,
+				XAIE_IO_SOCKET_OP_BLOCKSET,
+				SocketIOInst->BaseAddr + RegOff, Size, &Data, 1U);
+	}
+
 	for(u32 i = 0U; i < Size; i++)
 		XAie_SocketIO_Write32(IOInst, RegOff+ i * 4U, Data);
 
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This is the memory IO function to read a block of data from aie.
+*
+* @param	IOInst: IO instance pointer
+* @param	RegOff: Register offset to read from.
+* @param	Data: Pointer to store the data.
+* @param	Size: Number of 32-bit words.
+*
+* @return	XAIE_OK on success, error code on failure.
+*
+* @note		Internal only.
+*
+*******************************************************************************/
+static AieRC XAie_SocketIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	XAie_SocketIO *SocketIOInst = (XAie_SocketIO *)IOInst;
+	AieRC RC;
+
+	if(SocketIOInst->IsBinary != 0U) {
+		return _XAie_SocketIO_Transact(SocketIOInst,
+				XAIE_IO_SOCKET_OP_BLOCKREAD,
+				SocketIOInst->BaseAddr + RegOff, Size, NULL,
+				0U, Data);
+	}
+
+	for(u32 i = 0U; i < Size; i++) {
+		RC = XAie_SocketIO_Read32(IOInst, RegOff + i * 4U, &Data[i]);
+		if(RC != XAIE_OK) {
+			return RC;
+		}
+	}
+
+	return XAIE_OK;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -424,6 +996,13 @@ static void _XAie_SocketIO_NpiWrite32(void *IOInst, u32 RegOff, u32 RegVal)
 	char CmdBuf[XAIE_IO_SOCKET_CMDBUFSIZE];
 	size_t Len;
 
+	if(SocketIOInst->IsBinary != 0U) {
+		_XAie_SocketIO_SendFrame(SocketIOInst, XAIE_IO_SOCKET_OP_WRITE,
+				SocketIOInst->NpiBaseAddr + RegOff, 1U, &RegVal,
+				sizeof(RegVal));
+		return;
+	}
+
 	sprintf(CmdBuf, "W 0X%016lX 0X%08X\n",
 			SocketIOInst->NpiBaseAddr + RegOff, RegVal);
 	Len = write(SocketIOInst->SocketFd, CmdBuf, strlen(CmdBuf));
@@ -458,6 +1037,13 @@ static AieRC _XAie_SocketIO_NpiRead32(void *IOInst, u64 RegOff, u32 *Data)
 	size_t Len;
 	int Ret;
 
+	if(SocketIOInst->IsBinary != 0U) {
+		return _XAie_SocketIO_Transact(SocketIOInst,
+				XAIE_IO_SOCKET_OP_READ,
+				SocketIOInst->NpiBaseAddr + RegOff, 1U, NULL,
+				0U, Data);
+	}
+
 	sprintf(CmdBuf, "R 0X%016lX\n", SocketIOInst->NpiBaseAddr + RegOff);
 	Len = write(SocketIOInst->SocketFd, CmdBuf, strlen(CmdBuf));
 	if(Len != strlen(CmdBuf)) {
@@ -490,6 +1076,8 @@ static AieRC _XAie_SocketIO_NpiRead32(void *IOInst, u64 RegOff, u32 *Data)
 * @param	Mask: Mask to be applied to Data.
 * @param	Value: 32-bit value to poll for
 * @param	TimeOutUs: Timeout in micro seconds.
+* @param	Policy: Poll policy, unused with the binary protocol where the
+*		server polls the register.
 *
 * @return	XAIE_OK or XAIE_ERR.
 *
@@ -497,34 +1085,19 @@ static AieRC _XAie_SocketIO_NpiRead32(void *IOInst, u64 RegOff, u32 *Data)
 *
 *******************************************************************************/
 static AieRC _XAie_SocketIO_NpiMaskPoll(void *IOInst, u64 RegOff, u32 Mask,
-		u32 Value, u32 TimeOutUs)
+		u32 Value, u32 TimeOutUs,
+		const XAie_PollPolicy *Policy)
 {
-	AieRC Ret = XAIE_ERR;
-	u32 Count, MinTimeOutUs, RegVal;
-
-	/*
-	 * Any value less than 200 us becomes noticable overhead. This is based
-	 * on some profiling, and it may vary between platforms.
-	 */
-	MinTimeOutUs = 200;
-	Count = ((u64)TimeOutUs + MinTimeOutUs - 1) / MinTimeOutUs;
-
-	while (Count > 0U) {
-		_XAie_SocketIO_NpiRead32(IOInst, RegOff, &RegVal);
-		if((RegVal & Mask) == Value) {
-			return XAIE_OK;
-		}
-		usleep(MinTimeOutUs);
-		Count--;
-	}
+	XAie_SocketIO *SocketIOInst = (XAie_SocketIO *)IOInst;
 
-	/* Check for the break from timed-out loop */
-	_XAie_SocketIO_NpiRead32(IOInst, RegOff, &RegVal);
-	if((RegVal & Mask) == Value) {
-		Ret = XAIE_OK;
+	if(SocketIOInst->IsBinary != 0U) {
+		return _XAie_SocketIO_RemotePoll(SocketIOInst,
+				SocketIOInst->NpiBaseAddr + RegOff, Mask, Value,
+				TimeOutUs);
 	}
 
-	return Ret;
+	return _XAie_IOCommon_MaskPoll(IOInst, _XAie_SocketIO_NpiRead32,
+			RegOff, Mask, Value, TimeOutUs, Policy);
 }
 
 static AieRC XAie_SocketIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
@@ -536,12 +1109,9 @@ static AieRC XAie_SocketIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 		{
 			XAie_ShimDmaBdArgs *BdArgs =
 				(XAie_ShimDmaBdArgs *)Arg;
-			for(u8 i = 0; i < BdArgs->NumBdWords; i++) {
-				XAie_SocketIO_Write32(IOInst,
-						BdArgs->Addr + i * 4,
-						BdArgs->BdWords[i]);
-			}
-			break;
+
+			return XAie_SocketIO_BlockWrite32(IOInst, BdArgs->Addr,
+					BdArgs->BdWords, BdArgs->NumBdWords);
 		}
 		case XAIE_BACKEND_OP_NPIWR32:
 		{
@@ -557,7 +1127,8 @@ static AieRC XAie_SocketIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 
 			return _XAie_SocketIO_NpiMaskPoll(IOInst,
 					Req->NpiRegOff, Req->Mask, Req->Val,
-					Req->TimeOutUs);
+					Req->TimeOutUs,
+					&DevInst->PollPolicy[XAIE_POLL_DEFAULT]);
 		}
 		case XAIE_BACKEND_OP_REQUEST_RESOURCE:
 			return _XAie_RequestRscCommon(DevInst, Arg);
@@ -577,6 +1148,15 @@ static AieRC XAie_SocketIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 					(XAie_PartInitOpts *)Arg);
 		case XAIE_BACKEND_OP_PARTITION_TEARDOWN:
 			return _XAie_PrivilegeTeardownPart(DevInst);
+		case XAIE_BACKEND_OP_FLUSH:
+		{
+			XAie_SocketIO *SocketIOInst = (XAie_SocketIO *)IOInst;
+
+			if(SocketIOInst->IsBinary != 0U) {
+				return _XAie_SocketIO_Sync(SocketIOInst);
+			}
+			break;
+		}
 		default:
 			XAIE_ERROR("Socket backend does not support operation "
 					"%d\n", Op);
@@ -636,7 +1216,7 @@ static AieRC XAie_SocketIO_MaskWrite32(void *IOInst, u64 RegOff, u32 Mask,
 }
 
 static AieRC XAie_SocketIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
-		u32 Value, u32 TimeOutUs)
+		u32 Value, u32 TimeOutUs, const XAie_PollPolicy *Policy)
 {
 	/* no-op */
 	(void)IOInst;
@@ -644,6 +1224,7 @@ static AieRC XAie_SocketIO_MaskPoll(void *IOInst, u64 RegOff, u32 Mask,
 	(void)Mask;
 	(void)Value;
 	(void)TimeOutUs;
+	(void)Policy;
 
 	return XAIE_ERR;
 }
@@ -672,6 +1253,18 @@ static AieRC XAie_SocketIO_BlockSet32(void *IOInst, u64 RegOff, u32 Data,
 	return XAIE_ERR;
 }
 
+static AieRC XAie_SocketIO_BlockRead32(void *IOInst, u64 RegOff, u32 *Data,
+		u32 Size)
+{
+	/* no-op */
+	(void)IOInst;
+	(void)RegOff;
+	(void)Data;
+	(void)Size;
+
+	return XAIE_ERR;
+}
+
 static AieRC XAie_SocketIO_RunOp(void *IOInst, XAie_DevInst *DevInst,
 		XAie_BackendOpCode Op, void *Arg)
 {
@@ -750,6 +1343,7 @@ const XAie_Backend SocketBackend =
 	.Ops.MaskPoll = XAie_SocketIO_MaskPoll,
 	.Ops.BlockWrite32 = XAie_SocketIO_BlockWrite32,
 	.Ops.BlockSet32 = XAie_SocketIO_BlockSet32,
+	.Ops.BlockRead32 = XAie_SocketIO_BlockRead32,
 	.Ops.CmdWrite = XAie_SocketIO_CmdWrite,
 	.Ops.RunOp = XAie_SocketIO_RunOp,
 	.Ops.MemAllocate = XAie_SocketMemAllocate,
@@ -42,6 +42,8 @@
 	#define XAIE_DEFAULT_BACKEND XAIE_IO_BACKEND_BAREMETAL
 #elif defined (__AIESOCKET__)
 	#define XAIE_DEFAULT_BACKEND XAIE_IO_BACKEND_SOCKET
+#elif defined (__AIESHADOWDEV__)
+	#define XAIE_DEFAULT_BACKEND XAIE_IO_BACKEND_SHADOWDEV
 #else
 	#define __AIEDEBUG__
 	#define XAIE_DEFAULT_BACKEND XAIE_IO_BACKEND_DEBUG
@@ -77,6 +79,11 @@
 #else
 	#define SOCKETBACKEND NULL
 #endif
+#if defined (__AIESHADOWDEV__)
+	#define SHADOWDEVBACKEND &ShadowDevBackend
+#else
+	#define SHADOWDEVBACKEND NULL
+#endif
 #if defined (__AIEDEBUG__)
 	#define DEBUGBACKEND &DebugBackend
 #else
@@ -91,6 +98,7 @@ extern const XAie_Backend BaremetalBackend;
 extern const XAie_Backend DebugBackend;
 extern const XAie_Backend LinuxBackend;
 extern const XAie_Backend SocketBackend;
+extern const XAie_Backend ShadowDevBackend;
 
 static const XAie_Backend *IOBackend[XAIE_IO_BACKEND_MAX] =
 {
@@ -101,6 +109,7 @@ static const XAie_Backend *IOBackend[XAIE_IO_BACKEND_MAX] =
 	DEBUGBACKEND,
 	LINUXBACKEND,
 	SOCKETBACKEND,
+	SHADOWDEVBACKEND,
 };
 
 /************************** Function Definitions *****************************/
@@ -53,6 +53,8 @@ typedef enum {
 	XAIE_BACKEND_OP_PARTITION_TEARDOWN,
 	XAIE_BACKEND_OP_GET_RSC_STAT,
 	XAIE_BACKEND_OP_UPDATE_NPI_ADDR,
+	XAIE_BACKEND_OP_FLUSH,
+	XAIE_BACKEND_OP_CONFIG_DEBUG_OUTPUT,
 } XAie_BackendOpCode;
 
 /*
@@ -128,10 +130,13 @@ typedef struct XAie_BackendRscStat {
  * Write32     : IO operation to write 32-bit data.
  * Read32      : IO operation to read 32-bit data.
  * MaskWrite32 : IO operation to write masked 32-bit data.
- * MaskPoll    : IO operation to mask poll an address for a value.
+ * MaskPoll    : IO operation to mask poll an address for a value. Backends
+ *               which poll the register from the host follow the poll
+ *               policy.
  * BlockWrite32: IO operation to write a block of data at 32-bit granularity.
  * BlockSet32  : IO operation to initialize a chunk of aie address space with a
  *               a specified value at 32-bit granularity.
+ * BlockRead32 : IO operation to read a block of data at 32-bit granularity.
  * CmdWrite32  : This IO operation is required only in simulation mode. Other
  *               backends should have a no-op.
  * RunOp       : Run operation specified by the operation code
@@ -154,9 +159,10 @@ typedef struct XAie_BackendOps {
 	AieRC (*Read32)(void *IOInst,  u64 RegOff, u32 *Data);
 	AieRC (*MaskWrite32)(void *IOInst, u64 RegOff, u32 Mask, u32 Value);
 	AieRC (*MaskPoll)(void *IOInst, u64 RegOff, u32 Mask, u32 Value,
-			u32 TimeOutUs);
+			u32 TimeOutUs, const XAie_PollPolicy *Policy);
 	AieRC (*BlockWrite32)(void *IOInst, u64 RegOff, const u32 *Data, u32 Size);
 	AieRC (*BlockSet32)(void *IOInst, u64 RegOff, u32 Data, u32 Size);
+	AieRC (*BlockRead32)(void *IOInst, u64 RegOff, u32 *Data, u32 Size);
 	AieRC (*CmdWrite)(void *IOInst, u8 Col, u8 Row, u8 Command, u32 CmdWd0,
 			u32 CmdWd1, const char *CmdStr);
 	AieRC (*RunOp)(void *IOInst, XAie_DevInst *DevInst,
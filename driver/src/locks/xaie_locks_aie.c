@@ -79,9 +79,10 @@ AieRC _XAie_LockAcquire(XAie_DevInst *DevInst, const XAie_LockMod *LockMod,
 
 	RegAddr = _XAie_GetTileAddr(DevInst, Loc.Row, Loc.Col) + RegOff;
 
-	if(XAie_MaskPoll(DevInst, RegAddr, XAIE_LOCK_RESULT_MASK,
+	if(_XAie_MaskPollSite(DevInst, RegAddr, XAIE_LOCK_RESULT_MASK,
 				(XAIE_LOCK_RESULT_SUCCESS <<
-				 XAIE_LOCK_RESULT_LSB), TimeOut) != XAIE_OK) {
+				 XAIE_LOCK_RESULT_LSB), TimeOut,
+				XAIE_POLL_LOCK) != XAIE_OK) {
 
 		return XAIE_LOCK_RESULT_FAILED;
 	}
@@ -132,9 +133,10 @@ AieRC _XAie_LockRelease(XAie_DevInst *DevInst, const XAie_LockMod *LockMod,
 
 	RegAddr = _XAie_GetTileAddr(DevInst, Loc.Row, Loc.Col) + RegOff;
 
-	if(XAie_MaskPoll(DevInst, RegAddr, XAIE_LOCK_RESULT_MASK,
+	if(_XAie_MaskPollSite(DevInst, RegAddr, XAIE_LOCK_RESULT_MASK,
 				(XAIE_LOCK_RESULT_SUCCESS <<
-				 XAIE_LOCK_RESULT_LSB), TimeOut) != XAIE_OK) {
+				 XAIE_LOCK_RESULT_LSB), TimeOut,
+				XAIE_POLL_LOCK) != XAIE_OK) {
 
 		return XAIE_LOCK_RESULT_FAILED;
 	}
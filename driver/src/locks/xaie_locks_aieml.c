@@ -75,9 +75,10 @@ AieRC _XAieMl_LockRelease(XAie_DevInst *DevInst, const XAie_LockMod *LockMod,
 
 	RegAddr = _XAie_GetTileAddr(DevInst, Loc.Row, Loc.Col) + RegOff;
 
-	if(XAie_MaskPoll(DevInst, RegAddr, XAIEML_LOCK_RESULT_MASK,
+	if(_XAie_MaskPollSite(DevInst, RegAddr, XAIEML_LOCK_RESULT_MASK,
 				(XAIEML_LOCK_RESULT_SUCCESS <<
-				 XAIEML_LOCK_RESULT_LSB), TimeOut) != XAIE_OK) {
+				 XAIEML_LOCK_RESULT_LSB), TimeOut,
+				XAIE_POLL_LOCK) != XAIE_OK) {
 
 		return XAIE_LOCK_RESULT_FAILED;
 	}
@@ -122,9 +123,10 @@ AieRC _XAieMl_LockAcquire(XAie_DevInst *DevInst, const XAie_LockMod *LockMod,
 
 	RegAddr = _XAie_GetTileAddr(DevInst, Loc.Row, Loc.Col) + RegOff;
 
-	if(XAie_MaskPoll(DevInst, RegAddr, XAIEML_LOCK_RESULT_MASK,
+	if(_XAie_MaskPollSite(DevInst, RegAddr, XAIEML_LOCK_RESULT_MASK,
 				(XAIEML_LOCK_RESULT_SUCCESS <<
-				 XAIEML_LOCK_RESULT_LSB), TimeOut) != XAIE_OK) {
+				 XAIEML_LOCK_RESULT_LSB), TimeOut,
+				XAIE_POLL_LOCK) != XAIE_OK) {
 
 		return XAIE_LOCK_RESULT_FAILED;
 	}
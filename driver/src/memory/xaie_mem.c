@@ -34,6 +34,10 @@
 
 #ifdef XAIE_FEATURE_DATAMEM_ENABLE
 
+/***************************** Macro Definitions *****************************/
+/* Head mask write, block write and tail mask write of a data memory block */
+#define XAIE_MEM_VEC_CMDS_PER_TARGET	3U
+
 /************************** Function Definitions *****************************/
 /*****************************************************************************/
 /**
@@ -134,23 +138,24 @@ AieRC XAie_DataMemRdWord(XAie_DevInst *DevInst, XAie_LocType Loc,
 /*****************************************************************************/
 /**
 *
-* This API writes a block of data to the specified data memory location of
-* the selected tile. Byte-level writes are supported by this API. For unaligned
-* data memory offsets, this API implements read-modify-write operation.
+* This API writes a block of data to the data memory of a tile. The unaligned
+* head and tail bytes are written with masked writes.
 *
 * @param	DevInst: Device Instance
+* @param	MemMod: Memory module of the tile.
 * @param	Loc: Loc of AIE Tiles
 * @param	Addr: Address in data memory to write.
-* @param	Src - Source to write data.
-* @param	Size - Size in bytes to write.
+* @param	CharSrc: Source to write data.
+* @param	Size: Size in bytes to write.
 *
 * @return	XAIE_OK on success and error code on failure
 *
-* @note		None.
+* @note		Internal only. The arguments must have been validated.
 *
 *******************************************************************************/
-AieRC XAie_DataMemBlockWrite(XAie_DevInst *DevInst, XAie_LocType Loc, u32 Addr,
-		const void *Src, u32 Size)
+static AieRC _XAie_DataMemBlockWrite(XAie_DevInst *DevInst,
+		const XAie_MemMod *MemMod, XAie_LocType Loc, u32 Addr,
+		const unsigned char *CharSrc, u32 Size)
 {
 	AieRC RC;
 	u64 DmAddrRoundDown, DmAddrRoundUp;
@@ -158,31 +163,6 @@ AieRC XAie_DataMemBlockWrite(XAie_DevInst *DevInst, XAie_LocType Loc, u32 Addr,
 	u32 Mask = 0, TempWord = 0;
 	u32 RemBytes = Size;
 	u8 FirstWriteOffset = Addr & XAIE_MEM_WORD_ALIGN_MASK;
-	u8 TileType;
-	unsigned char *CharSrc = (unsigned char *)Src;
-	const XAie_MemMod *MemMod;
-
-	if((DevInst == XAIE_NULL) ||
-		(DevInst->IsReady != XAIE_COMPONENT_IS_READY) || (Src == NULL))
-	{
-		XAIE_ERROR("Invalid device instance or source pointer\n");
-		return XAIE_INVALID_ARGS;
-	}
-
-	TileType = DevInst->DevOps->GetTTypefromLoc(DevInst, Loc);
-	if((TileType != XAIEGBL_TILE_TYPE_AIETILE) &&
-			(TileType != XAIEGBL_TILE_TYPE_MEMTILE)) {
-		XAIE_ERROR("Invalid tile type\n");
-		return XAIE_INVALID_TILE;
-	}
-
-	MemMod = DevInst->DevProp.DevMod[TileType].MemMod;
-
-	/* Check for any size overflow */
-	if((u64)Addr + Size > MemMod->Size) {
-		XAIE_ERROR("Size of source block overflows tile data memory\n");
-		return XAIE_ERR_OUTOFBOUND;
-	}
 
 	/* Absolute 4-byte aligned AXI-MM address to write */
 	DmAddrRoundDown =  MemMod->MemAddr + XAIE_MEM_WORD_ROUND_DOWN(Addr) +
@@ -240,6 +220,149 @@ AieRC XAie_DataMemBlockWrite(XAie_DevInst *DevInst, XAie_LocType Loc, u32 Addr,
 	return XAIE_OK;
 }
 
+/*****************************************************************************/
+/**
+*
+* This API writes a block of data to the specified data memory location of
+* the selected tile. Byte-level writes are supported by this API. For unaligned
+* data memory offsets, this API implements read-modify-write operation.
+*
+* @param	DevInst: Device Instance
+* @param	Loc: Loc of AIE Tiles
+* @param	Addr: Address in data memory to write.
+* @param	Src - Source to write data.
+* @param	Size - Size in bytes to write.
+*
+* @return	XAIE_OK on success and error code on failure
+*
+* @note		None.
+*
+*******************************************************************************/
+AieRC XAie_DataMemBlockWrite(XAie_DevInst *DevInst, XAie_LocType Loc, u32 Addr,
+		const void *Src, u32 Size)
+{
+	u8 TileType;
+	const XAie_MemMod *MemMod;
+
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY) || (Src == NULL))
+	{
+		XAIE_ERROR("Invalid device instance or source pointer\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	TileType = DevInst->DevOps->GetTTypefromLoc(DevInst, Loc);
+	if((TileType != XAIEGBL_TILE_TYPE_AIETILE) &&
+			(TileType != XAIEGBL_TILE_TYPE_MEMTILE)) {
+		XAIE_ERROR("Invalid tile type\n");
+		return XAIE_INVALID_TILE;
+	}
+
+	MemMod = DevInst->DevProp.DevMod[TileType].MemMod;
+
+	/* Check for any size overflow */
+	if((u64)Addr + Size > MemMod->Size) {
+		XAIE_ERROR("Size of source block overflows tile data memory\n");
+		return XAIE_ERR_OUTOFBOUND;
+	}
+
+	return _XAie_DataMemBlockWrite(DevInst, MemMod, Loc, Addr,
+			(const unsigned char *)Src, Size);
+}
+
+/*****************************************************************************/
+/**
+*
+* This API writes the same block of data to the data memory of several tiles.
+* All the targets are validated before any of them is written. The writes of
+* all the targets are then submitted to the backend as one transaction, or
+* added to the transaction of the calling thread if one is open.
+*
+* @param	DevInst: Device Instance
+* @param	Targets: Tiles and data memory addresses to write.
+* @param	NumTargets: Number of targets.
+* @param	Src - Source to write data.
+* @param	Size - Size in bytes to write to each target.
+*
+* @return	XAIE_OK on success and error code on failure
+*
+* @note		The backends with a transaction submit op receive the writes
+*		in one submission. If the transaction fails to build or to
+*		submit, it is dropped and the error is returned; the targets
+*		may then be partially written.
+*
+*******************************************************************************/
+AieRC XAie_DataMemBlockWriteVec(XAie_DevInst *DevInst,
+		const XAie_DataMemTarget *Targets, u32 NumTargets,
+		const void *Src, u32 Size)
+{
+	AieRC RC = XAIE_OK;
+	u8 TileType, OwnTxn;
+
+	if((DevInst == XAIE_NULL) ||
+		(DevInst->IsReady != XAIE_COMPONENT_IS_READY) ||
+		(Targets == NULL) || (NumTargets == 0U) || (Src == NULL))
+	{
+		XAIE_ERROR("Invalid device instance, targets or source "
+				"pointer\n");
+		return XAIE_INVALID_ARGS;
+	}
+
+	for(u32 i = 0U; i < NumTargets; i++) {
+		const XAie_MemMod *MemMod;
+
+		TileType = DevInst->DevOps->GetTTypefromLoc(DevInst,
+				Targets[i].Loc);
+		if((TileType != XAIEGBL_TILE_TYPE_AIETILE) &&
+				(TileType != XAIEGBL_TILE_TYPE_MEMTILE)) {
+			XAIE_ERROR("Invalid tile type of target %u\n", i);
+			return XAIE_INVALID_TILE;
+		}
+
+		MemMod = DevInst->DevProp.DevMod[TileType].MemMod;
+		if((u64)Targets[i].Addr + Size > MemMod->Size) {
+			XAIE_ERROR("Size of source block overflows tile data "
+					"memory of target %u\n", i);
+			return XAIE_ERR_OUTOFBOUND;
+		}
+	}
+
+	OwnTxn = (_XAie_GetTxnInst(DevInst,
+			DevInst->Backend->Ops.GetTid()) == NULL);
+	if(OwnTxn) {
+		RC = _XAie_Txn_Start(DevInst,
+				XAIE_TRANSACTION_DISABLE_AUTO_FLUSH,
+				NumTargets * XAIE_MEM_VEC_CMDS_PER_TARGET,
+				(u64)NumTargets * Size);
+		if(RC != XAIE_OK) {
+			return RC;
+		}
+	}
+
+	for(u32 i = 0U; (i < NumTargets) && (RC == XAIE_OK); i++) {
+		TileType = DevInst->DevOps->GetTTypefromLoc(DevInst,
+				Targets[i].Loc);
+		RC = _XAie_DataMemBlockWrite(DevInst,
+				DevInst->DevProp.DevMod[TileType].MemMod,
+				Targets[i].Loc, Targets[i].Addr,
+				(const unsigned char *)Src, Size);
+	}
+
+	if(!OwnTxn) {
+		return RC;
+	}
+
+	if(RC == XAIE_OK) {
+		RC = _XAie_Txn_Submit(DevInst, NULL);
+	}
+	if(RC != XAIE_OK) {
+		XAIE_ERROR("Failed to write the data memory targets\n");
+		_XAie_Txn_Discard(DevInst);
+	}
+
+	return RC;
+}
+
 /*****************************************************************************/
 /**
 *
@@ -317,14 +440,13 @@ AieRC XAie_DataMemBlockRead(XAie_DevInst *DevInst, XAie_LocType Loc, u32 Addr,
 	}
 
 	/* Aligned bytes */
-	for(u32 AlignedWord = 0; AlignedWord < RemBytes / 4;
-		AlignedWord++, BytePtr += 4, DmAddrRoundUp += 4) {
-		RC = XAie_Read32(DevInst, DmAddrRoundUp,
-				(u32 *)(CharDst + BytePtr));
-		if(RC != XAIE_OK) {
-			return RC;
-		}
+	RC = XAie_BlockRead32(DevInst, DmAddrRoundUp, (u32 *)(CharDst + BytePtr),
+			RemBytes / 4);
+	if(RC != XAIE_OK) {
+		return RC;
 	}
+	BytePtr += XAIE_MEM_WORD_ROUND_DOWN(RemBytes);
+	DmAddrRoundUp += XAIE_MEM_WORD_ROUND_DOWN(RemBytes);
 
 	/* Remaining bytes */
 	if(RemBytes % XAIE_MEM_WORD_ALIGN_SIZE) {
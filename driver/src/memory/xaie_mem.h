@@ -37,6 +37,16 @@
 						~XAIE_MEM_WORD_ALIGN_MASK)
 #define XAIE_MEM_WORD_ROUND_DOWN(Addr)	((Addr) & (~XAIE_MEM_WORD_ALIGN_MASK))
 
+/****************************** Type Definitions *****************************/
+/*
+ * This typedef contains a target of a data memory block write to several
+ * tiles.
+ */
+typedef struct {
+	XAie_LocType Loc;
+	u32 Addr;	/* Address in the data memory of the tile */
+} XAie_DataMemTarget;
+
 /************************** Function Prototypes  *****************************/
 AieRC XAie_DataMemWrWord(XAie_DevInst *DevInst, XAie_LocType Loc,
 		u32 Addr, u32 Data);
@@ -46,6 +56,9 @@ AieRC XAie_DataMemBlockWrite(XAie_DevInst *DevInst, XAie_LocType Loc, u32 Addr,
 		const void *Src, u32 Size);
 AieRC XAie_DataMemBlockRead(XAie_DevInst *DevInst, XAie_LocType Loc, u32 Addr,
 		void *Dst, u32 Size);
+AieRC XAie_DataMemBlockWriteVec(XAie_DevInst *DevInst,
+		const XAie_DataMemTarget *Targets, u32 NumTargets,
+		const void *Src, u32 Size);
 
 #endif		/* end of protection macro */
 
@@ -74,6 +74,14 @@ else()
       elseif (WITH_AIEDRV_LINUX)
         set (AIEDRV_BACKEND -D__AIELINUX__)
       endif (WITH_AIEDRV_LIBMETAL)
+    else()
+      option (WITH_AIEDRV_SHADOWDEV "Build with shadow device backend" OFF)
+      option (WITH_AIEDRV_SOCKET "Build with socket backend" OFF)
+      if (WITH_AIEDRV_SHADOWDEV)
+        set (AIEDRV_BACKEND -D__AIESHADOWDEV__)
+      elseif (WITH_AIEDRV_SOCKET)
+        set (AIEDRV_BACKEND -D__AIESOCKET__)
+      endif (WITH_AIEDRV_SHADOWDEV)
     endif(NOT ${_host} STREQUAL ${_target})
   else()
     option (WITH_AIEDRV_BAREMETAL "Build with baremetal backend" ON)
@@ -0,0 +1,180 @@
+// Copyright(C) 2022 by Xilinx, Inc. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "CppUTest/CommandLineTestRunner.h"
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+
+#include "common/tc_config.h"
+
+/*
+ * Fault injection tests, on the shadow device backend. The DMA channels of
+ * the shadow device are idle, so waiting for them only fails on injected
+ * faults.
+ */
+#ifdef TEST_SHADOWDEV
+
+#define FAULT_SEED		0x1234U
+#define FAULT_NUM_WAITS		64U
+#define FAULT_TIMEOUT_US	10U
+
+TEST_GROUP(Fault)
+{
+	XAie_Config ConfigPtr;
+	XAie_DevInst DevInst;
+	XAie_FaultCfg FaultCfg;
+	XAie_LocType Tile;
+	u64 Dm;
+
+	TEST_SETUP()
+	{
+		AieRC RC;
+
+		XAie_SetupConfig(Cfg, HW_GEN, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_MEM_TILE_ROW_START, XAIE_MEM_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+		ConfigPtr = Cfg;
+		memset(&DevInst, 0, sizeof(DevInst));
+
+		RC = XAie_CfgInitialize(&DevInst, &ConfigPtr);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		Tile = XAie_TileLoc(2, XAIE_AIE_TILE_ROW_START);
+		Dm = ((u64)Tile.Row << XAIE_ROW_SHIFT) |
+			((u64)Tile.Col << XAIE_COL_SHIFT);
+
+		memset(&FaultCfg, 0, sizeof(FaultCfg));
+		FaultCfg.Seed = FAULT_SEED;
+	}
+
+	TEST_TEARDOWN()
+	{
+		XAie_Finish(&DevInst);
+	}
+
+	AieRC WaitForDone(XAie_DevInst *Inst)
+	{
+		return XAie_DmaWaitForDone(Inst, Tile, 0U, DMA_S2MM,
+				FAULT_TIMEOUT_US);
+	}
+
+	AieRC WaitForDone()
+	{
+		return WaitForDone(&DevInst);
+	}
+
+	/*
+	 * Exports a transaction which writes 0x2 to the data memory, and waits
+	 * for the DMA after the write if WithPoll is enabled.
+	 */
+	XAie_TxnInst *Export(u8 WithPoll)
+	{
+		XAie_DevInst Src;
+		XAie_TxnInst *TxnInst;
+
+		memset(&Src, 0, sizeof(Src));
+		CHECK_EQUAL(XAie_CfgInitialize(&Src, &ConfigPtr), XAIE_OK);
+		CHECK_EQUAL(XAie_StartTransaction(&Src,
+				XAIE_TRANSACTION_DISABLE_AUTO_FLUSH), XAIE_OK);
+		CHECK_EQUAL(XAie_Write32(&Src, Dm, 0x2U), XAIE_OK);
+		if(WithPoll == XAIE_ENABLE) {
+			CHECK_EQUAL(XAIE_OK, WaitForDone(&Src));
+		}
+		TxnInst = XAie_ExportTransactionInstance(&Src);
+		CHECK(TxnInst != NULL);
+		XAie_Finish(&Src);
+
+		return TxnInst;
+	}
+
+	/* Returns a bit per wait which failed, for FAULT_NUM_WAITS waits */
+	u64 FailedWaits()
+	{
+		u64 Failed = 0U;
+
+		CHECK_EQUAL(XAie_StartFaultInjection(&DevInst, &FaultCfg),
+				XAIE_OK);
+		for(u32 i = 0U; i < FAULT_NUM_WAITS; i++) {
+			AieRC RC = WaitForDone();
+
+			if(RC != XAIE_OK) {
+				CHECK_EQUAL(XAIE_ERR, RC);
+				Failed |= 1ULL << i;
+			}
+		}
+		CHECK_EQUAL(XAie_StopFaultInjection(&DevInst), XAIE_OK);
+
+		return Failed;
+	}
+};
+
+/* An injected poll timeout is reported by the DMA wait */
+TEST(Fault, PollTimeOutIsReported) {
+	CHECK_EQUAL(XAIE_OK, WaitForDone());
+
+	FaultCfg.PollTimeOutPerMille = 1000U;
+	UNSIGNED_LONGS_EQUAL(~0ULL, FailedWaits());
+
+	CHECK_EQUAL(XAIE_OK, WaitForDone());
+}
+
+/* The faults drawn from the same seed are the same */
+TEST(Fault, SeedIsReproducible) {
+	u64 Failed;
+
+	FaultCfg.PollTimeOutPerMille = 500U;
+	Failed = FailedWaits();
+	CHECK(Failed != 0U);
+	CHECK(Failed != ~0ULL);
+	UNSIGNED_LONGS_EQUAL(Failed, FailedWaits());
+
+	FaultCfg.Seed = FAULT_SEED + 1U;
+	CHECK(Failed != FailedWaits());
+}
+
+/*
+ * The polls of a transaction run through the fault injection when it is
+ * submitted, and a failed submission leaves the transaction to be submitted
+ * again.
+ */
+TEST(Fault, TxnPollTimeOutIsReported) {
+	XAie_TxnInst *TxnInst = Export(XAIE_ENABLE);
+	u32 Val;
+
+	FaultCfg.PollTimeOutPerMille = 1000U;
+	CHECK_EQUAL(XAie_StartFaultInjection(&DevInst, &FaultCfg), XAIE_OK);
+	CHECK_EQUAL(XAIE_ERR, XAie_SubmitTransaction(&DevInst, TxnInst));
+	CHECK_EQUAL(XAie_StopFaultInjection(&DevInst), XAIE_OK);
+
+	CHECK_EQUAL(XAie_SubmitTransaction(&DevInst, TxnInst), XAIE_OK);
+	CHECK_EQUAL(XAie_Read32(&DevInst, Dm, &Val), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x2U, Val);
+
+	XAie_FreeTransactionInstance(TxnInst);
+}
+
+/* A failed submission is reported before any of its writes is issued */
+TEST(Fault, TxnFailureIsReported) {
+	XAie_TxnInst *TxnInst = Export(XAIE_DISABLE);
+	u32 Val;
+
+	CHECK_EQUAL(XAie_Write32(&DevInst, Dm, 0x1U), XAIE_OK);
+
+	FaultCfg.TxnFailPerMille = 1000U;
+	CHECK_EQUAL(XAie_StartFaultInjection(&DevInst, &FaultCfg), XAIE_OK);
+	CHECK_EQUAL(XAIE_ERR, XAie_SubmitTransaction(&DevInst, TxnInst));
+	CHECK_EQUAL(XAie_StopFaultInjection(&DevInst), XAIE_OK);
+
+	CHECK_EQUAL(XAie_Read32(&DevInst, Dm, &Val), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x1U, Val);
+
+	CHECK_EQUAL(XAie_SubmitTransaction(&DevInst, TxnInst), XAIE_OK);
+	CHECK_EQUAL(XAie_Read32(&DevInst, Dm, &Val), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x2U, Val);
+
+	XAie_FreeTransactionInstance(TxnInst);
+}
+
+#endif /* TEST_SHADOWDEV */
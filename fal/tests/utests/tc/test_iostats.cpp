@@ -0,0 +1,151 @@
+// Copyright(C) 2022 by Xilinx, Inc. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include <pthread.h>
+
+#include "CppUTest/CommandLineTestRunner.h"
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+
+#include "common/tc_config.h"
+
+/*
+ * IO statistics tests, on the shadow device backend.
+ */
+#ifdef TEST_SHADOWDEV
+
+#define IOSTATS_NUM_THREADS	8U
+#define IOSTATS_NUM_WRITES	16U
+
+static XAie_DevInst IOStatsDevInst;
+
+static u64 IOStatsTileAddr(u8 Col, u8 Row)
+{
+	return ((u64)Row << XAIE_ROW_SHIFT) | ((u64)Col << XAIE_COL_SHIFT);
+}
+
+static void *IOStatsThread(void *Arg)
+{
+	u8 Col = (u8)(1U + (u8)(uintptr_t)Arg % 4U);
+	u64 Dm = IOStatsTileAddr(Col, XAIE_AIE_TILE_ROW_START);
+
+	for(u32 i = 0U; i < IOSTATS_NUM_WRITES; i++) {
+		if(XAie_Write32(&IOStatsDevInst, Dm + i * 4U, i) != XAIE_OK) {
+			return (void *)1;
+		}
+	}
+
+	return NULL;
+}
+
+TEST_GROUP(IOStats)
+{
+	XAie_Config ConfigPtr;
+
+	TEST_SETUP()
+	{
+		AieRC RC;
+
+		XAie_SetupConfig(Cfg, HW_GEN, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_MEM_TILE_ROW_START, XAIE_MEM_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+		ConfigPtr = Cfg;
+		memset(&IOStatsDevInst, 0, sizeof(IOStatsDevInst));
+
+		RC = XAie_CfgInitialize(&IOStatsDevInst, &ConfigPtr);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		RC = XAie_StartIOStats(&IOStatsDevInst);
+		CHECK_EQUAL(RC, XAIE_OK);
+	}
+
+	TEST_TEARDOWN()
+	{
+		XAie_StopIOStats(&IOStatsDevInst);
+		XAie_Finish(&IOStatsDevInst);
+	}
+
+	u64 Writes()
+	{
+		XAie_IOStats Stats;
+		u64 Calls = 0U;
+
+		CHECK_EQUAL(XAie_GetIOStats(&IOStatsDevInst, &Stats), XAIE_OK);
+		for(u32 M = 0U; M < XAIE_IOSTATS_NUM_MODS; M++) {
+			Calls += Stats.Cnt[XAIE_IOSTATS_WRITE32]
+				[XAIEGBL_TILE_TYPE_AIETILE][M].Calls;
+		}
+
+		return Calls;
+	}
+
+	void RunThreads()
+	{
+		pthread_t Threads[IOSTATS_NUM_THREADS];
+		void *Ret;
+
+		for(u32 i = 0U; i < IOSTATS_NUM_THREADS; i++) {
+			CHECK_EQUAL(0, pthread_create(&Threads[i], NULL,
+					IOStatsThread, (void *)(uintptr_t)i));
+		}
+		for(u32 i = 0U; i < IOSTATS_NUM_THREADS; i++) {
+			CHECK_EQUAL(0, pthread_join(Threads[i], &Ret));
+			POINTERS_EQUAL(NULL, Ret);
+		}
+	}
+};
+
+/* The counters of the threads are kept once the threads exited */
+TEST(IOStats, CountsOfExitedThreadsAreKept) {
+	RunThreads();
+	UNSIGNED_LONGS_EQUAL(IOSTATS_NUM_THREADS * IOSTATS_NUM_WRITES,
+			Writes());
+
+	RunThreads();
+	UNSIGNED_LONGS_EQUAL(2U * IOSTATS_NUM_THREADS * IOSTATS_NUM_WRITES,
+			Writes());
+
+	CHECK_EQUAL(XAie_Write32(&IOStatsDevInst,
+			IOStatsTileAddr(1, XAIE_AIE_TILE_ROW_START), 0U),
+			XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(2U * IOSTATS_NUM_THREADS * IOSTATS_NUM_WRITES + 1U,
+			Writes());
+}
+
+/* The counting is only started and stopped without an open transaction */
+TEST(IOStats, ChangedWhenIdle) {
+	CHECK_EQUAL(XAie_StartTransaction(&IOStatsDevInst,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH), XAIE_OK);
+	CHECK_EQUAL(XAIE_ERR, XAie_StopIOStats(&IOStatsDevInst));
+	CHECK_EQUAL(XAie_SubmitTransaction(&IOStatsDevInst, NULL), XAIE_OK);
+	CHECK_EQUAL(XAie_StopIOStats(&IOStatsDevInst), XAIE_OK);
+
+	CHECK_EQUAL(XAie_StartTransaction(&IOStatsDevInst,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH), XAIE_OK);
+	CHECK_EQUAL(XAIE_ERR, XAie_StartIOStats(&IOStatsDevInst));
+	CHECK_EQUAL(XAie_SubmitTransaction(&IOStatsDevInst, NULL), XAIE_OK);
+	CHECK_EQUAL(XAie_StartIOStats(&IOStatsDevInst), XAIE_OK);
+}
+
+/*
+ * Memory ops reach the backend while the counting runs, and memories outlive
+ * the counting.
+ */
+TEST(IOStats, MemoryOps) {
+	XAie_MemInst *MemInst;
+
+	MemInst = XAie_MemAllocate(&IOStatsDevInst, 64U, XAIE_MEM_CACHEABLE);
+	CHECK(MemInst != NULL);
+	POINTERS_EQUAL(&IOStatsDevInst, MemInst->DevInst);
+	CHECK_EQUAL(XAie_MemSyncForDev(MemInst), XAIE_OK);
+	POINTERS_EQUAL(&IOStatsDevInst, MemInst->DevInst);
+
+	CHECK_EQUAL(XAie_StopIOStats(&IOStatsDevInst), XAIE_OK);
+	CHECK_EQUAL(XAie_MemSyncForCPU(MemInst), XAIE_OK);
+	CHECK_EQUAL(XAie_StartIOStats(&IOStatsDevInst), XAIE_OK);
+	CHECK_EQUAL(XAie_MemFree(MemInst), XAIE_OK);
+}
+
+#endif /* TEST_SHADOWDEV */
@@ -0,0 +1,209 @@
+// Copyright(C) 2022 by Xilinx, Inc. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "CppUTest/CommandLineTestRunner.h"
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+
+#include "common/tc_config.h"
+
+/*
+ * Data memory tests. They read back the data memories, so they need the
+ * shadow device backend.
+ */
+#ifdef TEST_SHADOWDEV
+
+#define MEM_NUM_TARGETS	4U
+#define MEM_BLOCK_SIZE	13U
+#define MEM_FILL	0xEEU
+
+TEST_GROUP(Mem)
+{
+	XAie_Config ConfigPtr;
+	XAie_DevInst DevInst;
+	XAie_DataMemTarget Targets[MEM_NUM_TARGETS];
+	u8 Src[MEM_BLOCK_SIZE];
+
+	TEST_SETUP()
+	{
+		AieRC RC;
+
+		XAie_SetupConfig(Cfg, HW_GEN, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_MEM_TILE_ROW_START, XAIE_MEM_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+		ConfigPtr = Cfg;
+		memset(&DevInst, 0, sizeof(DevInst));
+
+		RC = XAie_CfgInitialize(&DevInst, &ConfigPtr);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		/* Unaligned heads and tails, one target per tile */
+		for(u32 i = 0U; i < MEM_NUM_TARGETS; i++) {
+			u8 Fill[MEM_BLOCK_SIZE + 8U];
+
+			Targets[i].Loc = XAie_TileLoc(1 + i,
+					XAIE_AIE_TILE_ROW_START + i);
+			Targets[i].Addr = 0x100U + i * 0x41U;
+
+			memset(Fill, MEM_FILL, sizeof(Fill));
+			RC = XAie_DataMemBlockWrite(&DevInst, Targets[i].Loc,
+					Targets[i].Addr - 4U, Fill,
+					sizeof(Fill));
+			CHECK_EQUAL(RC, XAIE_OK);
+		}
+
+		for(u32 i = 0U; i < MEM_BLOCK_SIZE; i++) {
+			Src[i] = (u8)(0x30U + i);
+		}
+	}
+
+	TEST_TEARDOWN()
+	{
+		XAie_Finish(&DevInst);
+	}
+
+	/* Calls of an IO operation which reached the backend */
+	u64 Calls(XAie_IOStatsOp Op)
+	{
+		XAie_IOStats Stats;
+		u64 Total = 0U;
+
+		CHECK_EQUAL(XAie_GetIOStats(&DevInst, &Stats), XAIE_OK);
+		for(u32 T = 0U; T < XAIE_IOSTATS_NUM_TILE_TYPES; T++) {
+			for(u32 M = 0U; M < XAIE_IOSTATS_NUM_MODS; M++) {
+				Total += Stats.Cnt[Op][T][M].Calls;
+			}
+		}
+
+		return Total;
+	}
+
+	/* Checks the block of a target and the bytes around it */
+	void CheckTarget(u32 Idx, u8 Written)
+	{
+		u8 Dst[MEM_BLOCK_SIZE + 8U];
+		AieRC RC;
+
+		RC = XAie_DataMemBlockRead(&DevInst, Targets[Idx].Loc,
+				Targets[Idx].Addr - 4U, Dst, sizeof(Dst));
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		for(u32 i = 0U; i < sizeof(Dst); i++) {
+			u8 Expected = MEM_FILL;
+
+			if((Written != 0U) && (i >= 4U) &&
+					(i < 4U + MEM_BLOCK_SIZE)) {
+				Expected = Src[i - 4U];
+			}
+			UNSIGNED_LONGS_EQUAL(Expected, Dst[i]);
+		}
+	}
+};
+
+TEST(Mem, BlockWriteVecWritesAllTargets) {
+	AieRC RC;
+
+	RC = XAie_DataMemBlockWriteVec(&DevInst, Targets, MEM_NUM_TARGETS,
+			Src, MEM_BLOCK_SIZE);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	for(u32 i = 0U; i < MEM_NUM_TARGETS; i++) {
+		CheckTarget(i, 1U);
+	}
+}
+
+TEST(Mem, BlockWriteVecInTransaction) {
+	AieRC RC;
+
+	RC = XAie_StartTransaction(&DevInst,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_DataMemBlockWriteVec(&DevInst, Targets, MEM_NUM_TARGETS,
+			Src, MEM_BLOCK_SIZE);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_SubmitTransaction(&DevInst, NULL);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	for(u32 i = 0U; i < MEM_NUM_TARGETS; i++) {
+		CheckTarget(i, 1U);
+	}
+}
+
+TEST(Mem, BlockWriteVecInvalidTargetWritesNothing) {
+	AieRC RC;
+	XAie_DataMemTarget Bad[MEM_NUM_TARGETS + 1U];
+
+	memcpy(Bad, Targets, sizeof(Targets));
+	Bad[MEM_NUM_TARGETS].Loc = XAie_TileLoc(1, XAIE_SHIM_ROW);
+	Bad[MEM_NUM_TARGETS].Addr = 0U;
+
+	RC = XAie_DataMemBlockWriteVec(&DevInst, Bad, MEM_NUM_TARGETS + 1U,
+			Src, MEM_BLOCK_SIZE);
+	CHECK_EQUAL(RC, XAIE_INVALID_TILE);
+
+	for(u32 i = 0U; i < MEM_NUM_TARGETS; i++) {
+		CheckTarget(i, 0U);
+	}
+}
+
+/*
+ * The shadow device has no transaction submit op, the fault injection adds
+ * one below the IO statistics.
+ */
+TEST(Mem, BlockWriteVecIsOneSubmission) {
+	XAie_FaultCfg FaultCfg;
+	AieRC RC;
+
+	memset(&FaultCfg, 0, sizeof(FaultCfg));
+	CHECK_EQUAL(XAie_StartFaultInjection(&DevInst, &FaultCfg), XAIE_OK);
+	CHECK_EQUAL(XAie_StartIOStats(&DevInst), XAIE_OK);
+
+	RC = XAie_DataMemBlockWriteVec(&DevInst, Targets, MEM_NUM_TARGETS,
+			Src, MEM_BLOCK_SIZE);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	UNSIGNED_LONGS_EQUAL(1U, Calls(XAIE_IOSTATS_SUBMITTXN));
+	UNSIGNED_LONGS_EQUAL(0U, Calls(XAIE_IOSTATS_MASKWRITE32));
+	UNSIGNED_LONGS_EQUAL(0U, Calls(XAIE_IOSTATS_BLOCKWRITE32));
+
+	CHECK_EQUAL(XAie_StopIOStats(&DevInst), XAIE_OK);
+	CHECK_EQUAL(XAie_StopFaultInjection(&DevInst), XAIE_OK);
+
+	for(u32 i = 0U; i < MEM_NUM_TARGETS; i++) {
+		CheckTarget(i, 1U);
+	}
+}
+
+/* A failed submission writes none of the targets and is not left open */
+TEST(Mem, BlockWriteVecFailureWritesNothing) {
+	XAie_FaultCfg FaultCfg;
+	AieRC RC;
+
+	memset(&FaultCfg, 0, sizeof(FaultCfg));
+	FaultCfg.TxnFailPerMille = 1000U;
+	CHECK_EQUAL(XAie_StartFaultInjection(&DevInst, &FaultCfg), XAIE_OK);
+
+	RC = XAie_DataMemBlockWriteVec(&DevInst, Targets, MEM_NUM_TARGETS,
+			Src, MEM_BLOCK_SIZE);
+	CHECK_EQUAL(RC, XAIE_ERR);
+
+	CHECK_EQUAL(XAie_StopFaultInjection(&DevInst), XAIE_OK);
+
+	for(u32 i = 0U; i < MEM_NUM_TARGETS; i++) {
+		CheckTarget(i, 0U);
+	}
+
+	RC = XAie_DataMemBlockWriteVec(&DevInst, Targets, MEM_NUM_TARGETS,
+			Src, MEM_BLOCK_SIZE);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	for(u32 i = 0U; i < MEM_NUM_TARGETS; i++) {
+		CheckTarget(i, 1U);
+	}
+}
+
+#endif /* TEST_SHADOWDEV */
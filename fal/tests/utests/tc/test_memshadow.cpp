@@ -0,0 +1,206 @@
+// Copyright(C) 2022 by Xilinx, Inc. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "CppUTest/CommandLineTestRunner.h"
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+
+#include "common/tc_config.h"
+
+/*
+ * Memory shadow tests. The bytes of the block writes reaching the backend are
+ * counted with the IO statistics, on the shadow device backend.
+ */
+#ifdef TEST_SHADOWDEV
+
+#define MEMSHADOW_PAGE_WORDS	64U
+#define MEMSHADOW_NUM_PAGES	4U
+#define MEMSHADOW_NUM_WORDS	(MEMSHADOW_PAGE_WORDS * MEMSHADOW_NUM_PAGES)
+#define MEMSHADOW_PAGE_BYTES	(MEMSHADOW_PAGE_WORDS * sizeof(u32))
+
+TEST_GROUP(MemShadow)
+{
+	XAie_Config ConfigPtr;
+	XAie_DevInst DevInst;
+	XAie_LocType Tile;
+	u64 Dm;
+	u32 Data[MEMSHADOW_NUM_WORDS];
+
+	TEST_SETUP()
+	{
+		AieRC RC;
+
+		XAie_SetupConfig(Cfg, HW_GEN, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_MEM_TILE_ROW_START, XAIE_MEM_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+		ConfigPtr = Cfg;
+		memset(&DevInst, 0, sizeof(DevInst));
+
+		RC = XAie_CfgInitialize(&DevInst, &ConfigPtr);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		RC = XAie_EnableMemShadow(&DevInst);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		RC = XAie_StartIOStats(&DevInst);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		/* Page aligned block in the data memory of an AIE tile */
+		Tile = XAie_TileLoc(2, XAIE_AIE_TILE_ROW_START);
+		Dm = ((u64)Tile.Row << XAIE_ROW_SHIFT) |
+			((u64)Tile.Col << XAIE_COL_SHIFT);
+		Dm += 0x400U;
+
+		for(u32 i = 0U; i < MEMSHADOW_NUM_WORDS; i++) {
+			Data[i] = 0x1000U + i;
+		}
+	}
+
+	TEST_TEARDOWN()
+	{
+		XAie_StopIOStats(&DevInst);
+		XAie_Finish(&DevInst);
+	}
+
+	/* Bytes of the block writes and block sets which reached the backend */
+	u64 Bytes()
+	{
+		XAie_IOStats Stats;
+		u64 Total = 0U;
+
+		CHECK_EQUAL(XAie_GetIOStats(&DevInst, &Stats), XAIE_OK);
+		for(u32 T = 0U; T < XAIE_IOSTATS_NUM_TILE_TYPES; T++) {
+			for(u32 M = 0U; M < XAIE_IOSTATS_NUM_MODS; M++) {
+				Total += Stats.Cnt[XAIE_IOSTATS_BLOCKWRITE32]
+					[T][M].Bytes;
+				Total += Stats.Cnt[XAIE_IOSTATS_BLOCKSET32]
+					[T][M].Bytes;
+			}
+		}
+
+		return Total;
+	}
+
+	/* Writes the block and returns the bytes which reached the backend */
+	u64 WriteBlock()
+	{
+		u64 Base = Bytes();
+
+		CHECK_EQUAL(XAie_BlockWrite32(&DevInst, Dm, Data,
+				MEMSHADOW_NUM_WORDS), XAIE_OK);
+
+		return Bytes() - Base;
+	}
+
+	void CheckBlock()
+	{
+		u32 Val;
+
+		for(u32 i = 0U; i < MEMSHADOW_NUM_WORDS; i++) {
+			CHECK_EQUAL(XAie_Read32(&DevInst, Dm + i * 4U, &Val),
+					XAIE_OK);
+			UNSIGNED_LONGS_EQUAL(Data[i], Val);
+		}
+	}
+};
+
+TEST(MemShadow, UnchangedPagesAreSkipped) {
+	UNSIGNED_LONGS_EQUAL(MEMSHADOW_NUM_PAGES * MEMSHADOW_PAGE_BYTES,
+			WriteBlock());
+	UNSIGNED_LONGS_EQUAL(0U, WriteBlock());
+
+	/* Only the page which changed is written */
+	Data[2U * MEMSHADOW_PAGE_WORDS + 5U] = 0xDEADU;
+	UNSIGNED_LONGS_EQUAL(MEMSHADOW_PAGE_BYTES, WriteBlock());
+	CheckBlock();
+}
+
+TEST(MemShadow, RegisterWriteForgetsPage) {
+	WriteBlock();
+
+	CHECK_EQUAL(XAie_Write32(&DevInst, Dm + MEMSHADOW_PAGE_BYTES + 8U,
+			0xBADU), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(MEMSHADOW_PAGE_BYTES, WriteBlock());
+	CheckBlock();
+}
+
+TEST(MemShadow, TransactionForgetsPages) {
+	WriteBlock();
+
+	CHECK_EQUAL(XAie_StartTransaction(&DevInst,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH), XAIE_OK);
+	CHECK_EQUAL(XAie_Write32(&DevInst, Dm + 3U * MEMSHADOW_PAGE_BYTES,
+			0xBADU), XAIE_OK);
+	CHECK_EQUAL(XAie_SubmitTransaction(&DevInst, NULL), XAIE_OK);
+
+	UNSIGNED_LONGS_EQUAL(MEMSHADOW_PAGE_BYTES, WriteBlock());
+	CheckBlock();
+}
+
+TEST(MemShadow, InvalidateWritesAgain) {
+	WriteBlock();
+
+	CHECK_EQUAL(XAie_InvalidateDataMemShadow(&DevInst, Tile), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(MEMSHADOW_NUM_PAGES * MEMSHADOW_PAGE_BYTES,
+			WriteBlock());
+
+	CHECK_EQUAL(XAie_InvalidateMemShadow(&DevInst), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(MEMSHADOW_NUM_PAGES * MEMSHADOW_PAGE_BYTES,
+			WriteBlock());
+	CheckBlock();
+}
+
+/* Enabling a core forgets its memory and the memories of its neighbours */
+TEST(MemShadow, CoreEnableForgetsPages) {
+	WriteBlock();
+
+	CHECK_EQUAL(XAie_CoreEnable(&DevInst, Tile), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(MEMSHADOW_NUM_PAGES * MEMSHADOW_PAGE_BYTES,
+			WriteBlock());
+
+	CHECK_EQUAL(XAie_CoreEnable(&DevInst, XAie_TileLoc(Tile.Col + 1U,
+				Tile.Row)), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(MEMSHADOW_NUM_PAGES * MEMSHADOW_PAGE_BYTES,
+			WriteBlock());
+
+	/* A core two columns away cannot write the memory */
+	CHECK_EQUAL(XAie_CoreEnable(&DevInst, XAie_TileLoc(Tile.Col + 2U,
+				Tile.Row)), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0U, WriteBlock());
+	CheckBlock();
+}
+
+/* Starting a S2MM channel forgets the memory, a MM2S channel only reads it */
+TEST(MemShadow, DmaStartForgetsPages) {
+	WriteBlock();
+
+	CHECK_EQUAL(XAie_DmaChannelEnable(&DevInst, Tile, 0U, DMA_MM2S),
+			XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0U, WriteBlock());
+
+	CHECK_EQUAL(XAie_DmaChannelEnable(&DevInst, Tile, 0U, DMA_S2MM),
+			XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(MEMSHADOW_NUM_PAGES * MEMSHADOW_PAGE_BYTES,
+			WriteBlock());
+
+	CHECK_EQUAL(XAie_DmaChannelPushBdToQueue(&DevInst, Tile, 0U, DMA_S2MM,
+				0U), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(MEMSHADOW_NUM_PAGES * MEMSHADOW_PAGE_BYTES,
+			WriteBlock());
+	CheckBlock();
+}
+
+/* A page set by a block set is the same content as a block write of it */
+TEST(MemShadow, BlockSetMatchesBlockWrite) {
+	CHECK_EQUAL(XAie_BlockSet32(&DevInst, Dm, 0U, MEMSHADOW_NUM_WORDS),
+			XAIE_OK);
+
+	memset(Data, 0, sizeof(Data));
+	Data[5U] = 0x55U;
+	UNSIGNED_LONGS_EQUAL(MEMSHADOW_PAGE_BYTES, WriteBlock());
+	CheckBlock();
+}
+
+#endif /* TEST_SHADOWDEV */
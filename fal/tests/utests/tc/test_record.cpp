@@ -0,0 +1,147 @@
+// Copyright(C) 2022 by Xilinx, Inc. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include <stdio.h>
+
+#include "CppUTest/CommandLineTestRunner.h"
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+
+#include "common/tc_config.h"
+
+/*
+ * IO record and replay tests. A recording made on one shadow device is
+ * replayed on another one, whose memory is then compared.
+ */
+#ifdef TEST_SHADOWDEV
+
+#define RECORD_FILE "record_test.bin"
+
+static u64 TileAddr(u8 Col, u8 Row)
+{
+	return ((u64)Row << XAIE_ROW_SHIFT) | ((u64)Col << XAIE_COL_SHIFT);
+}
+
+TEST_GROUP(Record)
+{
+	XAie_Config ConfigPtr;
+	XAie_DevInst Rec;
+	XAie_DevInst Play;
+	u64 Dm;
+
+	TEST_SETUP()
+	{
+		AieRC RC;
+
+		XAie_SetupConfig(Cfg, HW_GEN, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_MEM_TILE_ROW_START, XAIE_MEM_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+		ConfigPtr = Cfg;
+		memset(&Rec, 0, sizeof(Rec));
+		memset(&Play, 0, sizeof(Play));
+
+		RC = XAie_CfgInitialize(&Rec, &ConfigPtr);
+		CHECK_EQUAL(RC, XAIE_OK);
+		RC = XAie_CfgInitialize(&Play, &ConfigPtr);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		Dm = TileAddr(3, XAIE_AIE_TILE_ROW_START);
+	}
+
+	TEST_TEARDOWN()
+	{
+		XAie_Finish(&Rec);
+		XAie_Finish(&Play);
+		remove(RECORD_FILE);
+	}
+};
+
+TEST(Record, ReplayWrites) {
+	AieRC RC;
+	u32 Val;
+
+	RC = XAie_StartIORecord(&Rec, RECORD_FILE);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_Write32(&Rec, Dm, 0xA5A5U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_MaskWrite32(&Rec, Dm + 4U, 0xFF00U, 0x1200U);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_StopIORecord(&Rec);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_ReplayIORecord(&Play, RECORD_FILE, XAIE_REPLAY_FAST);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_Read32(&Play, Dm, &Val);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0xA5A5U, Val);
+	RC = XAie_Read32(&Play, Dm + 4U, &Val);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x1200U, Val);
+}
+
+/*
+ * The fault injection, with no faults, gives the shadow device a transaction
+ * submission, so the transaction reaches the recorder as a whole.
+ */
+TEST(Record, ReplayTransaction) {
+	XAie_FaultCfg Fault;
+	u32 Data[8];
+	u32 Val;
+	AieRC RC;
+
+	memset(&Fault, 0, sizeof(Fault));
+	RC = XAie_StartFaultInjection(&Rec, &Fault);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_StartIORecord(&Rec, RECORD_FILE);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	for(u32 i = 0U; i < 8U; i++) {
+		Data[i] = 0x100U + i;
+	}
+
+	RC = XAie_StartTransaction(&Rec, XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_Write32(&Rec, Dm, 0x11U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_MaskWrite32(&Rec, Dm + 4U, 0xF0U, 0x30U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_BlockWrite32(&Rec, Dm + 0x100U, Data, 8U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_BlockSet32(&Rec, Dm + 0x200U, 0x77U, 4U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_SubmitTransaction(&Rec, NULL);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_StopIORecord(&Rec);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_StopFaultInjection(&Rec);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_ReplayIORecord(&Play, RECORD_FILE, XAIE_REPLAY_FAST);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_Read32(&Play, Dm, &Val);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x11U, Val);
+	RC = XAie_Read32(&Play, Dm + 4U, &Val);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x30U, Val);
+	for(u32 i = 0U; i < 8U; i++) {
+		RC = XAie_Read32(&Play, Dm + 0x100U + i * 4U, &Val);
+		CHECK_EQUAL(RC, XAIE_OK);
+		UNSIGNED_LONGS_EQUAL(0x100U + i, Val);
+	}
+	for(u32 i = 0U; i < 4U; i++) {
+		RC = XAie_Read32(&Play, Dm + 0x200U + i * 4U, &Val);
+		CHECK_EQUAL(RC, XAIE_OK);
+		UNSIGNED_LONGS_EQUAL(0x77U, Val);
+	}
+}
+
+#endif /* TEST_SHADOWDEV */
@@ -0,0 +1,169 @@
+// Copyright(C) 2022 by Xilinx, Inc. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "CppUTest/CommandLineTestRunner.h"
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+
+#include "common/tc_config.h"
+
+/*
+ * Register shadow tests. The writes reaching the backend are counted with the
+ * IO statistics, on the shadow device backend.
+ */
+#ifdef TEST_SHADOWDEV
+
+TEST_GROUP(Shadow)
+{
+	XAie_Config ConfigPtr;
+	XAie_DevInst DevInst;
+	XAie_LocType Tile;
+	XAie_LocType Shim;
+
+	TEST_SETUP()
+	{
+		AieRC RC;
+
+		XAie_SetupConfig(Cfg, HW_GEN, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_MEM_TILE_ROW_START, XAIE_MEM_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+		ConfigPtr = Cfg;
+		memset(&DevInst, 0, sizeof(DevInst));
+
+		RC = XAie_CfgInitialize(&DevInst, &ConfigPtr);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		RC = XAie_EnableShadow(&DevInst);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		RC = XAie_StartIOStats(&DevInst);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		Tile = XAie_TileLoc(2, XAIE_AIE_TILE_ROW_START);
+		Shim = XAie_TileLoc(2, XAIE_SHIM_ROW);
+	}
+
+	TEST_TEARDOWN()
+	{
+		XAie_StopIOStats(&DevInst);
+		XAie_Finish(&DevInst);
+	}
+
+	/* Writes of any kind which reached the backend */
+	u64 Writes()
+	{
+		XAie_IOStats Stats;
+		u64 Calls = 0U;
+
+		CHECK_EQUAL(XAie_GetIOStats(&DevInst, &Stats), XAIE_OK);
+		for(u32 T = 0U; T < XAIE_IOSTATS_NUM_TILE_TYPES; T++) {
+			for(u32 M = 0U; M < XAIE_IOSTATS_NUM_MODS; M++) {
+				Calls += Stats.Cnt[XAIE_IOSTATS_WRITE32][T][M].Calls;
+				Calls += Stats.Cnt[XAIE_IOSTATS_MASKWRITE32][T][M].Calls;
+			}
+		}
+
+		return Calls;
+	}
+};
+
+TEST(Shadow, ConfigWriteIsElided) {
+	AieRC RC;
+	u64 Base;
+
+	RC = XAie_PerfCounterEventValueSet(&DevInst, Tile, XAIE_CORE_MOD, 0U,
+			0x100U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	Base = Writes();
+
+	RC = XAie_PerfCounterEventValueSet(&DevInst, Tile, XAIE_CORE_MOD, 0U,
+			0x100U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(Base, Writes());
+
+	RC = XAie_PerfCounterEventValueSet(&DevInst, Tile, XAIE_CORE_MOD, 0U,
+			0x200U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(Base + 1U, Writes());
+}
+
+TEST(Shadow, MaskWriteUsesCachedValue) {
+	AieRC RC;
+	u64 Base;
+
+	/* A full write puts the trace control in the shadow */
+	RC = XAie_TraceControlConfigReset(&DevInst, Tile, XAIE_CORE_MOD);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	Base = Writes();
+	RC = XAie_TraceStartEvent(&DevInst, Tile, XAIE_CORE_MOD,
+			XAIE_EVENT_TRUE_CORE);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(Base + 1U, Writes());
+
+	/* Same field again, nothing reaches the backend */
+	RC = XAie_TraceStartEvent(&DevInst, Tile, XAIE_CORE_MOD,
+			XAIE_EVENT_TRUE_CORE);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(Base + 1U, Writes());
+}
+
+TEST(Shadow, CounterValueIsNotCached) {
+	AieRC RC;
+	u64 Base;
+
+	Base = Writes();
+	for(u8 i = 0U; i < 3U; i++) {
+		RC = XAie_PerfCounterSet(&DevInst, Tile, XAIE_CORE_MOD, 0U, 0U);
+		CHECK_EQUAL(RC, XAIE_OK);
+	}
+	UNSIGNED_LONGS_EQUAL(Base + 3U, Writes());
+}
+
+TEST(Shadow, InterruptEnableIsNotCached) {
+	AieRC RC;
+	u64 Base;
+
+	Base = Writes();
+	RC = XAie_IntrCtrlL1Enable(&DevInst, Shim, XAIE_EVENT_SWITCH_A, 1U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_IntrCtrlL1Disable(&DevInst, Shim, XAIE_EVENT_SWITCH_A, 1U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_IntrCtrlL1Enable(&DevInst, Shim, XAIE_EVENT_SWITCH_A, 1U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(Base + 3U, Writes());
+}
+
+TEST(Shadow, BroadcastBlockIsNotCached) {
+	AieRC RC;
+	u64 Base;
+
+	Base = Writes();
+	for(u8 i = 0U; i < 2U; i++) {
+		RC = XAie_EventBroadcastBlockDir(&DevInst, Shim, XAIE_PL_MOD,
+				XAIE_EVENT_SWITCH_A, 0U, XAIE_EVENT_BROADCAST_WEST);
+		CHECK_EQUAL(RC, XAIE_OK);
+	}
+	UNSIGNED_LONGS_EQUAL(Base + 2U, Writes());
+}
+
+TEST(Shadow, InvalidateWritesAgain) {
+	AieRC RC;
+	u64 Base;
+
+	RC = XAie_PerfCounterEventValueSet(&DevInst, Tile, XAIE_CORE_MOD, 1U,
+			0x10U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_InvalidateShadow(&DevInst);
+	CHECK_EQUAL(RC, XAIE_OK);
+	Base = Writes();
+
+	RC = XAie_PerfCounterEventValueSet(&DevInst, Tile, XAIE_CORE_MOD, 1U,
+			0x10U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(Base + 1U, Writes());
+}
+
+#endif /* TEST_SHADOWDEV */
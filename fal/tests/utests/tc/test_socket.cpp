@@ -0,0 +1,178 @@
+// Copyright(C) 2022 by Xilinx, Inc. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include <limits.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "CppUTest/CommandLineTestRunner.h"
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+
+#include "common/tc_config.h"
+
+/*
+ * Socket backend tests. Each test starts the example socket server in a
+ * directory of its own and connects to it with the text or the binary
+ * protocol.
+ */
+#ifdef TEST_SOCKET
+
+#define SOCKET_PORT_DIR		"mesim_output"
+#define SOCKET_PORT_FILE	SOCKET_PORT_DIR "/mesimulator_aximm_port"
+#define SOCKET_START_TRIES	500U
+#define SOCKET_START_WAIT_US	10000U
+#define SOCKET_NUM_WORDS	64U
+#define SOCKET_POLL_TIMEOUT_US	1000U
+
+TEST_GROUP(Socket)
+{
+	XAie_Config ConfigPtr;
+	XAie_DevInst DevInst;
+	char Cwd[PATH_MAX];
+	char Dir[32];
+	pid_t Server;
+	u64 Dm;
+
+	TEST_SETUP()
+	{
+		XAie_SetupConfig(Cfg, HW_GEN, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_MEM_TILE_ROW_START, XAIE_MEM_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+		ConfigPtr = Cfg;
+		memset(&DevInst, 0, sizeof(DevInst));
+		CHECK(getcwd(Cwd, sizeof(Cwd)) != NULL);
+		Dir[0] = '\0';
+		Server = -1;
+
+		Dm = ((u64)XAIE_AIE_TILE_ROW_START << XAIE_ROW_SHIFT) |
+			((u64)2U << XAIE_COL_SHIFT);
+	}
+
+	TEST_TEARDOWN()
+	{
+		if(Server > 0) {
+			XAie_Finish(&DevInst);
+			kill(Server, SIGTERM);
+			waitpid(Server, NULL, 0);
+		}
+		unsetenv("XAIE_SOCKET_PROTOCOL");
+
+		if(Dir[0] != '\0') {
+			CHECK_EQUAL(0, chdir(Dir));
+			unlink(SOCKET_PORT_FILE);
+			rmdir(SOCKET_PORT_DIR);
+			CHECK_EQUAL(0, chdir(Cwd));
+			rmdir(Dir);
+		}
+	}
+
+	/*
+	 * Starts the server and connects to it once it published its port.
+	 * The backend reads the port from the current directory, so the test
+	 * runs from the directory of the server.
+	 */
+	void Connect(const char *Proto)
+	{
+		struct stat St;
+		u32 Tries;
+
+		strcpy(Dir, "/tmp/aiesocketXXXXXX");
+		if(mkdtemp(Dir) == NULL) {
+			Dir[0] = '\0';
+			FAIL("Failed to create the server directory");
+		}
+		CHECK_EQUAL(0, chdir(Dir));
+
+		Server = fork();
+		CHECK(Server >= 0);
+		if(Server == 0) {
+			execl(XAIE_SOCKET_SERVER, XAIE_SOCKET_SERVER,
+					(char *)NULL);
+			_exit(127);
+		}
+
+		for(Tries = 0U; Tries < SOCKET_START_TRIES; Tries++) {
+			if(stat(SOCKET_PORT_FILE, &St) == 0 && St.st_size > 0) {
+				break;
+			}
+			usleep(SOCKET_START_WAIT_US);
+		}
+		CHECK(Tries < SOCKET_START_TRIES);
+
+		if(Proto != NULL) {
+			setenv("XAIE_SOCKET_PROTOCOL", Proto, 1);
+		}
+		CHECK_EQUAL(XAie_CfgInitialize(&DevInst, &ConfigPtr), XAIE_OK);
+	}
+
+	void CheckAccess()
+	{
+		u32 Data[SOCKET_NUM_WORDS], Val;
+
+		CHECK_EQUAL(XAie_Write32(&DevInst, Dm, 0x12345678U), XAIE_OK);
+		CHECK_EQUAL(XAie_Read32(&DevInst, Dm, &Val), XAIE_OK);
+		UNSIGNED_LONGS_EQUAL(0x12345678U, Val);
+
+		CHECK_EQUAL(XAie_MaskWrite32(&DevInst, Dm, 0xFF00U, 0xAB00U),
+				XAIE_OK);
+		CHECK_EQUAL(XAie_Read32(&DevInst, Dm, &Val), XAIE_OK);
+		UNSIGNED_LONGS_EQUAL(0x1234AB78U, Val);
+
+		for(u32 i = 0U; i < SOCKET_NUM_WORDS; i++) {
+			Data[i] = 0x1000U + i;
+		}
+		CHECK_EQUAL(XAie_BlockWrite32(&DevInst, Dm + 0x100U, Data,
+				SOCKET_NUM_WORDS), XAIE_OK);
+		CHECK_EQUAL(XAie_BlockSet32(&DevInst, Dm + 0x100U, 0x55U, 4U),
+				XAIE_OK);
+		memset(Data, 0, sizeof(Data));
+		CHECK_EQUAL(XAie_BlockRead32(&DevInst, Dm + 0x100U, Data,
+				SOCKET_NUM_WORDS), XAIE_OK);
+		for(u32 i = 0U; i < SOCKET_NUM_WORDS; i++) {
+			UNSIGNED_LONGS_EQUAL((i < 4U) ? 0x55U : 0x1000U + i,
+					Data[i]);
+		}
+	}
+
+	void CheckMaskPoll()
+	{
+		CHECK_EQUAL(XAie_Write32(&DevInst, Dm, 0x5U), XAIE_OK);
+		CHECK_EQUAL(XAie_MaskPoll(&DevInst, Dm, 0xFU, 0x5U,
+				SOCKET_POLL_TIMEOUT_US), XAIE_OK);
+		CHECK_EQUAL(XAie_MaskPoll(&DevInst, Dm, 0xFU, 0x6U,
+				SOCKET_POLL_TIMEOUT_US), XAIE_ERR);
+
+		/* The connection is still usable after a failed poll */
+		CHECK_EQUAL(XAie_Write32(&DevInst, Dm, 0x6U), XAIE_OK);
+		CHECK_EQUAL(XAie_MaskPoll(&DevInst, Dm, 0xFU, 0x6U,
+				SOCKET_POLL_TIMEOUT_US), XAIE_OK);
+	}
+};
+
+TEST(Socket, TextAccess) {
+	Connect(NULL);
+	CheckAccess();
+}
+
+TEST(Socket, BinaryAccess) {
+	Connect("binary");
+	CheckAccess();
+}
+
+TEST(Socket, TextMaskPoll) {
+	Connect(NULL);
+	CheckMaskPoll();
+}
+
+TEST(Socket, BinaryMaskPoll) {
+	Connect("binary");
+	CheckMaskPoll();
+}
+
+#endif /* TEST_SOCKET */
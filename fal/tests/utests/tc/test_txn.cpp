@@ -0,0 +1,353 @@
+// Copyright(C) 2022 by Xilinx, Inc. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include <pthread.h>
+
+#include "CppUTest/CommandLineTestRunner.h"
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+
+#include "common/tc_config.h"
+
+/*
+ * Transaction tests. They read back what the transactions wrote, so they need
+ * the shadow device backend.
+ */
+#ifdef TEST_SHADOWDEV
+
+/* More threads than the slots of the transaction table of the driver */
+#define TXN_NUM_THREADS	80U
+/* Size of the data memory span written by the optimizer test */
+#define TXN_OPT_SPAN	0x80U
+
+static u64 TileAddr(u8 Col, u8 Row)
+{
+	return ((u64)Row << XAIE_ROW_SHIFT) | ((u64)Col << XAIE_COL_SHIFT);
+}
+
+/*
+ * Runs a transaction with writes the optimizer drops, folds and merges, around
+ * barrier commands, and returns the number of backend writes it took.
+ */
+static u64 TxnOptSequence(XAie_DevInst *DevInst, u64 Dm, u32 Flags)
+{
+	XAie_IOStats Stats;
+	u64 Calls = 0U;
+
+	CHECK_EQUAL(XAie_Write32(DevInst, Dm + 4U, 0xAABBCCDDU), XAIE_OK);
+	CHECK_EQUAL(XAie_StartIOStats(DevInst), XAIE_OK);
+
+	CHECK_EQUAL(XAie_StartTransaction(DevInst, Flags), XAIE_OK);
+	/* Overwritten write */
+	CHECK_EQUAL(XAie_Write32(DevInst, Dm, 1U), XAIE_OK);
+	CHECK_EQUAL(XAie_Write32(DevInst, Dm, 2U), XAIE_OK);
+	/* Mask writes folded together, and into a full write */
+	CHECK_EQUAL(XAie_MaskWrite32(DevInst, Dm + 4U, 0xFFU, 0x11U), XAIE_OK);
+	CHECK_EQUAL(XAie_MaskWrite32(DevInst, Dm + 4U, 0xFF00U, 0x2200U),
+			XAIE_OK);
+	CHECK_EQUAL(XAie_Write32(DevInst, Dm + 8U, 0x12345678U), XAIE_OK);
+	CHECK_EQUAL(XAie_MaskWrite32(DevInst, Dm + 8U, 0xF0U, 0xA0U), XAIE_OK);
+	/* Contiguous writes merged into a block write */
+	for(u32 i = 0U; i < 4U; i++) {
+		CHECK_EQUAL(XAie_Write32(DevInst, Dm + 0x20U + i * 4U,
+				0x100U + i), XAIE_OK);
+	}
+	/* The poll observes the first write, not the one after it */
+	CHECK_EQUAL(XAie_Write32(DevInst, Dm + 0x40U, 5U), XAIE_OK);
+	CHECK_EQUAL(XAie_MaskPoll(DevInst, Dm + 0x40U, 0xFFU, 5U, 1000U),
+			XAIE_OK);
+	CHECK_EQUAL(XAie_Write32(DevInst, Dm + 0x40U, 6U), XAIE_OK);
+	CHECK_EQUAL(XAie_BlockSet32(DevInst, Dm + 0x50U, 0x77U, 2U), XAIE_OK);
+	CHECK_EQUAL(XAie_Write32(DevInst, Dm + 0x50U, 8U), XAIE_OK);
+	/* A write with a patch point is kept */
+	CHECK_EQUAL(XAie_Write32(DevInst, Dm + 0x60U, 1U), XAIE_OK);
+	CHECK_EQUAL(XAie_AddTransactionPatchPoint(DevInst, "kept", Dm + 0x60U,
+			0U, 0xFFU), XAIE_OK);
+	CHECK_EQUAL(XAie_Write32(DevInst, Dm + 0x60U, 2U), XAIE_OK);
+	CHECK_EQUAL(XAie_SubmitTransaction(DevInst, NULL), XAIE_OK);
+
+	CHECK_EQUAL(XAie_GetIOStats(DevInst, &Stats), XAIE_OK);
+	CHECK_EQUAL(XAie_StopIOStats(DevInst), XAIE_OK);
+	for(u32 T = 0U; T < XAIE_IOSTATS_NUM_TILE_TYPES; T++) {
+		for(u32 M = 0U; M < XAIE_IOSTATS_NUM_MODS; M++) {
+			Calls += Stats.Cnt[XAIE_IOSTATS_WRITE32][T][M].Calls;
+			Calls += Stats.Cnt[XAIE_IOSTATS_MASKWRITE32][T][M].Calls;
+			Calls += Stats.Cnt[XAIE_IOSTATS_BLOCKWRITE32][T][M].Calls;
+		}
+	}
+
+	return Calls;
+}
+
+typedef struct {
+	XAie_DevInst *DevInst;
+	pthread_barrier_t *Barrier;
+	u64 RegOff;
+	u32 Value;
+	AieRC RC;
+} TxnThreadArgs;
+
+/* Opens a transaction, waits until all the threads did, then submits it */
+static void *TxnThread(void *Arg)
+{
+	TxnThreadArgs *Args = (TxnThreadArgs *)Arg;
+	AieRC RC;
+
+	RC = XAie_StartTransaction(Args->DevInst,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	if(RC == XAIE_OK) {
+		RC = XAie_Write32(Args->DevInst, Args->RegOff, Args->Value);
+	}
+
+	pthread_barrier_wait(Args->Barrier);
+
+	if(RC == XAIE_OK) {
+		RC = XAie_SubmitTransaction(Args->DevInst, NULL);
+	}
+	Args->RC = RC;
+
+	return NULL;
+}
+
+TEST_GROUP(Txn)
+{
+	XAie_Config ConfigPtr;
+	XAie_DevInst DevInst;
+	u64 Dm;
+
+	TEST_SETUP()
+	{
+		AieRC RC;
+
+		XAie_SetupConfig(Cfg, HW_GEN, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_MEM_TILE_ROW_START, XAIE_MEM_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+		ConfigPtr = Cfg;
+		memset(&DevInst, 0, sizeof(DevInst));
+
+		RC = XAie_CfgInitialize(&DevInst, &ConfigPtr);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		/* Data memory of an AIE tile, plain memory on the device */
+		Dm = TileAddr(2, XAIE_AIE_TILE_ROW_START);
+	}
+
+	TEST_TEARDOWN()
+	{
+		XAie_Finish(&DevInst);
+	}
+};
+
+TEST(Txn, ReadInEmptyTxnIsImmediate) {
+	AieRC RC;
+	u32 Val = 0U;
+
+	RC = XAie_Write32(&DevInst, Dm, 0x1234U);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_StartTransaction(&DevInst,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_Read32(&DevInst, Dm, &Val);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x1234U, Val);
+
+	RC = XAie_SubmitTransaction(&DevInst, NULL);
+	CHECK_EQUAL(RC, XAIE_OK);
+}
+
+TEST(Txn, ReadWithPendingCmdsIsNotDeferred) {
+	AieRC RC;
+	u32 Val;
+
+	RC = XAie_StartTransaction(&DevInst,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_Write32(&DevInst, Dm, 0x55U);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	/* Driver APIs use the value right away, it cannot be deferred */
+	RC = XAie_Read32(&DevInst, Dm, &Val);
+	CHECK(RC != XAIE_OK);
+	RC = XAie_DataMemRdWord(&DevInst,
+			XAie_TileLoc(2, XAIE_AIE_TILE_ROW_START), 0x0U, &Val);
+	CHECK(RC != XAIE_OK);
+
+	RC = XAie_SubmitTransaction(&DevInst, NULL);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_Read32(&DevInst, Dm, &Val);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x55U, Val);
+}
+
+TEST(Txn, DeferredRead) {
+	AieRC RC;
+	u32 Val = 0U;
+
+	RC = XAie_StartTransaction(&DevInst,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_Write32(&DevInst, Dm, 0xABCDU);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_DeferredRead32(&DevInst, Dm, &Val);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_Write32(&DevInst, Dm, 0x1U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0U, Val);
+
+	RC = XAie_SubmitTransaction(&DevInst, NULL);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0xABCDU, Val);
+}
+
+TEST(Txn, ExportedDeferredReadDropsSlot) {
+	AieRC RC;
+	u32 Val = 0U;
+	XAie_TxnInst *Exported;
+
+	RC = XAie_StartTransaction(&DevInst,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_Write32(&DevInst, Dm, 0x77U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_DeferredRead32(&DevInst, Dm, &Val);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	Exported = XAie_ExportTransactionInstance(&DevInst);
+	CHECK(Exported != NULL);
+
+	RC = XAie_SubmitTransaction(&DevInst, NULL);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x77U, Val);
+
+	/* Resubmitting the copy does not write to the slot again */
+	Val = 0U;
+	RC = XAie_SubmitTransaction(&DevInst, Exported);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0U, Val);
+
+	RC = XAie_FreeTransactionInstance(Exported);
+	CHECK_EQUAL(RC, XAIE_OK);
+}
+
+TEST(Txn, PatchPointOutOfWriteMaskIsRejected) {
+	XAie_TxnInst *Exported;
+	AieRC RC;
+	u32 Val;
+
+	RC = XAie_Write32(&DevInst, Dm, 0xAA00AAU);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_StartTransaction(&DevInst,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_MaskWrite32(&DevInst, Dm, 0xFF00U, 0x1200U);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	/* The field is out of the mask, in part or in whole */
+	RC = XAie_AddTransactionPatchPoint(&DevInst, "out", Dm, 0U, 0xFFU);
+	CHECK_EQUAL(RC, XAIE_INVALID_ARGS);
+	RC = XAie_AddTransactionPatchPoint(&DevInst, "out", Dm, 4U, 0xFF0U);
+	CHECK_EQUAL(RC, XAIE_INVALID_ARGS);
+	RC = XAie_AddTransactionPatchPoint(&DevInst, "in", Dm, 8U, 0xFF00U);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	Exported = XAie_ExportTransactionInstance(&DevInst);
+	CHECK(Exported != NULL);
+	RC = XAie_SubmitTransaction(&DevInst, NULL);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_PatchTransactionInstance(Exported, "out", 0x34U);
+	CHECK_EQUAL(RC, XAIE_INVALID_ARGS);
+	RC = XAie_PatchTransactionInstance(Exported, "in", 0x34U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_SubmitTransaction(&DevInst, Exported);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RC = XAie_Read32(&DevInst, Dm, &Val);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0xAA34AAU, Val);
+
+	RC = XAie_FreeTransactionInstance(Exported);
+	CHECK_EQUAL(RC, XAIE_OK);
+}
+
+/* The optimized transaction leaves the memory as the plain one does */
+TEST(Txn, OptimizedTxnWritesSameContents) {
+	XAie_DevInst Ref;
+	u64 OptWrites, RefWrites;
+	u32 Val;
+	AieRC RC;
+
+	memset(&Ref, 0, sizeof(Ref));
+	RC = XAie_CfgInitialize(&Ref, &ConfigPtr);
+	CHECK_EQUAL(RC, XAIE_OK);
+
+	RefWrites = TxnOptSequence(&Ref, Dm,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	OptWrites = TxnOptSequence(&DevInst, Dm,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH |
+			XAIE_TRANSACTION_ENABLE_OPTIMIZE);
+	CHECK(OptWrites < RefWrites);
+
+	for(u32 Off = 0U; Off < TXN_OPT_SPAN; Off += 4U) {
+		u32 RefVal;
+
+		CHECK_EQUAL(XAie_Read32(&DevInst, Dm + Off, &Val), XAIE_OK);
+		CHECK_EQUAL(XAie_Read32(&Ref, Dm + Off, &RefVal), XAIE_OK);
+		UNSIGNED_LONGS_EQUAL(RefVal, Val);
+	}
+
+	CHECK_EQUAL(XAie_Read32(&DevInst, Dm + 4U, &Val), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0xAABB2211U, Val);
+	CHECK_EQUAL(XAie_Read32(&DevInst, Dm + 8U, &Val), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x123456A8U, Val);
+	CHECK_EQUAL(XAie_Read32(&DevInst, Dm + 0x2CU, &Val), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x103U, Val);
+	CHECK_EQUAL(XAie_Read32(&DevInst, Dm + 0x40U, &Val), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(6U, Val);
+	CHECK_EQUAL(XAie_Read32(&DevInst, Dm + 0x54U, &Val), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x77U, Val);
+
+	XAie_Finish(&Ref);
+}
+
+TEST(Txn, MoreThreadsThanSlots) {
+	pthread_t Threads[TXN_NUM_THREADS];
+	TxnThreadArgs Args[TXN_NUM_THREADS];
+	pthread_barrier_t Barrier;
+	AieRC RC;
+	u32 Val;
+
+	pthread_barrier_init(&Barrier, NULL, TXN_NUM_THREADS);
+	for(u32 i = 0U; i < TXN_NUM_THREADS; i++) {
+		Args[i].DevInst = &DevInst;
+		Args[i].Barrier = &Barrier;
+		Args[i].RegOff = Dm + i * 4U;
+		Args[i].Value = 0x1000U + i;
+		Args[i].RC = XAIE_ERR;
+		CHECK_EQUAL(pthread_create(&Threads[i], NULL, TxnThread,
+					&Args[i]), 0);
+	}
+
+	for(u32 i = 0U; i < TXN_NUM_THREADS; i++) {
+		pthread_join(Threads[i], NULL);
+		CHECK_EQUAL(Args[i].RC, XAIE_OK);
+	}
+	pthread_barrier_destroy(&Barrier);
+
+	for(u32 i = 0U; i < TXN_NUM_THREADS; i++) {
+		RC = XAie_Read32(&DevInst, Dm + i * 4U, &Val);
+		CHECK_EQUAL(RC, XAIE_OK);
+		UNSIGNED_LONGS_EQUAL(0x1000U + i, Val);
+	}
+}
+
+#endif /* TEST_SHADOWDEV */
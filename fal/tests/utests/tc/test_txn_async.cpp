@@ -0,0 +1,220 @@
+// Copyright(C) 2022 by Xilinx, Inc. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "CppUTest/CommandLineTestRunner.h"
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+
+#include "common/tc_config.h"
+
+/*
+ * Asynchronous transaction submission tests, on the shadow device backend.
+ */
+#ifdef TEST_SHADOWDEV
+
+/* More submissions than the depth of the submission queue */
+#define ASYNC_NUM_TXNS	40U
+
+/* Order in which the callbacks of the fences were called */
+static u32 AsyncCbOrder[ASYNC_NUM_TXNS];
+static u32 AsyncNumCbs;
+
+static void AsyncCb(XAie_TxnFence *Fence, AieRC RC, void *Arg)
+{
+	(void)Fence;
+
+	if(RC == XAIE_OK) {
+		AsyncCbOrder[__atomic_fetch_add(&AsyncNumCbs, 1U,
+				__ATOMIC_RELAXED)] = (u32)(uintptr_t)Arg;
+	}
+}
+
+TEST_GROUP(TxnAsync)
+{
+	XAie_Config ConfigPtr;
+	XAie_DevInst DevInst;
+	u64 Dm;
+
+	TEST_SETUP()
+	{
+		AieRC RC;
+
+		XAie_SetupConfig(Cfg, HW_GEN, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_MEM_TILE_ROW_START, XAIE_MEM_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+		ConfigPtr = Cfg;
+		memset(&DevInst, 0, sizeof(DevInst));
+
+		RC = XAie_CfgInitialize(&DevInst, &ConfigPtr);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		Dm = ((u64)XAIE_AIE_TILE_ROW_START << XAIE_ROW_SHIFT) |
+			((u64)2U << XAIE_COL_SHIFT);
+		AsyncNumCbs = 0U;
+	}
+
+	TEST_TEARDOWN()
+	{
+		XAie_Finish(&DevInst);
+	}
+
+	/*
+	 * Submits the transaction started by the calling thread. Each
+	 * transaction writes its index to the same word and to its own word.
+	 */
+	XAie_TxnFence *Submit(u32 Idx)
+	{
+		XAie_TxnFence *Fence;
+
+		CHECK_EQUAL(XAie_StartTransaction(&DevInst,
+				XAIE_TRANSACTION_DISABLE_AUTO_FLUSH), XAIE_OK);
+		CHECK_EQUAL(XAie_Write32(&DevInst, Dm, Idx), XAIE_OK);
+		CHECK_EQUAL(XAie_Write32(&DevInst, Dm + 0x100U + Idx * 4U,
+				Idx + 1U), XAIE_OK);
+
+		Fence = XAie_SubmitTransactionAsync(&DevInst, NULL);
+		CHECK(Fence != NULL);
+
+		return Fence;
+	}
+
+	void CheckWritten(u32 NumTxns)
+	{
+		u32 Val;
+
+		CHECK_EQUAL(XAie_Read32(&DevInst, Dm, &Val), XAIE_OK);
+		UNSIGNED_LONGS_EQUAL(NumTxns - 1U, Val);
+		for(u32 i = 0U; i < NumTxns; i++) {
+			CHECK_EQUAL(XAie_Read32(&DevInst, Dm + 0x100U + i * 4U,
+					&Val), XAIE_OK);
+			UNSIGNED_LONGS_EQUAL(i + 1U, Val);
+		}
+	}
+};
+
+/* Transactions are applied in submission order, past the queue depth */
+TEST(TxnAsync, AppliedInOrder) {
+	XAie_TxnFence *Fences[ASYNC_NUM_TXNS];
+	u8 IsSignaled;
+	AieRC Status;
+
+	for(u32 i = 0U; i < ASYNC_NUM_TXNS; i++) {
+		Fences[i] = Submit(i);
+	}
+
+	CHECK_EQUAL(XAie_WaitTransactionFence(Fences[ASYNC_NUM_TXNS - 1U]),
+			XAIE_OK);
+	for(u32 i = 0U; i < ASYNC_NUM_TXNS; i++) {
+		CHECK_EQUAL(XAie_PollTransactionFence(Fences[i], &IsSignaled,
+				&Status), XAIE_OK);
+		UNSIGNED_LONGS_EQUAL(1U, IsSignaled);
+		CHECK_EQUAL(XAIE_OK, Status);
+		CHECK_EQUAL(XAie_FreeTransactionFence(Fences[i]), XAIE_OK);
+	}
+
+	CheckWritten(ASYNC_NUM_TXNS);
+}
+
+/* Callbacks are called once per fence, in submission order */
+TEST(TxnAsync, CallbacksInOrder) {
+	XAie_TxnFence *Fences[ASYNC_NUM_TXNS];
+
+	for(u32 i = 0U; i < ASYNC_NUM_TXNS; i++) {
+		Fences[i] = Submit(i);
+		CHECK_EQUAL(XAie_SetTransactionFenceCallback(Fences[i], AsyncCb,
+				(void *)(uintptr_t)i), XAIE_OK);
+	}
+
+	for(u32 i = 0U; i < ASYNC_NUM_TXNS; i++) {
+		CHECK_EQUAL(XAie_WaitTransactionFence(Fences[i]), XAIE_OK);
+	}
+
+	/* A second callback is rejected, on a signaled fence too */
+	CHECK_EQUAL(XAie_SetTransactionFenceCallback(Fences[0], AsyncCb, NULL),
+			XAIE_ERR);
+
+	UNSIGNED_LONGS_EQUAL(ASYNC_NUM_TXNS,
+			__atomic_load_n(&AsyncNumCbs, __ATOMIC_ACQUIRE));
+	for(u32 i = 0U; i < ASYNC_NUM_TXNS; i++) {
+		UNSIGNED_LONGS_EQUAL(i, AsyncCbOrder[i]);
+		XAie_FreeTransactionFence(Fences[i]);
+	}
+}
+
+/* A callback set on a signaled fence is called by the calling thread */
+TEST(TxnAsync, CallbackOnSignaledFence) {
+	XAie_TxnFence *Fence;
+
+	Fence = Submit(0U);
+	CHECK_EQUAL(XAie_WaitTransactionFence(Fence), XAIE_OK);
+
+	CHECK_EQUAL(XAie_SetTransactionFenceCallback(Fence, AsyncCb,
+			(void *)(uintptr_t)7U), XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(1U, AsyncNumCbs);
+	UNSIGNED_LONGS_EQUAL(7U, AsyncCbOrder[0]);
+
+	XAie_FreeTransactionFence(Fence);
+}
+
+/*
+ * Released fences are still applied, and their detached transactions are
+ * freed by the worker.
+ */
+TEST(TxnAsync, FreedFencesAreApplied) {
+	XAie_TxnFence *Fence;
+
+	for(u32 i = 0U; i < ASYNC_NUM_TXNS - 1U; i++) {
+		CHECK_EQUAL(XAie_FreeTransactionFence(Submit(i)), XAIE_OK);
+	}
+
+	Fence = Submit(ASYNC_NUM_TXNS - 1U);
+	CHECK_EQUAL(XAie_WaitTransactionFence(Fence), XAIE_OK);
+	XAie_FreeTransactionFence(Fence);
+
+	CheckWritten(ASYNC_NUM_TXNS);
+}
+
+/* Finish applies the queued transactions before it stops the worker */
+TEST(TxnAsync, FinishDrainsQueue) {
+	for(u32 i = 0U; i < ASYNC_NUM_TXNS; i++) {
+		CHECK_EQUAL(XAie_FreeTransactionFence(Submit(i)), XAIE_OK);
+	}
+
+	XAie_Finish(&DevInst);
+	memset(&DevInst, 0, sizeof(DevInst));
+	CHECK_EQUAL(XAie_CfgInitialize(&DevInst, &ConfigPtr), XAIE_OK);
+}
+
+/* An exported instance stays owned by the caller and can be queued again */
+TEST(TxnAsync, ExportedInstance) {
+	XAie_DevInst Src;
+	XAie_TxnInst *TxnInst;
+	XAie_TxnFence *Fence;
+	u32 Val;
+
+	memset(&Src, 0, sizeof(Src));
+	CHECK_EQUAL(XAie_CfgInitialize(&Src, &ConfigPtr), XAIE_OK);
+	CHECK_EQUAL(XAie_StartTransaction(&Src,
+			XAIE_TRANSACTION_DISABLE_AUTO_FLUSH), XAIE_OK);
+	CHECK_EQUAL(XAie_Write32(&Src, Dm, 0xA5U), XAIE_OK);
+	TxnInst = XAie_ExportTransactionInstance(&Src);
+	CHECK(TxnInst != NULL);
+	XAie_Finish(&Src);
+
+	for(u32 i = 0U; i < 2U; i++) {
+		Fence = XAie_SubmitTransactionAsync(&DevInst, TxnInst);
+		CHECK(Fence != NULL);
+		CHECK_EQUAL(XAie_WaitTransactionFence(Fence), XAIE_OK);
+		XAie_FreeTransactionFence(Fence);
+
+		CHECK_EQUAL(XAie_Read32(&DevInst, Dm, &Val), XAIE_OK);
+		UNSIGNED_LONGS_EQUAL(0xA5U, Val);
+		CHECK_EQUAL(XAie_Write32(&DevInst, Dm, 0U), XAIE_OK);
+	}
+
+	XAie_FreeTransactionInstance(TxnInst);
+}
+
+#endif /* TEST_SHADOWDEV */
@@ -0,0 +1,401 @@
+// Copyright(C) 2022 by Xilinx, Inc. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include <stdlib.h>
+
+#include "CppUTest/CommandLineTestRunner.h"
+#include "CppUTest/TestHarness.h"
+#include "CppUTest/TestRegistry.h"
+
+#include "common/tc_config.h"
+
+/*
+ * Serialized transaction tests, on the shadow device backend.
+ */
+#ifdef TEST_SHADOWDEV
+
+#define TXN_HDR_SIZE_V1	48U
+
+/* Header of a serialized transaction, as laid out by the driver */
+typedef struct {
+	u32 Magic;
+	u16 Version;
+	u16 HdrSize;
+	u32 Flags;
+	u32 NumCmds;
+	u64 CmdOff;
+	u64 PayloadOff;
+	u64 PayloadSize;
+	u64 TotalSize;
+	u64 RelocOff;
+	u32 NumRelocs;
+	u32 Rsvd;
+} TxnFileHdr;
+
+/* Command of a serialized transaction */
+typedef struct {
+	u32 Opcode;
+	u32 Mask;
+	u64 RegOff;
+	u32 Value;
+	u32 Size;
+	u64 DataOff;
+} TxnFileCmd;
+
+#define TXN_OPCODE_MASKPOLL	3U
+
+/* Patch point of a serialized transaction */
+typedef struct {
+	char Name[32];
+	u32 CmdIdx;
+	u32 WordIdx;
+	u32 Mask;
+	u32 Lsb;
+} TxnFileReloc;
+
+static u64 SerTileAddr(u8 Col, u8 Row)
+{
+	return ((u64)Row << XAIE_ROW_SHIFT) | ((u64)Col << XAIE_COL_SHIFT);
+}
+
+TEST_GROUP(TxnSerialize)
+{
+	XAie_Config ConfigPtr;
+	XAie_DevInst DevInst;
+	u64 Dm;
+	u32 Data[4];
+
+	TEST_SETUP()
+	{
+		AieRC RC;
+
+		XAie_SetupConfig(Cfg, HW_GEN, XAIE_BASE_ADDR,
+			XAIE_COL_SHIFT, XAIE_ROW_SHIFT,
+			XAIE_NUM_COLS, XAIE_NUM_ROWS, XAIE_SHIM_ROW,
+			XAIE_MEM_TILE_ROW_START, XAIE_MEM_TILE_NUM_ROWS,
+			XAIE_AIE_TILE_ROW_START, XAIE_AIE_TILE_NUM_ROWS);
+		ConfigPtr = Cfg;
+		memset(&DevInst, 0, sizeof(DevInst));
+
+		RC = XAie_CfgInitialize(&DevInst, &ConfigPtr);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		Dm = SerTileAddr(2, XAIE_AIE_TILE_ROW_START);
+		for(u32 i = 0U; i < 4U; i++) {
+			Data[i] = 0xC0U + i;
+		}
+	}
+
+	TEST_TEARDOWN()
+	{
+		XAie_Finish(&DevInst);
+	}
+
+	/*
+	 * Serializes a transaction of a write and a block write, built on
+	 * another device instance.
+	 */
+	void *Serialize(u64 *Size)
+	{
+		XAie_DevInst Src;
+		XAie_TxnInst *TxnInst;
+		void *Buf;
+		AieRC RC;
+
+		memset(&Src, 0, sizeof(Src));
+		RC = XAie_CfgInitialize(&Src, &ConfigPtr);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		RC = XAie_StartTransaction(&Src,
+				XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+		CHECK_EQUAL(RC, XAIE_OK);
+		RC = XAie_Write32(&Src, Dm, 0x5AU);
+		CHECK_EQUAL(RC, XAIE_OK);
+		RC = XAie_BlockWrite32(&Src, Dm + 0x40U, Data, 4U);
+		CHECK_EQUAL(RC, XAIE_OK);
+
+		TxnInst = XAie_ExportTransactionInstance(&Src);
+		CHECK(TxnInst != NULL);
+		XAie_Finish(&Src);
+
+		RC = XAie_SerializeTransactionInstance(TxnInst, NULL, Size);
+		CHECK_EQUAL(RC, XAIE_OK);
+		Buf = malloc(*Size);
+		CHECK(Buf != NULL);
+		RC = XAie_SerializeTransactionInstance(TxnInst, Buf, Size);
+		CHECK_EQUAL(RC, XAIE_OK);
+		XAie_FreeTransactionInstance(TxnInst);
+
+		return Buf;
+	}
+
+	/* Rewrites a version 2 serialized transaction with a version 1 header */
+	void *ToV1(const void *Buf, u64 *Size)
+	{
+		const TxnFileHdr *Hdr = (const TxnFileHdr *)Buf;
+		u64 Skip = Hdr->CmdOff - TXN_HDR_SIZE_V1;
+		TxnFileHdr *V1Hdr;
+		u8 *V1;
+
+		CHECK_EQUAL(0U, Hdr->NumRelocs);
+		V1 = (u8 *)malloc(*Size - Skip);
+		CHECK(V1 != NULL);
+		memcpy(V1, Buf, TXN_HDR_SIZE_V1);
+		memcpy(V1 + TXN_HDR_SIZE_V1, (const u8 *)Buf + Hdr->CmdOff,
+				*Size - Hdr->CmdOff);
+
+		V1Hdr = (TxnFileHdr *)V1;
+		V1Hdr->Version = 1U;
+		V1Hdr->HdrSize = TXN_HDR_SIZE_V1;
+		V1Hdr->CmdOff = TXN_HDR_SIZE_V1;
+		V1Hdr->PayloadOff -= Skip;
+		V1Hdr->TotalSize -= Skip;
+		*Size -= Skip;
+
+		return V1;
+	}
+
+	void CheckWritten()
+	{
+		u32 Val;
+
+		CHECK_EQUAL(XAie_Read32(&DevInst, Dm, &Val), XAIE_OK);
+		UNSIGNED_LONGS_EQUAL(0x5AU, Val);
+		for(u32 i = 0U; i < 4U; i++) {
+			CHECK_EQUAL(XAie_Read32(&DevInst, Dm + 0x40U + i * 4U,
+					&Val), XAIE_OK);
+			UNSIGNED_LONGS_EQUAL(Data[i], Val);
+		}
+	}
+};
+
+TEST(TxnSerialize, LoadV2) {
+	XAie_TxnInst *TxnInst;
+	void *Buf;
+	u64 Size;
+
+	Buf = Serialize(&Size);
+	TxnInst = XAie_DeserializeTransactionInstance(Buf, Size);
+	CHECK(TxnInst != NULL);
+	CHECK_EQUAL(XAie_SubmitTransaction(&DevInst, TxnInst), XAIE_OK);
+	CheckWritten();
+
+	XAie_FreeTransactionInstance(TxnInst);
+	free(Buf);
+}
+
+/* A version 1 header is shorter than the current one */
+TEST(TxnSerialize, LoadV1) {
+	XAie_TxnInst *TxnInst;
+	void *Buf;
+	void *V1;
+	u64 Size;
+
+	Buf = Serialize(&Size);
+	V1 = ToV1(Buf, &Size);
+	free(Buf);
+
+	TxnInst = XAie_DeserializeTransactionInstance(V1, Size);
+	CHECK(TxnInst != NULL);
+	CHECK_EQUAL(XAie_SubmitTransaction(&DevInst, TxnInst), XAIE_OK);
+	CheckWritten();
+
+	XAie_FreeTransactionInstance(TxnInst);
+	free(V1);
+}
+
+/* An empty version 1 transaction is only a version 1 header */
+TEST(TxnSerialize, LoadEmptyV1) {
+	XAie_TxnInst *TxnInst;
+	TxnFileHdr *Hdr;
+	u8 *V1;
+
+	V1 = (u8 *)malloc(TXN_HDR_SIZE_V1);
+	CHECK(V1 != NULL);
+	memset(V1, 0, TXN_HDR_SIZE_V1);
+	Hdr = (TxnFileHdr *)V1;
+	Hdr->Magic = 0x4E585458U;
+	Hdr->Version = 1U;
+	Hdr->HdrSize = TXN_HDR_SIZE_V1;
+	Hdr->CmdOff = TXN_HDR_SIZE_V1;
+	Hdr->PayloadOff = TXN_HDR_SIZE_V1;
+	Hdr->TotalSize = TXN_HDR_SIZE_V1;
+
+	TxnInst = XAie_DeserializeTransactionInstance(V1, TXN_HDR_SIZE_V1);
+	CHECK(TxnInst != NULL);
+	CHECK_EQUAL(XAie_SubmitTransaction(&DevInst, TxnInst), XAIE_OK);
+
+	XAie_FreeTransactionInstance(TxnInst);
+	free(V1);
+}
+
+/* A version 2 header cut to the size of a version 1 header is rejected */
+TEST(TxnSerialize, TruncatedV2IsRejected) {
+	void *Buf;
+	u8 *Cut;
+	u64 Size;
+
+	Buf = Serialize(&Size);
+	Cut = (u8 *)malloc(TXN_HDR_SIZE_V1);
+	CHECK(Cut != NULL);
+	memcpy(Cut, Buf, TXN_HDR_SIZE_V1);
+	free(Buf);
+
+	POINTERS_EQUAL(NULL, XAie_DeserializeTransactionInstance(Cut,
+				TXN_HDR_SIZE_V1));
+	free(Cut);
+}
+
+/* Buffers which are not aligned for the header and the commands are rejected */
+TEST(TxnSerialize, UnalignedBufferIsRejected) {
+	XAie_DevInst Src;
+	XAie_TxnInst *TxnInst;
+	void *Buf;
+	u8 *Copy;
+	u64 Size;
+	AieRC RC;
+
+	Buf = Serialize(&Size);
+	Copy = (u8 *)malloc(Size + sizeof(u64));
+	CHECK(Copy != NULL);
+	memcpy(Copy + 4U, Buf, Size);
+	free(Buf);
+
+	POINTERS_EQUAL(NULL, XAie_DeserializeTransactionInstance(Copy + 4U,
+				Size));
+
+	memset(&Src, 0, sizeof(Src));
+	RC = XAie_CfgInitialize(&Src, &ConfigPtr);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_StartTransaction(&Src, XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_Write32(&Src, Dm, 0x5AU);
+	CHECK_EQUAL(RC, XAIE_OK);
+	TxnInst = XAie_ExportTransactionInstance(&Src);
+	CHECK(TxnInst != NULL);
+	XAie_Finish(&Src);
+
+	RC = XAie_SerializeTransactionInstance(TxnInst, Copy + 4U, &Size);
+	CHECK_EQUAL(RC, XAIE_INVALID_ARGS);
+
+	XAie_FreeTransactionInstance(TxnInst);
+	free(Copy);
+}
+
+/* Polls keep their site, which selects their policy when submitted */
+TEST(TxnSerialize, PollSiteIsKept) {
+	XAie_DevInst Src;
+	XAie_TxnInst *TxnInst;
+	TxnFileHdr *Hdr;
+	TxnFileCmd *Cmd;
+	XAie_PollSite Sites[2];
+	u32 NumPolls = 0U;
+	void *Buf;
+	u64 Size;
+	AieRC RC;
+
+	memset(&Src, 0, sizeof(Src));
+	RC = XAie_CfgInitialize(&Src, &ConfigPtr);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_StartTransaction(&Src, XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_MaskPoll(&Src, Dm, 0xFFU, 0U, 10U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_DmaWaitForDone(&Src, XAie_TileLoc(2,
+				XAIE_AIE_TILE_ROW_START), 0U, DMA_S2MM, 10U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	TxnInst = XAie_ExportTransactionInstance(&Src);
+	CHECK(TxnInst != NULL);
+	XAie_Finish(&Src);
+
+	RC = XAie_SerializeTransactionInstance(TxnInst, NULL, &Size);
+	CHECK_EQUAL(RC, XAIE_OK);
+	Buf = malloc(Size);
+	CHECK(Buf != NULL);
+	RC = XAie_SerializeTransactionInstance(TxnInst, Buf, &Size);
+	CHECK_EQUAL(RC, XAIE_OK);
+	XAie_FreeTransactionInstance(TxnInst);
+
+	Hdr = (TxnFileHdr *)Buf;
+	Cmd = (TxnFileCmd *)((u8 *)Buf + Hdr->CmdOff);
+	for(u32 i = 0U; i < Hdr->NumCmds; i++) {
+		if(Cmd[i].Opcode == TXN_OPCODE_MASKPOLL) {
+			CHECK(NumPolls < 2U);
+			Sites[NumPolls++] = (XAie_PollSite)Cmd[i].DataOff;
+		}
+	}
+	UNSIGNED_LONGS_EQUAL(2U, NumPolls);
+	UNSIGNED_LONGS_EQUAL(XAIE_POLL_DEFAULT, Sites[0]);
+	UNSIGNED_LONGS_EQUAL(XAIE_POLL_DMA, Sites[1]);
+
+	TxnInst = XAie_DeserializeTransactionInstance(Buf, Size);
+	CHECK(TxnInst != NULL);
+	CHECK_EQUAL(XAie_SubmitTransaction(&DevInst, TxnInst), XAIE_OK);
+	XAie_FreeTransactionInstance(TxnInst);
+
+	/* A site out of range is rejected */
+	for(u32 i = 0U; i < Hdr->NumCmds; i++) {
+		if(Cmd[i].Opcode == TXN_OPCODE_MASKPOLL) {
+			Cmd[i].DataOff = XAIE_POLL_MAX;
+		}
+	}
+	POINTERS_EQUAL(NULL, XAie_DeserializeTransactionInstance(Buf, Size));
+
+	free(Buf);
+}
+
+/* Patch points of a loaded transaction are checked against the write mask */
+TEST(TxnSerialize, LoadedPatchPointOutOfWriteMaskIsRejected) {
+	XAie_DevInst Src;
+	XAie_TxnInst *TxnInst;
+	TxnFileReloc *Reloc;
+	TxnFileHdr *Hdr;
+	void *Buf;
+	u64 Size;
+	u32 Val;
+	AieRC RC;
+
+	memset(&Src, 0, sizeof(Src));
+	RC = XAie_CfgInitialize(&Src, &ConfigPtr);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_StartTransaction(&Src, XAIE_TRANSACTION_DISABLE_AUTO_FLUSH);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_MaskWrite32(&Src, Dm, 0xFF00U, 0x1200U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_AddTransactionPatchPoint(&Src, "field", Dm, 8U, 0xFF00U);
+	CHECK_EQUAL(RC, XAIE_OK);
+	TxnInst = XAie_ExportTransactionInstance(&Src);
+	CHECK(TxnInst != NULL);
+	XAie_Finish(&Src);
+
+	RC = XAie_SerializeTransactionInstance(TxnInst, NULL, &Size);
+	CHECK_EQUAL(RC, XAIE_OK);
+	Buf = malloc(Size);
+	CHECK(Buf != NULL);
+	RC = XAie_SerializeTransactionInstance(TxnInst, Buf, &Size);
+	CHECK_EQUAL(RC, XAIE_OK);
+	XAie_FreeTransactionInstance(TxnInst);
+
+	/* Widen the field out of the mask of the write */
+	Hdr = (TxnFileHdr *)Buf;
+	UNSIGNED_LONGS_EQUAL(1U, Hdr->NumRelocs);
+	Reloc = (TxnFileReloc *)((u8 *)Buf + Hdr->RelocOff);
+	Reloc->Mask = 0xFFFF00U;
+
+	TxnInst = XAie_DeserializeTransactionInstance(Buf, Size);
+	CHECK(TxnInst != NULL);
+	RC = XAie_PatchTransactionInstance(TxnInst, "field", 0x34U);
+	CHECK_EQUAL(RC, XAIE_INVALID_ARGS);
+
+	/* The transaction is left as it was serialized */
+	RC = XAie_SubmitTransaction(&DevInst, TxnInst);
+	CHECK_EQUAL(RC, XAIE_OK);
+	RC = XAie_Read32(&DevInst, Dm, &Val);
+	CHECK_EQUAL(RC, XAIE_OK);
+	UNSIGNED_LONGS_EQUAL(0x1200U, Val);
+
+	XAie_FreeTransactionInstance(TxnInst);
+	free(Buf);
+}
+
+#endif /* TEST_SHADOWDEV */